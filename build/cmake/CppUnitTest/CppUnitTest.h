@@ -0,0 +1,242 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+//
+// Stand-in for the subset of the Visual Studio CppUnitTestFramework that is
+// used by the tests of our portable code (the numerics library and the CPU
+// geometry helpers). This lets the CMake build compile those test files
+// unchanged with GCC or Clang, and run them on Linux, including under an
+// emulator when cross compiling.
+//
+// Tests register themselves as they are declared, and are run by
+// CppUnitTestMain.cpp.
+//
+
+#include <cstdint>
+#include <cstdio>
+#include <cwchar>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace Microsoft { namespace VisualStudio { namespace CppUnitTestFramework
+{
+    // Thrown when an assertion fails, and caught by the test runner.
+    struct AssertFailedException
+    {
+        std::wstring Message;
+    };
+
+
+    class TestRegistry
+    {
+    public:
+        struct TestMethod
+        {
+            std::string Name;
+            std::function<void()> Invoke;
+        };
+
+        static std::vector<TestMethod>& GetTestMethods()
+        {
+            static std::vector<TestMethod> testMethods;
+            return testMethods;
+        }
+
+        static void Add(char const* className, char const* methodName, std::function<void()> invoke)
+        {
+            GetTestMethods().push_back(TestMethod{ std::string(className) + "::" + methodName, std::move(invoke) });
+        }
+    };
+
+
+    template<typename T, typename ClassName>
+    class TestClass
+    {
+    protected:
+        typedef T ThisClass;
+
+        static char const* GetClassName()
+        {
+            return ClassName::Get();
+        }
+    };
+
+
+    namespace Details
+    {
+        template<typename T>
+        typename std::enable_if<std::is_arithmetic<T>::value, std::wstring>::type Format(T const& value)
+        {
+            return std::to_wstring(value);
+        }
+
+        template<typename T>
+        typename std::enable_if<!std::is_arithmetic<T>::value, std::wstring>::type Format(T const&)
+        {
+            return L"<value>";
+        }
+    }
+
+
+    // Tests specialize these to format their own types in failure messages.
+    template<typename Q>
+    inline std::wstring ToString(Q const& value)
+    {
+        return Details::Format(value);
+    }
+
+    template<typename Q>
+    inline std::wstring ToString(Q* value)
+    {
+        wchar_t buffer[32];
+        swprintf(buffer, sizeof(buffer) / sizeof(buffer[0]), L"%p", static_cast<void const*>(value));
+        return buffer;
+    }
+
+
+    class Assert
+    {
+    public:
+        template<typename T>
+        static void AreEqual(T const& expected, T const& actual, wchar_t const* message = nullptr)
+        {
+            if (!(expected == actual))
+                FailComparison(L"AreEqual", ToString(expected), ToString(actual), message);
+        }
+
+        static void AreEqual(float expected, float actual, float tolerance, wchar_t const* message = nullptr)
+        {
+            float difference = expected - actual;
+
+            if (!(difference <= tolerance && -difference <= tolerance))
+                FailComparison(L"AreEqual", ToString(expected), ToString(actual), message);
+        }
+
+        static void AreEqual(double expected, double actual, double tolerance, wchar_t const* message = nullptr)
+        {
+            double difference = expected - actual;
+
+            if (!(difference <= tolerance && -difference <= tolerance))
+                FailComparison(L"AreEqual", ToString(expected), ToString(actual), message);
+        }
+
+        template<typename T>
+        static void AreNotEqual(T const& notExpected, T const& actual, wchar_t const* message = nullptr)
+        {
+            if (notExpected == actual)
+                FailComparison(L"AreNotEqual", ToString(notExpected), ToString(actual), message);
+        }
+
+        static void IsTrue(bool condition, wchar_t const* message = nullptr)
+        {
+            if (!condition)
+                Fail(Describe(L"IsTrue", message));
+        }
+
+        static void IsFalse(bool condition, wchar_t const* message = nullptr)
+        {
+            if (condition)
+                Fail(Describe(L"IsFalse", message));
+        }
+
+        template<typename T>
+        static void IsNull(T const* pointer, wchar_t const* message = nullptr)
+        {
+            if (pointer)
+                Fail(Describe(L"IsNull", message));
+        }
+
+        template<typename T>
+        static void IsNotNull(T const* pointer, wchar_t const* message = nullptr)
+        {
+            if (!pointer)
+                Fail(Describe(L"IsNotNull", message));
+        }
+
+        template<typename ExpectedException, typename Functor>
+        static void ExpectException(Functor functor, wchar_t const* message = nullptr)
+        {
+            try
+            {
+                functor();
+            }
+            catch (ExpectedException const&)
+            {
+                return;
+            }
+            catch (AssertFailedException const&)
+            {
+                throw;
+            }
+            catch (...)
+            {
+                Fail(Describe(L"ExpectException: a different exception was thrown", message));
+            }
+
+            Fail(Describe(L"ExpectException: no exception was thrown", message));
+        }
+
+        static void Fail(wchar_t const* message = nullptr)
+        {
+            Fail(std::wstring(message ? message : L"Fail"));
+        }
+
+        static void Fail(std::wstring const& message)
+        {
+            throw AssertFailedException{ message };
+        }
+
+    private:
+        static std::wstring Describe(wchar_t const* assertion, wchar_t const* message)
+        {
+            std::wstring description(assertion);
+
+            if (message)
+                description = description + L" - " + message;
+
+            return description;
+        }
+
+        static void FailComparison(wchar_t const* assertion, std::wstring const& expected, std::wstring const& actual, wchar_t const* message)
+        {
+            Fail(Describe(assertion, message) + L" (expected " + expected + L", actual " + actual + L")");
+        }
+    };
+}}}
+
+
+#define TEST_CLASS(className)                                                   \
+    struct className##_ClassName                                                \
+    {                                                                           \
+        static char const* Get() { return #className; }                         \
+    };                                                                          \
+                                                                                \
+    class className : public ::Microsoft::VisualStudio::CppUnitTestFramework::TestClass<className, className##_ClassName>
+
+#define TEST_METHOD(methodName)                                                 \
+    struct methodName##_Registration                                            \
+    {                                                                           \
+        methodName##_Registration()                                             \
+        {                                                                       \
+            ::Microsoft::VisualStudio::CppUnitTestFramework::TestRegistry::Add( \
+                GetClassName(), #methodName, [] { ThisClass().methodName(); }); \
+        }                                                                       \
+    };                                                                          \
+                                                                                \
+    static inline methodName##_Registration methodName##_registration{};        \
+                                                                                \
+public:                                                                         \
+    void methodName()
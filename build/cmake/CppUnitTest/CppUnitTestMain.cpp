@@ -0,0 +1,94 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+//
+// Runs every test registered through CppUnitTest.h.
+//
+// Usage: <tests> [--exclude <pattern>]...
+//
+// Tests whose ClassName::MethodName matches an --exclude pattern (which may
+// use * and ? wildcards) are skipped. The exit code is non-zero if any test
+// fails.
+//
+
+#include "CppUnitTest.h"
+
+#include <cstring>
+#include <exception>
+
+#include <fnmatch.h>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+int main(int argc, char** argv)
+{
+    std::vector<char const*> excludePatterns;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--exclude") == 0 && i + 1 < argc)
+        {
+            excludePatterns.push_back(argv[++i]);
+        }
+        else
+        {
+            fprintf(stderr, "Usage: %s [--exclude <pattern>]...\n", argv[0]);
+            return 2;
+        }
+    }
+
+    int passCount = 0;
+    int skipCount = 0;
+    int failCount = 0;
+
+    for (auto& test : TestRegistry::GetTestMethods())
+    {
+        bool isExcluded = false;
+
+        for (auto pattern : excludePatterns)
+        {
+            if (fnmatch(pattern, test.Name.c_str(), 0) == 0)
+                isExcluded = true;
+        }
+
+        if (isExcluded)
+        {
+            skipCount++;
+            continue;
+        }
+
+        try
+        {
+            test.Invoke();
+            passCount++;
+        }
+        catch (AssertFailedException const& e)
+        {
+            fprintf(stderr, "FAILED %s: %ls\n", test.Name.c_str(), e.Message.c_str());
+            failCount++;
+        }
+        catch (std::exception const& e)
+        {
+            fprintf(stderr, "FAILED %s: unexpected exception: %s\n", test.Name.c_str(), e.what());
+            failCount++;
+        }
+        catch (...)
+        {
+            fprintf(stderr, "FAILED %s: unexpected exception\n", test.Name.c_str());
+            failCount++;
+        }
+    }
+
+    printf("%d passed, %d failed, %d skipped\n", passCount, failCount, skipCount);
+
+    return (failCount > 0) ? 1 : 0;
+}
@@ -0,0 +1,49 @@
+# Copyright (c) Microsoft Corporation. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License"); you may
+# not use these files except in compliance with the License. You may obtain
+# a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+# WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+# License for the specific language governing permissions and limitations
+# under the License.
+
+# Cross compiles the portable code for 64 bit ARM Linux, and runs its tests
+# under qemu, so the AArch64 code paths are tested on x64 build machines:
+#
+#   cmake -S . -B build-arm64 -DCMAKE_TOOLCHAIN_FILE=build/cmake/aarch64-linux-gnu.cmake
+#   cmake --build build-arm64
+#   ctest --test-dir build-arm64
+#
+# On Debian and Ubuntu this needs the g++-aarch64-linux-gnu and qemu-user
+# packages. Set CROSS_SYSROOT if the target libraries live somewhere other
+# than /usr/aarch64-linux-gnu.
+
+set(CMAKE_SYSTEM_NAME Linux)
+set(CMAKE_SYSTEM_PROCESSOR aarch64)
+
+set(CMAKE_C_COMPILER aarch64-linux-gnu-gcc)
+set(CMAKE_CXX_COMPILER aarch64-linux-gnu-g++)
+
+if(NOT CROSS_SYSROOT)
+    set(CROSS_SYSROOT /usr/aarch64-linux-gnu)
+endif()
+
+list(APPEND CMAKE_TRY_COMPILE_PLATFORM_VARIABLES CROSS_SYSROOT)
+
+# Target libraries come from the sysroot, but header only dependencies such
+# as DirectXMath may be installed for the host.
+set(CMAKE_FIND_ROOT_PATH ${CROSS_SYSROOT})
+set(CMAKE_FIND_ROOT_PATH_MODE_PROGRAM NEVER)
+set(CMAKE_FIND_ROOT_PATH_MODE_LIBRARY ONLY)
+set(CMAKE_FIND_ROOT_PATH_MODE_INCLUDE BOTH)
+set(CMAKE_FIND_ROOT_PATH_MODE_PACKAGE BOTH)
+
+# CTest runs every test executable through this.
+find_program(QEMU_AARCH64 NAMES qemu-aarch64 qemu-aarch64-static)
+
+if(QEMU_AARCH64)
+    set(CMAKE_CROSSCOMPILING_EMULATOR ${QEMU_AARCH64} -L ${CROSS_SYSROOT})
+endif()
@@ -0,0 +1,35 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+//
+// Stand-in for winrt/test.internal/pch.h in the portable build, for test
+// files that only exercise the geometry helpers, and so need none of the
+// WinRT mocks.
+//
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <CppUnitTest.h>
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas {} } } }
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace ABI::Microsoft::Graphics::Canvas;
+
+// There are no LifespanTracker objects or mock expectations to validate.
+#define TEST_METHOD_EX(METHOD_NAME) TEST_METHOD(METHOD_NAME)
@@ -13,6 +13,7 @@
 #pragma once
 
 #include <DirectXMath.h>
+#include <DirectXPackedVector.h>
 
 
 #if defined __cplusplus_winrt && _MSC_VER >= 1900
@@ -56,6 +57,16 @@
 #endif
 
 
+// Simple float2 and float3x2 construction and arithmetic is constexpr, so tables of
+// fixed transforms can be built at compile time. Older compilers do not support
+// constexpr, and C++/CX projected types have their own non-constexpr constructors.
+#if defined _WINDOWS_NUMERICS_CX_PROJECTION_ || (defined _MSC_VER && _MSC_VER < 1900)
+#define _WINDOWS_NUMERICS_CONSTEXPR_ inline
+#else
+#define _WINDOWS_NUMERICS_CONSTEXPR_ constexpr
+#endif
+
+
 namespace Windows { namespace Foundation { namespace Numerics
 {
 #ifndef _WINDOWS_NUMERICS_CX_PROJECTION_
@@ -75,8 +86,8 @@ namespace Windows { namespace Foundation { namespace Numerics
 
         // Constructors.
         float2() = default;
-        float2(float x, float y);
-        explicit float2(float value);
+        _WINDOWS_NUMERICS_CONSTEXPR_ float2(float x, float y);
+        _WINDOWS_NUMERICS_CONSTEXPR_ explicit float2(float value);
 
         // Conversion operators.
         _DEFINE_WINDOWS_NUMERICS_INTEROP_(float2, Vector2)
@@ -90,32 +101,32 @@ namespace Windows { namespace Foundation { namespace Numerics
 #endif
 
         // Common values.
-        static float2 zero();
-        static float2 one();
-        static float2 unit_x();
-        static float2 unit_y();
+        static _WINDOWS_NUMERICS_CONSTEXPR_ float2 zero();
+        static _WINDOWS_NUMERICS_CONSTEXPR_ float2 one();
+        static _WINDOWS_NUMERICS_CONSTEXPR_ float2 unit_x();
+        static _WINDOWS_NUMERICS_CONSTEXPR_ float2 unit_y();
     };
 
 #endif  // !_WINDOWS_NUMERICS_CX_PROJECTION_
 
 
     // Operators.
-    float2 operator +(float2 const& value1, float2 const& value2);
-    float2 operator -(float2 const& value1, float2 const& value2);
-    float2 operator *(float2 const& value1, float2 const& value2);
-    float2 operator *(float2 const& value1, float value2);
-    float2 operator *(float value1, float2 const& value2);
-    float2 operator /(float2 const& value1, float2 const& value2);
-    float2 operator /(float2 const& value1, float value2);
-    float2 operator -(float2 const& value);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float2 operator +(float2 const& value1, float2 const& value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float2 operator -(float2 const& value1, float2 const& value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float2 operator *(float2 const& value1, float2 const& value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float2 operator *(float2 const& value1, float value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float2 operator *(float value1, float2 const& value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float2 operator /(float2 const& value1, float2 const& value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float2 operator /(float2 const& value1, float value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float2 operator -(float2 const& value);
     float2& operator +=(float2& value1, float2 const& value2);
     float2& operator -=(float2& value1, float2 const& value2);
     float2& operator *=(float2& value1, float2 const& value2);
     float2& operator *=(float2& value1, float value2);
     float2& operator /=(float2& value1, float2 const& value2);
     float2& operator /=(float2& value1, float value2);
-    bool operator ==(float2 const& value1, float2 const& value2);
-    bool operator !=(float2 const& value1, float2 const& value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ bool operator ==(float2 const& value1, float2 const& value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ bool operator !=(float2 const& value1, float2 const& value2);
 
     // Functions.
     float length(float2 const& value);
@@ -135,6 +146,12 @@ namespace Windows { namespace Foundation { namespace Numerics
     float2 transform_normal(float2 const& normal, float4x4 const& matrix);
     float2 transform(float2 const& value, quaternion const& rotation);
 
+    // Batched functions.
+    void transform(_In_reads_(count) float2 const* positions, size_t count, float3x2 const& matrix, _Out_writes_(count) float2* results);
+    void transform(_In_reads_(count) float2 const* positions, size_t count, float4x4 const& matrix, _Out_writes_(count) float2* results);
+    void deinterleave(_In_reads_(count) float2 const* values, size_t count, _Out_writes_(count) float* x, _Out_writes_(count) float* y);
+    void interleave(_In_reads_(count) float const* x, _In_reads_(count) float const* y, size_t count, _Out_writes_(count) float2* values);
+
 
 #ifndef _WINDOWS_NUMERICS_CX_PROJECTION_
 
@@ -196,6 +213,11 @@ namespace Windows { namespace Foundation { namespace Numerics
     float3 transform_normal(float3 const& normal, float4x4 const& matrix);
     float3 transform(float3 const& value, quaternion const& rotation);
 
+    // Batched functions.
+    void transform(_In_reads_(count) float3 const* positions, size_t count, float4x4 const& matrix, _Out_writes_(count) float3* results);
+    void deinterleave(_In_reads_(count) float3 const* values, size_t count, _Out_writes_(count) float* x, _Out_writes_(count) float* y, _Out_writes_(count) float* z);
+    void interleave(_In_reads_(count) float const* x, _In_reads_(count) float const* y, _In_reads_(count) float const* z, size_t count, _Out_writes_(count) float3* values);
+
 
 #ifndef _WINDOWS_NUMERICS_CX_PROJECTION_
 
@@ -260,6 +282,11 @@ namespace Windows { namespace Foundation { namespace Numerics
     float4 transform4(float3 const& value, quaternion const& rotation);
     float4 transform4(float2 const& value, quaternion const& rotation);
 
+    // Batched functions.
+    void transform(_In_reads_(count) float4 const* vectors, size_t count, float4x4 const& matrix, _Out_writes_(count) float4* results);
+    void deinterleave(_In_reads_(count) float4 const* values, size_t count, _Out_writes_(count) float* x, _Out_writes_(count) float* y, _Out_writes_(count) float* z, _Out_writes_(count) float* w);
+    void interleave(_In_reads_(count) float const* x, _In_reads_(count) float const* y, _In_reads_(count) float const* z, _In_reads_(count) float const* w, size_t count, _Out_writes_(count) float4* values);
+
 
 #ifndef _WINDOWS_NUMERICS_CX_PROJECTION_
 
@@ -271,48 +298,48 @@ namespace Windows { namespace Foundation { namespace Numerics
 
         // Constructors.
         float3x2() = default;
-        float3x2(float m11, float m12, float m21, float m22, float m31, float m32);
+        _WINDOWS_NUMERICS_CONSTEXPR_ float3x2(float m11, float m12, float m21, float m22, float m31, float m32);
 
         _DEFINE_WINDOWS_NUMERICS_INTEROP_(float3x2, Matrix3x2)
 
         // Common values.
-        static float3x2 identity();
+        static _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 identity();
     };
 
 #endif  // !_WINDOWS_NUMERICS_CX_PROJECTION_
 
 
     // Factory functions.
-    float3x2 make_float3x2_translation(float2 const& position);
-    float3x2 make_float3x2_translation(float xPosition, float yPosition);
-    float3x2 make_float3x2_scale(float xScale, float yScale);
-    float3x2 make_float3x2_scale(float xScale, float yScale, float2 const& centerPoint);
-    float3x2 make_float3x2_scale(float2 const& scales);
-    float3x2 make_float3x2_scale(float2 const& scales, float2 const& centerPoint);
-    float3x2 make_float3x2_scale(float scale);
-    float3x2 make_float3x2_scale(float scale, float2 const& centerPoint);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 make_float3x2_translation(float2 const& position);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 make_float3x2_translation(float xPosition, float yPosition);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 make_float3x2_scale(float xScale, float yScale);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 make_float3x2_scale(float xScale, float yScale, float2 const& centerPoint);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 make_float3x2_scale(float2 const& scales);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 make_float3x2_scale(float2 const& scales, float2 const& centerPoint);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 make_float3x2_scale(float scale);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 make_float3x2_scale(float scale, float2 const& centerPoint);
     float3x2 make_float3x2_skew(float radiansX, float radiansY);
     float3x2 make_float3x2_skew(float radiansX, float radiansY, float2 const& centerPoint);
     float3x2 make_float3x2_rotation(float radians);
     float3x2 make_float3x2_rotation(float radians, float2 const& centerPoint);
 
     // Operators.
-    float3x2 operator +(float3x2 const& value1, float3x2 const& value2);
-    float3x2 operator -(float3x2 const& value1, float3x2 const& value2);
-    float3x2 operator *(float3x2 const& value1, float3x2 const& value2);
-    float3x2 operator *(float3x2 const& value1, float value2);
-    float3x2 operator -(float3x2 const& value);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 operator +(float3x2 const& value1, float3x2 const& value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 operator -(float3x2 const& value1, float3x2 const& value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 operator *(float3x2 const& value1, float3x2 const& value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 operator *(float3x2 const& value1, float value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 operator -(float3x2 const& value);
     float3x2& operator +=(float3x2& value1, float3x2 const& value2);
     float3x2& operator -=(float3x2& value1, float3x2 const& value2);
     float3x2& operator *=(float3x2& value1, float3x2 const& value2);
     float3x2& operator *=(float3x2& value1, float value2);
-    bool operator ==(float3x2 const& value1, float3x2 const& value2);
-    bool operator !=(float3x2 const& value1, float3x2 const& value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ bool operator ==(float3x2 const& value1, float3x2 const& value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ bool operator !=(float3x2 const& value1, float3x2 const& value2);
 
     // Functions.
-    bool is_identity(float3x2 const& value);
-    float determinant(float3x2 const& value);
-    float2 translation(float3x2 const& value);
+    _WINDOWS_NUMERICS_CONSTEXPR_ bool is_identity(float3x2 const& value);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float determinant(float3x2 const& value);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float2 translation(float3x2 const& value);
     bool invert(float3x2 const& matrix, _Out_ float3x2* result);
     float3x2 lerp(float3x2 const& matrix1, float3x2 const& matrix2, float amount);
 
@@ -393,6 +420,9 @@ namespace Windows { namespace Foundation { namespace Numerics
     float4x4 transpose(float4x4 const& matrix);
     float4x4 lerp(float4x4 const& matrix1, float4x4 const& matrix2, float amount);
 
+    // Batched functions.
+    void make_float4x4_from_quaternion(_In_reads_(count) quaternion const* quaternions, size_t count, _Out_writes_(count) float4x4* results);
+
 
 #ifndef _WINDOWS_NUMERICS_CX_PROJECTION_
 
@@ -427,6 +457,11 @@ namespace Windows { namespace Foundation { namespace Numerics
     float dot(plane const& plane, float4 const& value);
     float dot_coordinate(plane const& plane, float3 const& value);
     float dot_normal(plane const& plane, float3 const& value);
+    void extract_frustum_planes(float4x4 const& matrix, _Out_writes_(6) plane* planes);
+
+    // Batched functions.
+    void cull_spheres(_In_reads_(count) float const* centerX, _In_reads_(count) float const* centerY, _In_reads_(count) float const* centerZ, _In_reads_(count) float const* radius, size_t count, _In_reads_(planeCount) plane const* planes, size_t planeCount, _Out_writes_((count + 31) / 32) uint32_t* visible);
+    void cull_boxes(_In_reads_(count) float const* minX, _In_reads_(count) float const* minY, _In_reads_(count) float const* minZ, _In_reads_(count) float const* maxX, _In_reads_(count) float const* maxY, _In_reads_(count) float const* maxZ, size_t count, _In_reads_(planeCount) plane const* planes, size_t planeCount, _Out_writes_((count + 31) / 32) uint32_t* visible);
 
 
 #ifndef _WINDOWS_NUMERICS_CX_PROJECTION_
@@ -480,6 +515,128 @@ namespace Windows { namespace Foundation { namespace Numerics
     quaternion slerp(quaternion const& quaternion1, quaternion const& quaternion2, float amount);
     quaternion lerp(quaternion const& quaternion1, quaternion const& quaternion2, float amount);
     quaternion concatenate(quaternion const& value1, quaternion const& value2);
+
+    // Batched functions.
+    void normalize(_In_reads_(count) quaternion const* values, size_t count, _Out_writes_(count) quaternion* results);
+    void slerp(_In_reads_(count) quaternion const* quaternions1, _In_reads_(count) quaternion const* quaternions2, size_t count, float amount, _Out_writes_(count) quaternion* results);
+    void concatenate(_In_reads_(count) quaternion const* values1, _In_reads_(count) quaternion const* values2, size_t count, _Out_writes_(count) quaternion* results);
+
+
+    // Compact storage formats, for holding large arrays of vectors in less memory.
+    // These do not support arithmetic: convert to float2 or float4 to operate on them.
+    struct half2
+    {
+        uint16_t x, y;
+
+        // Constructors.
+        half2() = default;
+        half2(uint16_t x, uint16_t y);
+    };
+
+    struct half4
+    {
+        uint16_t x, y, z, w;
+
+        // Constructors.
+        half4() = default;
+        half4(uint16_t x, uint16_t y, uint16_t z, uint16_t w);
+    };
+
+    struct unorm8x4
+    {
+        uint8_t x, y, z, w;
+
+        // Constructors.
+        unorm8x4() = default;
+        unorm8x4(uint8_t x, uint8_t y, uint8_t z, uint8_t w);
+    };
+
+
+    // Factory functions.
+    half2 make_half2_from_float2(float2 const& value);
+    half4 make_half4_from_float4(float4 const& value);
+    unorm8x4 make_unorm8x4_from_float4(float4 const& value);
+    float2 make_float2_from_half2(half2 const& value);
+    float4 make_float4_from_half4(half4 const& value);
+    float4 make_float4_from_unorm8x4(unorm8x4 const& value);
+
+    // Operators.
+    bool operator ==(half2 const& value1, half2 const& value2);
+    bool operator !=(half2 const& value1, half2 const& value2);
+    bool operator ==(half4 const& value1, half4 const& value2);
+    bool operator !=(half4 const& value1, half4 const& value2);
+    bool operator ==(unorm8x4 const& value1, unorm8x4 const& value2);
+    bool operator !=(unorm8x4 const& value1, unorm8x4 const& value2);
+
+    // Batched functions.
+    void make_half2_from_float2(_In_reads_(count) float2 const* values, size_t count, _Out_writes_(count) half2* results);
+    void make_half4_from_float4(_In_reads_(count) float4 const* values, size_t count, _Out_writes_(count) half4* results);
+    void make_unorm8x4_from_float4(_In_reads_(count) float4 const* values, size_t count, _Out_writes_(count) unorm8x4* results);
+    void make_float2_from_half2(_In_reads_(count) half2 const* values, size_t count, _Out_writes_(count) float2* results);
+    void make_float4_from_half4(_In_reads_(count) half4 const* values, size_t count, _Out_writes_(count) float4* results);
+    void make_float4_from_unorm8x4(_In_reads_(count) unorm8x4 const* values, size_t count, _Out_writes_(count) float4* results);
+
+
+    // Axis aligned bounding boxes. A box is empty if its minimum is greater than its
+    // maximum along any axis. Merging points into empty() builds up the bounds of a set.
+    struct aabb2
+    {
+        float2 minimum;
+        float2 maximum;
+
+        // Constructors.
+        aabb2() = default;
+        aabb2(float2 const& minimum, float2 const& maximum);
+
+        // Common values.
+        static aabb2 empty();
+    };
+
+    struct aabb3
+    {
+        float3 minimum;
+        float3 maximum;
+
+        // Constructors.
+        aabb3() = default;
+        aabb3(float3 const& minimum, float3 const& maximum);
+
+        // Common values.
+        static aabb3 empty();
+    };
+
+
+    // Factory functions.
+    aabb2 make_aabb2_from_points(_In_reads_(count) float2 const* points, size_t count);
+    aabb3 make_aabb3_from_points(_In_reads_(count) float3 const* points, size_t count);
+
+    // Operators.
+    bool operator ==(aabb2 const& value1, aabb2 const& value2);
+    bool operator !=(aabb2 const& value1, aabb2 const& value2);
+    bool operator ==(aabb3 const& value1, aabb3 const& value2);
+    bool operator !=(aabb3 const& value1, aabb3 const& value2);
+
+    // Functions.
+    bool is_empty(aabb2 const& value);
+    bool is_empty(aabb3 const& value);
+    float2 center(aabb2 const& value);
+    float3 center(aabb3 const& value);
+    float2 size(aabb2 const& value);
+    float3 size(aabb3 const& value);
+    aabb2 merge(aabb2 const& value1, aabb2 const& value2);
+    aabb3 merge(aabb3 const& value1, aabb3 const& value2);
+    aabb2 merge(aabb2 const& value, float2 const& point);
+    aabb3 merge(aabb3 const& value, float3 const& point);
+    aabb2 intersect(aabb2 const& value1, aabb2 const& value2);
+    aabb3 intersect(aabb3 const& value1, aabb3 const& value2);
+    bool intersects(aabb2 const& value1, aabb2 const& value2);
+    bool intersects(aabb3 const& value1, aabb3 const& value2);
+    bool contains(aabb2 const& value, float2 const& point);
+    bool contains(aabb3 const& value, float3 const& point);
+    bool contains(aabb2 const& value, aabb2 const& other);
+    bool contains(aabb3 const& value, aabb3 const& other);
+    aabb2 transform(aabb2 const& value, float3x2 const& matrix);
+    aabb3 transform(aabb3 const& value, float4x4 const& matrix);
 }}}
 
 
@@ -510,3 +667,4 @@ namespace DirectX
 #undef _WINDOWS_NUMERICS_CX_PROJECTION_
 #undef _WINDOWS_NUMERICS_INTEROP_NAMESPACE_
 #undef _DEFINE_WINDOWS_NUMERICS_INTEROP_
+#undef _WINDOWS_NUMERICS_CONSTEXPR_
@@ -10,9 +10,11 @@
 // License for the specific language governing permissions and limitations
 // under the License.
 
+#ifdef _MSC_VER
 #pragma warning(push)
 #pragma warning(disable: 4723) // potential divide by 0
 #pragma warning(disable: 4756) // overflow in constant arithmetic
+#endif
 
 
 #ifdef _CPPUNWIND
@@ -33,6 +35,63 @@
 #endif
 
 
+// Batched operations keep their constants in SIMD registers across many elements, so
+// they are worth vectorizing on every architecture DirectXMath has intrinsics for.
+#if !defined WINDOWS_NUMERICS_DISABLE_SIMD && !defined _XM_NO_INTRINSICS_
+#define _WINDOWS_NUMERICS_BATCH_SIMD_
+#endif
+
+
+// On x86 and x64, float4x4 multiply, invert and batched transform have AVX2/FMA
+// implementations, and bulk half precision conversions use F16C (which every AVX2
+// CPU also supports). When the compiler already targets AVX2 (/arch:AVX2, or -mavx2 -mfma -mf16c)
+// these are used unconditionally. Otherwise invert and batched transform are selected
+// at runtime if the CPU supports them, so binaries built for a generic baseline still
+// benefit on newer hardware. Define WINDOWS_NUMERICS_DISABLE_AVX2 to always use the SSE implementations.
+#if (defined _M_IX86 || defined _M_X64 || defined __i386__ || defined __x86_64__) && \
+    !defined WINDOWS_NUMERICS_DISABLE_SIMD && !defined WINDOWS_NUMERICS_DISABLE_AVX2 && !defined _XM_NO_INTRINSICS_
+
+#define _WINDOWS_NUMERICS_AVX2_
+
+#include <immintrin.h>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#if defined __AVX2__ && ((defined __FMA__ && defined __F16C__) || (defined _MSC_VER && !defined __clang__))
+#define _WINDOWS_NUMERICS_AVX2_ALWAYS_
+#endif
+
+#if defined __GNUC__ || defined __clang__
+#define _WINDOWS_NUMERICS_AVX2_TARGET_ __attribute__((target("avx2,fma,f16c")))
+#else
+#define _WINDOWS_NUMERICS_AVX2_TARGET_
+#endif
+
+#endif
+
+
+// On ARM, a few hot operations (length, normalize, float4x4 multiply and invert,
+// quaternion slerp) have hand written NEON implementations. These work directly on
+// the numerics types rather than going through the DirectXMath load/store layer, so
+// they are a win even where the rest of the DirectXMath paths are disabled (below).
+// Define WINDOWS_NUMERICS_DISABLE_NEON to use the scalar implementations instead.
+#if (defined _M_ARM || defined _M_ARM64 || defined __ARM_NEON) && \
+    !defined WINDOWS_NUMERICS_DISABLE_SIMD && !defined WINDOWS_NUMERICS_DISABLE_NEON
+
+#define _WINDOWS_NUMERICS_NEON_
+
+#include <arm_neon.h>
+
+// AArch64 adds instructions for horizontal add, fused multiply-add, divide and square root.
+#if defined _M_ARM64 || defined __aarch64__
+#define _WINDOWS_NUMERICS_NEON_AARCH64_
+#endif
+
+#endif
+
+
 // Implementing some operations via the SIMD DirectXMath API is a performance
 // win for SSE CPU architectures (x86 and x64), but not for ARM NEON.
 #if defined _M_ARM && !defined WINDOWS_NUMERICS_DISABLE_SIMD
@@ -143,2853 +202,4868 @@ namespace DirectX
 
 namespace Windows { namespace Foundation { namespace Numerics
 {
-    inline float2::float2(float x, float y)
-        : x(x), y(y)
-    { }
+#ifdef _WINDOWS_NUMERICS_BATCH_SIMD_
 
+    // Helpers used by the batched operations. These convert groups of four
+    // consecutive values between array-of-structures layout (as stored in memory)
+    // and structure-of-arrays layout (one SIMD register per component), so that
+    // each SIMD lane processes a different value.
+    namespace details
+    {
+        inline void XM_CALLCONV LoadFloat2x4(_In_reads_(4) float2 const* source, _Out_ ::DirectX::XMVECTOR* x, _Out_ ::DirectX::XMVECTOR* y)
+        {
+            using namespace ::DirectX;
 
-    inline float2::float2(float value)
-        : x(value), y(value)
-    { }
+            XMVECTOR a = XMLoadFloat4(reinterpret_cast<XMFLOAT4 const*>(source));        // x0 y0 x1 y1
+            XMVECTOR b = XMLoadFloat4(reinterpret_cast<XMFLOAT4 const*>(source + 2));    // x2 y2 x3 y3
 
+            *x = XMVectorPermute<0, 2, 4, 6>(a, b);
+            *y = XMVectorPermute<1, 3, 5, 7>(a, b);
+        }
 
-#ifdef _WINDOWS_NUMERICS_CX_PROJECTION_
 
+        inline void XM_CALLCONV StoreFloat2x4(_Out_writes_(4) float2* destination, ::DirectX::FXMVECTOR x, ::DirectX::FXMVECTOR y)
+        {
+            using namespace ::DirectX;
 
-    inline float2::operator float2(Windows::Foundation::Point value)
-    {
-        return float2(value.X, value.Y);
-    }
+            XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(destination),     XMVectorMergeXY(x, y));
+            XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(destination + 2), XMVectorMergeZW(x, y));
+        }
 
 
-    inline float2::operator float2(Windows::Foundation::Size value)
-    {
-        return float2(value.Width, value.Height);
-    }
+        inline void XM_CALLCONV LoadFloat3x4(_In_reads_(4) float3 const* source, _Out_ ::DirectX::XMVECTOR* x, _Out_ ::DirectX::XMVECTOR* y, _Out_ ::DirectX::XMVECTOR* z)
+        {
+            using namespace ::DirectX;
 
+            float const* p = &source->x;
 
-    inline float2::operator Windows::Foundation::Point(float2 value)
-    {
-        return Windows::Foundation::Point(value.x, value.y);
-    }
+            XMVECTOR a = XMLoadFloat4(reinterpret_cast<XMFLOAT4 const*>(p));        // x0 y0 z0 x1
+            XMVECTOR b = XMLoadFloat4(reinterpret_cast<XMFLOAT4 const*>(p + 4));    // y1 z1 x2 y2
+            XMVECTOR c = XMLoadFloat4(reinterpret_cast<XMFLOAT4 const*>(p + 8));    // z2 x3 y3 z3
 
+            *x = XMVectorPermute<0, 1, 2, 5>(XMVectorPermute<0, 3, 6, 7>(a, b), c);
+            *y = XMVectorPermute<0, 1, 2, 6>(XMVectorPermute<1, 4, 7, 7>(a, b), c);
+            *z = XMVectorPermute<0, 1, 4, 7>(XMVectorPermute<2, 5, 5, 5>(a, b), c);
+        }
 
-    inline float2::operator Windows::Foundation::Size(float2 value)
-    {
-        return Windows::Foundation::Size(value.x, value.y);
-    }
 
+        inline void XM_CALLCONV StoreFloat3x4(_Out_writes_(4) float3* destination, ::DirectX::FXMVECTOR x, ::DirectX::FXMVECTOR y, ::DirectX::FXMVECTOR z)
+        {
+            using namespace ::DirectX;
 
-#elif defined __cplusplus_winrt // && !_WINDOWS_NUMERICS_CX_PROJECTION_
+            float* p = &destination->x;
 
+            XMVECTOR a = XMVectorPermute<0, 1, 4, 2>(XMVectorMergeXY(x, y), z);              // x0 y0 z0 x1
+            XMVECTOR b = XMVectorPermute<0, 2, 6, 1>(XMVectorPermute<1, 2, 5, 6>(y, z), x);  // y1 z1 x2 y2
+            XMVECTOR c = XMVectorPermute<6, 2, 3, 7>(XMVectorMergeZW(x, y), z);              // z2 x3 y3 z3
 
-    inline float2::float2(Windows::Foundation::Point const& value)
-        : x(value.X), y(value.Y)
-    { }
+            XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(p),     a);
+            XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(p + 4), b);
+            XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(p + 8), c);
+        }
 
 
-    inline float2::float2(Windows::Foundation::Size const& value)
-        : x(value.Width), y(value.Height)
-    { }
+        inline void XM_CALLCONV LoadFloat4x4(_In_reads_(4) float4 const* source, _Out_ ::DirectX::XMVECTOR* x, _Out_ ::DirectX::XMVECTOR* y, _Out_ ::DirectX::XMVECTOR* z, _Out_ ::DirectX::XMVECTOR* w)
+        {
+            using namespace ::DirectX;
 
+            XMMATRIX m = XMMatrixTranspose(XMLoadFloat4x4(reinterpret_cast<float4x4 const*>(source)));
 
-    inline float2::operator Windows::Foundation::Point() const
-    {
-        return Windows::Foundation::Point(x, y);
-    }
+            *x = m.r[0];
+            *y = m.r[1];
+            *z = m.r[2];
+            *w = m.r[3];
+        }
 
 
-    inline float2::operator Windows::Foundation::Size() const
-    {
-        return Windows::Foundation::Size(x, y);
-    }
+        inline void XM_CALLCONV StoreFloat4x4(_Out_writes_(4) float4* destination, ::DirectX::FXMVECTOR x, ::DirectX::FXMVECTOR y, ::DirectX::FXMVECTOR z, ::DirectX::GXMVECTOR w)
+        {
+            using namespace ::DirectX;
 
+            XMMATRIX m;
 
-#endif  // __cpluspluswinrt && !_WINDOWS_NUMERICS_CX_PROJECTION_
+            m.r[0] = x;
+            m.r[1] = y;
+            m.r[2] = z;
+            m.r[3] = w;
 
+            XMStoreFloat4x4(reinterpret_cast<float4x4*>(destination), XMMatrixTranspose(m));
+        }
 
-    inline float2 float2::zero()
-    {
-        return float2(0, 0);
-    }
 
+        inline float XM_CALLCONV HorizontalMin(::DirectX::FXMVECTOR value)
+        {
+            using namespace ::DirectX;
 
-    inline float2 float2::one()
-    {
-        return float2(1, 1);
-    }
+            XMVECTOR m = XMVectorMin(value, XMVectorSwizzle<2, 3, 0, 1>(value));
 
+            return XMVectorGetX(XMVectorMin(m, XMVectorSwizzle<1, 0, 3, 2>(m)));
+        }
 
-    inline float2 float2::unit_x()
-    {
-        return float2(1, 0);
-    }
 
+        inline float XM_CALLCONV HorizontalMax(::DirectX::FXMVECTOR value)
+        {
+            using namespace ::DirectX;
 
-    inline float2 float2::unit_y()
-    {
-        return float2(0, 1);
-    }
+            XMVECTOR m = XMVectorMax(value, XMVectorSwizzle<2, 3, 0, 1>(value));
 
+            return XMVectorGetX(XMVectorMax(m, XMVectorSwizzle<1, 0, 3, 2>(m)));
+        }
 
-    inline float2 operator +(float2 const& value1, float2 const& value2)
-    {
-        return float2(value1.x + value2.x,
-                      value1.y + value2.y);
-    }
 
+        // Packs the result of a four lane comparison into the low four bits of an integer.
+        inline uint32_t XM_CALLCONV MoveMask(::DirectX::FXMVECTOR mask)
+        {
+#ifdef _XM_SSE_INTRINSICS_
+            return static_cast<uint32_t>(_mm_movemask_ps(mask));
+#else
+            using namespace ::DirectX;
 
-    inline float2 operator -(float2 const& value1, float2 const& value2)
-    {
-        return float2(value1.x - value2.x,
-                      value1.y - value2.y);
+            return (XMVectorGetIntX(mask) & 1) |
+                   (XMVectorGetIntY(mask) & 2) |
+                   (XMVectorGetIntZ(mask) & 4) |
+                   (XMVectorGetIntW(mask) & 8);
+#endif
+        }
     }
 
+#endif  // _WINDOWS_NUMERICS_BATCH_SIMD_
 
-    inline float2 operator *(float2 const& value1, float2 const& value2)
-    {
-        return float2(value1.x * value2.x,
-                      value1.y * value2.y);
-    }
 
+#ifdef _WINDOWS_NUMERICS_AVX2_
 
-    inline float2 operator *(float2 const& value1, float value2)
+    // AVX2/FMA implementations of the float4x4 operations. These are only called
+    // when targeting AVX2, or after UseAvx2 has confirmed that the CPU supports them. Each one ends with
+    // vzeroupper, because when the rest of the binary is compiled for SSE, leaving
+    // the upper halves of the YMM registers dirty makes subsequent SSE code slow.
+    namespace details
     {
-        return float2(value1.x * value2,
-                      value1.y * value2);
-    }
+        inline bool IsAvx2Supported()
+        {
+#ifdef _MSC_VER
+            int info[4];
 
+            __cpuid(info, 0);
 
-    inline float2 operator *(float value1, float2 const& value2)
-    {
-        return value2 * value1;
-    }
+            if (info[0] < 7)
+                return false;
 
+            __cpuid(info, 1);
 
-    inline float2 operator /(float2 const& value1, float2 const& value2)
-    {
-        return float2(value1.x / value2.x,
-                      value1.y / value2.y);
-    }
+            const int fma     = 1 << 12;
+            const int osxsave = 1 << 27;
+            const int avx     = 1 << 28;
+            const int f16c    = 1 << 29;
 
+            if ((info[2] & (fma | osxsave | avx | f16c)) != (fma | osxsave | avx | f16c))
+                return false;
 
-    inline float2 operator /(float2 const& value1, float value2)
-    {
-        return value1 * (1.0f / value2);
-    }
+            // The OS must preserve both the XMM and YMM register state.
+            if ((_xgetbv(0) & 6) != 6)
+                return false;
 
+            __cpuidex(info, 7, 0);
 
-    inline float2 operator -(float2 const& value)
-    {
-        return float2(-value.x,
-                      -value.y);
-    }
+            const int avx2 = 1 << 5;
 
+            return (info[1] & avx2) != 0;
+#else
+            __builtin_cpu_init();
 
-    inline float2& operator +=(float2& value1, float2 const& value2)
-    {
-        value1 = value1 + value2;
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma") && __builtin_cpu_supports("f16c");
+#endif
+        }
 
-        return value1;
-    }
 
+        inline bool UseAvx2()
+        {
+#ifdef _WINDOWS_NUMERICS_AVX2_ALWAYS_
+            return true;
+#else
+            // Initialization of this static is not thread safe on older compilers, but
+            // that is harmless: every thread computes the same value.
+            static const bool supported = IsAvx2Supported();
 
-    inline float2& operator -=(float2& value1, float2 const& value2)
-    {
-        value1 = value1 - value2;
+            return supported;
+#endif
+        }
 
-        return value1;
-    }
 
+        _WINDOWS_NUMERICS_AVX2_TARGET_ inline float4x4 MultiplyAvx2(float4x4 const& value1, float4x4 const& value2)
+        {
+            // Each row of value2, duplicated into both 128 bit lanes.
+            __m256 b0 = _mm256_broadcast_ps(reinterpret_cast<__m128 const*>(&value2.m11));
+            __m256 b1 = _mm256_broadcast_ps(reinterpret_cast<__m128 const*>(&value2.m21));
+            __m256 b2 = _mm256_broadcast_ps(reinterpret_cast<__m128 const*>(&value2.m31));
+            __m256 b3 = _mm256_broadcast_ps(reinterpret_cast<__m128 const*>(&value2.m41));
 
-    inline float2& operator *=(float2& value1, float2 const& value2)
-    {
-        value1 = value1 * value2;
+            // Two rows of value1 per register, so each instruction computes two result rows.
+            __m256 a01 = _mm256_loadu_ps(&value1.m11);
+            __m256 a23 = _mm256_loadu_ps(&value1.m31);
 
-        return value1;
-    }
+            __m256 r01 = _mm256_mul_ps(_mm256_shuffle_ps(a01, a01, _MM_SHUFFLE(0, 0, 0, 0)), b0);
+            __m256 r23 = _mm256_mul_ps(_mm256_shuffle_ps(a23, a23, _MM_SHUFFLE(0, 0, 0, 0)), b0);
 
+            r01 = _mm256_fmadd_ps(_mm256_shuffle_ps(a01, a01, _MM_SHUFFLE(1, 1, 1, 1)), b1, r01);
+            r23 = _mm256_fmadd_ps(_mm256_shuffle_ps(a23, a23, _MM_SHUFFLE(1, 1, 1, 1)), b1, r23);
 
-    inline float2& operator *=(float2& value1, float value2)
-    {
-        value1 = value1 * value2;
+            r01 = _mm256_fmadd_ps(_mm256_shuffle_ps(a01, a01, _MM_SHUFFLE(2, 2, 2, 2)), b2, r01);
+            r23 = _mm256_fmadd_ps(_mm256_shuffle_ps(a23, a23, _MM_SHUFFLE(2, 2, 2, 2)), b2, r23);
 
-        return value1;
-    }
+            r01 = _mm256_fmadd_ps(_mm256_shuffle_ps(a01, a01, _MM_SHUFFLE(3, 3, 3, 3)), b3, r01);
+            r23 = _mm256_fmadd_ps(_mm256_shuffle_ps(a23, a23, _MM_SHUFFLE(3, 3, 3, 3)), b3, r23);
 
+            float4x4 result;
 
-    inline float2& operator /=(float2& value1, float2 const& value2)
-    {
-        value1 = value1 / value2;
+            _mm256_storeu_ps(&result.m11, r01);
+            _mm256_storeu_ps(&result.m31, r23);
 
-        return value1;
-    }
+            _mm256_zeroupper();
 
+            return result;
+        }
 
-    inline float2& operator /=(float2& value1, float value2)
-    {
-        value1 = value1 / value2;
 
-        return value1;
-    }
+        // 2x2 matrix helpers for InvertAvx2. Each 2x2 matrix is stored row major
+        // in a single register, and A# denotes the adjugate of A.
 
+        // A * B
+        _WINDOWS_NUMERICS_AVX2_TARGET_ inline __m128 Multiply2x2Avx2(__m128 a, __m128 b)
+        {
+            return _mm_fmadd_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 3, 0)),
+                                _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2))));
+        }
 
-    inline bool operator ==(float2 const& value1, float2 const& value2)
-    {
-        return value1.x == value2.x &&
-               value1.y == value2.y;
-    }
 
+        // A# * B
+        _WINDOWS_NUMERICS_AVX2_TARGET_ inline __m128 AdjugateMultiply2x2Avx2(__m128 a, __m128 b)
+        {
+            return _mm_fmsub_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 3, 3)), b,
+                                _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 1, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2))));
+        }
 
-    inline bool operator !=(float2 const& value1, float2 const& value2)
-    {
-        return value1.x != value2.x ||
-               value1.y != value2.y;
-    }
 
+        // A * B#
+        _WINDOWS_NUMERICS_AVX2_TARGET_ inline __m128 MultiplyAdjugate2x2Avx2(__m128 a, __m128 b)
+        {
+            return _mm_fmsub_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 3, 0, 3)),
+                                _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2))));
+        }
 
-    inline float length(float2 const& value)
-    {
-        return sqrtf(length_squared(value));
-    }
 
+        _WINDOWS_NUMERICS_AVX2_TARGET_ inline bool InvertAvx2(float4x4 const& matrix, _Out_ float4x4* result)
+        {
+            // Blockwise inversion. Partitioning the matrix into 2x2 blocks
+            //
+            //     M = [ A B ]
+            //         [ C D ]
+            //
+            // gives the inverse in terms of 2x2 adjugates and determinants:
+            //
+            //      -1      1      [ X Y ]#
+            //     M   = ------- * [ Z W ]
+            //            det(M)
+            //
+            //     X = det(D) A - B (D# C)      Y = det(B) C - D (A# B)#
+            //     Z = det(C) B - A (D# C)#     W = det(A) D - C (A# B)
+            //
+            //     det(M) = det(A) det(D) + det(B) det(C) - trace((A# B) (D# C))
+            //
+            __m128 r0 = _mm_loadu_ps(&matrix.m11);
+            __m128 r1 = _mm_loadu_ps(&matrix.m21);
+            __m128 r2 = _mm_loadu_ps(&matrix.m31);
+            __m128 r3 = _mm_loadu_ps(&matrix.m41);
+
+            __m128 a = _mm_movelh_ps(r0, r1);
+            __m128 b = _mm_movehl_ps(r1, r0);
+            __m128 c = _mm_movelh_ps(r2, r3);
+            __m128 d = _mm_movehl_ps(r3, r2);
+
+            // (det(A), det(B), det(C), det(D))
+            __m128 detSub = _mm_fmsub_ps(_mm_shuffle_ps(r0, r2, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(r1, r3, _MM_SHUFFLE(3, 1, 3, 1)),
+                                         _mm_mul_ps(_mm_shuffle_ps(r0, r2, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(r1, r3, _MM_SHUFFLE(2, 0, 2, 0))));
+
+            __m128 detA = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(0, 0, 0, 0));
+            __m128 detB = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(1, 1, 1, 1));
+            __m128 detC = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(2, 2, 2, 2));
+            __m128 detD = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(3, 3, 3, 3));
+
+            __m128 dc = AdjugateMultiply2x2Avx2(d, c);
+            __m128 ab = AdjugateMultiply2x2Avx2(a, b);
+
+            __m128 x = _mm_fmsub_ps(detD, a, Multiply2x2Avx2(b, dc));
+            __m128 w = _mm_fmsub_ps(detA, d, Multiply2x2Avx2(c, ab));
+            __m128 y = _mm_fmsub_ps(detB, c, MultiplyAdjugate2x2Avx2(d, ab));
+            __m128 z = _mm_fmsub_ps(detC, b, MultiplyAdjugate2x2Avx2(a, dc));
+
+            __m128 trace = _mm_mul_ps(ab, _mm_shuffle_ps(dc, dc, _MM_SHUFFLE(3, 1, 2, 0)));
+            trace = _mm_hadd_ps(trace, trace);
+            trace = _mm_hadd_ps(trace, trace);
+
+            __m128 det = _mm_sub_ps(_mm_fmadd_ps(detB, detC, _mm_mul_ps(detA, detD)), trace);
+
+            if (fabs(_mm_cvtss_f32(det)) < FLT_EPSILON)
+            {
+                __m256 nan = _mm256_set1_ps(_WINDOWS_NUMERICS_NAN_);
 
-    inline float length_squared(float2 const& value)
-    {
-        return dot(value, value);
-    }
+                _mm256_storeu_ps(&result->m11, nan);
+                _mm256_storeu_ps(&result->m31, nan);
 
+                _mm256_zeroupper();
 
-    inline float distance(float2 const& value1, float2 const& value2)
-    {
-        return length(value1 - value2);
-    }
+                return false;
+            }
 
+            // The adjugate sign pattern of each 2x2 block, divided by det(M).
+            __m128 invDet = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), det);
 
-    inline float distance_squared(float2 const& value1, float2 const& value2)
-    {
-        return length_squared(value1 - value2);
-    }
+            x = _mm_mul_ps(x, invDet);
+            y = _mm_mul_ps(y, invDet);
+            z = _mm_mul_ps(z, invDet);
+            w = _mm_mul_ps(w, invDet);
 
+            // Shuffling the blocks back into rows also applies the adjugate swap.
+            _mm_storeu_ps(&result->m11, _mm_shuffle_ps(x, y, _MM_SHUFFLE(1, 3, 1, 3)));
+            _mm_storeu_ps(&result->m21, _mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 2, 0, 2)));
+            _mm_storeu_ps(&result->m31, _mm_shuffle_ps(z, w, _MM_SHUFFLE(1, 3, 1, 3)));
+            _mm_storeu_ps(&result->m41, _mm_shuffle_ps(z, w, _MM_SHUFFLE(0, 2, 0, 2)));
 
-    inline float dot(float2 const& value1, float2 const& value2)
-    {
-        return value1.x * value2.x +
-               value1.y * value2.y;
-    }
+            return true;
+        }
 
 
-    inline float2 normalize(float2 const& value)
-    {
-#ifdef WINDOWS_NUMERICS_DISABLE_SIMD
-        return value / length(value);
-#else
-        using namespace ::DirectX;
+        _WINDOWS_NUMERICS_AVX2_TARGET_ inline void TransformAvx2(_In_reads_(count) float4 const* vectors, size_t count, float4x4 const& matrix, _Out_writes_(count) float4* results)
+        {
+            __m256 m0 = _mm256_broadcast_ps(reinterpret_cast<__m128 const*>(&matrix.m11));
+            __m256 m1 = _mm256_broadcast_ps(reinterpret_cast<__m128 const*>(&matrix.m21));
+            __m256 m2 = _mm256_broadcast_ps(reinterpret_cast<__m128 const*>(&matrix.m31));
+            __m256 m3 = _mm256_broadcast_ps(reinterpret_cast<__m128 const*>(&matrix.m41));
 
-        float2 result;
-        XMVECTOR v = XMLoadFloat2(&value);
-        XMStoreFloat2(&result, XMVectorDivide(v, XMVector2Length(v)));
-        return result;
-#endif
-    }
+            size_t i = 0;
 
+            // Two vectors per register.
+            for (; i < count - count % 2; i += 2)
+            {
+                __m256 v = _mm256_loadu_ps(&vectors[i].x);
 
-    inline float2 reflect(float2 const& vector, float2 const& normal)
-    {
-        return vector - 2.0f * dot(vector, normal) * normal;
-    }
+                __m256 r = _mm256_mul_ps(_mm256_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0)), m0);
+                r = _mm256_fmadd_ps(_mm256_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)), m1, r);
+                r = _mm256_fmadd_ps(_mm256_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2)), m2, r);
+                r = _mm256_fmadd_ps(_mm256_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3)), m3, r);
 
+                _mm256_storeu_ps(&results[i].x, r);
+            }
 
-    inline float2 (min)(float2 const& value1, float2 const& value2)
-    {
-        return float2((value1.x < value2.x) ? value1.x : value2.x,
-                      (value1.y < value2.y) ? value1.y : value2.y);
-    }
+            if (i < count)
+            {
+                __m128 v = _mm_loadu_ps(&vectors[i].x);
 
+                __m128 r = _mm_mul_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0)), _mm256_castps256_ps128(m0));
+                r = _mm_fmadd_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)), _mm256_castps256_ps128(m1), r);
+                r = _mm_fmadd_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2)), _mm256_castps256_ps128(m2), r);
+                r = _mm_fmadd_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3)), _mm256_castps256_ps128(m3), r);
 
-    inline float2 (max)(float2 const& value1, float2 const& value2)
-    {
-        return float2((value1.x > value2.x) ? value1.x : value2.x,
-                      (value1.y > value2.y) ? value1.y : value2.y);
-    }
+                _mm_storeu_ps(&results[i].x, r);
+            }
 
+            _mm256_zeroupper();
+        }
 
-    inline float2 clamp(float2 const& value1, float2 const& minValue, float2 const& maxValue)
-    {
-        return (max)((min)(value1, maxValue), minValue);
-    }
 
+        _WINDOWS_NUMERICS_AVX2_TARGET_ inline void ConvertFloatToHalfAvx2(_In_reads_(count) float const* source, size_t count, _Out_writes_(count) uint16_t* destination)
+        {
+            size_t i = 0;
 
-    inline float2 lerp(float2 const& value1, float2 const& value2, float amount)
-    {
-        return value1 + (value2 - value1) * amount;
-    }
+            for (; i < count - count % 8; i += 8)
+            {
+                __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(source + i), _MM_FROUND_TO_NEAREST_INT);
 
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), h);
+            }
 
-    inline float2 transform(float2 const& position, float3x2 const& matrix)
-    {
-        return float2(position.x * matrix.m11 + position.y * matrix.m21 + matrix.m31,
-                      position.x * matrix.m12 + position.y * matrix.m22 + matrix.m32);
-    }
+            if (count - i >= 4)
+            {
+                __m128i h = _mm_cvtps_ph(_mm_loadu_ps(source + i), _MM_FROUND_TO_NEAREST_INT);
 
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(destination + i), h);
+                i += 4;
+            }
 
-    inline float2 transform(float2 const& position, float4x4 const& matrix)
-    {
-        return float2(position.x * matrix.m11 + position.y * matrix.m21 + matrix.m41,
-                      position.x * matrix.m12 + position.y * matrix.m22 + matrix.m42);
-    }
+            for (; i < count; i++)
+            {
+                __m128i h = _mm_cvtps_ph(_mm_set_ss(source[i]), _MM_FROUND_TO_NEAREST_INT);
 
+                destination[i] = static_cast<uint16_t>(_mm_cvtsi128_si32(h));
+            }
 
-    inline float2 transform_normal(float2 const& normal, float3x2 const& matrix)
-    {
-        return float2(normal.x * matrix.m11 + normal.y * matrix.m21,
-                      normal.x * matrix.m12 + normal.y * matrix.m22);
-    }
+            _mm256_zeroupper();
+        }
 
 
-    inline float2 transform_normal(float2 const& normal, float4x4 const& matrix)
-    {
-        return float2(normal.x * matrix.m11 + normal.y * matrix.m21,
-                      normal.x * matrix.m12 + normal.y * matrix.m22);
+        _WINDOWS_NUMERICS_AVX2_TARGET_ inline void ConvertHalfToFloatAvx2(_In_reads_(count) uint16_t const* source, size_t count, _Out_writes_(count) float* destination)
+        {
+            size_t i = 0;
+
+            for (; i < count - count % 8; i += 8)
+            {
+                __m128i h = _mm_loadu_si128(reinterpret_cast<__m128i const*>(source + i));
+
+                _mm256_storeu_ps(destination + i, _mm256_cvtph_ps(h));
+            }
+
+            if (count - i >= 4)
+            {
+                __m128i h = _mm_loadl_epi64(reinterpret_cast<__m128i const*>(source + i));
+
+                _mm_storeu_ps(destination + i, _mm_cvtph_ps(h));
+                i += 4;
+            }
+
+            for (; i < count; i++)
+            {
+                destination[i] = _mm_cvtss_f32(_mm_cvtph_ps(_mm_cvtsi32_si128(source[i])));
+            }
+
+            _mm256_zeroupper();
+        }
     }
 
+#endif  // _WINDOWS_NUMERICS_AVX2_
 
-    inline float2 transform(float2 const& value, quaternion const& rotation)
+
+#ifdef _WINDOWS_NUMERICS_NEON_
+
+    // Helpers used by the NEON implementations.
+    namespace details
     {
-        float x2 = rotation.x + rotation.x;
-        float y2 = rotation.y + rotation.y;
-        float z2 = rotation.z + rotation.z;
+        inline float32x2_t LoadNeon(float2 const& value)
+        {
+            return vld1_f32(&value.x);
+        }
 
-        float wz2 = rotation.w * z2;
-        float xx2 = rotation.x * x2;
-        float xy2 = rotation.x * y2;
-        float yy2 = rotation.y * y2;
-        float zz2 = rotation.z * z2;
 
-        return float2(value.x * (1.0f - yy2 - zz2) + value.y * (xy2 - wz2),
-                      value.x * (xy2 + wz2) + value.y * (1.0f - xx2 - zz2));
-    }
+        // The unused w lane is zeroed, so it does not contribute to sums.
+        inline float32x4_t LoadNeon(float3 const& value)
+        {
+            return vcombine_f32(vld1_f32(&value.x), vld1_lane_f32(&value.z, vdup_n_f32(0), 0));
+        }
 
 
-    inline float3::float3(float x, float y, float z)
-        : x(x), y(y), z(z)
-    { }
+        inline float32x4_t LoadNeon(float4 const& value)
+        {
+            return vld1q_f32(&value.x);
+        }
 
 
-    inline float3::float3(float2 value, float z)
-        : x(value.x), y(value.y), z(z)
-    { }
+        inline float32x4_t LoadNeon(quaternion const& value)
+        {
+            return vld1q_f32(&value.x);
+        }
 
 
-    inline float3::float3(float value)
-        : x(value), y(value), z(value)
-    { }
+        inline void StoreNeon(_Out_ float2* destination, float32x2_t value)
+        {
+            vst1_f32(&destination->x, value);
+        }
 
 
-    inline float3 float3::zero()
-    {
-        return float3(0, 0, 0);
-    }
+        inline void StoreNeon(_Out_ float3* destination, float32x4_t value)
+        {
+            vst1_f32(&destination->x, vget_low_f32(value));
+            vst1q_lane_f32(&destination->z, value, 2);
+        }
 
 
-    inline float3 float3::one()
-    {
-        return float3(1, 1, 1);
-    }
+        inline void StoreNeon(_Out_ float4* destination, float32x4_t value)
+        {
+            vst1q_f32(&destination->x, value);
+        }
 
 
-    inline float3 float3::unit_x()
-    {
-        return float3(1, 0, 0);
-    }
+        inline void StoreNeon(_Out_ quaternion* destination, float32x4_t value)
+        {
+            vst1q_f32(&destination->x, value);
+        }
 
 
-    inline float3 float3::unit_y()
-    {
-        return float3(0, 1, 0);
-    }
+        // Sum of all lanes, broadcast to every lane.
+        inline float32x2_t SumNeon(float32x2_t value)
+        {
+            return vpadd_f32(value, value);
+        }
 
 
-    inline float3 float3::unit_z()
-    {
-        return float3(0, 0, 1);
-    }
+        inline float32x4_t SumNeon(float32x4_t value)
+        {
+#ifdef _WINDOWS_NUMERICS_NEON_AARCH64_
+            return vdupq_n_f32(vaddvq_f32(value));
+#else
+            float32x2_t sum = SumNeon(vadd_f32(vget_low_f32(value), vget_high_f32(value)));
 
+            return vcombine_f32(sum, sum);
+#endif
+        }
 
-    inline float3 operator +(float3 const& value1, float3 const& value2)
-    {
-        return float3(value1.x + value2.x,
-                      value1.y + value2.y,
-                      value1.z + value2.z);
-    }
 
+        // a + b * c
+        inline float32x4_t MultiplyAddNeon(float32x4_t a, float32x4_t b, float32x4_t c)
+        {
+#ifdef _WINDOWS_NUMERICS_NEON_AARCH64_
+            return vfmaq_f32(a, b, c);
+#else
+            return vmlaq_f32(a, b, c);
+#endif
+        }
 
-    inline float3 operator -(float3 const& value1, float3 const& value2)
-    {
-        return float3(value1.x - value2.x,
-                      value1.y - value2.y,
-                      value1.z - value2.z);
-    }
 
+        // a - b * c
+        inline float32x4_t MultiplySubtractNeon(float32x4_t a, float32x4_t b, float32x4_t c)
+        {
+#ifdef _WINDOWS_NUMERICS_NEON_AARCH64_
+            return vfmsq_f32(a, b, c);
+#else
+            return vmlsq_f32(a, b, c);
+#endif
+        }
 
-    inline float3 operator *(float3 const& value1, float3 const& value2)
-    {
-        return float3(value1.x * value2.x,
-                      value1.y * value2.y,
-                      value1.z * value2.z);
-    }
 
+        // value / sqrt(lengthSquared), where lengthSquared holds the same value in every lane.
+        inline float32x2_t DivideBySqrtNeon(float32x2_t value, float32x2_t lengthSquared)
+        {
+#ifdef _WINDOWS_NUMERICS_NEON_AARCH64_
+            return vdiv_f32(value, vsqrt_f32(lengthSquared));
+#else
+            // ARMv7 NEON has no divide or square root instructions, so we refine
+            // the reciprocal square root estimate with two Newton-Raphson steps. Squaring
+            // the estimate (rather than multiplying it by lengthSquared) keeps zero and
+            // infinite lengths giving the same results as the scalar implementation.
+            float32x2_t estimate = vrsqrte_f32(lengthSquared);
+            estimate = vmul_f32(estimate, vrsqrts_f32(vmul_f32(estimate, estimate), lengthSquared));
+            estimate = vmul_f32(estimate, vrsqrts_f32(vmul_f32(estimate, estimate), lengthSquared));
+
+            return vmul_f32(value, estimate);
+#endif
+        }
 
-    inline float3 operator *(float3 const& value1, float value2)
-    {
-        return float3(value1.x * value2,
-                      value1.y * value2,
-                      value1.z * value2);
-    }
 
+        inline float32x4_t DivideBySqrtNeon(float32x4_t value, float32x4_t lengthSquared)
+        {
+#ifdef _WINDOWS_NUMERICS_NEON_AARCH64_
+            return vdivq_f32(value, vsqrtq_f32(lengthSquared));
+#else
+            float32x4_t estimate = vrsqrteq_f32(lengthSquared);
+            estimate = vmulq_f32(estimate, vrsqrtsq_f32(vmulq_f32(estimate, estimate), lengthSquared));
+            estimate = vmulq_f32(estimate, vrsqrtsq_f32(vmulq_f32(estimate, estimate), lengthSquared));
 
-    inline float3 operator *(float value1, float3 const& value2)
-    {
-        return value2 * value1;
-    }
+            return vmulq_f32(value, estimate);
+#endif
+        }
 
 
-    inline float3 operator /(float3 const& value1, float3 const& value2)
-    {
-        return float3(value1.x / value2.x,
-                      value1.y / value2.y,
-                      value1.z / value2.z);
-    }
+        // row * [ m0 m1 m2 m3 ], where m0-m3 are the rows of a matrix.
+        inline float32x4_t MultiplyRowNeon(float32x4_t row, float32x4_t m0, float32x4_t m1, float32x4_t m2, float32x4_t m3)
+        {
+            float32x2_t low = vget_low_f32(row);
+            float32x2_t high = vget_high_f32(row);
 
+            float32x4_t result = vmulq_lane_f32(m0, low, 0);
 
-    inline float3 operator /(float3 const& value1, float value2)
-    {
-        return value1 * (1.0f / value2);
-    }
+#ifdef _WINDOWS_NUMERICS_NEON_AARCH64_
+            result = vfmaq_lane_f32(result, m1, low, 1);
+            result = vfmaq_lane_f32(result, m2, high, 0);
+            result = vfmaq_lane_f32(result, m3, high, 1);
+#else
+            result = vmlaq_lane_f32(result, m1, low, 1);
+            result = vmlaq_lane_f32(result, m2, high, 0);
+            result = vmlaq_lane_f32(result, m3, high, 1);
+#endif
 
+            return result;
+        }
 
-    inline float3 operator -(float3 const& value)
-    {
-        return float3(-value.x,
-                      -value.y,
-                      -value.z);
-    }
 
+        inline float4x4 MultiplyNeon(float4x4 const& value1, float4x4 const& value2)
+        {
+            float32x4_t m0 = vld1q_f32(&value2.m11);
+            float32x4_t m1 = vld1q_f32(&value2.m21);
+            float32x4_t m2 = vld1q_f32(&value2.m31);
+            float32x4_t m3 = vld1q_f32(&value2.m41);
 
-    inline float3& operator +=(float3& value1, float3 const& value2)
-    {
-        value1 = value1 + value2;
+            float4x4 result;
 
-        return value1;
-    }
+            vst1q_f32(&result.m11, MultiplyRowNeon(vld1q_f32(&value1.m11), m0, m1, m2, m3));
+            vst1q_f32(&result.m21, MultiplyRowNeon(vld1q_f32(&value1.m21), m0, m1, m2, m3));
+            vst1q_f32(&result.m31, MultiplyRowNeon(vld1q_f32(&value1.m31), m0, m1, m2, m3));
+            vst1q_f32(&result.m41, MultiplyRowNeon(vld1q_f32(&value1.m41), m0, m1, m2, m3));
 
+            return result;
+        }
 
-    inline float3& operator -=(float3& value1, float3 const& value2)
-    {
-        value1 = value1 - value2;
 
-        return value1;
-    }
+        // Given columns p and q of a 4x4 matrix m, computes the 2x2 minors
+        //
+        //     s = m[0][p] m[1][q] - m[1][p] m[0][q]
+        //     c = m[2][p] m[3][q] - m[3][p] m[2][q]
+        //
+        // returned as (c, c, s, s), the layout needed by InvertNeon.
+        inline float32x4_t MinorsNeon(float32x4_t columnP, float32x4_t columnQ)
+        {
+            float32x4_t products = vmulq_f32(columnP, vrev64q_f32(columnQ));
+            float32x4_t minors = vsubq_f32(products, vrev64q_f32(products));   // (s, -s, c, -c)
 
+            return vcombine_f32(vdup_lane_f32(vget_high_f32(minors), 0), vdup_lane_f32(vget_low_f32(minors), 0));
+        }
 
-    inline float3& operator *=(float3& value1, float3 const& value2)
-    {
-        value1 = value1 * value2;
 
-        return value1;
-    }
+        inline bool InvertNeon(float4x4 const& matrix, _Out_ float4x4* result)
+        {
+            // Laplace expansion by complementary minors. Every element of the adjugate
+            // is a sum of three products of a matrix element with a 2x2 minor from either
+            // the top (s) or bottom (c) pair of rows. Pairing up the minors taken from the
+            // same columns lets us compute a whole row of the adjugate at a time.
+            //
+            // The de-interleaving load transposes the matrix, giving us its columns.
+            float32x4x4_t columns = vld4q_f32(&matrix.m11);
+
+            float32x4_t minors01 = MinorsNeon(columns.val[0], columns.val[1]);
+            float32x4_t minors02 = MinorsNeon(columns.val[0], columns.val[2]);
+            float32x4_t minors03 = MinorsNeon(columns.val[0], columns.val[3]);
+            float32x4_t minors12 = MinorsNeon(columns.val[1], columns.val[2]);
+            float32x4_t minors13 = MinorsNeon(columns.val[1], columns.val[3]);
+            float32x4_t minors23 = MinorsNeon(columns.val[2], columns.val[3]);
+
+            // Each column with its elements swapped in pairs: (m[1][j], m[0][j], m[3][j], m[2][j]).
+            float32x4_t c0 = vrev64q_f32(columns.val[0]);
+            float32x4_t c1 = vrev64q_f32(columns.val[1]);
+            float32x4_t c2 = vrev64q_f32(columns.val[2]);
+            float32x4_t c3 = vrev64q_f32(columns.val[3]);
+
+            // Rows of the adjugate, before applying the alternating (+, -, +, -) signs.
+            float32x4_t a0 = MultiplyAddNeon(MultiplySubtractNeon(vmulq_f32(c1, minors23), c2, minors13), c3, minors12);
+            float32x4_t a1 = MultiplySubtractNeon(MultiplyAddNeon(vnegq_f32(vmulq_f32(c0, minors23)), c2, minors03), c3, minors02);
+            float32x4_t a2 = MultiplyAddNeon(MultiplySubtractNeon(vmulq_f32(c0, minors13), c1, minors03), c3, minors01);
+            float32x4_t a3 = MultiplySubtractNeon(MultiplyAddNeon(vnegq_f32(vmulq_f32(c0, minors12)), c1, minors02), c2, minors01);
+
+            // The first element of M * adjugate(M) is the determinant. The sign of the
+            // first column of the adjugate is +, so the unsigned rows work here.
+            float det = vgetq_lane_f32(MultiplyRowNeon(vld1q_f32(&matrix.m11), a0, a1, a2, a3), 0);
+
+            if (fabs(det) < FLT_EPSILON)
+            {
+                float32x4_t nan = vdupq_n_f32(_WINDOWS_NUMERICS_NAN_);
 
+                vst1q_f32(&result->m11, nan);
+                vst1q_f32(&result->m21, nan);
+                vst1q_f32(&result->m31, nan);
+                vst1q_f32(&result->m41, nan);
 
-    inline float3& operator *=(float3& value1, float value2)
-    {
-        value1 = value1 * value2;
+                return false;
+            }
 
-        return value1;
-    }
+            const float signs[4] = { 1.0f, -1.0f, 1.0f, -1.0f };
 
+            float32x4_t scale = vmulq_n_f32(vld1q_f32(signs), 1.0f / det);
 
-    inline float3& operator /=(float3& value1, float3 const& value2)
-    {
-        value1 = value1 / value2;
+            vst1q_f32(&result->m11, vmulq_f32(a0, scale));
+            vst1q_f32(&result->m21, vmulq_f32(a1, scale));
+            vst1q_f32(&result->m31, vmulq_f32(a2, scale));
+            vst1q_f32(&result->m41, vmulq_f32(a3, scale));
 
-        return value1;
-    }
+            return true;
+        }
 
 
-    inline float3& operator /=(float3& value1, float value2)
-    {
-        value1 = value1 / value2;
+        // Converts a float4 in the range 0 to 1 to four integers in the range 0 to 255,
+        // rounding to nearest. NaN converts to zero.
+        inline uint32x4_t ToUnorm8Neon(float32x4_t value)
+        {
+            float32x4_t saturated = vminq_f32(vmaxq_f32(value, vdupq_n_f32(0)), vdupq_n_f32(1));
 
-        return value1;
-    }
+            return vcvtq_u32_f32(vmlaq_f32(vdupq_n_f32(0.5f), saturated, vdupq_n_f32(255.0f)));
+        }
 
 
-    inline bool operator ==(float3 const& value1, float3 const& value2)
-    {
-        return value1.x == value2.x &&
-               value1.y == value2.y &&
-               value1.z == value2.z;
-    }
+#ifdef _WINDOWS_NUMERICS_NEON_AARCH64_
 
+        // ARMv7 does not guarantee the half precision conversion instructions, so these are AArch64 only.
+        inline void ConvertFloatToHalfNeon(_In_reads_(count) float const* source, size_t count, _Out_writes_(count) uint16_t* destination)
+        {
+            size_t i = 0;
 
-    inline bool operator !=(float3 const& value1, float3 const& value2)
-    {
-        return value1.x != value2.x ||
-               value1.y != value2.y ||
-               value1.z != value2.z;
+            for (; i < count - count % 4; i += 4)
+            {
+                vst1_u16(destination + i, vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(source + i))));
+            }
+
+            for (; i < count; i++)
+            {
+                destination[i] = ::DirectX::PackedVector::XMConvertFloatToHalf(source[i]);
+            }
+        }
+
+
+        inline void ConvertHalfToFloatNeon(_In_reads_(count) uint16_t const* source, size_t count, _Out_writes_(count) float* destination)
+        {
+            size_t i = 0;
+
+            for (; i < count - count % 4; i += 4)
+            {
+                vst1q_f32(destination + i, vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(source + i))));
+            }
+
+            for (; i < count; i++)
+            {
+                destination[i] = ::DirectX::PackedVector::XMConvertHalfToFloat(source[i]);
+            }
+        }
+
+#endif
     }
 
+#endif  // _WINDOWS_NUMERICS_NEON_
 
-    inline float length(float3 const& value)
+
+    _WINDOWS_NUMERICS_CONSTEXPR_ float2::float2(float x, float y)
+        : x(x), y(y)
+    { }
+
+
+    _WINDOWS_NUMERICS_CONSTEXPR_ float2::float2(float value)
+        : x(value), y(value)
+    { }
+
+
+#ifdef _WINDOWS_NUMERICS_CX_PROJECTION_
+
+
+    inline float2::operator float2(Windows::Foundation::Point value)
     {
-        return sqrtf(length_squared(value));
+        return float2(value.X, value.Y);
     }
 
 
-    inline float length_squared(float3 const& value)
+    inline float2::operator float2(Windows::Foundation::Size value)
     {
-        return dot(value, value);
+        return float2(value.Width, value.Height);
     }
 
 
-    inline float distance(float3 const& value1, float3 const& value2)
+    inline float2::operator Windows::Foundation::Point(float2 value)
     {
-        return length(value1 - value2);
+        return Windows::Foundation::Point(value.x, value.y);
     }
 
 
-    inline float distance_squared(float3 const& value1, float3 const& value2)
+    inline float2::operator Windows::Foundation::Size(float2 value)
     {
-        return length_squared(value1 - value2);
+        return Windows::Foundation::Size(value.x, value.y);
     }
 
 
-    inline float dot(float3 const& vector1, float3 const& vector2)
-    {
-        return vector1.x * vector2.x +
-               vector1.y * vector2.y +
-               vector1.z * vector2.z;
-    }
+#elif defined __cplusplus_winrt // && !_WINDOWS_NUMERICS_CX_PROJECTION_
 
 
-    inline float3 normalize(float3 const& value)
-    {
-#ifdef WINDOWS_NUMERICS_DISABLE_SIMD
-        return value / length(value);
-#else
-        using namespace ::DirectX;
+    inline float2::float2(Windows::Foundation::Point const& value)
+        : x(value.X), y(value.Y)
+    { }
 
-        float3 result;
-        XMVECTOR v = XMLoadFloat3(&value);
-        XMStoreFloat3(&result, XMVectorDivide(v, XMVector3Length(v)));
-        return result;
-#endif
-    }
+
+    inline float2::float2(Windows::Foundation::Size const& value)
+        : x(value.Width), y(value.Height)
+    { }
 
 
-    inline float3 cross(float3 const& vector1, float3 const& vector2)
+    inline float2::operator Windows::Foundation::Point() const
     {
-        return float3(vector1.y * vector2.z - vector1.z * vector2.y,
-                      vector1.z * vector2.x - vector1.x * vector2.z,
-                      vector1.x * vector2.y - vector1.y * vector2.x);
+        return Windows::Foundation::Point(x, y);
     }
 
 
-    inline float3 reflect(float3 const& vector, float3 const& normal)
+    inline float2::operator Windows::Foundation::Size() const
     {
-        return vector - 2.0f * dot(vector, normal) * normal;
+        return Windows::Foundation::Size(x, y);
     }
 
 
-    inline float3 (min)(float3 const& value1, float3 const& value2)
-    {
-        return float3((value1.x < value2.x) ? value1.x : value2.x,
-                      (value1.y < value2.y) ? value1.y : value2.y,
-                      (value1.z < value2.z) ? value1.z : value2.z);
-    }
+#endif  // __cpluspluswinrt && !_WINDOWS_NUMERICS_CX_PROJECTION_
 
 
-    inline float3 (max)(float3 const& value1, float3 const& value2)
+    _WINDOWS_NUMERICS_CONSTEXPR_ float2 float2::zero()
     {
-        return float3((value1.x > value2.x) ? value1.x : value2.x,
-                      (value1.y > value2.y) ? value1.y : value2.y,
-                      (value1.z > value2.z) ? value1.z : value2.z);
+        return float2(0, 0);
     }
 
 
-    inline float3 clamp(float3 const& value1, float3 const& minValue, float3 const& maxValue)
+    _WINDOWS_NUMERICS_CONSTEXPR_ float2 float2::one()
     {
-        return (max)((min)(value1, maxValue), minValue);
+        return float2(1, 1);
     }
 
 
-    inline float3 lerp(float3 const& value1, float3 const& value2, float amount)
+    _WINDOWS_NUMERICS_CONSTEXPR_ float2 float2::unit_x()
     {
-        return value1 + (value2 - value1) * amount;
+        return float2(1, 0);
     }
 
 
-    inline float3 transform(float3 const& position, float4x4 const& matrix)
+    _WINDOWS_NUMERICS_CONSTEXPR_ float2 float2::unit_y()
     {
-        return float3(position.x * matrix.m11 + position.y * matrix.m21 + position.z * matrix.m31 + matrix.m41,
-                      position.x * matrix.m12 + position.y * matrix.m22 + position.z * matrix.m32 + matrix.m42,
-                      position.x * matrix.m13 + position.y * matrix.m23 + position.z * matrix.m33 + matrix.m43);
+        return float2(0, 1);
     }
 
 
-    inline float3 transform_normal(float3 const& normal, float4x4 const& matrix)
+    _WINDOWS_NUMERICS_CONSTEXPR_ float2 operator +(float2 const& value1, float2 const& value2)
     {
-        return float3(normal.x * matrix.m11 + normal.y * matrix.m21 + normal.z * matrix.m31,
-                      normal.x * matrix.m12 + normal.y * matrix.m22 + normal.z * matrix.m32,
-                      normal.x * matrix.m13 + normal.y * matrix.m23 + normal.z * matrix.m33);
+        return float2(value1.x + value2.x,
+                      value1.y + value2.y);
     }
 
 
-    inline float3 transform(float3 const& value, quaternion const& rotation)
+    _WINDOWS_NUMERICS_CONSTEXPR_ float2 operator -(float2 const& value1, float2 const& value2)
     {
-        float x2 = rotation.x + rotation.x;
-        float y2 = rotation.y + rotation.y;
-        float z2 = rotation.z + rotation.z;
-
-        float wx2 = rotation.w * x2;
-        float wy2 = rotation.w * y2;
-        float wz2 = rotation.w * z2;
-        float xx2 = rotation.x * x2;
-        float xy2 = rotation.x * y2;
-        float xz2 = rotation.x * z2;
-        float yy2 = rotation.y * y2;
-        float yz2 = rotation.y * z2;
-        float zz2 = rotation.z * z2;
-
-        return float3(value.x * (1.0f - yy2 - zz2) + value.y * (xy2 - wz2) + value.z * (xz2 + wy2),
-                      value.x * (xy2 + wz2) + value.y * (1.0f - xx2 - zz2) + value.z * (yz2 - wx2),
-                      value.x * (xz2 - wy2) + value.y * (yz2 + wx2) + value.z * (1.0f - xx2 - yy2));
+        return float2(value1.x - value2.x,
+                      value1.y - value2.y);
     }
 
 
-    inline float4::float4(float x, float y, float z, float w)
-        : x(x), y(y), z(z), w(w)
-    { }
-
-
-    inline float4::float4(float2 value, float z, float w)
-        : x(value.x), y(value.y), z(z), w(w)
-    { }
-
-
-    inline float4::float4(float3 value, float w)
-        : x(value.x), y(value.y), z(value.z), w(w)
-    { }
-
-
-    inline float4::float4(float value)
-        : x(value), y(value), z(value), w(value)
-    { }
+    _WINDOWS_NUMERICS_CONSTEXPR_ float2 operator *(float2 const& value1, float2 const& value2)
+    {
+        return float2(value1.x * value2.x,
+                      value1.y * value2.y);
+    }
 
 
-    inline float4 float4::zero()
+    _WINDOWS_NUMERICS_CONSTEXPR_ float2 operator *(float2 const& value1, float value2)
     {
-        return float4(0, 0, 0, 0);
+        return float2(value1.x * value2,
+                      value1.y * value2);
     }
 
 
-    inline float4 float4::one()
+    _WINDOWS_NUMERICS_CONSTEXPR_ float2 operator *(float value1, float2 const& value2)
     {
-        return float4(1, 1, 1, 1);
+        return value2 * value1;
     }
 
 
-    inline float4 float4::unit_x()
+    _WINDOWS_NUMERICS_CONSTEXPR_ float2 operator /(float2 const& value1, float2 const& value2)
     {
-        return float4(1, 0, 0, 0);
+        return float2(value1.x / value2.x,
+                      value1.y / value2.y);
     }
 
 
-    inline float4 float4::unit_y()
+    _WINDOWS_NUMERICS_CONSTEXPR_ float2 operator /(float2 const& value1, float value2)
     {
-        return float4(0, 1, 0, 0);
+        return value1 * (1.0f / value2);
     }
 
 
-    inline float4 float4::unit_z()
+    _WINDOWS_NUMERICS_CONSTEXPR_ float2 operator -(float2 const& value)
     {
-        return float4(0, 0, 1, 0);
+        return float2(-value.x,
+                      -value.y);
     }
 
 
-    inline float4 float4::unit_w()
+    inline float2& operator +=(float2& value1, float2 const& value2)
     {
-        return float4(0, 0, 0, 1);
+        value1 = value1 + value2;
+
+        return value1;
     }
 
 
-    inline float4 operator +(float4 const& value1, float4 const& value2)
+    inline float2& operator -=(float2& value1, float2 const& value2)
     {
-#ifdef WINDOWS_NUMERICS_DISABLE_SIMD
-        return float4(value1.x + value2.x,
-                      value1.y + value2.y,
-                      value1.z + value2.z,
-                      value1.w + value2.w);
-#else
-        using namespace ::DirectX;
+        value1 = value1 - value2;
 
-        float4 result;
-        XMStoreFloat4(&result, XMVectorAdd(XMLoadFloat4(&value1), XMLoadFloat4(&value2)));
-        return result;
-#endif
+        return value1;
     }
 
 
-    inline float4 operator -(float4 const& value1, float4 const& value2)
+    inline float2& operator *=(float2& value1, float2 const& value2)
     {
-#ifdef WINDOWS_NUMERICS_DISABLE_SIMD
-        return float4(value1.x - value2.x,
-                      value1.y - value2.y,
-                      value1.z - value2.z,
-                      value1.w - value2.w);
-#else
-        using namespace ::DirectX;
+        value1 = value1 * value2;
 
-        float4 result;
-        XMStoreFloat4(&result, XMVectorSubtract(XMLoadFloat4(&value1), XMLoadFloat4(&value2)));
-        return result;
-#endif
+        return value1;
     }
 
 
-    inline float4 operator *(float4 const& value1, float4 const& value2)
+    inline float2& operator *=(float2& value1, float value2)
     {
-#ifdef WINDOWS_NUMERICS_DISABLE_SIMD
-        return float4(value1.x * value2.x,
-                      value1.y * value2.y,
-                      value1.z * value2.z,
-                      value1.w * value2.w);
-#else
-        using namespace ::DirectX;
+        value1 = value1 * value2;
 
-        float4 result;
-        XMStoreFloat4(&result, XMVectorMultiply(XMLoadFloat4(&value1), XMLoadFloat4(&value2)));
-        return result;
-#endif
+        return value1;
     }
 
 
-    inline float4 operator *(float4 const& value1, float value2)
+    inline float2& operator /=(float2& value1, float2 const& value2)
     {
-#ifdef WINDOWS_NUMERICS_DISABLE_SIMD
-        return float4(value1.x * value2,
-                      value1.y * value2,
-                      value1.z * value2,
-                      value1.w * value2);
-#else
-        using namespace ::DirectX;
+        value1 = value1 / value2;
 
-        float4 result;
-        XMStoreFloat4(&result, XMVectorScale(XMLoadFloat4(&value1), value2));
-        return result;
-#endif
+        return value1;
     }
 
 
-    inline float4 operator *(float value1, float4 const& value2)
+    inline float2& operator /=(float2& value1, float value2)
     {
-        return value2 * value1;
+        value1 = value1 / value2;
+
+        return value1;
     }
 
 
-    inline float4 operator /(float4 const& value1, float4 const& value2)
+    _WINDOWS_NUMERICS_CONSTEXPR_ bool operator ==(float2 const& value1, float2 const& value2)
     {
-#ifdef WINDOWS_NUMERICS_DISABLE_SIMD
-        return float4(value1.x / value2.x,
-                      value1.y / value2.y,
-                      value1.z / value2.z,
-                      value1.w / value2.w);
-#else
-        using namespace ::DirectX;
-
-        float4 result;
-        XMStoreFloat4(&result, XMVectorDivide(XMLoadFloat4(&value1), XMLoadFloat4(&value2)));
-        return result;
-#endif
+        return value1.x == value2.x &&
+               value1.y == value2.y;
     }
 
 
-    inline float4 operator /(float4 const& value1, float value2)
+    _WINDOWS_NUMERICS_CONSTEXPR_ bool operator !=(float2 const& value1, float2 const& value2)
     {
-        return value1 * (1.0f / value2);
+        return value1.x != value2.x ||
+               value1.y != value2.y;
     }
 
 
-    inline float4 operator -(float4 const& value)
+    inline float length(float2 const& value)
     {
-#ifdef WINDOWS_NUMERICS_DISABLE_SIMD
-        return float4(-value.x,
-                      -value.y,
-                      -value.z,
-                      -value.w);
+#ifdef _WINDOWS_NUMERICS_NEON_
+        float32x2_t v = details::LoadNeon(value);
+        return sqrtf(vget_lane_f32(details::SumNeon(vmul_f32(v, v)), 0));
 #else
-        using namespace ::DirectX;
-
-        float4 result;
-        XMStoreFloat4(&result, XMVectorNegate(XMLoadFloat4(&value)));
-        return result;
+        return sqrtf(length_squared(value));
 #endif
     }
 
 
-    inline float4& operator +=(float4& value1, float4 const& value2)
+    inline float length_squared(float2 const& value)
     {
-        value1 = value1 + value2;
-
-        return value1;
+        return dot(value, value);
     }
 
 
-    inline float4& operator -=(float4& value1, float4 const& value2)
+    inline float distance(float2 const& value1, float2 const& value2)
     {
-        value1 = value1 - value2;
-
-        return value1;
+        return length(value1 - value2);
     }
 
 
-    inline float4& operator *=(float4& value1, float4 const& value2)
+    inline float distance_squared(float2 const& value1, float2 const& value2)
     {
-        value1 = value1 * value2;
-
-        return value1;
+        return length_squared(value1 - value2);
     }
 
 
-    inline float4& operator *=(float4& value1, float value2)
+    inline float dot(float2 const& value1, float2 const& value2)
     {
-        value1 = value1 * value2;
-
-        return value1;
+        return value1.x * value2.x +
+               value1.y * value2.y;
     }
 
 
-    inline float4& operator /=(float4& value1, float4 const& value2)
+    inline float2 normalize(float2 const& value)
     {
-        value1 = value1 / value2;
-
-        return value1;
-    }
+#if defined _WINDOWS_NUMERICS_NEON_
+        float32x2_t v = details::LoadNeon(value);
 
+        float2 result;
+        details::StoreNeon(&result, details::DivideBySqrtNeon(v, details::SumNeon(vmul_f32(v, v))));
+        return result;
+#elif defined WINDOWS_NUMERICS_DISABLE_SIMD
+        return value / length(value);
+#else
+        using namespace ::DirectX;
 
-    inline float4& operator /=(float4& value1, float value2)
-    {
-        value1 = value1 / value2;
-
-        return value1;
+        float2 result;
+        XMVECTOR v = XMLoadFloat2(&value);
+        XMStoreFloat2(&result, XMVectorDivide(v, XMVector2Length(v)));
+        return result;
+#endif
     }
 
 
-    inline bool operator ==(float4 const& value1, float4 const& value2)
+    inline float2 reflect(float2 const& vector, float2 const& normal)
     {
-        return value1.x == value2.x &&
-               value1.y == value2.y &&
-               value1.z == value2.z &&
-               value1.w == value2.w;
+        return vector - 2.0f * dot(vector, normal) * normal;
     }
 
 
-    inline bool operator !=(float4 const& value1, float4 const& value2)
+    inline float2 (min)(float2 const& value1, float2 const& value2)
     {
-        return value1.x != value2.x ||
-               value1.y != value2.y ||
-               value1.z != value2.z ||
-               value1.w != value2.w;
+        return float2((value1.x < value2.x) ? value1.x : value2.x,
+                      (value1.y < value2.y) ? value1.y : value2.y);
     }
 
 
-    inline float length(float4 const& value)
+    inline float2 (max)(float2 const& value1, float2 const& value2)
     {
-        return sqrtf(length_squared(value));
+        return float2((value1.x > value2.x) ? value1.x : value2.x,
+                      (value1.y > value2.y) ? value1.y : value2.y);
     }
 
 
-    inline float length_squared(float4 const& value)
+    inline float2 clamp(float2 const& value1, float2 const& minValue, float2 const& maxValue)
     {
-        return dot(value, value);
+        return (max)((min)(value1, maxValue), minValue);
     }
 
 
-    inline float distance(float4 const& value1, float4 const& value2)
+    inline float2 lerp(float2 const& value1, float2 const& value2, float amount)
     {
-        return length(value1 - value2);
+        return value1 + (value2 - value1) * amount;
     }
 
 
-    inline float distance_squared(float4 const& value1, float4 const& value2)
+    inline float2 transform(float2 const& position, float3x2 const& matrix)
     {
-        return length_squared(value1 - value2);
+        return float2(position.x * matrix.m11 + position.y * matrix.m21 + matrix.m31,
+                      position.x * matrix.m12 + position.y * matrix.m22 + matrix.m32);
     }
 
 
-    inline float dot(float4 const& vector1, float4 const& vector2)
+    inline float2 transform(float2 const& position, float4x4 const& matrix)
     {
-        return vector1.x * vector2.x + 
-               vector1.y * vector2.y + 
-               vector1.z * vector2.z + 
-               vector1.w * vector2.w;
+        return float2(position.x * matrix.m11 + position.y * matrix.m21 + matrix.m41,
+                      position.x * matrix.m12 + position.y * matrix.m22 + matrix.m42);
     }
 
 
-    inline float4 normalize(float4 const& value)
+    inline float2 transform_normal(float2 const& normal, float3x2 const& matrix)
     {
-#ifdef WINDOWS_NUMERICS_DISABLE_SIMD
-        return value / length(value);
-#else
-        using namespace ::DirectX;
-
-        float4 result;
-        XMVECTOR v = XMLoadFloat4(&value);
-        XMStoreFloat4(&result, XMVectorDivide(v, XMVector4Length(v)));
-        return result;
-#endif
+        return float2(normal.x * matrix.m11 + normal.y * matrix.m21,
+                      normal.x * matrix.m12 + normal.y * matrix.m22);
     }
 
 
-    inline float4 (min)(float4 const& value1, float4 const& value2)
+    inline float2 transform_normal(float2 const& normal, float4x4 const& matrix)
     {
-#ifdef WINDOWS_NUMERICS_DISABLE_SIMD
-        return float4((value1.x < value2.x) ? value1.x : value2.x,
-                      (value1.y < value2.y) ? value1.y : value2.y,
-                      (value1.z < value2.z) ? value1.z : value2.z,
-                      (value1.w < value2.w) ? value1.w : value2.w);
-#else
-        using namespace ::DirectX;
-
-        float4 result;
-        XMStoreFloat4(&result, XMVectorMin(XMLoadFloat4(&value1), XMLoadFloat4(&value2)));
-        return result;
-#endif
+        return float2(normal.x * matrix.m11 + normal.y * matrix.m21,
+                      normal.x * matrix.m12 + normal.y * matrix.m22);
     }
 
 
-    inline float4 (max)(float4 const& value1, float4 const& value2)
+    inline float2 transform(float2 const& value, quaternion const& rotation)
     {
-#ifdef WINDOWS_NUMERICS_DISABLE_SIMD
-        return float4((value1.x > value2.x) ? value1.x : value2.x,
-                      (value1.y > value2.y) ? value1.y : value2.y,
-                      (value1.z > value2.z) ? value1.z : value2.z,
-                      (value1.w > value2.w) ? value1.w : value2.w);
-#else
-        using namespace ::DirectX;
+        float x2 = rotation.x + rotation.x;
+        float y2 = rotation.y + rotation.y;
+        float z2 = rotation.z + rotation.z;
 
-        float4 result;
-        XMStoreFloat4(&result, XMVectorMax(XMLoadFloat4(&value1), XMLoadFloat4(&value2)));
-        return result;
-#endif
+        float wz2 = rotation.w * z2;
+        float xx2 = rotation.x * x2;
+        float xy2 = rotation.x * y2;
+        float yy2 = rotation.y * y2;
+        float zz2 = rotation.z * z2;
+
+        return float2(value.x * (1.0f - yy2 - zz2) + value.y * (xy2 - wz2),
+                      value.x * (xy2 + wz2) + value.y * (1.0f - xx2 - zz2));
     }
 
 
-    inline float4 clamp(float4 const& value1, float4 const& minValue, float4 const& maxValue)
+    inline void transform(_In_reads_(count) float2 const* positions, size_t count, float3x2 const& matrix, _Out_writes_(count) float2* results)
     {
-        return (max)((min)(value1, maxValue), minValue);
-    }
+        size_t i = 0;
 
+#ifdef _WINDOWS_NUMERICS_BATCH_SIMD_
+        using namespace ::DirectX;
 
-    inline float4 lerp(float4 const& value1, float4 const& value2, float amount)
-    {
-        return value1 + (value2 - value1) * amount;
-    }
+        XMVECTOR m11 = XMVectorReplicate(matrix.m11);
+        XMVECTOR m12 = XMVectorReplicate(matrix.m12);
+        XMVECTOR m21 = XMVectorReplicate(matrix.m21);
+        XMVECTOR m22 = XMVectorReplicate(matrix.m22);
+        XMVECTOR m31 = XMVectorReplicate(matrix.m31);
+        XMVECTOR m32 = XMVectorReplicate(matrix.m32);
 
+        for (; i < count - count % 4; i += 4)
+        {
+            XMVECTOR x, y;
+            details::LoadFloat2x4(positions + i, &x, &y);
 
-    inline float4 transform(float4 const& vector, float4x4 const& matrix)
-    {
-#ifdef WINDOWS_NUMERICS_DISABLE_SIMD
-        return float4(vector.x * matrix.m11 + vector.y * matrix.m21 + vector.z * matrix.m31 + vector.w * matrix.m41,
-                      vector.x * matrix.m12 + vector.y * matrix.m22 + vector.z * matrix.m32 + vector.w * matrix.m42,
-                      vector.x * matrix.m13 + vector.y * matrix.m23 + vector.z * matrix.m33 + vector.w * matrix.m43,
-                      vector.x * matrix.m14 + vector.y * matrix.m24 + vector.z * matrix.m34 + vector.w * matrix.m44);
-#else
-        using namespace ::DirectX;
+            XMVECTOR resultX = XMVectorMultiplyAdd(x, m11, XMVectorMultiplyAdd(y, m21, m31));
+            XMVECTOR resultY = XMVectorMultiplyAdd(x, m12, XMVectorMultiplyAdd(y, m22, m32));
 
-        float4 result;
-        XMStoreFloat4(&result, XMVector4Transform(XMLoadFloat4(&vector), XMLoadFloat4x4(&matrix)));
-        return result;
+            details::StoreFloat2x4(results + i, resultX, resultY);
+        }
 #endif
+
+        for (; i < count; i++)
+        {
+            results[i] = transform(positions[i], matrix);
+        }
     }
 
 
-    inline float4 transform4(float3 const& position, float4x4 const& matrix)
+    inline void transform(_In_reads_(count) float2 const* positions, size_t count, float4x4 const& matrix, _Out_writes_(count) float2* results)
     {
-        return float4(position.x * matrix.m11 + position.y * matrix.m21 + position.z * matrix.m31 + matrix.m41,
-                      position.x * matrix.m12 + position.y * matrix.m22 + position.z * matrix.m32 + matrix.m42,
-                      position.x * matrix.m13 + position.y * matrix.m23 + position.z * matrix.m33 + matrix.m43,
-                      position.x * matrix.m14 + position.y * matrix.m24 + position.z * matrix.m34 + matrix.m44);
+        // Only the 2D affine part of the matrix affects a float2 position.
+        float3x2 affine(matrix.m11, matrix.m12,
+                        matrix.m21, matrix.m22,
+                        matrix.m41, matrix.m42);
+
+        transform(positions, count, affine, results);
     }
 
 
-    inline float4 transform4(float2 const& position, float4x4 const& matrix)
+    inline void deinterleave(_In_reads_(count) float2 const* values, size_t count, _Out_writes_(count) float* x, _Out_writes_(count) float* y)
     {
-        return float4(position.x * matrix.m11 + position.y * matrix.m21 + matrix.m41,
-                      position.x * matrix.m12 + position.y * matrix.m22 + matrix.m42,
-                      position.x * matrix.m13 + position.y * matrix.m23 + matrix.m43,
-                      position.x * matrix.m14 + position.y * matrix.m24 + matrix.m44);
-    }
+        size_t i = 0;
 
+#ifdef _WINDOWS_NUMERICS_BATCH_SIMD_
+        using namespace ::DirectX;
 
-    inline float4 transform(float4 const& value, quaternion const& rotation)
-    {
-        float x2 = rotation.x + rotation.x;
-        float y2 = rotation.y + rotation.y;
-        float z2 = rotation.z + rotation.z;
+        for (; i < count - count % 4; i += 4)
+        {
+            XMVECTOR vx, vy;
+            details::LoadFloat2x4(values + i, &vx, &vy);
 
-        float wx2 = rotation.w * x2;
-        float wy2 = rotation.w * y2;
-        float wz2 = rotation.w * z2;
-        float xx2 = rotation.x * x2;
-        float xy2 = rotation.x * y2;
-        float xz2 = rotation.x * z2;
-        float yy2 = rotation.y * y2;
-        float yz2 = rotation.y * z2;
-        float zz2 = rotation.z * z2;
+            XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(x + i), vx);
+            XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(y + i), vy);
+        }
+#endif
 
-        return float4(value.x * (1.0f - yy2 - zz2) + value.y * (       xy2 - wz2) + value.z * (       xz2 + wy2),
-                      value.x * (       xy2 + wz2) + value.y * (1.0f - xx2 - zz2) + value.z * (       yz2 - wx2),
-                      value.x * (       xz2 - wy2) + value.y * (       yz2 + wx2) + value.z * (1.0f - xx2 - yy2),
-                      value.w);
+        for (; i < count; i++)
+        {
+            x[i] = values[i].x;
+            y[i] = values[i].y;
+        }
     }
 
 
-    inline float4 transform4(float3 const& value, quaternion const& rotation)
+    inline void interleave(_In_reads_(count) float const* x, _In_reads_(count) float const* y, size_t count, _Out_writes_(count) float2* values)
     {
-        float x2 = rotation.x + rotation.x;
-        float y2 = rotation.y + rotation.y;
-        float z2 = rotation.z + rotation.z;
+        size_t i = 0;
 
-        float wx2 = rotation.w * x2;
-        float wy2 = rotation.w * y2;
-        float wz2 = rotation.w * z2;
-        float xx2 = rotation.x * x2;
-        float xy2 = rotation.x * y2;
-        float xz2 = rotation.x * z2;
-        float yy2 = rotation.y * y2;
-        float yz2 = rotation.y * z2;
-        float zz2 = rotation.z * z2;
+#ifdef _WINDOWS_NUMERICS_BATCH_SIMD_
+        using namespace ::DirectX;
 
-        return float4(value.x * (1.0f - yy2 - zz2) + value.y * (       xy2 - wz2) + value.z * (       xz2 + wy2),
-                      value.x * (       xy2 + wz2) + value.y * (1.0f - xx2 - zz2) + value.z * (       yz2 - wx2),
-                      value.x * (       xz2 - wy2) + value.y * (       yz2 + wx2) + value.z * (1.0f - xx2 - yy2),
-                      1.0f);
+        for (; i < count - count % 4; i += 4)
+        {
+            details::StoreFloat2x4(values + i,
+                                   XMLoadFloat4(reinterpret_cast<XMFLOAT4 const*>(x + i)),
+                                   XMLoadFloat4(reinterpret_cast<XMFLOAT4 const*>(y + i)));
+        }
+#endif
+
+        for (; i < count; i++)
+        {
+            values[i] = float2(x[i], y[i]);
+        }
     }
 
 
-    inline float4 transform4(float2 const& value, quaternion const& rotation)
-    {
-        float x2 = rotation.x + rotation.x;
-        float y2 = rotation.y + rotation.y;
-        float z2 = rotation.z + rotation.z;
+    inline float3::float3(float x, float y, float z)
+        : x(x), y(y), z(z)
+    { }
 
-        float wx2 = rotation.w * x2;
-        float wy2 = rotation.w * y2;
-        float wz2 = rotation.w * z2;
-        float xx2 = rotation.x * x2;
-        float xy2 = rotation.x * y2;
-        float xz2 = rotation.x * z2;
-        float yy2 = rotation.y * y2;
-        float yz2 = rotation.y * z2;
-        float zz2 = rotation.z * z2;
 
-        return float4(value.x * (1.0f - yy2 - zz2) + value.y * (       xy2 - wz2),
-                      value.x * (       xy2 + wz2) + value.y * (1.0f - xx2 - zz2),
-                      value.x * (       xz2 - wy2) + value.y * (       yz2 + wx2),
-                      1.0f);
-    }
+    inline float3::float3(float2 value, float z)
+        : x(value.x), y(value.y), z(z)
+    { }
 
 
-    inline float3x2::float3x2(float m11, float m12, float m21, float m22, float m31, float m32)
-        : m11(m11), m12(m12), m21(m21), m22(m22), m31(m31), m32(m32)
+    inline float3::float3(float value)
+        : x(value), y(value), z(value)
     { }
 
 
-    inline float3x2 float3x2::identity()
+    inline float3 float3::zero()
     {
-        return float3x2(1, 0,
-                        0, 1,
-                        0, 0);
+        return float3(0, 0, 0);
     }
 
 
-    inline float3x2 make_float3x2_translation(float2 const& position)
+    inline float3 float3::one()
     {
-        return float3x2(1, 0,
-                        0, 1,
-                        position.x, position.y);
+        return float3(1, 1, 1);
     }
 
 
-    inline float3x2 make_float3x2_translation(float xPosition, float yPosition)
+    inline float3 float3::unit_x()
     {
-        return float3x2(1, 0,
-                        0, 1,
-                        xPosition, yPosition);
+        return float3(1, 0, 0);
     }
 
 
-    inline float3x2 make_float3x2_scale(float xScale, float yScale)
+    inline float3 float3::unit_y()
     {
-        return float3x2(xScale, 0,
-                        0,      yScale,
-                        0,      0);
+        return float3(0, 1, 0);
     }
 
 
-    inline float3x2 make_float3x2_scale(float xScale, float yScale, float2 const& centerPoint)
+    inline float3 float3::unit_z()
     {
-        float tx = centerPoint.x * (1 - xScale);
-        float ty = centerPoint.y * (1 - yScale);
-
-        return float3x2(xScale, 0,
-                        0,      yScale,
-                        tx,     ty);
+        return float3(0, 0, 1);
     }
 
 
-    inline float3x2 make_float3x2_scale(float2 const& scales)
+    inline float3 operator +(float3 const& value1, float3 const& value2)
     {
-        return float3x2(scales.x, 0,
-                        0,        scales.y,
-                        0,        0);
+        return float3(value1.x + value2.x,
+                      value1.y + value2.y,
+                      value1.z + value2.z);
     }
 
 
-    inline float3x2 make_float3x2_scale(float2 const& scales, float2 const& centerPoint)
+    inline float3 operator -(float3 const& value1, float3 const& value2)
     {
-        float2 t = centerPoint * (float2::one() - scales);
-
-        return float3x2(scales.x, 0,
-                        0,        scales.y,
-                        t.x,      t.y);
+        return float3(value1.x - value2.x,
+                      value1.y - value2.y,
+                      value1.z - value2.z);
     }
 
 
-    inline float3x2 make_float3x2_scale(float scale)
+    inline float3 operator *(float3 const& value1, float3 const& value2)
     {
-        return float3x2(scale, 0,
-                        0,     scale,
-                        0,     0);
+        return float3(value1.x * value2.x,
+                      value1.y * value2.y,
+                      value1.z * value2.z);
     }
 
 
-    inline float3x2 make_float3x2_scale(float scale, float2 const& centerPoint)
+    inline float3 operator *(float3 const& value1, float value2)
     {
-        float2 t = centerPoint * (1 - scale);
-
-        return float3x2(scale, 0,
-                        0,     scale,
-                        t.x,   t.y);
+        return float3(value1.x * value2,
+                      value1.y * value2,
+                      value1.z * value2);
     }
 
 
-    inline float3x2 make_float3x2_skew(float radiansX, float radiansY)
+    inline float3 operator *(float value1, float3 const& value2)
     {
-        float xTan = tanf(radiansX);
-        float yTan = tanf(radiansY);
-
-        return float3x2(1,    yTan,
-                        xTan, 1,
-                        0,    0);
+        return value2 * value1;
     }
 
 
-    inline float3x2 make_float3x2_skew(float radiansX, float radiansY, float2 const& centerPoint)
+    inline float3 operator /(float3 const& value1, float3 const& value2)
     {
-        float xTan = tanf(radiansX);
-        float yTan = tanf(radiansY);
-
-        float tx = -centerPoint.y * xTan;
-        float ty = -centerPoint.x * yTan;
-
-        return float3x2(1,    yTan,
-                        xTan, 1,
-                        tx,   ty);
+        return float3(value1.x / value2.x,
+                      value1.y / value2.y,
+                      value1.z / value2.z);
     }
 
 
-    inline float3x2 make_float3x2_rotation(float radians)
+    inline float3 operator /(float3 const& value1, float value2)
     {
-        return make_float3x2_rotation(radians, float2::zero());
+        return value1 * (1.0f / value2);
     }
 
 
-    inline float3x2 make_float3x2_rotation(float radians, float2 const& centerPoint)
+    inline float3 operator -(float3 const& value)
     {
-        radians = fmodf(radians, ::DirectX::XM_2PI);
-
-        if (radians < 0)
-            radians += ::DirectX::XM_2PI;
-
-        float c, s;
-
-        const float epsilon = 0.001f * ::DirectX::XM_PI / 180.0f;     // 0.1% of a degree
-
-        if (radians < epsilon || radians > ::DirectX::XM_2PI - epsilon)
-        {
-            // Exact case for zero rotation.
-            c = 1;
-            s = 0;
-        }
-        else if (radians > ::DirectX::XM_PIDIV2 - epsilon && radians < ::DirectX::XM_PIDIV2 + epsilon)
-        {
-            // Exact case for 90 degree rotation.
-            c = 0;
-            s = 1;
-        }
-        else if (radians > ::DirectX::XM_PI - epsilon && radians < ::DirectX::XM_PI + epsilon)
-        {
-            // Exact case for 180 degree rotation.
-            c = -1;
-            s = 0;
-        }
-        else if (radians > ::DirectX::XM_PI + ::DirectX::XM_PIDIV2 - epsilon && radians < ::DirectX::XM_PI + ::DirectX::XM_PIDIV2 + epsilon)
-        {
-            // Exact case for 270 degree rotation.
-            c = 0;
-            s = -1;
-        }
-        else
-        {
-            // Arbitrary rotation.
-            c = cosf(radians);
-            s = sinf(radians);
-        }
-
-        float x = centerPoint.x * (1 - c) + centerPoint.y * s;
-        float y = centerPoint.y * (1 - c) - centerPoint.x * s;
-
-        return float3x2( c, s,
-                        -s, c,
-                         x, y);
+        return float3(-value.x,
+                      -value.y,
+                      -value.z);
     }
 
 
-    inline float3x2 operator +(float3x2 const& value1, float3x2 const& value2)
+    inline float3& operator +=(float3& value1, float3 const& value2)
     {
-        return float3x2(value1.m11 + value2.m11,  value1.m12 + value2.m12,
-                        value1.m21 + value2.m21,  value1.m22 + value2.m22,
-                        value1.m31 + value2.m31,  value1.m32 + value2.m32);
-    }
-
+        value1 = value1 + value2;
 
-    inline float3x2 operator -(float3x2 const& value1, float3x2 const& value2)
-    {
-        return float3x2(value1.m11 - value2.m11,  value1.m12 - value2.m12,
-                        value1.m21 - value2.m21,  value1.m22 - value2.m22,
-                        value1.m31 - value2.m31,  value1.m32 - value2.m32);
+        return value1;
     }
 
 
-    inline float3x2 operator *(float3x2 const& value1, float3x2 const& value2)
+    inline float3& operator -=(float3& value1, float3 const& value2)
     {
-        return float3x2
-        (
-            // First row
-            value1.m11 * value2.m11 + value1.m12 * value2.m21,
-            value1.m11 * value2.m12 + value1.m12 * value2.m22,
-            
-            // Second row
-            value1.m21 * value2.m11 + value1.m22 * value2.m21,
-            value1.m21 * value2.m12 + value1.m22 * value2.m22,
-            
-            // Third row
-            value1.m31 * value2.m11 + value1.m32 * value2.m21 + value2.m31,
-            value1.m31 * value2.m12 + value1.m32 * value2.m22 + value2.m32
-        );
-    }
-
+        value1 = value1 - value2;
 
-    inline float3x2 operator *(float3x2 const& value1, float value2)
-    {
-        return float3x2(value1.m11 * value2,  value1.m12 * value2,
-                        value1.m21 * value2,  value1.m22 * value2,
-                        value1.m31 * value2,  value1.m32 * value2);
+        return value1;
     }
 
 
-    inline float3x2 operator -(float3x2 const& value)
+    inline float3& operator *=(float3& value1, float3 const& value2)
     {
-        return float3x2(-value.m11, -value.m12,
-                        -value.m21, -value.m22,
-                        -value.m31, -value.m32);
+        value1 = value1 * value2;
+
+        return value1;
     }
 
 
-    inline float3x2& operator +=(float3x2& value1, float3x2 const& value2)
+    inline float3& operator *=(float3& value1, float value2)
     {
-        value1 = value1 + value2;
+        value1 = value1 * value2;
 
         return value1;
     }
 
 
-    inline float3x2& operator -=(float3x2& value1, float3x2 const& value2)
+    inline float3& operator /=(float3& value1, float3 const& value2)
     {
-        value1 = value1 - value2;
+        value1 = value1 / value2;
 
         return value1;
     }
 
 
-    inline float3x2& operator *=(float3x2& value1, float3x2 const& value2)
+    inline float3& operator /=(float3& value1, float value2)
     {
-        value1 = value1 * value2;
+        value1 = value1 / value2;
 
         return value1;
     }
 
 
-    inline float3x2& operator *=(float3x2& value1, float value2)
+    inline bool operator ==(float3 const& value1, float3 const& value2)
     {
-        value1 = value1 * value2;
-
-        return value1;
+        return value1.x == value2.x &&
+               value1.y == value2.y &&
+               value1.z == value2.z;
     }
 
 
-    inline bool operator ==(float3x2 const& value1, float3x2 const& value2)
+    inline bool operator !=(float3 const& value1, float3 const& value2)
     {
-        return value1.m11 == value2.m11 && value1.m22 == value2.m22 && // Check diagonal element first for early out.
-                                           value1.m12 == value2.m12 &&
-               value1.m21 == value2.m21                             &&
-               value1.m31 == value2.m31 && value1.m32 == value2.m32;
+        return value1.x != value2.x ||
+               value1.y != value2.y ||
+               value1.z != value2.z;
     }
 
 
-    inline bool operator !=(float3x2 const& value1, float3x2 const& value2)
+    inline float length(float3 const& value)
     {
-        return value1.m11 != value2.m11 || value1.m12 != value2.m12 ||
-               value1.m21 != value2.m21 || value1.m22 != value2.m22 ||
-               value1.m31 != value2.m31 || value1.m32 != value2.m32;
+#ifdef _WINDOWS_NUMERICS_NEON_
+        float32x4_t v = details::LoadNeon(value);
+        return sqrtf(vgetq_lane_f32(details::SumNeon(vmulq_f32(v, v)), 0));
+#else
+        return sqrtf(length_squared(value));
+#endif
     }
 
 
-    inline bool is_identity(float3x2 const& value)
+    inline float length_squared(float3 const& value)
     {
-        return value.m11 == 1 && value.m22 == 1 && // Check diagonal element first for early out.
-                                 value.m12 == 0 &&
-               value.m21 == 0                   &&
-               value.m31 == 0 && value.m32 == 0;
+        return dot(value, value);
     }
 
 
-    inline float determinant(float3x2 const& value)
+    inline float distance(float3 const& value1, float3 const& value2)
     {
-        return (value.m11 * value.m22) - (value.m21 * value.m12);
+        return length(value1 - value2);
     }
 
 
-    inline float2 translation(float3x2 const& value)
+    inline float distance_squared(float3 const& value1, float3 const& value2)
     {
-        return float2(value.m31, value.m32);
+        return length_squared(value1 - value2);
     }
 
 
-    inline bool invert(float3x2 const& matrix, _Out_ float3x2* result)
+    inline float dot(float3 const& vector1, float3 const& vector2)
     {
-        float det = determinant(matrix);
+        return vector1.x * vector2.x +
+               vector1.y * vector2.y +
+               vector1.z * vector2.z;
+    }
 
-        if (fabs(det) < FLT_EPSILON)
-        {
-            const float nan = _WINDOWS_NUMERICS_NAN_;
-            *result = float3x2(nan, nan, nan, nan, nan, nan);
-            return false;
-        }
 
-        float invDet = 1.0f / det;
+    inline float3 normalize(float3 const& value)
+    {
+#if defined _WINDOWS_NUMERICS_NEON_
+        float32x4_t v = details::LoadNeon(value);
 
-        *result = float3x2
-        (
-            // First row
-            matrix.m22 * invDet,
-            -matrix.m12 * invDet,
+        float3 result;
+        details::StoreNeon(&result, details::DivideBySqrtNeon(v, details::SumNeon(vmulq_f32(v, v))));
+        return result;
+#elif defined WINDOWS_NUMERICS_DISABLE_SIMD
+        return value / length(value);
+#else
+        using namespace ::DirectX;
 
-            // Second row
-            -matrix.m21 * invDet,
-            matrix.m11 * invDet,
+        float3 result;
+        XMVECTOR v = XMLoadFloat3(&value);
+        XMStoreFloat3(&result, XMVectorDivide(v, XMVector3Length(v)));
+        return result;
+#endif
+    }
 
-            // Third row
-            (matrix.m21 * matrix.m32 - matrix.m31 * matrix.m22) * invDet,
-            (matrix.m31 * matrix.m12 - matrix.m11 * matrix.m32) * invDet
-        );
 
-        return true;
+    inline float3 cross(float3 const& vector1, float3 const& vector2)
+    {
+        return float3(vector1.y * vector2.z - vector1.z * vector2.y,
+                      vector1.z * vector2.x - vector1.x * vector2.z,
+                      vector1.x * vector2.y - vector1.y * vector2.x);
     }
 
 
-    inline float3x2 lerp(float3x2 const& matrix1, float3x2 const& matrix2, float amount)
+    inline float3 reflect(float3 const& vector, float3 const& normal)
     {
-        return matrix1 + (matrix2 - matrix1) * amount;
+        return vector - 2.0f * dot(vector, normal) * normal;
     }
 
 
-    inline float4x4::float4x4(float m11, float m12, float m13, float m14, float m21, float m22, float m23, float m24, float m31, float m32, float m33, float m34, float m41, float m42, float m43, float m44)
-        : m11(m11), m12(m12), m13(m13), m14(m14),
-          m21(m21), m22(m22), m23(m23), m24(m24),
-          m31(m31), m32(m32), m33(m33), m34(m34),
-          m41(m41), m42(m42), m43(m43), m44(m44)
-    { }
+    inline float3 (min)(float3 const& value1, float3 const& value2)
+    {
+        return float3((value1.x < value2.x) ? value1.x : value2.x,
+                      (value1.y < value2.y) ? value1.y : value2.y,
+                      (value1.z < value2.z) ? value1.z : value2.z);
+    }
 
 
-    inline float4x4::float4x4(float3x2 value)
-        : m11(value.m11), m12(value.m12), m13(0), m14(0),
-          m21(value.m21), m22(value.m22), m23(0), m24(0),
-          m31(0),         m32(0),         m33(1), m34(0),
-          m41(value.m31), m42(value.m32), m43(0), m44(1)
-    { }
+    inline float3 (max)(float3 const& value1, float3 const& value2)
+    {
+        return float3((value1.x > value2.x) ? value1.x : value2.x,
+                      (value1.y > value2.y) ? value1.y : value2.y,
+                      (value1.z > value2.z) ? value1.z : value2.z);
+    }
 
 
-    inline float4x4 float4x4::identity()
+    inline float3 clamp(float3 const& value1, float3 const& minValue, float3 const& maxValue)
     {
-        return float4x4(1, 0, 0, 0,
-                        0, 1, 0, 0,
-                        0, 0, 1, 0,
-                        0, 0, 0, 1);
+        return (max)((min)(value1, maxValue), minValue);
     }
 
 
-    inline float4x4 make_float4x4_billboard(float3 const& objectPosition, float3 const& cameraPosition, float3 const& cameraUpVector, float3 const& cameraForwardVector)
+    inline float3 lerp(float3 const& value1, float3 const& value2, float amount)
     {
-        const float epsilon = 1e-4f;
+        return value1 + (value2 - value1) * amount;
+    }
 
-        float3 zaxis = objectPosition - cameraPosition;
 
-        float norm = length_squared(zaxis);
+    inline float3 transform(float3 const& position, float4x4 const& matrix)
+    {
+        return float3(position.x * matrix.m11 + position.y * matrix.m21 + position.z * matrix.m31 + matrix.m41,
+                      position.x * matrix.m12 + position.y * matrix.m22 + position.z * matrix.m32 + matrix.m42,
+                      position.x * matrix.m13 + position.y * matrix.m23 + position.z * matrix.m33 + matrix.m43);
+    }
 
-        if (norm < epsilon)
-        {
-            zaxis = -cameraForwardVector;
-        }
-        else
-        {
-            zaxis = zaxis / sqrtf(norm);
-        }
 
-        float3 xaxis = normalize(cross(cameraUpVector, zaxis));
+    inline float3 transform_normal(float3 const& normal, float4x4 const& matrix)
+    {
+        return float3(normal.x * matrix.m11 + normal.y * matrix.m21 + normal.z * matrix.m31,
+                      normal.x * matrix.m12 + normal.y * matrix.m22 + normal.z * matrix.m32,
+                      normal.x * matrix.m13 + normal.y * matrix.m23 + normal.z * matrix.m33);
+    }
 
-        float3 yaxis = cross(zaxis, xaxis);
 
-        return float4x4(xaxis.x,          xaxis.y,          xaxis.z,          0,
-                        yaxis.x,          yaxis.y,          yaxis.z,          0,
-                        zaxis.x,          zaxis.y,          zaxis.z,          0,
-                        objectPosition.x, objectPosition.y, objectPosition.z, 1);
+    inline float3 transform(float3 const& value, quaternion const& rotation)
+    {
+        float x2 = rotation.x + rotation.x;
+        float y2 = rotation.y + rotation.y;
+        float z2 = rotation.z + rotation.z;
+
+        float wx2 = rotation.w * x2;
+        float wy2 = rotation.w * y2;
+        float wz2 = rotation.w * z2;
+        float xx2 = rotation.x * x2;
+        float xy2 = rotation.x * y2;
+        float xz2 = rotation.x * z2;
+        float yy2 = rotation.y * y2;
+        float yz2 = rotation.y * z2;
+        float zz2 = rotation.z * z2;
+
+        return float3(value.x * (1.0f - yy2 - zz2) + value.y * (xy2 - wz2) + value.z * (xz2 + wy2),
+                      value.x * (xy2 + wz2) + value.y * (1.0f - xx2 - zz2) + value.z * (yz2 - wx2),
+                      value.x * (xz2 - wy2) + value.y * (yz2 + wx2) + value.z * (1.0f - xx2 - yy2));
     }
 
 
-    inline float4x4 make_float4x4_constrained_billboard(float3 const& objectPosition, float3 const& cameraPosition, float3 const& rotateAxis, float3 const& cameraForwardVector, float3 const& objectForwardVector)
+    inline void transform(_In_reads_(count) float3 const* positions, size_t count, float4x4 const& matrix, _Out_writes_(count) float3* results)
     {
-        const float epsilon = 1e-4f;
-        const float minAngle = 1.0f - (0.1f * (::DirectX::XM_PI / 180.0f)); // 0.1 degrees
+        size_t i = 0;
 
-        // Treat the case when object and camera positions are too close.
-        float3 faceDir = objectPosition - cameraPosition;
-
-        float norm = length_squared(faceDir);
+#ifdef _WINDOWS_NUMERICS_BATCH_SIMD_
+        using namespace ::DirectX;
 
-        if (norm < epsilon)
+        XMVECTOR m11 = XMVectorReplicate(matrix.m11);
+        XMVECTOR m12 = XMVectorReplicate(matrix.m12);
+        XMVECTOR m13 = XMVectorReplicate(matrix.m13);
+        XMVECTOR m21 = XMVectorReplicate(matrix.m21);
+        XMVECTOR m22 = XMVectorReplicate(matrix.m22);
+        XMVECTOR m23 = XMVectorReplicate(matrix.m23);
+        XMVECTOR m31 = XMVectorReplicate(matrix.m31);
+        XMVECTOR m32 = XMVectorReplicate(matrix.m32);
+        XMVECTOR m33 = XMVectorReplicate(matrix.m33);
+        XMVECTOR m41 = XMVectorReplicate(matrix.m41);
+        XMVECTOR m42 = XMVectorReplicate(matrix.m42);
+        XMVECTOR m43 = XMVectorReplicate(matrix.m43);
+
+        for (; i < count - count % 4; i += 4)
         {
-            faceDir = -cameraForwardVector;
+            XMVECTOR x, y, z;
+            details::LoadFloat3x4(positions + i, &x, &y, &z);
+
+            XMVECTOR resultX = XMVectorMultiplyAdd(x, m11, XMVectorMultiplyAdd(y, m21, XMVectorMultiplyAdd(z, m31, m41)));
+            XMVECTOR resultY = XMVectorMultiplyAdd(x, m12, XMVectorMultiplyAdd(y, m22, XMVectorMultiplyAdd(z, m32, m42)));
+            XMVECTOR resultZ = XMVectorMultiplyAdd(x, m13, XMVectorMultiplyAdd(y, m23, XMVectorMultiplyAdd(z, m33, m43)));
+
+            details::StoreFloat3x4(results + i, resultX, resultY, resultZ);
         }
-        else
+#endif
+
+        for (; i < count; i++)
         {
-            faceDir = faceDir / sqrtf(norm);
+            results[i] = transform(positions[i], matrix);
         }
+    }
 
-        float3 yaxis = rotateAxis;
-        float3 xaxis;
-        float3 zaxis;
 
-        // Treat the case when angle between faceDir and rotateAxis is too close to 0.
-        if (fabs(dot(rotateAxis, faceDir)) > minAngle)
-        {
-            zaxis = objectForwardVector;
+    inline void deinterleave(_In_reads_(count) float3 const* values, size_t count, _Out_writes_(count) float* x, _Out_writes_(count) float* y, _Out_writes_(count) float* z)
+    {
+        size_t i = 0;
 
-            if (fabs(dot(rotateAxis, zaxis)) > minAngle)
-            {
-                zaxis = (fabs(rotateAxis.z) > minAngle) ? float3(1, 0, 0) : float3(0, 0, -1);
-            }
+#ifdef _WINDOWS_NUMERICS_BATCH_SIMD_
+        using namespace ::DirectX;
 
-            xaxis = normalize(cross(rotateAxis, zaxis));
-            zaxis = normalize(cross(xaxis, rotateAxis));
-        }
-        else
+        for (; i < count - count % 4; i += 4)
         {
-            xaxis = normalize(cross(rotateAxis, faceDir));
-            zaxis = normalize(cross(xaxis, yaxis));
+            XMVECTOR vx, vy, vz;
+            details::LoadFloat3x4(values + i, &vx, &vy, &vz);
+
+            XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(x + i), vx);
+            XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(y + i), vy);
+            XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(z + i), vz);
         }
+#endif
 
-        return float4x4(xaxis.x,          xaxis.y,          xaxis.z,          0,
-                        yaxis.x,          yaxis.y,          yaxis.z,          0,
-                        zaxis.x,          zaxis.y,          zaxis.z,          0,
-                        objectPosition.x, objectPosition.y, objectPosition.z, 1);
+        for (; i < count; i++)
+        {
+            x[i] = values[i].x;
+            y[i] = values[i].y;
+            z[i] = values[i].z;
+        }
     }
 
 
-    inline float4x4 make_float4x4_translation(float3 const& position)
+    inline void interleave(_In_reads_(count) float const* x, _In_reads_(count) float const* y, _In_reads_(count) float const* z, size_t count, _Out_writes_(count) float3* values)
     {
-        return float4x4(1, 0, 0, 0,
-                        0, 1, 0, 0,
-                        0, 0, 1, 0,
-                        position.x, position.y, position.z, 1);
-    }
-
+        size_t i = 0;
 
-    inline float4x4 make_float4x4_translation(float xPosition, float yPosition, float zPosition)
-    {
-        return float4x4(1, 0, 0, 0,
-                        0, 1, 0, 0,
-                        0, 0, 1, 0,
-                        xPosition, yPosition, zPosition, 1);
-    }
+#ifdef _WINDOWS_NUMERICS_BATCH_SIMD_
+        using namespace ::DirectX;
 
+        for (; i < count - count % 4; i += 4)
+        {
+            details::StoreFloat3x4(values + i,
+                                   XMLoadFloat4(reinterpret_cast<XMFLOAT4 const*>(x + i)),
+                                   XMLoadFloat4(reinterpret_cast<XMFLOAT4 const*>(y + i)),
+                                   XMLoadFloat4(reinterpret_cast<XMFLOAT4 const*>(z + i)));
+        }
+#endif
 
-    inline float4x4 make_float4x4_scale(float xScale, float yScale, float zScale)
-    {
-        return float4x4(xScale, 0,      0,      0,
-                        0,      yScale, 0,      0,
-                        0,      0,      zScale, 0,
-                        0,      0,      0,      1);
+        for (; i < count; i++)
+        {
+            values[i] = float3(x[i], y[i], z[i]);
+        }
     }
 
 
-    inline float4x4 make_float4x4_scale(float xScale, float yScale, float zScale, float3 const& centerPoint)
-    { 
-        float tx = centerPoint.x * (1 - xScale);
-        float ty = centerPoint.y * (1 - yScale);
-        float tz = centerPoint.z * (1 - zScale);
+    inline float4::float4(float x, float y, float z, float w)
+        : x(x), y(y), z(z), w(w)
+    { }
 
-        return float4x4(xScale, 0,      0,      0,
-                        0,      yScale, 0,      0,
-                        0,      0,      zScale, 0,
-                        tx,     ty,     tz,     1);
-    }
 
+    inline float4::float4(float2 value, float z, float w)
+        : x(value.x), y(value.y), z(z), w(w)
+    { }
 
-    inline float4x4 make_float4x4_scale(float3 const& scales)
-    {
-        return float4x4(scales.x, 0,        0,        0,
-                        0,        scales.y, 0,        0,
-                        0,        0,        scales.z, 0,
-                        0,        0,        0,        1);
-    }
 
+    inline float4::float4(float3 value, float w)
+        : x(value.x), y(value.y), z(value.z), w(w)
+    { }
 
-    inline float4x4 make_float4x4_scale(float3 const& scales, float3 const& centerPoint)
-    {
-        float3 t = centerPoint * (float3::one() - scales);
 
-        return float4x4(scales.x, 0,        0,        0,
-                        0,        scales.y, 0,        0,
-                        0,        0,        scales.z, 0,
-                        t.x,      t.y,      t.z,      1);
-    }
+    inline float4::float4(float value)
+        : x(value), y(value), z(value), w(value)
+    { }
 
 
-    inline float4x4 make_float4x4_scale(float scale)
+    inline float4 float4::zero()
     {
-        return float4x4(scale, 0,     0,     0,
-                        0,     scale, 0,     0,
-                        0,     0,     scale, 0,
-                        0,     0,     0,     1);
+        return float4(0, 0, 0, 0);
     }
 
 
-    inline float4x4 make_float4x4_scale(float scale, float3 const& centerPoint)
+    inline float4 float4::one()
     {
-        float3 t = centerPoint * (1 - scale);
-
-        return float4x4(scale, 0,     0,     0,
-                        0,     scale, 0,     0,
-                        0,     0,     scale, 0,
-                        t.x,   t.y,   t.z,   1);
+        return float4(1, 1, 1, 1);
     }
 
 
-    inline float4x4 make_float4x4_rotation_x(float radians)
+    inline float4 float4::unit_x()
     {
-        float c = cosf(radians);
-        float s = sinf(radians);
-
-        return float4x4(1,  0, 0, 0,
-                        0,  c, s, 0,
-                        0, -s, c, 0,
-                        0,  0, 0, 1);
+        return float4(1, 0, 0, 0);
     }
 
 
-    inline float4x4 make_float4x4_rotation_x(float radians, float3 const& centerPoint)
+    inline float4 float4::unit_y()
     {
-        float c = cosf(radians);
-        float s = sinf(radians);
+        return float4(0, 1, 0, 0);
+    }
 
-        float y = centerPoint.y * (1 - c) + centerPoint.z * s;
-        float z = centerPoint.z * (1 - c) - centerPoint.y * s;
 
-        return float4x4(1,  0, 0, 0,
-                        0,  c, s, 0,
-                        0, -s, c, 0,
-                        0,  y, z, 1);
+    inline float4 float4::unit_z()
+    {
+        return float4(0, 0, 1, 0);
     }
 
 
-    inline float4x4 make_float4x4_rotation_y(float radians)
+    inline float4 float4::unit_w()
     {
-        float c = cosf(radians);
-        float s = sinf(radians);
-
-        return float4x4(c, 0, -s, 0,
-                        0, 1,  0, 0,
-                        s, 0,  c, 0,
-                        0, 0,  0, 1);
+        return float4(0, 0, 0, 1);
     }
 
 
-    inline float4x4 make_float4x4_rotation_y(float radians, float3 const& centerPoint)
+    inline float4 operator +(float4 const& value1, float4 const& value2)
     {
-        float c = cosf(radians);
-        float s = sinf(radians);
-
-        float x = centerPoint.x * (1 - c) - centerPoint.z * s;
-        float z = centerPoint.z * (1 - c) + centerPoint.x * s;
+#ifdef WINDOWS_NUMERICS_DISABLE_SIMD
+        return float4(value1.x + value2.x,
+                      value1.y + value2.y,
+                      value1.z + value2.z,
+                      value1.w + value2.w);
+#else
+        using namespace ::DirectX;
 
-        return float4x4(c, 0, -s, 0,
-                        0, 1,  0, 0,
-                        s, 0,  c, 0,
-                        x, 0,  z, 1);
+        float4 result;
+        XMStoreFloat4(&result, XMVectorAdd(XMLoadFloat4(&value1), XMLoadFloat4(&value2)));
+        return result;
+#endif
     }
 
 
-    inline float4x4 make_float4x4_rotation_z(float radians)
+    inline float4 operator -(float4 const& value1, float4 const& value2)
     {
-        float c = cosf(radians);
-        float s = sinf(radians);
-
-        return float4x4( c, s, 0, 0,
-                        -s, c, 0, 0,
-                         0, 0, 1, 0,
-                         0, 0, 0, 1);
+#ifdef WINDOWS_NUMERICS_DISABLE_SIMD
+        return float4(value1.x - value2.x,
+                      value1.y - value2.y,
+                      value1.z - value2.z,
+                      value1.w - value2.w);
+#else
+        using namespace ::DirectX;
+
+        float4 result;
+        XMStoreFloat4(&result, XMVectorSubtract(XMLoadFloat4(&value1), XMLoadFloat4(&value2)));
+        return result;
+#endif
     }
 
 
-    inline float4x4 make_float4x4_rotation_z(float radians, float3 const& centerPoint)
+    inline float4 operator *(float4 const& value1, float4 const& value2)
     {
-        float c = cosf(radians);
-        float s = sinf(radians);
-
-        float x = centerPoint.x * (1 - c) + centerPoint.y * s;
-        float y = centerPoint.y * (1 - c) - centerPoint.x * s;
+#ifdef WINDOWS_NUMERICS_DISABLE_SIMD
+        return float4(value1.x * value2.x,
+                      value1.y * value2.y,
+                      value1.z * value2.z,
+                      value1.w * value2.w);
+#else
+        using namespace ::DirectX;
 
-        return float4x4( c, s, 0, 0,
-                        -s, c, 0, 0,
-                         0, 0, 1, 0,
-                         x, y, 0, 1);
+        float4 result;
+        XMStoreFloat4(&result, XMVectorMultiply(XMLoadFloat4(&value1), XMLoadFloat4(&value2)));
+        return result;
+#endif
     }
 
 
-    inline float4x4 make_float4x4_from_axis_angle(float3 const& axis, float angle)
+    inline float4 operator *(float4 const& value1, float value2)
     {
-        // a: angle
-        // x, y, z: unit vector for axis.
-        //
-        // Rotation matrix M can be computed by below equation.
-        //
-        //  M = uu + (cos a)(I-uu) + (sin a)S
-        //
-        // Where:
-        //
-        //  u = ( x, y, z )
-        //
-        //      [  0 -z  y ]
-        //  S = [  z  0 -x ]
-        //      [ -y  x  0 ]
-        //
-        //      [ 1 0 0 ]
-        //  I = [ 0 1 0 ]
-        //      [ 0 0 1 ]
-
-        float x = axis.x, y = axis.y, z = axis.z;
-        float sa = sinf(angle), ca = cosf(angle);
-        float xx = x * x, yy = y * y, zz = z * z;
-        float xy = x * y, xz = x * z, yz = y * z;
+#ifdef WINDOWS_NUMERICS_DISABLE_SIMD
+        return float4(value1.x * value2,
+                      value1.y * value2,
+                      value1.z * value2,
+                      value1.w * value2);
+#else
+        using namespace ::DirectX;
 
-        return float4x4(xx + ca * (1 - xx),     xy - ca * xy + sa * z,  xz - ca * xz - sa * y,  0,
-                        xy - ca * xy - sa * z,  yy + ca * (1 - yy),     yz - ca * yz + sa * x,  0,
-                        xz - ca * xz + sa * y,  yz - ca * yz - sa * x,  zz + ca * (1 - zz),     0,
-                        0,                      0,                      0,                      1);
+        float4 result;
+        XMStoreFloat4(&result, XMVectorScale(XMLoadFloat4(&value1), value2));
+        return result;
+#endif
     }
 
 
-    inline float4x4 make_float4x4_perspective_field_of_view(float fieldOfView, float aspectRatio, float nearPlaneDistance, float farPlaneDistance)
+    inline float4 operator *(float value1, float4 const& value2)
     {
-        if (fieldOfView <= 0.0f || fieldOfView >= ::DirectX::XM_PI)
-            _WINDOWS_NUMERICS_THROW_(std::invalid_argument("fieldOfView"));
+        return value2 * value1;
+    }
 
-        if (nearPlaneDistance <= 0.0f)
-            _WINDOWS_NUMERICS_THROW_(std::invalid_argument("nearPlaneDistance"));
 
-        if (farPlaneDistance <= 0.0f)
-            _WINDOWS_NUMERICS_THROW_(std::invalid_argument("farPlaneDistance"));
+    inline float4 operator /(float4 const& value1, float4 const& value2)
+    {
+#ifdef WINDOWS_NUMERICS_DISABLE_SIMD
+        return float4(value1.x / value2.x,
+                      value1.y / value2.y,
+                      value1.z / value2.z,
+                      value1.w / value2.w);
+#else
+        using namespace ::DirectX;
 
-        if (nearPlaneDistance >= farPlaneDistance )
-            _WINDOWS_NUMERICS_THROW_(std::invalid_argument("nearPlaneDistance"));
+        float4 result;
+        XMStoreFloat4(&result, XMVectorDivide(XMLoadFloat4(&value1), XMLoadFloat4(&value2)));
+        return result;
+#endif
+    }
 
-        float yScale = 1.0f / tanf(fieldOfView * 0.5f);
-        float xScale = yScale / aspectRatio;
-        float clipDist = nearPlaneDistance - farPlaneDistance;
 
-        return float4x4(xScale, 0,      0,                                                0,
-                        0,      yScale, 0,                                                0,
-                        0,      0,      farPlaneDistance / clipDist,                     -1,
-                        0,      0,      nearPlaneDistance * farPlaneDistance / clipDist,  0);
+    inline float4 operator /(float4 const& value1, float value2)
+    {
+        return value1 * (1.0f / value2);
     }
 
 
-    inline float4x4 make_float4x4_perspective(float width, float height, float nearPlaneDistance, float farPlaneDistance)
+    inline float4 operator -(float4 const& value)
     {
-        if (nearPlaneDistance <= 0.0f)
-            _WINDOWS_NUMERICS_THROW_(std::invalid_argument("nearPlaneDistance"));
+#ifdef WINDOWS_NUMERICS_DISABLE_SIMD
+        return float4(-value.x,
+                      -value.y,
+                      -value.z,
+                      -value.w);
+#else
+        using namespace ::DirectX;
 
-        if (farPlaneDistance <= 0.0f)
-            _WINDOWS_NUMERICS_THROW_(std::invalid_argument("farPlaneDistance"));
+        float4 result;
+        XMStoreFloat4(&result, XMVectorNegate(XMLoadFloat4(&value)));
+        return result;
+#endif
+    }
 
-        if (nearPlaneDistance >= farPlaneDistance)
-            _WINDOWS_NUMERICS_THROW_(std::invalid_argument("nearPlaneDistance"));
 
-        float clipDist = nearPlaneDistance - farPlaneDistance;
+    inline float4& operator +=(float4& value1, float4 const& value2)
+    {
+        value1 = value1 + value2;
 
-        return float4x4(2 * nearPlaneDistance / width, 0,                              0,                                                0,
-                        0,                             2 * nearPlaneDistance / height, 0,                                                0,
-                        0,                             0,                              farPlaneDistance / clipDist,                     -1,
-                        0,                             0,                              nearPlaneDistance * farPlaneDistance / clipDist,  0);
+        return value1;
     }
 
 
-    inline float4x4 make_float4x4_perspective_off_center(float left, float right, float bottom, float top, float nearPlaneDistance, float farPlaneDistance)
+    inline float4& operator -=(float4& value1, float4 const& value2)
     {
-        if (nearPlaneDistance <= 0.0f)
-            _WINDOWS_NUMERICS_THROW_(std::invalid_argument("nearPlaneDistance"));
+        value1 = value1 - value2;
 
-        if (farPlaneDistance <= 0.0f)
-            _WINDOWS_NUMERICS_THROW_(std::invalid_argument("farPlaneDistance"));
+        return value1;
+    }
 
-        if (nearPlaneDistance >= farPlaneDistance)
-            _WINDOWS_NUMERICS_THROW_(std::invalid_argument("nearPlaneDistance"));
 
-        float clipDist = nearPlaneDistance - farPlaneDistance;
+    inline float4& operator *=(float4& value1, float4 const& value2)
+    {
+        value1 = value1 * value2;
 
-        return float4x4(2 * nearPlaneDistance / (right - left), 0,                                      0,                                                0,
-                        0,                                      2 * nearPlaneDistance / (top - bottom), 0,                                                0,
-                        (left + right) / (right - left),        (top + bottom) / (top - bottom),        farPlaneDistance / clipDist,                     -1,
-                        0,                                      0,                                      nearPlaneDistance * farPlaneDistance / clipDist,  0);
+        return value1;
     }
 
 
-    inline float4x4 make_float4x4_orthographic(float width, float height, float zNearPlane, float zFarPlane)
+    inline float4& operator *=(float4& value1, float value2)
     {
-        float clipDist = zNearPlane - zFarPlane;
+        value1 = value1 * value2;
 
-        return float4x4(2 / width, 0,          0,                     0,
-                        0,         2 / height, 0,                     0,
-                        0,         0,          1 / clipDist,          0,
-                        0,         0,          zNearPlane / clipDist, 1);
+        return value1;
     }
 
 
-    inline float4x4 make_float4x4_orthographic_off_center(float left, float right, float bottom, float top, float zNearPlane, float zFarPlane)
+    inline float4& operator /=(float4& value1, float4 const& value2)
     {
-        float clipDist = zNearPlane - zFarPlane;
+        value1 = value1 / value2;
 
-        return float4x4(2 / (right - left),              0,                               0,                     0,
-                        0,                               2 / (top - bottom),              0,                     0,
-                        0,                               0,                               1 / clipDist,          0,
-                        (left + right) / (left - right), (top + bottom) / (bottom - top), zNearPlane / clipDist, 1);
+        return value1;
     }
 
 
-    inline float4x4 make_float4x4_look_at(float3 const& cameraPosition, float3 const& cameraTarget, float3 const& cameraUpVector)
+    inline float4& operator /=(float4& value1, float value2)
     {
-        float3 zaxis = normalize(cameraPosition - cameraTarget);
-        float3 xaxis = normalize(cross(cameraUpVector, zaxis));
-        float3 yaxis = cross(zaxis, xaxis);
+        value1 = value1 / value2;
 
-        return float4x4(xaxis.x,                     yaxis.x,                     zaxis.x,                     0,
-                        xaxis.y,                     yaxis.y,                     zaxis.y,                     0,
-                        xaxis.z,                     yaxis.z,                     zaxis.z,                     0,
-                        -dot(xaxis, cameraPosition), -dot(yaxis, cameraPosition), -dot(zaxis, cameraPosition), 1);
+        return value1;
     }
 
 
-    inline float4x4 make_float4x4_world(float3 const& position, float3 const& forward, float3 const& up)
+    inline bool operator ==(float4 const& value1, float4 const& value2)
     {
-        float3 zaxis = normalize(-forward);
-        float3 xaxis = normalize(cross(up, zaxis));
-        float3 yaxis = cross(zaxis, xaxis);
-
-        return float4x4(xaxis.x,    xaxis.y,    xaxis.z,    0,
-                        yaxis.x,    yaxis.y,    yaxis.z,    0,
-                        zaxis.x,    zaxis.y,    zaxis.z,    0,
-                        position.x, position.y, position.z, 1);
+        return value1.x == value2.x &&
+               value1.y == value2.y &&
+               value1.z == value2.z &&
+               value1.w == value2.w;
     }
 
 
-    inline float4x4 make_float4x4_from_quaternion(quaternion const& quaternion)
+    inline bool operator !=(float4 const& value1, float4 const& value2)
     {
-        float xx = quaternion.x * quaternion.x;
-        float yy = quaternion.y * quaternion.y;
-        float zz = quaternion.z * quaternion.z;
+        return value1.x != value2.x ||
+               value1.y != value2.y ||
+               value1.z != value2.z ||
+               value1.w != value2.w;
+    }
 
-        float xy = quaternion.x * quaternion.y;
-        float wz = quaternion.z * quaternion.w;
-        float xz = quaternion.z * quaternion.x;
-        float wy = quaternion.y * quaternion.w;
-        float yz = quaternion.y * quaternion.z;
-        float wx = quaternion.x * quaternion.w;
 
-        return float4x4(1 - 2 * (yy + zz),  2 * (xy + wz),      2 * (xz - wy),      0,
-                        2 * (xy - wz),      1 - 2 * (zz + xx),  2 * (yz + wx),      0,
-                        2 * (xz + wy),      2 * (yz - wx),      1 - 2 * (yy + xx),  0,
-                        0,                  0,                  0,                  1);
+    inline float length(float4 const& value)
+    {
+#ifdef _WINDOWS_NUMERICS_NEON_
+        float32x4_t v = details::LoadNeon(value);
+        return sqrtf(vgetq_lane_f32(details::SumNeon(vmulq_f32(v, v)), 0));
+#else
+        return sqrtf(length_squared(value));
+#endif
     }
 
 
-    inline float4x4 make_float4x4_from_yaw_pitch_roll(float yaw, float pitch, float roll)
+    inline float length_squared(float4 const& value)
     {
-        quaternion q = make_quaternion_from_yaw_pitch_roll(yaw, pitch, roll);
-
-        return make_float4x4_from_quaternion(q);
+        return dot(value, value);
     }
 
 
-    inline float4x4 make_float4x4_shadow(float3 const& lightDirection, plane const& plane)
+    inline float distance(float4 const& value1, float4 const& value2)
     {
-        auto p = normalize(plane);
-
-        float dot = dot_normal(p, lightDirection);
+        return length(value1 - value2);
+    }
 
-        float a = -p.normal.x;
-        float b = -p.normal.y;
-        float c = -p.normal.z;
-        float d = -p.d;
 
-        return float4x4(a * lightDirection.x + dot,  a * lightDirection.y,        a * lightDirection.z,        0,
-                        b * lightDirection.x,        b * lightDirection.y + dot,  b * lightDirection.z,        0,
-                        c * lightDirection.x,        c * lightDirection.y,        c * lightDirection.z + dot,  0,
-                        d * lightDirection.x,        d * lightDirection.y,        d * lightDirection.z,        dot);
+    inline float distance_squared(float4 const& value1, float4 const& value2)
+    {
+        return length_squared(value1 - value2);
     }
 
 
-    inline float4x4 make_float4x4_reflection(plane const& value)
+    inline float dot(float4 const& vector1, float4 const& vector2)
     {
-        plane v = normalize(value);
-
-        float a = v.normal.x;
-        float b = v.normal.y;
-        float c = v.normal.z;
-
-        float fa = -2 * a;
-        float fb = -2 * b;
-        float fc = -2 * c;
-
-        return float4x4(fa * a + 1,  fb * a,      fc * a,      0,
-                        fa * b,      fb * b + 1,  fc * b,      0,
-                        fa * c,      fb * c,      fc * c + 1,  0,
-                        fa * v.d,    fb * v.d,    fc * v.d,    1);
+        return vector1.x * vector2.x + 
+               vector1.y * vector2.y + 
+               vector1.z * vector2.z + 
+               vector1.w * vector2.w;
     }
 
 
-    inline float4x4 operator +(float4x4 const& value1, float4x4 const& value2)
+    inline float4 normalize(float4 const& value)
     {
-#ifdef WINDOWS_NUMERICS_DISABLE_SIMD
-        return float4x4(value1.m11 + value2.m11,  value1.m12 + value2.m12,  value1.m13 + value2.m13,  value1.m14 + value2.m14,
-                        value1.m21 + value2.m21,  value1.m22 + value2.m22,  value1.m23 + value2.m23,  value1.m24 + value2.m24,
-                        value1.m31 + value2.m31,  value1.m32 + value2.m32,  value1.m33 + value2.m33,  value1.m34 + value2.m34,
-                        value1.m41 + value2.m41,  value1.m42 + value2.m42,  value1.m43 + value2.m43,  value1.m44 + value2.m44);
+#if defined _WINDOWS_NUMERICS_NEON_
+        float32x4_t v = details::LoadNeon(value);
+
+        float4 result;
+        details::StoreNeon(&result, details::DivideBySqrtNeon(v, details::SumNeon(vmulq_f32(v, v))));
+        return result;
+#elif defined WINDOWS_NUMERICS_DISABLE_SIMD
+        return value / length(value);
 #else
         using namespace ::DirectX;
 
-        float4x4 result;
-        XMStoreFloat4x4(&result, XMLoadFloat4x4(&value1) + XMLoadFloat4x4(&value2));
+        float4 result;
+        XMVECTOR v = XMLoadFloat4(&value);
+        XMStoreFloat4(&result, XMVectorDivide(v, XMVector4Length(v)));
         return result;
 #endif
     }
 
 
-    inline float4x4 operator -(float4x4 const& value1, float4x4 const& value2)
+    inline float4 (min)(float4 const& value1, float4 const& value2)
     {
 #ifdef WINDOWS_NUMERICS_DISABLE_SIMD
-        return float4x4(value1.m11 - value2.m11,  value1.m12 - value2.m12,  value1.m13 - value2.m13,  value1.m14 - value2.m14,
-                        value1.m21 - value2.m21,  value1.m22 - value2.m22,  value1.m23 - value2.m23,  value1.m24 - value2.m24,
-                        value1.m31 - value2.m31,  value1.m32 - value2.m32,  value1.m33 - value2.m33,  value1.m34 - value2.m34,
-                        value1.m41 - value2.m41,  value1.m42 - value2.m42,  value1.m43 - value2.m43,  value1.m44 - value2.m44);
+        return float4((value1.x < value2.x) ? value1.x : value2.x,
+                      (value1.y < value2.y) ? value1.y : value2.y,
+                      (value1.z < value2.z) ? value1.z : value2.z,
+                      (value1.w < value2.w) ? value1.w : value2.w);
 #else
         using namespace ::DirectX;
 
-        float4x4 result;
-        XMStoreFloat4x4(&result, XMLoadFloat4x4(&value1) - XMLoadFloat4x4(&value2));
+        float4 result;
+        XMStoreFloat4(&result, XMVectorMin(XMLoadFloat4(&value1), XMLoadFloat4(&value2)));
         return result;
 #endif
     }
 
 
-    inline float4x4 operator *(float4x4 const& value1, float4x4 const& value2)
+    inline float4 (max)(float4 const& value1, float4 const& value2)
     {
 #ifdef WINDOWS_NUMERICS_DISABLE_SIMD
-        return float4x4
-        (
-            // First row
-            value1.m11 * value2.m11 + value1.m12 * value2.m21 + value1.m13 * value2.m31 + value1.m14 * value2.m41,
-            value1.m11 * value2.m12 + value1.m12 * value2.m22 + value1.m13 * value2.m32 + value1.m14 * value2.m42,
-            value1.m11 * value2.m13 + value1.m12 * value2.m23 + value1.m13 * value2.m33 + value1.m14 * value2.m43,
-            value1.m11 * value2.m14 + value1.m12 * value2.m24 + value1.m13 * value2.m34 + value1.m14 * value2.m44,
-
-            // Second row
-            value1.m21 * value2.m11 + value1.m22 * value2.m21 + value1.m23 * value2.m31 + value1.m24 * value2.m41,
-            value1.m21 * value2.m12 + value1.m22 * value2.m22 + value1.m23 * value2.m32 + value1.m24 * value2.m42,
-            value1.m21 * value2.m13 + value1.m22 * value2.m23 + value1.m23 * value2.m33 + value1.m24 * value2.m43,
-            value1.m21 * value2.m14 + value1.m22 * value2.m24 + value1.m23 * value2.m34 + value1.m24 * value2.m44,
-
-            // Third row
-            value1.m31 * value2.m11 + value1.m32 * value2.m21 + value1.m33 * value2.m31 + value1.m34 * value2.m41,
-            value1.m31 * value2.m12 + value1.m32 * value2.m22 + value1.m33 * value2.m32 + value1.m34 * value2.m42,
-            value1.m31 * value2.m13 + value1.m32 * value2.m23 + value1.m33 * value2.m33 + value1.m34 * value2.m43,
-            value1.m31 * value2.m14 + value1.m32 * value2.m24 + value1.m33 * value2.m34 + value1.m34 * value2.m44,
-
-            // Fourth row
-            value1.m41 * value2.m11 + value1.m42 * value2.m21 + value1.m43 * value2.m31 + value1.m44 * value2.m41,
-            value1.m41 * value2.m12 + value1.m42 * value2.m22 + value1.m43 * value2.m32 + value1.m44 * value2.m42,
-            value1.m41 * value2.m13 + value1.m42 * value2.m23 + value1.m43 * value2.m33 + value1.m44 * value2.m43,
-            value1.m41 * value2.m14 + value1.m42 * value2.m24 + value1.m43 * value2.m34 + value1.m44 * value2.m44
-        );
+        return float4((value1.x > value2.x) ? value1.x : value2.x,
+                      (value1.y > value2.y) ? value1.y : value2.y,
+                      (value1.z > value2.z) ? value1.z : value2.z,
+                      (value1.w > value2.w) ? value1.w : value2.w);
 #else
         using namespace ::DirectX;
 
-        float4x4 result;
-        XMStoreFloat4x4(&result, XMMatrixMultiply(XMLoadFloat4x4(&value1), XMLoadFloat4x4(&value2)));
+        float4 result;
+        XMStoreFloat4(&result, XMVectorMax(XMLoadFloat4(&value1), XMLoadFloat4(&value2)));
         return result;
 #endif
     }
 
 
-    inline float4x4 operator *(float4x4 const& value1, float value2)
+    inline float4 clamp(float4 const& value1, float4 const& minValue, float4 const& maxValue)
     {
-#ifdef WINDOWS_NUMERICS_DISABLE_SIMD
-        return float4x4(value1.m11 * value2,  value1.m12 * value2,  value1.m13 * value2,  value1.m14 * value2,
-                        value1.m21 * value2,  value1.m22 * value2,  value1.m23 * value2,  value1.m24 * value2,
-                        value1.m31 * value2,  value1.m32 * value2,  value1.m33 * value2,  value1.m34 * value2,
-                        value1.m41 * value2,  value1.m42 * value2,  value1.m43 * value2,  value1.m44 * value2);
-#else
-        using namespace ::DirectX;
+        return (max)((min)(value1, maxValue), minValue);
+    }
 
-        float4x4 result;
-        XMStoreFloat4x4(&result, XMLoadFloat4x4(&value1) * value2);
-        return result;
-#endif
+
+    inline float4 lerp(float4 const& value1, float4 const& value2, float amount)
+    {
+        return value1 + (value2 - value1) * amount;
     }
 
 
-    inline float4x4 operator -(float4x4 const& value)
+    inline float4 transform(float4 const& vector, float4x4 const& matrix)
     {
 #ifdef WINDOWS_NUMERICS_DISABLE_SIMD
-        return float4x4(-value.m11, -value.m12, -value.m13, -value.m14,
-                        -value.m21, -value.m22, -value.m23, -value.m24,
-                        -value.m31, -value.m32, -value.m33, -value.m34,
-                        -value.m41, -value.m42, -value.m43, -value.m44);
+        return float4(vector.x * matrix.m11 + vector.y * matrix.m21 + vector.z * matrix.m31 + vector.w * matrix.m41,
+                      vector.x * matrix.m12 + vector.y * matrix.m22 + vector.z * matrix.m32 + vector.w * matrix.m42,
+                      vector.x * matrix.m13 + vector.y * matrix.m23 + vector.z * matrix.m33 + vector.w * matrix.m43,
+                      vector.x * matrix.m14 + vector.y * matrix.m24 + vector.z * matrix.m34 + vector.w * matrix.m44);
 #else
         using namespace ::DirectX;
 
-        float4x4 result;
-        XMStoreFloat4x4(&result, -XMLoadFloat4x4(&value));
+        float4 result;
+        XMStoreFloat4(&result, XMVector4Transform(XMLoadFloat4(&vector), XMLoadFloat4x4(&matrix)));
         return result;
 #endif
     }
 
 
-    inline float4x4& operator +=(float4x4& value1, float4x4 const& value2)
+    inline float4 transform4(float3 const& position, float4x4 const& matrix)
     {
-        value1 = value1 + value2;
+        return float4(position.x * matrix.m11 + position.y * matrix.m21 + position.z * matrix.m31 + matrix.m41,
+                      position.x * matrix.m12 + position.y * matrix.m22 + position.z * matrix.m32 + matrix.m42,
+                      position.x * matrix.m13 + position.y * matrix.m23 + position.z * matrix.m33 + matrix.m43,
+                      position.x * matrix.m14 + position.y * matrix.m24 + position.z * matrix.m34 + matrix.m44);
+    }
 
-        return value1;
+
+    inline float4 transform4(float2 const& position, float4x4 const& matrix)
+    {
+        return float4(position.x * matrix.m11 + position.y * matrix.m21 + matrix.m41,
+                      position.x * matrix.m12 + position.y * matrix.m22 + matrix.m42,
+                      position.x * matrix.m13 + position.y * matrix.m23 + matrix.m43,
+                      position.x * matrix.m14 + position.y * matrix.m24 + matrix.m44);
     }
 
 
-    inline float4x4& operator -=(float4x4& value1, float4x4 const& value2)
+    inline float4 transform(float4 const& value, quaternion const& rotation)
     {
-        value1 = value1 - value2;
+        float x2 = rotation.x + rotation.x;
+        float y2 = rotation.y + rotation.y;
+        float z2 = rotation.z + rotation.z;
 
-        return value1;
+        float wx2 = rotation.w * x2;
+        float wy2 = rotation.w * y2;
+        float wz2 = rotation.w * z2;
+        float xx2 = rotation.x * x2;
+        float xy2 = rotation.x * y2;
+        float xz2 = rotation.x * z2;
+        float yy2 = rotation.y * y2;
+        float yz2 = rotation.y * z2;
+        float zz2 = rotation.z * z2;
+
+        return float4(value.x * (1.0f - yy2 - zz2) + value.y * (       xy2 - wz2) + value.z * (       xz2 + wy2),
+                      value.x * (       xy2 + wz2) + value.y * (1.0f - xx2 - zz2) + value.z * (       yz2 - wx2),
+                      value.x * (       xz2 - wy2) + value.y * (       yz2 + wx2) + value.z * (1.0f - xx2 - yy2),
+                      value.w);
     }
 
 
-    inline float4x4& operator *=(float4x4& value1, float4x4 const& value2)
+    inline float4 transform4(float3 const& value, quaternion const& rotation)
     {
-        value1 = value1 * value2;
+        float x2 = rotation.x + rotation.x;
+        float y2 = rotation.y + rotation.y;
+        float z2 = rotation.z + rotation.z;
 
-        return value1;
+        float wx2 = rotation.w * x2;
+        float wy2 = rotation.w * y2;
+        float wz2 = rotation.w * z2;
+        float xx2 = rotation.x * x2;
+        float xy2 = rotation.x * y2;
+        float xz2 = rotation.x * z2;
+        float yy2 = rotation.y * y2;
+        float yz2 = rotation.y * z2;
+        float zz2 = rotation.z * z2;
+
+        return float4(value.x * (1.0f - yy2 - zz2) + value.y * (       xy2 - wz2) + value.z * (       xz2 + wy2),
+                      value.x * (       xy2 + wz2) + value.y * (1.0f - xx2 - zz2) + value.z * (       yz2 - wx2),
+                      value.x * (       xz2 - wy2) + value.y * (       yz2 + wx2) + value.z * (1.0f - xx2 - yy2),
+                      1.0f);
     }
 
 
-    inline float4x4& operator *=(float4x4& value1, float value2)
+    inline float4 transform4(float2 const& value, quaternion const& rotation)
     {
-        value1 = value1 * value2;
+        float x2 = rotation.x + rotation.x;
+        float y2 = rotation.y + rotation.y;
+        float z2 = rotation.z + rotation.z;
 
-        return value1;
+        float wx2 = rotation.w * x2;
+        float wy2 = rotation.w * y2;
+        float wz2 = rotation.w * z2;
+        float xx2 = rotation.x * x2;
+        float xy2 = rotation.x * y2;
+        float xz2 = rotation.x * z2;
+        float yy2 = rotation.y * y2;
+        float yz2 = rotation.y * z2;
+        float zz2 = rotation.z * z2;
+
+        return float4(value.x * (1.0f - yy2 - zz2) + value.y * (       xy2 - wz2),
+                      value.x * (       xy2 + wz2) + value.y * (1.0f - xx2 - zz2),
+                      value.x * (       xz2 - wy2) + value.y * (       yz2 + wx2),
+                      1.0f);
     }
 
 
-    inline bool operator ==(float4x4 const& value1, float4x4 const& value2)
+    inline void transform(_In_reads_(count) float4 const* vectors, size_t count, float4x4 const& matrix, _Out_writes_(count) float4* results)
     {
-        return value1.m11 == value2.m11 && value1.m22 == value2.m22 && value1.m33 == value2.m33 && value1.m44 == value2.m44 && // Check diagonal element first for early out.
-                                           value1.m12 == value2.m12 && value1.m13 == value2.m13 && value1.m14 == value2.m14 &&
-               value1.m21 == value2.m21                             && value1.m23 == value2.m23 && value1.m24 == value2.m24 &&
-               value1.m31 == value2.m31 && value1.m32 == value2.m32                             && value1.m34 == value2.m34 &&
-               value1.m41 == value2.m41 && value1.m42 == value2.m42 && value1.m43 == value2.m43;
+#ifdef _WINDOWS_NUMERICS_AVX2_
+        if (details::UseAvx2())
+        {
+            details::TransformAvx2(vectors, count, matrix, results);
+            return;
+        }
+#endif
+
+#ifdef _WINDOWS_NUMERICS_BATCH_SIMD_
+        using namespace ::DirectX;
+
+        // Each float4 already fills a SIMD register, so rather than transposing we
+        // just keep the matrix loaded for the duration of the loop.
+        XMMATRIX m = XMLoadFloat4x4(&matrix);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            XMStoreFloat4(&results[i], XMVector4Transform(XMLoadFloat4(&vectors[i]), m));
+        }
+#else
+        for (size_t i = 0; i < count; i++)
+        {
+            results[i] = transform(vectors[i], matrix);
+        }
+#endif
     }
 
 
-    inline bool operator !=(float4x4 const& value1, float4x4 const& value2)
+    inline void deinterleave(_In_reads_(count) float4 const* values, size_t count, _Out_writes_(count) float* x, _Out_writes_(count) float* y, _Out_writes_(count) float* z, _Out_writes_(count) float* w)
     {
-        return value1.m11 != value2.m11 || value1.m12 != value2.m12 || value1.m13 != value2.m13 || value1.m14 != value2.m14 ||
-               value1.m21 != value2.m21 || value1.m22 != value2.m22 || value1.m23 != value2.m23 || value1.m24 != value2.m24 ||
-               value1.m31 != value2.m31 || value1.m32 != value2.m32 || value1.m33 != value2.m33 || value1.m34 != value2.m34 ||
-               value1.m41 != value2.m41 || value1.m42 != value2.m42 || value1.m43 != value2.m43 || value1.m44 != value2.m44;
+        size_t i = 0;
+
+#ifdef _WINDOWS_NUMERICS_BATCH_SIMD_
+        using namespace ::DirectX;
+
+        for (; i < count - count % 4; i += 4)
+        {
+            XMVECTOR vx, vy, vz, vw;
+            details::LoadFloat4x4(values + i, &vx, &vy, &vz, &vw);
+
+            XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(x + i), vx);
+            XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(y + i), vy);
+            XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(z + i), vz);
+            XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(w + i), vw);
+        }
+#endif
+
+        for (; i < count; i++)
+        {
+            x[i] = values[i].x;
+            y[i] = values[i].y;
+            z[i] = values[i].z;
+            w[i] = values[i].w;
+        }
     }
 
 
-    inline bool is_identity(float4x4 const& value)
+    inline void interleave(_In_reads_(count) float const* x, _In_reads_(count) float const* y, _In_reads_(count) float const* z, _In_reads_(count) float const* w, size_t count, _Out_writes_(count) float4* values)
     {
-        return value.m11 == 1 && value.m22 == 1 && value.m33 == 1 && value.m44 == 1 && // Check diagonal element first for early out.
-                                 value.m12 == 0 && value.m13 == 0 && value.m14 == 0 &&
-               value.m21 == 0                   && value.m23 == 0 && value.m24 == 0 &&
-               value.m31 == 0 && value.m32 == 0                   && value.m34 == 0 &&
-               value.m41 == 0 && value.m42 == 0 && value.m43 == 0;
+        size_t i = 0;
+
+#ifdef _WINDOWS_NUMERICS_BATCH_SIMD_
+        using namespace ::DirectX;
+
+        for (; i < count - count % 4; i += 4)
+        {
+            details::StoreFloat4x4(values + i,
+                                   XMLoadFloat4(reinterpret_cast<XMFLOAT4 const*>(x + i)),
+                                   XMLoadFloat4(reinterpret_cast<XMFLOAT4 const*>(y + i)),
+                                   XMLoadFloat4(reinterpret_cast<XMFLOAT4 const*>(z + i)),
+                                   XMLoadFloat4(reinterpret_cast<XMFLOAT4 const*>(w + i)));
+        }
+#endif
+
+        for (; i < count; i++)
+        {
+            values[i] = float4(x[i], y[i], z[i], w[i]);
+        }
     }
 
 
-    inline float determinant(float4x4 const& value)
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2::float3x2(float m11, float m12, float m21, float m22, float m31, float m32)
+        : m11(m11), m12(m12), m21(m21), m22(m22), m31(m31), m32(m32)
+    { }
+
+
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 float3x2::identity()
     {
-        // | a b c d |     | f g h |     | e g h |     | e f h |     | e f g |
-        // | e f g h | = a | j k l | - b | i k l | + c | i j l | - d | i j k |
-        // | i j k l |     | n o p |     | m o p |     | m n p |     | m n o |
-        // | m n o p |
-        //
-        //   | f g h |
-        // a | j k l | = a ( f ( kp - lo ) - g ( jp - ln ) + h ( jo - kn ) )
+        return float3x2(1, 0,
+                        0, 1,
+                        0, 0);
+    }
+
+
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 make_float3x2_translation(float2 const& position)
+    {
+        return float3x2(1, 0,
+                        0, 1,
+                        position.x, position.y);
+    }
+
+
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 make_float3x2_translation(float xPosition, float yPosition)
+    {
+        return float3x2(1, 0,
+                        0, 1,
+                        xPosition, yPosition);
+    }
+
+
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 make_float3x2_scale(float xScale, float yScale)
+    {
+        return float3x2(xScale, 0,
+                        0,      yScale,
+                        0,      0);
+    }
+
+
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 make_float3x2_scale(float xScale, float yScale, float2 const& centerPoint)
+    {
+        return float3x2(xScale,                        0,
+                        0,                             yScale,
+                        centerPoint.x * (1 - xScale),  centerPoint.y * (1 - yScale));
+    }
+
+
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 make_float3x2_scale(float2 const& scales)
+    {
+        return float3x2(scales.x, 0,
+                        0,        scales.y,
+                        0,        0);
+    }
+
+
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 make_float3x2_scale(float2 const& scales, float2 const& centerPoint)
+    {
+        return float3x2(scales.x,                          0,
+                        0,                                 scales.y,
+                        centerPoint.x * (1 - scales.x),    centerPoint.y * (1 - scales.y));
+    }
+
+
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 make_float3x2_scale(float scale)
+    {
+        return float3x2(scale, 0,
+                        0,     scale,
+                        0,     0);
+    }
+
+
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 make_float3x2_scale(float scale, float2 const& centerPoint)
+    {
+        return float3x2(scale,                         0,
+                        0,                             scale,
+                        centerPoint.x * (1 - scale),   centerPoint.y * (1 - scale));
+    }
+
+
+    inline float3x2 make_float3x2_skew(float radiansX, float radiansY)
+    {
+        float xTan = tanf(radiansX);
+        float yTan = tanf(radiansY);
+
+        return float3x2(1,    yTan,
+                        xTan, 1,
+                        0,    0);
+    }
+
+
+    inline float3x2 make_float3x2_skew(float radiansX, float radiansY, float2 const& centerPoint)
+    {
+        float xTan = tanf(radiansX);
+        float yTan = tanf(radiansY);
+
+        float tx = -centerPoint.y * xTan;
+        float ty = -centerPoint.x * yTan;
+
+        return float3x2(1,    yTan,
+                        xTan, 1,
+                        tx,   ty);
+    }
+
+
+    inline float3x2 make_float3x2_rotation(float radians)
+    {
+        return make_float3x2_rotation(radians, float2::zero());
+    }
+
+
+    inline float3x2 make_float3x2_rotation(float radians, float2 const& centerPoint)
+    {
+        radians = fmodf(radians, ::DirectX::XM_2PI);
+
+        if (radians < 0)
+            radians += ::DirectX::XM_2PI;
+
+        float c, s;
+
+        const float epsilon = 0.001f * ::DirectX::XM_PI / 180.0f;     // 0.1% of a degree
+
+        if (radians < epsilon || radians > ::DirectX::XM_2PI - epsilon)
+        {
+            // Exact case for zero rotation.
+            c = 1;
+            s = 0;
+        }
+        else if (radians > ::DirectX::XM_PIDIV2 - epsilon && radians < ::DirectX::XM_PIDIV2 + epsilon)
+        {
+            // Exact case for 90 degree rotation.
+            c = 0;
+            s = 1;
+        }
+        else if (radians > ::DirectX::XM_PI - epsilon && radians < ::DirectX::XM_PI + epsilon)
+        {
+            // Exact case for 180 degree rotation.
+            c = -1;
+            s = 0;
+        }
+        else if (radians > ::DirectX::XM_PI + ::DirectX::XM_PIDIV2 - epsilon && radians < ::DirectX::XM_PI + ::DirectX::XM_PIDIV2 + epsilon)
+        {
+            // Exact case for 270 degree rotation.
+            c = 0;
+            s = -1;
+        }
+        else
+        {
+            // Arbitrary rotation.
+            c = cosf(radians);
+            s = sinf(radians);
+        }
+
+        float x = centerPoint.x * (1 - c) + centerPoint.y * s;
+        float y = centerPoint.y * (1 - c) - centerPoint.x * s;
+
+        return float3x2( c, s,
+                        -s, c,
+                         x, y);
+    }
+
+
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 operator +(float3x2 const& value1, float3x2 const& value2)
+    {
+        return float3x2(value1.m11 + value2.m11,  value1.m12 + value2.m12,
+                        value1.m21 + value2.m21,  value1.m22 + value2.m22,
+                        value1.m31 + value2.m31,  value1.m32 + value2.m32);
+    }
+
+
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 operator -(float3x2 const& value1, float3x2 const& value2)
+    {
+        return float3x2(value1.m11 - value2.m11,  value1.m12 - value2.m12,
+                        value1.m21 - value2.m21,  value1.m22 - value2.m22,
+                        value1.m31 - value2.m31,  value1.m32 - value2.m32);
+    }
+
+
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 operator *(float3x2 const& value1, float3x2 const& value2)
+    {
+        return float3x2
+        (
+            // First row
+            value1.m11 * value2.m11 + value1.m12 * value2.m21,
+            value1.m11 * value2.m12 + value1.m12 * value2.m22,
+            
+            // Second row
+            value1.m21 * value2.m11 + value1.m22 * value2.m21,
+            value1.m21 * value2.m12 + value1.m22 * value2.m22,
+            
+            // Third row
+            value1.m31 * value2.m11 + value1.m32 * value2.m21 + value2.m31,
+            value1.m31 * value2.m12 + value1.m32 * value2.m22 + value2.m32
+        );
+    }
+
+
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 operator *(float3x2 const& value1, float value2)
+    {
+        return float3x2(value1.m11 * value2,  value1.m12 * value2,
+                        value1.m21 * value2,  value1.m22 * value2,
+                        value1.m31 * value2,  value1.m32 * value2);
+    }
+
+
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 operator -(float3x2 const& value)
+    {
+        return float3x2(-value.m11, -value.m12,
+                        -value.m21, -value.m22,
+                        -value.m31, -value.m32);
+    }
+
+
+    inline float3x2& operator +=(float3x2& value1, float3x2 const& value2)
+    {
+        value1 = value1 + value2;
+
+        return value1;
+    }
+
+
+    inline float3x2& operator -=(float3x2& value1, float3x2 const& value2)
+    {
+        value1 = value1 - value2;
+
+        return value1;
+    }
+
+
+    inline float3x2& operator *=(float3x2& value1, float3x2 const& value2)
+    {
+        value1 = value1 * value2;
+
+        return value1;
+    }
+
+
+    inline float3x2& operator *=(float3x2& value1, float value2)
+    {
+        value1 = value1 * value2;
+
+        return value1;
+    }
+
+
+    _WINDOWS_NUMERICS_CONSTEXPR_ bool operator ==(float3x2 const& value1, float3x2 const& value2)
+    {
+        return value1.m11 == value2.m11 && value1.m22 == value2.m22 && // Check diagonal element first for early out.
+                                           value1.m12 == value2.m12 &&
+               value1.m21 == value2.m21                             &&
+               value1.m31 == value2.m31 && value1.m32 == value2.m32;
+    }
+
+
+    _WINDOWS_NUMERICS_CONSTEXPR_ bool operator !=(float3x2 const& value1, float3x2 const& value2)
+    {
+        return value1.m11 != value2.m11 || value1.m12 != value2.m12 ||
+               value1.m21 != value2.m21 || value1.m22 != value2.m22 ||
+               value1.m31 != value2.m31 || value1.m32 != value2.m32;
+    }
+
+
+    _WINDOWS_NUMERICS_CONSTEXPR_ bool is_identity(float3x2 const& value)
+    {
+        return value.m11 == 1 && value.m22 == 1 && // Check diagonal element first for early out.
+                                 value.m12 == 0 &&
+               value.m21 == 0                   &&
+               value.m31 == 0 && value.m32 == 0;
+    }
+
+
+    _WINDOWS_NUMERICS_CONSTEXPR_ float determinant(float3x2 const& value)
+    {
+        return (value.m11 * value.m22) - (value.m21 * value.m12);
+    }
+
+
+    _WINDOWS_NUMERICS_CONSTEXPR_ float2 translation(float3x2 const& value)
+    {
+        return float2(value.m31, value.m32);
+    }
+
+
+    inline bool invert(float3x2 const& matrix, _Out_ float3x2* result)
+    {
+        float det = determinant(matrix);
+
+        if (fabs(det) < FLT_EPSILON)
+        {
+            const float nan = _WINDOWS_NUMERICS_NAN_;
+            *result = float3x2(nan, nan, nan, nan, nan, nan);
+            return false;
+        }
+
+        float invDet = 1.0f / det;
+
+        *result = float3x2
+        (
+            // First row
+            matrix.m22 * invDet,
+            -matrix.m12 * invDet,
+
+            // Second row
+            -matrix.m21 * invDet,
+            matrix.m11 * invDet,
+
+            // Third row
+            (matrix.m21 * matrix.m32 - matrix.m31 * matrix.m22) * invDet,
+            (matrix.m31 * matrix.m12 - matrix.m11 * matrix.m32) * invDet
+        );
+
+        return true;
+    }
+
+
+    inline float3x2 lerp(float3x2 const& matrix1, float3x2 const& matrix2, float amount)
+    {
+        return matrix1 + (matrix2 - matrix1) * amount;
+    }
+
+
+    inline float4x4::float4x4(float m11, float m12, float m13, float m14, float m21, float m22, float m23, float m24, float m31, float m32, float m33, float m34, float m41, float m42, float m43, float m44)
+        : m11(m11), m12(m12), m13(m13), m14(m14),
+          m21(m21), m22(m22), m23(m23), m24(m24),
+          m31(m31), m32(m32), m33(m33), m34(m34),
+          m41(m41), m42(m42), m43(m43), m44(m44)
+    { }
+
+
+    inline float4x4::float4x4(float3x2 value)
+        : m11(value.m11), m12(value.m12), m13(0), m14(0),
+          m21(value.m21), m22(value.m22), m23(0), m24(0),
+          m31(0),         m32(0),         m33(1), m34(0),
+          m41(value.m31), m42(value.m32), m43(0), m44(1)
+    { }
+
+
+    inline float4x4 float4x4::identity()
+    {
+        return float4x4(1, 0, 0, 0,
+                        0, 1, 0, 0,
+                        0, 0, 1, 0,
+                        0, 0, 0, 1);
+    }
+
+
+    inline float4x4 make_float4x4_billboard(float3 const& objectPosition, float3 const& cameraPosition, float3 const& cameraUpVector, float3 const& cameraForwardVector)
+    {
+        const float epsilon = 1e-4f;
+
+        float3 zaxis = objectPosition - cameraPosition;
+
+        float norm = length_squared(zaxis);
+
+        if (norm < epsilon)
+        {
+            zaxis = -cameraForwardVector;
+        }
+        else
+        {
+            zaxis = zaxis / sqrtf(norm);
+        }
+
+        float3 xaxis = normalize(cross(cameraUpVector, zaxis));
+
+        float3 yaxis = cross(zaxis, xaxis);
+
+        return float4x4(xaxis.x,          xaxis.y,          xaxis.z,          0,
+                        yaxis.x,          yaxis.y,          yaxis.z,          0,
+                        zaxis.x,          zaxis.y,          zaxis.z,          0,
+                        objectPosition.x, objectPosition.y, objectPosition.z, 1);
+    }
+
+
+    inline float4x4 make_float4x4_constrained_billboard(float3 const& objectPosition, float3 const& cameraPosition, float3 const& rotateAxis, float3 const& cameraForwardVector, float3 const& objectForwardVector)
+    {
+        const float epsilon = 1e-4f;
+        const float minAngle = 1.0f - (0.1f * (::DirectX::XM_PI / 180.0f)); // 0.1 degrees
+
+        // Treat the case when object and camera positions are too close.
+        float3 faceDir = objectPosition - cameraPosition;
+
+        float norm = length_squared(faceDir);
+
+        if (norm < epsilon)
+        {
+            faceDir = -cameraForwardVector;
+        }
+        else
+        {
+            faceDir = faceDir / sqrtf(norm);
+        }
+
+        float3 yaxis = rotateAxis;
+        float3 xaxis;
+        float3 zaxis;
+
+        // Treat the case when angle between faceDir and rotateAxis is too close to 0.
+        if (fabs(dot(rotateAxis, faceDir)) > minAngle)
+        {
+            zaxis = objectForwardVector;
+
+            if (fabs(dot(rotateAxis, zaxis)) > minAngle)
+            {
+                zaxis = (fabs(rotateAxis.z) > minAngle) ? float3(1, 0, 0) : float3(0, 0, -1);
+            }
+
+            xaxis = normalize(cross(rotateAxis, zaxis));
+            zaxis = normalize(cross(xaxis, rotateAxis));
+        }
+        else
+        {
+            xaxis = normalize(cross(rotateAxis, faceDir));
+            zaxis = normalize(cross(xaxis, yaxis));
+        }
+
+        return float4x4(xaxis.x,          xaxis.y,          xaxis.z,          0,
+                        yaxis.x,          yaxis.y,          yaxis.z,          0,
+                        zaxis.x,          zaxis.y,          zaxis.z,          0,
+                        objectPosition.x, objectPosition.y, objectPosition.z, 1);
+    }
+
+
+    inline float4x4 make_float4x4_translation(float3 const& position)
+    {
+        return float4x4(1, 0, 0, 0,
+                        0, 1, 0, 0,
+                        0, 0, 1, 0,
+                        position.x, position.y, position.z, 1);
+    }
+
+
+    inline float4x4 make_float4x4_translation(float xPosition, float yPosition, float zPosition)
+    {
+        return float4x4(1, 0, 0, 0,
+                        0, 1, 0, 0,
+                        0, 0, 1, 0,
+                        xPosition, yPosition, zPosition, 1);
+    }
+
+
+    inline float4x4 make_float4x4_scale(float xScale, float yScale, float zScale)
+    {
+        return float4x4(xScale, 0,      0,      0,
+                        0,      yScale, 0,      0,
+                        0,      0,      zScale, 0,
+                        0,      0,      0,      1);
+    }
+
+
+    inline float4x4 make_float4x4_scale(float xScale, float yScale, float zScale, float3 const& centerPoint)
+    { 
+        float tx = centerPoint.x * (1 - xScale);
+        float ty = centerPoint.y * (1 - yScale);
+        float tz = centerPoint.z * (1 - zScale);
+
+        return float4x4(xScale, 0,      0,      0,
+                        0,      yScale, 0,      0,
+                        0,      0,      zScale, 0,
+                        tx,     ty,     tz,     1);
+    }
+
+
+    inline float4x4 make_float4x4_scale(float3 const& scales)
+    {
+        return float4x4(scales.x, 0,        0,        0,
+                        0,        scales.y, 0,        0,
+                        0,        0,        scales.z, 0,
+                        0,        0,        0,        1);
+    }
+
+
+    inline float4x4 make_float4x4_scale(float3 const& scales, float3 const& centerPoint)
+    {
+        float3 t = centerPoint * (float3::one() - scales);
+
+        return float4x4(scales.x, 0,        0,        0,
+                        0,        scales.y, 0,        0,
+                        0,        0,        scales.z, 0,
+                        t.x,      t.y,      t.z,      1);
+    }
+
+
+    inline float4x4 make_float4x4_scale(float scale)
+    {
+        return float4x4(scale, 0,     0,     0,
+                        0,     scale, 0,     0,
+                        0,     0,     scale, 0,
+                        0,     0,     0,     1);
+    }
+
+
+    inline float4x4 make_float4x4_scale(float scale, float3 const& centerPoint)
+    {
+        float3 t = centerPoint * (1 - scale);
+
+        return float4x4(scale, 0,     0,     0,
+                        0,     scale, 0,     0,
+                        0,     0,     scale, 0,
+                        t.x,   t.y,   t.z,   1);
+    }
+
+
+    inline float4x4 make_float4x4_rotation_x(float radians)
+    {
+        float c = cosf(radians);
+        float s = sinf(radians);
+
+        return float4x4(1,  0, 0, 0,
+                        0,  c, s, 0,
+                        0, -s, c, 0,
+                        0,  0, 0, 1);
+    }
+
+
+    inline float4x4 make_float4x4_rotation_x(float radians, float3 const& centerPoint)
+    {
+        float c = cosf(radians);
+        float s = sinf(radians);
+
+        float y = centerPoint.y * (1 - c) + centerPoint.z * s;
+        float z = centerPoint.z * (1 - c) - centerPoint.y * s;
+
+        return float4x4(1,  0, 0, 0,
+                        0,  c, s, 0,
+                        0, -s, c, 0,
+                        0,  y, z, 1);
+    }
+
+
+    inline float4x4 make_float4x4_rotation_y(float radians)
+    {
+        float c = cosf(radians);
+        float s = sinf(radians);
+
+        return float4x4(c, 0, -s, 0,
+                        0, 1,  0, 0,
+                        s, 0,  c, 0,
+                        0, 0,  0, 1);
+    }
+
+
+    inline float4x4 make_float4x4_rotation_y(float radians, float3 const& centerPoint)
+    {
+        float c = cosf(radians);
+        float s = sinf(radians);
+
+        float x = centerPoint.x * (1 - c) - centerPoint.z * s;
+        float z = centerPoint.z * (1 - c) + centerPoint.x * s;
+
+        return float4x4(c, 0, -s, 0,
+                        0, 1,  0, 0,
+                        s, 0,  c, 0,
+                        x, 0,  z, 1);
+    }
+
+
+    inline float4x4 make_float4x4_rotation_z(float radians)
+    {
+        float c = cosf(radians);
+        float s = sinf(radians);
+
+        return float4x4( c, s, 0, 0,
+                        -s, c, 0, 0,
+                         0, 0, 1, 0,
+                         0, 0, 0, 1);
+    }
+
+
+    inline float4x4 make_float4x4_rotation_z(float radians, float3 const& centerPoint)
+    {
+        float c = cosf(radians);
+        float s = sinf(radians);
+
+        float x = centerPoint.x * (1 - c) + centerPoint.y * s;
+        float y = centerPoint.y * (1 - c) - centerPoint.x * s;
+
+        return float4x4( c, s, 0, 0,
+                        -s, c, 0, 0,
+                         0, 0, 1, 0,
+                         x, y, 0, 1);
+    }
+
+
+    inline float4x4 make_float4x4_from_axis_angle(float3 const& axis, float angle)
+    {
+        // a: angle
+        // x, y, z: unit vector for axis.
+        //
+        // Rotation matrix M can be computed by below equation.
+        //
+        //  M = uu + (cos a)(I-uu) + (sin a)S
+        //
+        // Where:
+        //
+        //  u = ( x, y, z )
+        //
+        //      [  0 -z  y ]
+        //  S = [  z  0 -x ]
+        //      [ -y  x  0 ]
+        //
+        //      [ 1 0 0 ]
+        //  I = [ 0 1 0 ]
+        //      [ 0 0 1 ]
+
+        float x = axis.x, y = axis.y, z = axis.z;
+        float sa = sinf(angle), ca = cosf(angle);
+        float xx = x * x, yy = y * y, zz = z * z;
+        float xy = x * y, xz = x * z, yz = y * z;
+
+        return float4x4(xx + ca * (1 - xx),     xy - ca * xy + sa * z,  xz - ca * xz - sa * y,  0,
+                        xy - ca * xy - sa * z,  yy + ca * (1 - yy),     yz - ca * yz + sa * x,  0,
+                        xz - ca * xz + sa * y,  yz - ca * yz - sa * x,  zz + ca * (1 - zz),     0,
+                        0,                      0,                      0,                      1);
+    }
+
+
+    inline float4x4 make_float4x4_perspective_field_of_view(float fieldOfView, float aspectRatio, float nearPlaneDistance, float farPlaneDistance)
+    {
+        if (fieldOfView <= 0.0f || fieldOfView >= ::DirectX::XM_PI)
+            _WINDOWS_NUMERICS_THROW_(std::invalid_argument("fieldOfView"));
+
+        if (nearPlaneDistance <= 0.0f)
+            _WINDOWS_NUMERICS_THROW_(std::invalid_argument("nearPlaneDistance"));
+
+        if (farPlaneDistance <= 0.0f)
+            _WINDOWS_NUMERICS_THROW_(std::invalid_argument("farPlaneDistance"));
+
+        if (nearPlaneDistance >= farPlaneDistance )
+            _WINDOWS_NUMERICS_THROW_(std::invalid_argument("nearPlaneDistance"));
+
+        float yScale = 1.0f / tanf(fieldOfView * 0.5f);
+        float xScale = yScale / aspectRatio;
+        float clipDist = nearPlaneDistance - farPlaneDistance;
+
+        return float4x4(xScale, 0,      0,                                                0,
+                        0,      yScale, 0,                                                0,
+                        0,      0,      farPlaneDistance / clipDist,                     -1,
+                        0,      0,      nearPlaneDistance * farPlaneDistance / clipDist,  0);
+    }
+
+
+    inline float4x4 make_float4x4_perspective(float width, float height, float nearPlaneDistance, float farPlaneDistance)
+    {
+        if (nearPlaneDistance <= 0.0f)
+            _WINDOWS_NUMERICS_THROW_(std::invalid_argument("nearPlaneDistance"));
+
+        if (farPlaneDistance <= 0.0f)
+            _WINDOWS_NUMERICS_THROW_(std::invalid_argument("farPlaneDistance"));
+
+        if (nearPlaneDistance >= farPlaneDistance)
+            _WINDOWS_NUMERICS_THROW_(std::invalid_argument("nearPlaneDistance"));
+
+        float clipDist = nearPlaneDistance - farPlaneDistance;
+
+        return float4x4(2 * nearPlaneDistance / width, 0,                              0,                                                0,
+                        0,                             2 * nearPlaneDistance / height, 0,                                                0,
+                        0,                             0,                              farPlaneDistance / clipDist,                     -1,
+                        0,                             0,                              nearPlaneDistance * farPlaneDistance / clipDist,  0);
+    }
+
+
+    inline float4x4 make_float4x4_perspective_off_center(float left, float right, float bottom, float top, float nearPlaneDistance, float farPlaneDistance)
+    {
+        if (nearPlaneDistance <= 0.0f)
+            _WINDOWS_NUMERICS_THROW_(std::invalid_argument("nearPlaneDistance"));
+
+        if (farPlaneDistance <= 0.0f)
+            _WINDOWS_NUMERICS_THROW_(std::invalid_argument("farPlaneDistance"));
+
+        if (nearPlaneDistance >= farPlaneDistance)
+            _WINDOWS_NUMERICS_THROW_(std::invalid_argument("nearPlaneDistance"));
+
+        float clipDist = nearPlaneDistance - farPlaneDistance;
+
+        return float4x4(2 * nearPlaneDistance / (right - left), 0,                                      0,                                                0,
+                        0,                                      2 * nearPlaneDistance / (top - bottom), 0,                                                0,
+                        (left + right) / (right - left),        (top + bottom) / (top - bottom),        farPlaneDistance / clipDist,                     -1,
+                        0,                                      0,                                      nearPlaneDistance * farPlaneDistance / clipDist,  0);
+    }
+
+
+    inline float4x4 make_float4x4_orthographic(float width, float height, float zNearPlane, float zFarPlane)
+    {
+        float clipDist = zNearPlane - zFarPlane;
+
+        return float4x4(2 / width, 0,          0,                     0,
+                        0,         2 / height, 0,                     0,
+                        0,         0,          1 / clipDist,          0,
+                        0,         0,          zNearPlane / clipDist, 1);
+    }
+
+
+    inline float4x4 make_float4x4_orthographic_off_center(float left, float right, float bottom, float top, float zNearPlane, float zFarPlane)
+    {
+        float clipDist = zNearPlane - zFarPlane;
+
+        return float4x4(2 / (right - left),              0,                               0,                     0,
+                        0,                               2 / (top - bottom),              0,                     0,
+                        0,                               0,                               1 / clipDist,          0,
+                        (left + right) / (left - right), (top + bottom) / (bottom - top), zNearPlane / clipDist, 1);
+    }
+
+
+    inline float4x4 make_float4x4_look_at(float3 const& cameraPosition, float3 const& cameraTarget, float3 const& cameraUpVector)
+    {
+        float3 zaxis = normalize(cameraPosition - cameraTarget);
+        float3 xaxis = normalize(cross(cameraUpVector, zaxis));
+        float3 yaxis = cross(zaxis, xaxis);
+
+        return float4x4(xaxis.x,                     yaxis.x,                     zaxis.x,                     0,
+                        xaxis.y,                     yaxis.y,                     zaxis.y,                     0,
+                        xaxis.z,                     yaxis.z,                     zaxis.z,                     0,
+                        -dot(xaxis, cameraPosition), -dot(yaxis, cameraPosition), -dot(zaxis, cameraPosition), 1);
+    }
+
+
+    inline float4x4 make_float4x4_world(float3 const& position, float3 const& forward, float3 const& up)
+    {
+        float3 zaxis = normalize(-forward);
+        float3 xaxis = normalize(cross(up, zaxis));
+        float3 yaxis = cross(zaxis, xaxis);
+
+        return float4x4(xaxis.x,    xaxis.y,    xaxis.z,    0,
+                        yaxis.x,    yaxis.y,    yaxis.z,    0,
+                        zaxis.x,    zaxis.y,    zaxis.z,    0,
+                        position.x, position.y, position.z, 1);
+    }
+
+
+    inline float4x4 make_float4x4_from_quaternion(quaternion const& quaternion)
+    {
+        float xx = quaternion.x * quaternion.x;
+        float yy = quaternion.y * quaternion.y;
+        float zz = quaternion.z * quaternion.z;
+
+        float xy = quaternion.x * quaternion.y;
+        float wz = quaternion.z * quaternion.w;
+        float xz = quaternion.z * quaternion.x;
+        float wy = quaternion.y * quaternion.w;
+        float yz = quaternion.y * quaternion.z;
+        float wx = quaternion.x * quaternion.w;
+
+        return float4x4(1 - 2 * (yy + zz),  2 * (xy + wz),      2 * (xz - wy),      0,
+                        2 * (xy - wz),      1 - 2 * (zz + xx),  2 * (yz + wx),      0,
+                        2 * (xz + wy),      2 * (yz - wx),      1 - 2 * (yy + xx),  0,
+                        0,                  0,                  0,                  1);
+    }
+
+
+    inline float4x4 make_float4x4_from_yaw_pitch_roll(float yaw, float pitch, float roll)
+    {
+        quaternion q = make_quaternion_from_yaw_pitch_roll(yaw, pitch, roll);
+
+        return make_float4x4_from_quaternion(q);
+    }
+
+
+    inline float4x4 make_float4x4_shadow(float3 const& lightDirection, plane const& plane)
+    {
+        auto p = normalize(plane);
+
+        float dot = dot_normal(p, lightDirection);
+
+        float a = -p.normal.x;
+        float b = -p.normal.y;
+        float c = -p.normal.z;
+        float d = -p.d;
+
+        return float4x4(a * lightDirection.x + dot,  a * lightDirection.y,        a * lightDirection.z,        0,
+                        b * lightDirection.x,        b * lightDirection.y + dot,  b * lightDirection.z,        0,
+                        c * lightDirection.x,        c * lightDirection.y,        c * lightDirection.z + dot,  0,
+                        d * lightDirection.x,        d * lightDirection.y,        d * lightDirection.z,        dot);
+    }
+
+
+    inline float4x4 make_float4x4_reflection(plane const& value)
+    {
+        plane v = normalize(value);
+
+        float a = v.normal.x;
+        float b = v.normal.y;
+        float c = v.normal.z;
+
+        float fa = -2 * a;
+        float fb = -2 * b;
+        float fc = -2 * c;
+
+        return float4x4(fa * a + 1,  fb * a,      fc * a,      0,
+                        fa * b,      fb * b + 1,  fc * b,      0,
+                        fa * c,      fb * c,      fc * c + 1,  0,
+                        fa * v.d,    fb * v.d,    fc * v.d,    1);
+    }
+
+
+    inline float4x4 operator +(float4x4 const& value1, float4x4 const& value2)
+    {
+#ifdef WINDOWS_NUMERICS_DISABLE_SIMD
+        return float4x4(value1.m11 + value2.m11,  value1.m12 + value2.m12,  value1.m13 + value2.m13,  value1.m14 + value2.m14,
+                        value1.m21 + value2.m21,  value1.m22 + value2.m22,  value1.m23 + value2.m23,  value1.m24 + value2.m24,
+                        value1.m31 + value2.m31,  value1.m32 + value2.m32,  value1.m33 + value2.m33,  value1.m34 + value2.m34,
+                        value1.m41 + value2.m41,  value1.m42 + value2.m42,  value1.m43 + value2.m43,  value1.m44 + value2.m44);
+#else
+        using namespace ::DirectX;
+
+        float4x4 result;
+        XMStoreFloat4x4(&result, XMLoadFloat4x4(&value1) + XMLoadFloat4x4(&value2));
+        return result;
+#endif
+    }
+
+
+    inline float4x4 operator -(float4x4 const& value1, float4x4 const& value2)
+    {
+#ifdef WINDOWS_NUMERICS_DISABLE_SIMD
+        return float4x4(value1.m11 - value2.m11,  value1.m12 - value2.m12,  value1.m13 - value2.m13,  value1.m14 - value2.m14,
+                        value1.m21 - value2.m21,  value1.m22 - value2.m22,  value1.m23 - value2.m23,  value1.m24 - value2.m24,
+                        value1.m31 - value2.m31,  value1.m32 - value2.m32,  value1.m33 - value2.m33,  value1.m34 - value2.m34,
+                        value1.m41 - value2.m41,  value1.m42 - value2.m42,  value1.m43 - value2.m43,  value1.m44 - value2.m44);
+#else
+        using namespace ::DirectX;
+
+        float4x4 result;
+        XMStoreFloat4x4(&result, XMLoadFloat4x4(&value1) - XMLoadFloat4x4(&value2));
+        return result;
+#endif
+    }
+
+
+    inline float4x4 operator *(float4x4 const& value1, float4x4 const& value2)
+    {
+#if defined _WINDOWS_NUMERICS_NEON_
+        return details::MultiplyNeon(value1, value2);
+#elif defined WINDOWS_NUMERICS_DISABLE_SIMD
+        return float4x4
+        (
+            // First row
+            value1.m11 * value2.m11 + value1.m12 * value2.m21 + value1.m13 * value2.m31 + value1.m14 * value2.m41,
+            value1.m11 * value2.m12 + value1.m12 * value2.m22 + value1.m13 * value2.m32 + value1.m14 * value2.m42,
+            value1.m11 * value2.m13 + value1.m12 * value2.m23 + value1.m13 * value2.m33 + value1.m14 * value2.m43,
+            value1.m11 * value2.m14 + value1.m12 * value2.m24 + value1.m13 * value2.m34 + value1.m14 * value2.m44,
+
+            // Second row
+            value1.m21 * value2.m11 + value1.m22 * value2.m21 + value1.m23 * value2.m31 + value1.m24 * value2.m41,
+            value1.m21 * value2.m12 + value1.m22 * value2.m22 + value1.m23 * value2.m32 + value1.m24 * value2.m42,
+            value1.m21 * value2.m13 + value1.m22 * value2.m23 + value1.m23 * value2.m33 + value1.m24 * value2.m43,
+            value1.m21 * value2.m14 + value1.m22 * value2.m24 + value1.m23 * value2.m34 + value1.m24 * value2.m44,
+
+            // Third row
+            value1.m31 * value2.m11 + value1.m32 * value2.m21 + value1.m33 * value2.m31 + value1.m34 * value2.m41,
+            value1.m31 * value2.m12 + value1.m32 * value2.m22 + value1.m33 * value2.m32 + value1.m34 * value2.m42,
+            value1.m31 * value2.m13 + value1.m32 * value2.m23 + value1.m33 * value2.m33 + value1.m34 * value2.m43,
+            value1.m31 * value2.m14 + value1.m32 * value2.m24 + value1.m33 * value2.m34 + value1.m34 * value2.m44,
+
+            // Fourth row
+            value1.m41 * value2.m11 + value1.m42 * value2.m21 + value1.m43 * value2.m31 + value1.m44 * value2.m41,
+            value1.m41 * value2.m12 + value1.m42 * value2.m22 + value1.m43 * value2.m32 + value1.m44 * value2.m42,
+            value1.m41 * value2.m13 + value1.m42 * value2.m23 + value1.m43 * value2.m33 + value1.m44 * value2.m43,
+            value1.m41 * value2.m14 + value1.m42 * value2.m24 + value1.m43 * value2.m34 + value1.m44 * value2.m44
+        );
+#else
+#ifdef _WINDOWS_NUMERICS_AVX2_ALWAYS_
+        // Unlike invert and the batched operations, a single multiply is too cheap to
+        // pay for a runtime dispatch, so this is only used when it can be inlined.
+        return details::MultiplyAvx2(value1, value2);
+#else
+        using namespace ::DirectX;
+
+        float4x4 result;
+        XMStoreFloat4x4(&result, XMMatrixMultiply(XMLoadFloat4x4(&value1), XMLoadFloat4x4(&value2)));
+        return result;
+#endif
+#endif
+    }
+
+
+    inline float4x4 operator *(float4x4 const& value1, float value2)
+    {
+#ifdef WINDOWS_NUMERICS_DISABLE_SIMD
+        return float4x4(value1.m11 * value2,  value1.m12 * value2,  value1.m13 * value2,  value1.m14 * value2,
+                        value1.m21 * value2,  value1.m22 * value2,  value1.m23 * value2,  value1.m24 * value2,
+                        value1.m31 * value2,  value1.m32 * value2,  value1.m33 * value2,  value1.m34 * value2,
+                        value1.m41 * value2,  value1.m42 * value2,  value1.m43 * value2,  value1.m44 * value2);
+#else
+        using namespace ::DirectX;
+
+        float4x4 result;
+        XMStoreFloat4x4(&result, XMLoadFloat4x4(&value1) * value2);
+        return result;
+#endif
+    }
+
+
+    inline float4x4 operator -(float4x4 const& value)
+    {
+#ifdef WINDOWS_NUMERICS_DISABLE_SIMD
+        return float4x4(-value.m11, -value.m12, -value.m13, -value.m14,
+                        -value.m21, -value.m22, -value.m23, -value.m24,
+                        -value.m31, -value.m32, -value.m33, -value.m34,
+                        -value.m41, -value.m42, -value.m43, -value.m44);
+#else
+        using namespace ::DirectX;
+
+        float4x4 result;
+        XMStoreFloat4x4(&result, -XMLoadFloat4x4(&value));
+        return result;
+#endif
+    }
+
+
+    inline float4x4& operator +=(float4x4& value1, float4x4 const& value2)
+    {
+        value1 = value1 + value2;
+
+        return value1;
+    }
+
+
+    inline float4x4& operator -=(float4x4& value1, float4x4 const& value2)
+    {
+        value1 = value1 - value2;
+
+        return value1;
+    }
+
+
+    inline float4x4& operator *=(float4x4& value1, float4x4 const& value2)
+    {
+        value1 = value1 * value2;
+
+        return value1;
+    }
+
+
+    inline float4x4& operator *=(float4x4& value1, float value2)
+    {
+        value1 = value1 * value2;
+
+        return value1;
+    }
+
+
+    inline bool operator ==(float4x4 const& value1, float4x4 const& value2)
+    {
+        return value1.m11 == value2.m11 && value1.m22 == value2.m22 && value1.m33 == value2.m33 && value1.m44 == value2.m44 && // Check diagonal element first for early out.
+                                           value1.m12 == value2.m12 && value1.m13 == value2.m13 && value1.m14 == value2.m14 &&
+               value1.m21 == value2.m21                             && value1.m23 == value2.m23 && value1.m24 == value2.m24 &&
+               value1.m31 == value2.m31 && value1.m32 == value2.m32                             && value1.m34 == value2.m34 &&
+               value1.m41 == value2.m41 && value1.m42 == value2.m42 && value1.m43 == value2.m43;
+    }
+
+
+    inline bool operator !=(float4x4 const& value1, float4x4 const& value2)
+    {
+        return value1.m11 != value2.m11 || value1.m12 != value2.m12 || value1.m13 != value2.m13 || value1.m14 != value2.m14 ||
+               value1.m21 != value2.m21 || value1.m22 != value2.m22 || value1.m23 != value2.m23 || value1.m24 != value2.m24 ||
+               value1.m31 != value2.m31 || value1.m32 != value2.m32 || value1.m33 != value2.m33 || value1.m34 != value2.m34 ||
+               value1.m41 != value2.m41 || value1.m42 != value2.m42 || value1.m43 != value2.m43 || value1.m44 != value2.m44;
+    }
+
+
+    inline bool is_identity(float4x4 const& value)
+    {
+        return value.m11 == 1 && value.m22 == 1 && value.m33 == 1 && value.m44 == 1 && // Check diagonal element first for early out.
+                                 value.m12 == 0 && value.m13 == 0 && value.m14 == 0 &&
+               value.m21 == 0                   && value.m23 == 0 && value.m24 == 0 &&
+               value.m31 == 0 && value.m32 == 0                   && value.m34 == 0 &&
+               value.m41 == 0 && value.m42 == 0 && value.m43 == 0;
+    }
+
+
+    inline float determinant(float4x4 const& value)
+    {
+        // | a b c d |     | f g h |     | e g h |     | e f h |     | e f g |
+        // | e f g h | = a | j k l | - b | i k l | + c | i j l | - d | i j k |
+        // | i j k l |     | n o p |     | m o p |     | m n p |     | m n o |
+        // | m n o p |
+        //
+        //   | f g h |
+        // a | j k l | = a ( f ( kp - lo ) - g ( jp - ln ) + h ( jo - kn ) )
         //   | n o p |
         //
-        //   | e g h |     
-        // b | i k l | = b ( e ( kp - lo ) - g ( ip - lm ) + h ( io - km ) )
-        //   | m o p |     
+        //   | e g h |     
+        // b | i k l | = b ( e ( kp - lo ) - g ( ip - lm ) + h ( io - km ) )
+        //   | m o p |     
+        //
+        //   | e f h |
+        // c | i j l | = c ( e ( jp - ln ) - f ( ip - lm ) + h ( in - jm ) )
+        //   | m n p |
+        //
+        //   | e f g |
+        // d | i j k | = d ( e ( jo - kn ) - f ( io - km ) + g ( in - jm ) )
+        //   | m n o |
+
+        float a = value.m11, b = value.m12, c = value.m13, d = value.m14;
+        float e = value.m21, f = value.m22, g = value.m23, h = value.m24;
+        float i = value.m31, j = value.m32, k = value.m33, l = value.m34;
+        float m = value.m41, n = value.m42, o = value.m43, p = value.m44;
+
+        float kp_lo = k * p - l * o;
+        float jp_ln = j * p - l * n;
+        float jo_kn = j * o - k * n;
+        float ip_lm = i * p - l * m;
+        float io_km = i * o - k * m;
+        float in_jm = i * n - j * m;
+
+        return a * (f * kp_lo - g * jp_ln + h * jo_kn) -
+               b * (e * kp_lo - g * ip_lm + h * io_km) +
+               c * (e * jp_ln - f * ip_lm + h * in_jm) -
+               d * (e * jo_kn - f * io_km + g * in_jm);
+    }
+
+
+    inline float3 translation(float4x4 const& value)
+    {
+        return float3(value.m41, value.m42, value.m43);
+    }
+
+
+    inline bool invert(float4x4 const& matrix, _Out_ float4x4* result)
+    {
+#ifdef _WINDOWS_NUMERICS_NEON_
+        return details::InvertNeon(matrix, result);
+#else
+#ifdef _WINDOWS_NUMERICS_AVX2_
+        if (details::UseAvx2())
+        {
+            return details::InvertAvx2(matrix, result);
+        }
+#endif
+
+        //                                       -1
+        // If you have matrix M, inverse Matrix M   can compute
+        //
+        //     -1       1      
+        //    M   = --------- A
+        //            det(M)
+        //
+        // A is adjugate (adjoint) of M, where,
+        //
+        //      T
+        // A = C
         //
-        //   | e f h |
-        // c | i j l | = c ( e ( jp - ln ) - f ( ip - lm ) + h ( in - jm ) )
-        //   | m n p |
+        // C is Cofactor matrix of M, where,
+        //           i + j
+        // C   = (-1)      * det(M  )
+        //  ij                    ij
         //
-        //   | e f g |
-        // d | i j k | = d ( e ( jo - kn ) - f ( io - km ) + g ( in - jm ) )
-        //   | m n o |
+        //     [ a b c d ]
+        // M = [ e f g h ]
+        //     [ i j k l ]
+        //     [ m n o p ]
+        //
+        // First Row
+        //           2 | f g h |
+        // C   = (-1)  | j k l | = + ( f ( kp - lo ) - g ( jp - ln ) + h ( jo - kn ) )
+        //  11         | n o p |
+        //
+        //           3 | e g h |
+        // C   = (-1)  | i k l | = - ( e ( kp - lo ) - g ( ip - lm ) + h ( io - km ) )
+        //  12         | m o p |
+        //
+        //           4 | e f h |
+        // C   = (-1)  | i j l | = + ( e ( jp - ln ) - f ( ip - lm ) + h ( in - jm ) )
+        //  13         | m n p |
+        //
+        //           5 | e f g |
+        // C   = (-1)  | i j k | = - ( e ( jo - kn ) - f ( io - km ) + g ( in - jm ) )
+        //  14         | m n o |
+        //
+        // Second Row
+        //           3 | b c d |
+        // C   = (-1)  | j k l | = - ( b ( kp - lo ) - c ( jp - ln ) + d ( jo - kn ) )
+        //  21         | n o p |
+        //
+        //           4 | a c d |
+        // C   = (-1)  | i k l | = + ( a ( kp - lo ) - c ( ip - lm ) + d ( io - km ) )
+        //  22         | m o p |
+        //
+        //           5 | a b d |
+        // C   = (-1)  | i j l | = - ( a ( jp - ln ) - b ( ip - lm ) + d ( in - jm ) )
+        //  23         | m n p |
+        //
+        //           6 | a b c |
+        // C   = (-1)  | i j k | = + ( a ( jo - kn ) - b ( io - km ) + c ( in - jm ) )
+        //  24         | m n o |
+        //
+        // Third Row
+        //           4 | b c d |
+        // C   = (-1)  | f g h | = + ( b ( gp - ho ) - c ( fp - hn ) + d ( fo - gn ) )
+        //  31         | n o p |
+        //
+        //           5 | a c d |
+        // C   = (-1)  | e g h | = - ( a ( gp - ho ) - c ( ep - hm ) + d ( eo - gm ) )
+        //  32         | m o p |
+        //
+        //           6 | a b d |
+        // C   = (-1)  | e f h | = + ( a ( fp - hn ) - b ( ep - hm ) + d ( en - fm ) )
+        //  33         | m n p |
+        //
+        //           7 | a b c |
+        // C   = (-1)  | e f g | = - ( a ( fo - gn ) - b ( eo - gm ) + c ( en - fm ) )
+        //  34         | m n o |
+        //
+        // Fourth Row
+        //           5 | b c d |
+        // C   = (-1)  | f g h | = - ( b ( gl - hk ) - c ( fl - hj ) + d ( fk - gj ) )
+        //  41         | j k l |
+        //
+        //           6 | a c d |
+        // C   = (-1)  | e g h | = + ( a ( gl - hk ) - c ( el - hi ) + d ( ek - gi ) )
+        //  42         | i k l |
+        //
+        //           7 | a b d |
+        // C   = (-1)  | e f h | = - ( a ( fl - hj ) - b ( el - hi ) + d ( ej - fi ) )
+        //  43         | i j l |
+        //
+        //           8 | a b c |
+        // C   = (-1)  | e f g | = + ( a ( fk - gj ) - b ( ek - gi ) + c ( ej - fi ) )
+        //  44         | i j k |
+        //
+        float a = matrix.m11, b = matrix.m12, c = matrix.m13, d = matrix.m14;
+        float e = matrix.m21, f = matrix.m22, g = matrix.m23, h = matrix.m24;
+        float i = matrix.m31, j = matrix.m32, k = matrix.m33, l = matrix.m34;
+        float m = matrix.m41, n = matrix.m42, o = matrix.m43, p = matrix.m44;
+
+        float kp_lo = k * p - l * o;
+        float jp_ln = j * p - l * n;
+        float jo_kn = j * o - k * n;
+        float ip_lm = i * p - l * m;
+        float io_km = i * o - k * m;
+        float in_jm = i * n - j * m;
+
+        float a11 = +(f * kp_lo - g * jp_ln + h * jo_kn);
+        float a12 = -(e * kp_lo - g * ip_lm + h * io_km);
+        float a13 = +(e * jp_ln - f * ip_lm + h * in_jm);
+        float a14 = -(e * jo_kn - f * io_km + g * in_jm);
+
+        float det = a * a11 + b * a12 + c * a13 + d * a14;
+
+        if (fabs(det) < FLT_EPSILON)
+        {
+            const float nan = _WINDOWS_NUMERICS_NAN_;
+
+            *result = float4x4(nan, nan, nan, nan,
+                               nan, nan, nan, nan,
+                               nan, nan, nan, nan,
+                               nan, nan, nan, nan);
+            return false;
+        }
+
+        float invDet = 1.0f / det;
+
+        result->m11 = a11 * invDet;
+        result->m21 = a12 * invDet;
+        result->m31 = a13 * invDet;
+        result->m41 = a14 * invDet;
+
+        result->m12 = -(b * kp_lo - c * jp_ln + d * jo_kn) * invDet;
+        result->m22 = +(a * kp_lo - c * ip_lm + d * io_km) * invDet;
+        result->m32 = -(a * jp_ln - b * ip_lm + d * in_jm) * invDet;
+        result->m42 = +(a * jo_kn - b * io_km + c * in_jm) * invDet;
+
+        float gp_ho = g * p - h * o;
+        float fp_hn = f * p - h * n;
+        float fo_gn = f * o - g * n;
+        float ep_hm = e * p - h * m;
+        float eo_gm = e * o - g * m;
+        float en_fm = e * n - f * m;
+
+        result->m13 = +(b * gp_ho - c * fp_hn + d * fo_gn) * invDet;
+        result->m23 = -(a * gp_ho - c * ep_hm + d * eo_gm) * invDet;
+        result->m33 = +(a * fp_hn - b * ep_hm + d * en_fm) * invDet;
+        result->m43 = -(a * fo_gn - b * eo_gm + c * en_fm) * invDet;
+
+        float gl_hk = g * l - h * k;
+        float fl_hj = f * l - h * j;
+        float fk_gj = f * k - g * j;
+        float el_hi = e * l - h * i;
+        float ek_gi = e * k - g * i;
+        float ej_fi = e * j - f * i;
+
+        result->m14 = -(b * gl_hk - c * fl_hj + d * fk_gj) * invDet;
+        result->m24 = +(a * gl_hk - c * el_hi + d * ek_gi) * invDet;
+        result->m34 = -(a * fl_hj - b * el_hi + d * ej_fi) * invDet;
+        result->m44 = +(a * fk_gj - b * ek_gi + c * ej_fi) * invDet;
+
+        return true;
+#endif
+    }
+
+
+    inline bool decompose(float4x4 const& matrix, _Out_ float3* scale, _Out_ quaternion* rotation, _Out_ float3* translation)
+    {
+        using namespace ::DirectX;
+
+        XMVECTOR s, r, t;
+
+        if (!XMMatrixDecompose(&s, &r, &t, XMLoadFloat4x4(&matrix)))
+        {
+            return false;
+        }
+
+        XMStoreFloat3(scale, s);
+        XMStoreQuaternion(rotation, r);
+        XMStoreFloat3(translation, t);
+
+        return true;
+    }
+
+
+    inline float4x4 transform(float4x4 const& value, quaternion const& rotation)
+    {
+        // Compute rotation matrix.
+        float x2 = rotation.x + rotation.x;
+        float y2 = rotation.y + rotation.y;
+        float z2 = rotation.z + rotation.z;
+
+        float wx2 = rotation.w * x2;
+        float wy2 = rotation.w * y2;
+        float wz2 = rotation.w * z2;
+        float xx2 = rotation.x * x2;
+        float xy2 = rotation.x * y2;
+        float xz2 = rotation.x * z2;
+        float yy2 = rotation.y * y2;
+        float yz2 = rotation.y * z2;
+        float zz2 = rotation.z * z2;
+
+        float q11 = 1 - yy2 - zz2;
+        float q21 = xy2 - wz2;
+        float q31 = xz2 + wy2;
+
+        float q12 = xy2 + wz2;
+        float q22 = 1 - xx2 - zz2;
+        float q32 = yz2 - wx2;
+
+        float q13 = xz2 - wy2;
+        float q23 = yz2 + wx2;
+        float q33 = 1 - xx2 - yy2;
+
+        return float4x4
+        (
+            // First row
+            value.m11 * q11 + value.m12 * q21 + value.m13 * q31,
+            value.m11 * q12 + value.m12 * q22 + value.m13 * q32,
+            value.m11 * q13 + value.m12 * q23 + value.m13 * q33,
+            value.m14,
+
+            // Second row
+            value.m21 * q11 + value.m22 * q21 + value.m23 * q31,
+            value.m21 * q12 + value.m22 * q22 + value.m23 * q32,
+            value.m21 * q13 + value.m22 * q23 + value.m23 * q33,
+            value.m24,
+
+            // Third row
+            value.m31 * q11 + value.m32 * q21 + value.m33 * q31,
+            value.m31 * q12 + value.m32 * q22 + value.m33 * q32,
+            value.m31 * q13 + value.m32 * q23 + value.m33 * q33,
+            value.m34,
+
+            // Fourth row
+            value.m41 * q11 + value.m42 * q21 + value.m43 * q31,
+            value.m41 * q12 + value.m42 * q22 + value.m43 * q32,
+            value.m41 * q13 + value.m42 * q23 + value.m43 * q33,
+            value.m44
+        );
+    }
+
+
+    inline float4x4 transpose(float4x4 const& matrix)
+    {
+#ifdef WINDOWS_NUMERICS_DISABLE_SIMD
+        return float4x4(matrix.m11, matrix.m21, matrix.m31, matrix.m41,
+                        matrix.m12, matrix.m22, matrix.m32, matrix.m42,
+                        matrix.m13, matrix.m23, matrix.m33, matrix.m43,
+                        matrix.m14, matrix.m24, matrix.m34, matrix.m44);
+#else
+        using namespace ::DirectX;
+
+        float4x4 result;
+        XMStoreFloat4x4(&result, XMMatrixTranspose(XMLoadFloat4x4(&matrix)));
+        return result;
+#endif
+    }
+
+
+    inline float4x4 lerp(float4x4 const& matrix1, float4x4 const& matrix2, float amount)
+    {
+        return matrix1 + (matrix2 - matrix1) * amount;
+    }
+
+
+    inline void make_float4x4_from_quaternion(_In_reads_(count) quaternion const* quaternions, size_t count, _Out_writes_(count) float4x4* results)
+    {
+        size_t i = 0;
+
+#ifdef _WINDOWS_NUMERICS_BATCH_SIMD_
+        using namespace ::DirectX;
+
+        XMVECTOR one = XMVectorReplicate(1.0f);
+        XMVECTOR two = XMVectorReplicate(2.0f);
+        XMVECTOR zero = XMVectorZero();
+        XMVECTOR identityRow4 = XMVectorSet(0, 0, 0, 1);
+
+        for (; i < count - count % 4; i += 4)
+        {
+            XMVECTOR x, y, z, w;
+            details::LoadFloat4x4(reinterpret_cast<float4 const*>(quaternions + i), &x, &y, &z, &w);
+
+            XMVECTOR xx = XMVectorMultiply(x, x);
+            XMVECTOR yy = XMVectorMultiply(y, y);
+            XMVECTOR zz = XMVectorMultiply(z, z);
+
+            XMVECTOR xy = XMVectorMultiply(x, y);
+            XMVECTOR wz = XMVectorMultiply(z, w);
+            XMVECTOR xz = XMVectorMultiply(z, x);
+            XMVECTOR wy = XMVectorMultiply(y, w);
+            XMVECTOR yz = XMVectorMultiply(y, z);
+            XMVECTOR wx = XMVectorMultiply(x, w);
+
+            // Each transpose turns one row from four matrices (one matrix per lane)
+            // into four rows, one for each matrix.
+            XMMATRIX row1, row2, row3;
+
+            row1.r[0] = XMVectorNegativeMultiplySubtract(two, XMVectorAdd(yy, zz), one);
+            row1.r[1] = XMVectorMultiply(two, XMVectorAdd(xy, wz));
+            row1.r[2] = XMVectorMultiply(two, XMVectorSubtract(xz, wy));
+            row1.r[3] = zero;
+
+            row2.r[0] = XMVectorMultiply(two, XMVectorSubtract(xy, wz));
+            row2.r[1] = XMVectorNegativeMultiplySubtract(two, XMVectorAdd(zz, xx), one);
+            row2.r[2] = XMVectorMultiply(two, XMVectorAdd(yz, wx));
+            row2.r[3] = zero;
+
+            row3.r[0] = XMVectorMultiply(two, XMVectorAdd(xz, wy));
+            row3.r[1] = XMVectorMultiply(two, XMVectorSubtract(yz, wx));
+            row3.r[2] = XMVectorNegativeMultiplySubtract(two, XMVectorAdd(yy, xx), one);
+            row3.r[3] = zero;
+
+            row1 = XMMatrixTranspose(row1);
+            row2 = XMMatrixTranspose(row2);
+            row3 = XMMatrixTranspose(row3);
+
+            for (int j = 0; j < 4; j++)
+            {
+                float4x4& result = results[i + j];
+
+                XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(&result.m11), row1.r[j]);
+                XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(&result.m21), row2.r[j]);
+                XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(&result.m31), row3.r[j]);
+                XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(&result.m41), identityRow4);
+            }
+        }
+#endif
+
+        for (; i < count; i++)
+        {
+            results[i] = make_float4x4_from_quaternion(quaternions[i]);
+        }
+    }
+
+
+    inline plane::plane(float x, float y, float z, float d)
+        : normal(x, y, z), d(d)
+    { }
+
+
+    inline plane::plane(float3 normal, float d)
+        : normal(normal), d(d)
+    { }
+
+
+    inline plane::plane(float4 value)
+        : normal(value.x, value.y, value.z), d(value.w)
+    { }
+
+
+    inline plane make_plane_from_vertices(float3 const& point1, float3 const& point2, float3 const& point3)
+    {
+        float3 a = point2 - point1;
+        float3 b = point3 - point1;
+
+        float3 normal = normalize(cross(a, b));
+        float d = -dot(normal, point1);
+
+        return plane(normal, d);
+    }
+
+
+    inline bool operator ==(plane const& value1, plane const& value2)
+    {
+        return value1.normal.x == value2.normal.x &&
+               value1.normal.y == value2.normal.y &&
+               value1.normal.z == value2.normal.z &&
+               value1.d == value2.d;
+    }
+
+
+    inline bool operator !=(plane const& value1, plane const& value2)
+    {
+        return value1.normal.x != value2.normal.x ||
+               value1.normal.y != value2.normal.y || 
+               value1.normal.z != value2.normal.z ||
+               value1.d != value2.d;
+    }
+
+
+    inline plane normalize(plane const& value)
+    {
+#ifdef WINDOWS_NUMERICS_DISABLE_SIMD
+        float f = length_squared(value.normal);
+
+        if (fabs(f - 1.0f) < FLT_EPSILON)
+        {
+            return value;
+        }
+
+        float fInv = 1.0f / sqrtf(f);
+
+        return plane(value.normal * fInv, value.d * fInv);
+#else
+        using namespace ::DirectX;
+
+        plane result;
+        XMStorePlane(&result, XMPlaneNormalize(XMLoadPlane(&value)));
+        return result;
+#endif
+    }
+
+
+    inline plane transform(plane const& value, float4x4 const& matrix)
+    {
+        float4x4 inverseMatrix;
+        invert(matrix, &inverseMatrix);
+
+#ifdef WINDOWS_NUMERICS_DISABLE_SIMD
+        float4 planeAsVector(value.normal, value.d);
+
+        return plane(transform(planeAsVector, transpose(inverseMatrix)));
+#else
+        using namespace ::DirectX;
+
+        plane result;
+        XMStorePlane(&result, XMPlaneTransform(XMLoadPlane(&value), XMMatrixTranspose(XMLoadFloat4x4(&inverseMatrix))));
+        return result;
+#endif
+    }
+
+
+    inline plane transform(plane const& value, quaternion const& rotation)
+    {
+        float4 planeAsVector(value.normal, value.d);
+
+        return plane(transform(planeAsVector, rotation));
+    }
+
+
+    inline float dot(plane const& plane, float4 const& value)
+    {
+        return plane.normal.x * value.x +
+               plane.normal.y * value.y + 
+               plane.normal.z * value.z + 
+               plane.d * value.w;
+    }
+
+
+    inline float dot_coordinate(plane const& plane, float3 const& value)
+    {
+        return plane.normal.x * value.x +
+               plane.normal.y * value.y + 
+               plane.normal.z * value.z + 
+               plane.d;
+    }
+
+
+    inline float dot_normal(plane const& plane, float3 const& value)
+    {
+        return plane.normal.x * value.x +
+               plane.normal.y * value.y + 
+               plane.normal.z * value.z;
+    }
+
+
+    inline void extract_frustum_planes(float4x4 const& matrix, _Out_writes_(6) plane* planes)
+    {
+        // A point is inside the view frustum when its clip space position (point * matrix)
+        // satisfies -w <= x <= w, -w <= y <= w and 0 <= z <= w. Each of those inequalities
+        // is a plane equation built from columns of the matrix, with the normal pointing inward.
+        planes[0] = normalize(plane(matrix.m14 + matrix.m11, matrix.m24 + matrix.m21, matrix.m34 + matrix.m31, matrix.m44 + matrix.m41));   // Left
+        planes[1] = normalize(plane(matrix.m14 - matrix.m11, matrix.m24 - matrix.m21, matrix.m34 - matrix.m31, matrix.m44 - matrix.m41));   // Right
+        planes[2] = normalize(plane(matrix.m14 + matrix.m12, matrix.m24 + matrix.m22, matrix.m34 + matrix.m32, matrix.m44 + matrix.m42));   // Bottom
+        planes[3] = normalize(plane(matrix.m14 - matrix.m12, matrix.m24 - matrix.m22, matrix.m34 - matrix.m32, matrix.m44 - matrix.m42));   // Top
+        planes[4] = normalize(plane(matrix.m13,               matrix.m23,               matrix.m33,               matrix.m43));                 // Near
+        planes[5] = normalize(plane(matrix.m14 - matrix.m13, matrix.m24 - matrix.m23, matrix.m34 - matrix.m33, matrix.m44 - matrix.m43));   // Far
+    }
+
+
+    inline void cull_spheres(_In_reads_(count) float const* centerX, _In_reads_(count) float const* centerY, _In_reads_(count) float const* centerZ, _In_reads_(count) float const* radius, size_t count, _In_reads_(planeCount) plane const* planes, size_t planeCount, _Out_writes_((count + 31) / 32) uint32_t* visible)
+    {
+        // A sphere is culled when it lies entirely behind any one of the planes.
+        for (size_t word = 0; word < (count + 31) / 32; word++)
+        {
+            visible[word] = 0;
+        }
+
+        size_t i = 0;
+
+#ifdef _WINDOWS_NUMERICS_BATCH_SIMD_
+        using namespace ::DirectX;
+
+        for (; i < count - count % 4; i += 4)
+        {
+            XMVECTOR x = XMLoadFloat4(reinterpret_cast<XMFLOAT4 const*>(centerX + i));
+            XMVECTOR y = XMLoadFloat4(reinterpret_cast<XMFLOAT4 const*>(centerY + i));
+            XMVECTOR z = XMLoadFloat4(reinterpret_cast<XMFLOAT4 const*>(centerZ + i));
+            XMVECTOR negativeRadius = XMVectorNegate(XMLoadFloat4(reinterpret_cast<XMFLOAT4 const*>(radius + i)));
+
+            XMVECTOR inside = XMVectorTrueInt();
+
+            for (size_t j = 0; j < planeCount; j++)
+            {
+                XMVECTOR distance = XMVectorMultiplyAdd(XMVectorReplicatePtr(&planes[j].normal.x), x,
+                                    XMVectorMultiplyAdd(XMVectorReplicatePtr(&planes[j].normal.y), y,
+                                    XMVectorMultiplyAdd(XMVectorReplicatePtr(&planes[j].normal.z), z,
+                                                        XMVectorReplicatePtr(&planes[j].d))));
+
+                inside = XMVectorAndInt(inside, XMVectorGreaterOrEqual(distance, negativeRadius));
+            }
+
+            visible[i / 32] |= details::MoveMask(inside) << (i % 32);
+        }
+#endif
+
+        for (; i < count; i++)
+        {
+            float3 center(centerX[i], centerY[i], centerZ[i]);
+            bool inside = true;
+
+            for (size_t j = 0; j < planeCount && inside; j++)
+            {
+                inside = dot_coordinate(planes[j], center) >= -radius[i];
+            }
+
+            if (inside)
+            {
+                visible[i / 32] |= 1u << (i % 32);
+            }
+        }
+    }
+
+
+    inline void cull_boxes(_In_reads_(count) float const* minX, _In_reads_(count) float const* minY, _In_reads_(count) float const* minZ, _In_reads_(count) float const* maxX, _In_reads_(count) float const* maxY, _In_reads_(count) float const* maxZ, size_t count, _In_reads_(planeCount) plane const* planes, size_t planeCount, _Out_writes_((count + 31) / 32) uint32_t* visible)
+    {
+        // A box is culled when it lies entirely behind any one of the planes. Its
+        // projection onto a plane normal spans dot(abs(normal), extents) either side
+        // of the projected center, so it can be tested in the same way as a sphere.
+        for (size_t word = 0; word < (count + 31) / 32; word++)
+        {
+            visible[word] = 0;
+        }
+
+        size_t i = 0;
+
+#ifdef _WINDOWS_NUMERICS_BATCH_SIMD_
+        using namespace ::DirectX;
+
+        XMVECTOR half = XMVectorReplicate(0.5f);
+
+        for (; i < count - count % 4; i += 4)
+        {
+            XMVECTOR x0 = XMLoadFloat4(reinterpret_cast<XMFLOAT4 const*>(minX + i));
+            XMVECTOR y0 = XMLoadFloat4(reinterpret_cast<XMFLOAT4 const*>(minY + i));
+            XMVECTOR z0 = XMLoadFloat4(reinterpret_cast<XMFLOAT4 const*>(minZ + i));
+            XMVECTOR x1 = XMLoadFloat4(reinterpret_cast<XMFLOAT4 const*>(maxX + i));
+            XMVECTOR y1 = XMLoadFloat4(reinterpret_cast<XMFLOAT4 const*>(maxY + i));
+            XMVECTOR z1 = XMLoadFloat4(reinterpret_cast<XMFLOAT4 const*>(maxZ + i));
+
+            XMVECTOR centerX = XMVectorMultiply(XMVectorAdd(x0, x1), half);
+            XMVECTOR centerY = XMVectorMultiply(XMVectorAdd(y0, y1), half);
+            XMVECTOR centerZ = XMVectorMultiply(XMVectorAdd(z0, z1), half);
+            XMVECTOR extentX = XMVectorMultiply(XMVectorSubtract(x1, x0), half);
+            XMVECTOR extentY = XMVectorMultiply(XMVectorSubtract(y1, y0), half);
+            XMVECTOR extentZ = XMVectorMultiply(XMVectorSubtract(z1, z0), half);
+
+            XMVECTOR inside = XMVectorTrueInt();
+
+            for (size_t j = 0; j < planeCount; j++)
+            {
+                XMVECTOR normalX = XMVectorReplicatePtr(&planes[j].normal.x);
+                XMVECTOR normalY = XMVectorReplicatePtr(&planes[j].normal.y);
+                XMVECTOR normalZ = XMVectorReplicatePtr(&planes[j].normal.z);
+
+                XMVECTOR distance = XMVectorMultiplyAdd(normalX, centerX,
+                                    XMVectorMultiplyAdd(normalY, centerY,
+                                    XMVectorMultiplyAdd(normalZ, centerZ,
+                                                        XMVectorReplicatePtr(&planes[j].d))));
+
+                XMVECTOR projectedExtent = XMVectorMultiplyAdd(XMVectorAbs(normalX), extentX,
+                                           XMVectorMultiplyAdd(XMVectorAbs(normalY), extentY,
+                                                               XMVectorMultiply(XMVectorAbs(normalZ), extentZ)));
+
+                inside = XMVectorAndInt(inside, XMVectorGreaterOrEqual(XMVectorAdd(distance, projectedExtent), XMVectorZero()));
+            }
+
+            visible[i / 32] |= details::MoveMask(inside) << (i % 32);
+        }
+#endif
+
+        for (; i < count; i++)
+        {
+            float3 center((minX[i] + maxX[i]) * 0.5f, (minY[i] + maxY[i]) * 0.5f, (minZ[i] + maxZ[i]) * 0.5f);
+            float3 extent((maxX[i] - minX[i]) * 0.5f, (maxY[i] - minY[i]) * 0.5f, (maxZ[i] - minZ[i]) * 0.5f);
+            bool inside = true;
+
+            for (size_t j = 0; j < planeCount && inside; j++)
+            {
+                float3 normal = planes[j].normal;
+                float3 absNormal(fabsf(normal.x), fabsf(normal.y), fabsf(normal.z));
+
+                inside = dot_coordinate(planes[j], center) + dot(absNormal, extent) >= 0;
+            }
+
+            if (inside)
+            {
+                visible[i / 32] |= 1u << (i % 32);
+            }
+        }
+    }
+
+
+    inline quaternion::quaternion(float x, float y, float z, float w)
+        : x(x), y(y), z(z), w(w)
+    { }
+
+
+    inline quaternion::quaternion(float3 vectorPart, float scalarPart)
+        : x(vectorPart.x), y(vectorPart.y), z(vectorPart.z), w(scalarPart)
+    { }
+
+
+    inline quaternion quaternion::identity()
+    {
+        return quaternion(0, 0, 0, 1);
+    }
+
+
+    inline quaternion make_quaternion_from_axis_angle(float3 const& axis, float angle)
+    {
+        float halfAngle = angle * 0.5f;
+        float s = sinf(halfAngle);
+        float c = cosf(halfAngle);
+
+        return quaternion(axis * s, c);
+    }
+
+
+    inline quaternion make_quaternion_from_yaw_pitch_roll(float yaw, float pitch, float roll)
+    {
+        // Roll first, about axis the object is facing, then
+        // pitch upward, then yaw to face into the new heading
+        float sr, cr, sp, cp, sy, cy;
+
+        float halfRoll = roll * 0.5f;
+        sr = sinf(halfRoll); cr = cosf(halfRoll);
+
+        float halfPitch = pitch * 0.5f;
+        sp = sinf(halfPitch); cp = cosf(halfPitch);
+
+        float halfYaw = yaw * 0.5f;
+        sy = sinf(halfYaw); cy = cosf(halfYaw);
+
+        return quaternion(cy * sp * cr + sy * cp * sr,
+                          sy * cp * cr - cy * sp * sr,
+                          cy * cp * sr - sy * sp * cr,
+                          cy * cp * cr + sy * sp * sr);
+    }
+
+
+    inline quaternion make_quaternion_from_rotation_matrix(float4x4 const& matrix)
+    {
+        if (matrix.m11 + matrix.m22 + matrix.m33 > 0.0f)
+        {
+            float s = sqrtf(1.0f + matrix.m11 + matrix.m22 + matrix.m33);
+            float invS = 0.5f / s;
 
-        float a = value.m11, b = value.m12, c = value.m13, d = value.m14;
-        float e = value.m21, f = value.m22, g = value.m23, h = value.m24;
-        float i = value.m31, j = value.m32, k = value.m33, l = value.m34;
-        float m = value.m41, n = value.m42, o = value.m43, p = value.m44;
+            return quaternion((matrix.m23 - matrix.m32) * invS,
+                              (matrix.m31 - matrix.m13) * invS,
+                              (matrix.m12 - matrix.m21) * invS,
+                              s * 0.5f);
+        }
+        else if (matrix.m11 >= matrix.m22 && matrix.m11 >= matrix.m33)
+        {
+            float s = sqrtf(1.0f + matrix.m11 - matrix.m22 - matrix.m33);
+            float invS = 0.5f / s;
 
-        float kp_lo = k * p - l * o;
-        float jp_ln = j * p - l * n;
-        float jo_kn = j * o - k * n;
-        float ip_lm = i * p - l * m;
-        float io_km = i * o - k * m;
-        float in_jm = i * n - j * m;
+            return quaternion(0.5f * s,
+                              (matrix.m12 + matrix.m21) * invS,
+                              (matrix.m13 + matrix.m31) * invS,
+                              (matrix.m23 - matrix.m32) * invS);
+        }
+        else if (matrix.m22 > matrix.m33)
+        {
+            float s = sqrtf(1.0f + matrix.m22 - matrix.m11 - matrix.m33);
+            float invS = 0.5f / s;
 
-        return a * (f * kp_lo - g * jp_ln + h * jo_kn) -
-               b * (e * kp_lo - g * ip_lm + h * io_km) +
-               c * (e * jp_ln - f * ip_lm + h * in_jm) -
-               d * (e * jo_kn - f * io_km + g * in_jm);
+            return quaternion((matrix.m21 + matrix.m12) * invS,
+                              0.5f * s,
+                              (matrix.m32 + matrix.m23) * invS,
+                              (matrix.m31 - matrix.m13) * invS);
+        }
+        else
+        {
+            float s = sqrtf(1.0f + matrix.m33 - matrix.m11 - matrix.m22);
+            float invS = 0.5f / s;
+
+            return quaternion((matrix.m31 + matrix.m13) * invS,
+                              (matrix.m32 + matrix.m23) * invS,
+                              0.5f * s,
+                              (matrix.m12 - matrix.m21) * invS);
+        }
+    }
+
+
+    inline quaternion operator +(quaternion const& value1, quaternion const& value2)
+    {
+#ifdef WINDOWS_NUMERICS_DISABLE_SIMD
+        return quaternion(value1.x + value2.x,
+                          value1.y + value2.y,
+                          value1.z + value2.z,
+                          value1.w + value2.w);
+#else
+        using namespace ::DirectX;
+
+        quaternion result;
+        XMStoreQuaternion(&result, XMVectorAdd(XMLoadQuaternion(&value1), XMLoadQuaternion(&value2)));
+        return result;
+#endif
+    }
+
+
+    inline quaternion operator -(quaternion const& value1, quaternion const& value2)
+    {
+#ifdef WINDOWS_NUMERICS_DISABLE_SIMD
+        return quaternion(value1.x - value2.x,
+                          value1.y - value2.y,
+                          value1.z - value2.z,
+                          value1.w - value2.w);
+#else
+        using namespace ::DirectX;
+
+        quaternion result;
+        XMStoreQuaternion(&result, XMVectorSubtract(XMLoadQuaternion(&value1), XMLoadQuaternion(&value2)));
+        return result;
+#endif
+    }
+
+
+    inline quaternion operator *(quaternion const& value1, quaternion const& value2)
+    {
+#ifdef WINDOWS_NUMERICS_DISABLE_SIMD
+        float3 q1(value1.x, value1.y, value1.z);
+        float3 q2(value2.x, value2.y, value2.z);
+
+        float3 c = cross(q1, q2);
+        float d = dot(q1, q2);
+
+        return quaternion(q1 * value2.w + q2 * value1.w + c,
+                          value1.w * value2.w - d);
+#else
+        using namespace ::DirectX;
+
+        quaternion result;
+        XMStoreQuaternion(&result, XMQuaternionMultiply(XMLoadQuaternion(&value2), XMLoadQuaternion(&value1)));
+        return result;
+#endif
+    }
+
+
+    inline quaternion operator *(quaternion const& value1, float value2)
+    {
+#ifdef WINDOWS_NUMERICS_DISABLE_SIMD
+        return quaternion(value1.x * value2,
+                          value1.y * value2,
+                          value1.z * value2,
+                          value1.w * value2);
+#else
+        using namespace ::DirectX;
+
+        quaternion result;
+        XMStoreQuaternion(&result, XMVectorScale(XMLoadQuaternion(&value1), value2));
+        return result;
+#endif
+    }
+
+
+    inline quaternion operator /(quaternion const& value1, quaternion const& value2)
+    {
+        return value1 * inverse(value2);
+    }
+
+
+    inline quaternion operator -(quaternion const& value)
+    {
+#ifdef WINDOWS_NUMERICS_DISABLE_SIMD
+        return quaternion(-value.x,
+                          -value.y,
+                          -value.z,
+                          -value.w);
+#else
+        using namespace ::DirectX;
+
+        quaternion result;
+        XMStoreQuaternion(&result, XMVectorNegate(XMLoadQuaternion(&value)));
+        return result;
+#endif
+    }
+
+
+    inline quaternion& operator +=(quaternion& value1, quaternion const& value2)
+    {
+        value1 = value1 + value2;
+
+        return value1;
+    }
+
+
+    inline quaternion& operator -=(quaternion& value1, quaternion const& value2)
+    {
+        value1 = value1 - value2;
+
+        return value1;
+    }
+
+
+    inline quaternion& operator *=(quaternion& value1, quaternion const& value2)
+    {
+        value1 = value1 * value2;
+
+        return value1;
+    }
+
+
+    inline quaternion& operator *=(quaternion& value1, float value2)
+    {
+        value1 = value1 * value2;
+
+        return value1;
+    }
+
+
+    inline quaternion& operator /=(quaternion& value1, quaternion const& value2)
+    {
+        value1 = value1 / value2;
+
+        return value1;
+    }
+
+
+    inline bool operator ==(quaternion const& value1, quaternion const& value2)
+    {
+        return value1.x == value2.x &&
+               value1.y == value2.y &&
+               value1.z == value2.z &&
+               value1.w == value2.w;
+    }
+
+
+    inline bool operator !=(quaternion const& value1, quaternion const& value2)
+    {
+        return value1.x != value2.x ||
+               value1.y != value2.y ||
+               value1.z != value2.z ||
+               value1.w != value2.w;
+    }
+
+
+    inline bool is_identity(quaternion const& value)
+    {
+        return value.x == 0 &&
+               value.y == 0 &&
+               value.z == 0 &&
+               value.w == 1;
+    }
+
+
+    inline float length(quaternion const& value)
+    {
+#ifdef _WINDOWS_NUMERICS_NEON_
+        float32x4_t v = details::LoadNeon(value);
+        return sqrtf(vgetq_lane_f32(details::SumNeon(vmulq_f32(v, v)), 0));
+#else
+        return sqrtf(length_squared(value));
+#endif
+    }
+
+
+    inline float length_squared(quaternion const& value)
+    {
+        return dot(value, value);
+    }
+
+
+    inline float dot(quaternion const& quaternion1, quaternion const& quaternion2)
+    {
+        return quaternion1.x * quaternion2.x +
+               quaternion1.y * quaternion2.y + 
+               quaternion1.z * quaternion2.z + 
+               quaternion1.w * quaternion2.w;
+    }
+
+
+    inline quaternion normalize(quaternion const& value)
+    {
+#ifdef _WINDOWS_NUMERICS_NEON_
+        float32x4_t v = details::LoadNeon(value);
+
+        quaternion result;
+        details::StoreNeon(&result, details::DivideBySqrtNeon(v, details::SumNeon(vmulq_f32(v, v))));
+        return result;
+#else
+        return value * (1.0f / length(value));
+#endif
+    }
+
+
+    inline quaternion conjugate(quaternion const& value)
+    {
+#ifdef WINDOWS_NUMERICS_DISABLE_SIMD
+        return quaternion(-value.x,
+                          -value.y,
+                          -value.z,
+                           value.w);
+#else
+        using namespace ::DirectX;
+
+        quaternion result;
+        XMStoreQuaternion(&result, XMQuaternionConjugate(XMLoadQuaternion(&value)));
+        return result;
+#endif
     }
 
 
-    inline float3 translation(float4x4 const& value)
+    inline quaternion inverse(quaternion const& value)
     {
-        return float3(value.m41, value.m42, value.m43);
+        return conjugate(value * (1.0f / length_squared(value)));
     }
 
 
-    inline bool invert(float4x4 const& matrix, _Out_ float4x4* result)
+    inline quaternion slerp(quaternion const& quaternion1, quaternion const& quaternion2, float amount)
     {
-        //                                       -1
-        // If you have matrix M, inverse Matrix M   can compute
-        //
-        //     -1       1      
-        //    M   = --------- A
-        //            det(M)
-        //
-        // A is adjugate (adjoint) of M, where,
-        //
-        //      T
-        // A = C
-        //
-        // C is Cofactor matrix of M, where,
-        //           i + j
-        // C   = (-1)      * det(M  )
-        //  ij                    ij
-        //
-        //     [ a b c d ]
-        // M = [ e f g h ]
-        //     [ i j k l ]
-        //     [ m n o p ]
-        //
-        // First Row
-        //           2 | f g h |
-        // C   = (-1)  | j k l | = + ( f ( kp - lo ) - g ( jp - ln ) + h ( jo - kn ) )
-        //  11         | n o p |
-        //
-        //           3 | e g h |
-        // C   = (-1)  | i k l | = - ( e ( kp - lo ) - g ( ip - lm ) + h ( io - km ) )
-        //  12         | m o p |
-        //
-        //           4 | e f h |
-        // C   = (-1)  | i j l | = + ( e ( jp - ln ) - f ( ip - lm ) + h ( in - jm ) )
-        //  13         | m n p |
-        //
-        //           5 | e f g |
-        // C   = (-1)  | i j k | = - ( e ( jo - kn ) - f ( io - km ) + g ( in - jm ) )
-        //  14         | m n o |
-        //
-        // Second Row
-        //           3 | b c d |
-        // C   = (-1)  | j k l | = - ( b ( kp - lo ) - c ( jp - ln ) + d ( jo - kn ) )
-        //  21         | n o p |
-        //
-        //           4 | a c d |
-        // C   = (-1)  | i k l | = + ( a ( kp - lo ) - c ( ip - lm ) + d ( io - km ) )
-        //  22         | m o p |
-        //
-        //           5 | a b d |
-        // C   = (-1)  | i j l | = - ( a ( jp - ln ) - b ( ip - lm ) + d ( in - jm ) )
-        //  23         | m n p |
-        //
-        //           6 | a b c |
-        // C   = (-1)  | i j k | = + ( a ( jo - kn ) - b ( io - km ) + c ( in - jm ) )
-        //  24         | m n o |
-        //
-        // Third Row
-        //           4 | b c d |
-        // C   = (-1)  | f g h | = + ( b ( gp - ho ) - c ( fp - hn ) + d ( fo - gn ) )
-        //  31         | n o p |
-        //
-        //           5 | a c d |
-        // C   = (-1)  | e g h | = - ( a ( gp - ho ) - c ( ep - hm ) + d ( eo - gm ) )
-        //  32         | m o p |
-        //
-        //           6 | a b d |
-        // C   = (-1)  | e f h | = + ( a ( fp - hn ) - b ( ep - hm ) + d ( en - fm ) )
-        //  33         | m n p |
-        //
-        //           7 | a b c |
-        // C   = (-1)  | e f g | = - ( a ( fo - gn ) - b ( eo - gm ) + c ( en - fm ) )
-        //  34         | m n o |
-        //
-        // Fourth Row
-        //           5 | b c d |
-        // C   = (-1)  | f g h | = - ( b ( gl - hk ) - c ( fl - hj ) + d ( fk - gj ) )
-        //  41         | j k l |
-        //
-        //           6 | a c d |
-        // C   = (-1)  | e g h | = + ( a ( gl - hk ) - c ( el - hi ) + d ( ek - gi ) )
-        //  42         | i k l |
-        //
-        //           7 | a b d |
-        // C   = (-1)  | e f h | = - ( a ( fl - hj ) - b ( el - hi ) + d ( ej - fi ) )
-        //  43         | i j l |
-        //
-        //           8 | a b c |
-        // C   = (-1)  | e f g | = + ( a ( fk - gj ) - b ( ek - gi ) + c ( ej - fi ) )
-        //  44         | i j k |
-        //
-        float a = matrix.m11, b = matrix.m12, c = matrix.m13, d = matrix.m14;
-        float e = matrix.m21, f = matrix.m22, g = matrix.m23, h = matrix.m24;
-        float i = matrix.m31, j = matrix.m32, k = matrix.m33, l = matrix.m34;
-        float m = matrix.m41, n = matrix.m42, o = matrix.m43, p = matrix.m44;
+        const float epsilon = 1e-6f;
 
-        float kp_lo = k * p - l * o;
-        float jp_ln = j * p - l * n;
-        float jo_kn = j * o - k * n;
-        float ip_lm = i * p - l * m;
-        float io_km = i * o - k * m;
-        float in_jm = i * n - j * m;
+        float t = amount;
 
-        float a11 = +(f * kp_lo - g * jp_ln + h * jo_kn);
-        float a12 = -(e * kp_lo - g * ip_lm + h * io_km);
-        float a13 = +(e * jp_ln - f * ip_lm + h * in_jm);
-        float a14 = -(e * jo_kn - f * io_km + g * in_jm);
+#ifdef _WINDOWS_NUMERICS_NEON_
+        float32x4_t q1 = details::LoadNeon(quaternion1);
+        float32x4_t q2 = details::LoadNeon(quaternion2);
 
-        float det = a * a11 + b * a12 + c * a13 + d * a14;
+        float cosOmega = vgetq_lane_f32(details::SumNeon(vmulq_f32(q1, q2)), 0);
+#else
+        float cosOmega = dot(quaternion1, quaternion2);
+#endif
 
-        if (fabs(det) < FLT_EPSILON)
+        bool flip = false;
+        
+        if (cosOmega < 0.0f)
         {
-            const float nan = _WINDOWS_NUMERICS_NAN_;
+            flip = true;
+            cosOmega = -cosOmega;
+        }
 
-            *result = float4x4(nan, nan, nan, nan,
-                               nan, nan, nan, nan,
-                               nan, nan, nan, nan,
-                               nan, nan, nan, nan);
-            return false;
+        float s1, s2;
+        
+        if (cosOmega > (1.0f - epsilon))
+        {
+            // Too close, do straight linear interpolation.
+            s1 = 1.0f - t;
+            s2 = flip ? -t : t;
         }
+        else
+        {
+            float omega = acosf(cosOmega);
+            float invSinOmega = 1.0f / sinf(omega);
 
-        float invDet = 1.0f / det;
+            s1 = sinf((1.0f - t) * omega) * invSinOmega;
+            s2 = flip ? -sinf(t * omega) * invSinOmega
+                      :  sinf(t * omega) * invSinOmega;
+        }
 
-        result->m11 = a11 * invDet;
-        result->m21 = a12 * invDet;
-        result->m31 = a13 * invDet;
-        result->m41 = a14 * invDet;
+#if defined _WINDOWS_NUMERICS_NEON_
+        quaternion result;
+        details::StoreNeon(&result, vmlaq_n_f32(vmulq_n_f32(q1, s1), q2, s2));
+        return result;
+#elif defined WINDOWS_NUMERICS_DISABLE_SIMD
+        return quaternion(s1 * quaternion1.x + s2 * quaternion2.x,
+                          s1 * quaternion1.y + s2 * quaternion2.y,
+                          s1 * quaternion1.z + s2 * quaternion2.z,
+                          s1 * quaternion1.w + s2 * quaternion2.w);
+#else
+        using namespace ::DirectX;
 
-        result->m12 = -(b * kp_lo - c * jp_ln + d * jo_kn) * invDet;
-        result->m22 = +(a * kp_lo - c * ip_lm + d * io_km) * invDet;
-        result->m32 = -(a * jp_ln - b * ip_lm + d * in_jm) * invDet;
-        result->m42 = +(a * jo_kn - b * io_km + c * in_jm) * invDet;
+        XMVECTOR q1 = XMVectorScale(XMLoadQuaternion(&quaternion1), s1);
+        XMVECTOR q2 = XMVectorScale(XMLoadQuaternion(&quaternion2), s2);
 
-        float gp_ho = g * p - h * o;
-        float fp_hn = f * p - h * n;
-        float fo_gn = f * o - g * n;
-        float ep_hm = e * p - h * m;
-        float eo_gm = e * o - g * m;
-        float en_fm = e * n - f * m;
+        quaternion result;
+        XMStoreQuaternion(&result, XMVectorAdd(q1, q2));
+        return result;
+#endif
+    }
 
-        result->m13 = +(b * gp_ho - c * fp_hn + d * fo_gn) * invDet;
-        result->m23 = -(a * gp_ho - c * ep_hm + d * eo_gm) * invDet;
-        result->m33 = +(a * fp_hn - b * ep_hm + d * en_fm) * invDet;
-        result->m43 = -(a * fo_gn - b * eo_gm + c * en_fm) * invDet;
 
-        float gl_hk = g * l - h * k;
-        float fl_hj = f * l - h * j;
-        float fk_gj = f * k - g * j;
-        float el_hi = e * l - h * i;
-        float ek_gi = e * k - g * i;
-        float ej_fi = e * j - f * i;
+    inline quaternion lerp(quaternion const& quaternion1, quaternion const& quaternion2, float amount)
+    {
+        float t2 = amount;
+        float t1 = 1.0f - amount;
 
-        result->m14 = -(b * gl_hk - c * fl_hj + d * fk_gj) * invDet;
-        result->m24 = +(a * gl_hk - c * el_hi + d * ek_gi) * invDet;
-        result->m34 = -(a * fl_hj - b * el_hi + d * ej_fi) * invDet;
-        result->m44 = +(a * fk_gj - b * ek_gi + c * ej_fi) * invDet;
+        if (dot(quaternion1, quaternion2) < 0.0f)
+        {
+            t2 = -t2;
+        }
 
-        return true;
+#ifdef WINDOWS_NUMERICS_DISABLE_SIMD
+        return normalize(quaternion(t1 * quaternion1.x + t2 * quaternion2.x,
+                                    t1 * quaternion1.y + t2 * quaternion2.y,
+                                    t1 * quaternion1.z + t2 * quaternion2.z,
+                                    t1 * quaternion1.w + t2 * quaternion2.w));
+#else
+        using namespace ::DirectX;
+
+        XMVECTOR q1 = XMVectorScale(XMLoadQuaternion(&quaternion1), t1);
+        XMVECTOR q2 = XMVectorScale(XMLoadQuaternion(&quaternion2), t2);
+
+        quaternion result;
+        XMStoreQuaternion(&result, XMQuaternionNormalize(XMVectorAdd(q1, q2)));
+        return result;
+#endif
     }
 
 
-    inline bool decompose(float4x4 const& matrix, _Out_ float3* scale, _Out_ quaternion* rotation, _Out_ float3* translation)
+    inline quaternion concatenate(quaternion const& value1, quaternion const& value2)
+    {
+        return value2 * value1;
+    }
+
+
+    inline void normalize(_In_reads_(count) quaternion const* values, size_t count, _Out_writes_(count) quaternion* results)
     {
+        size_t i = 0;
+
+#ifdef _WINDOWS_NUMERICS_BATCH_SIMD_
         using namespace ::DirectX;
 
-        XMVECTOR s, r, t;
+        for (; i < count - count % 4; i += 4)
+        {
+            XMVECTOR x, y, z, w;
+            details::LoadFloat4x4(reinterpret_cast<float4 const*>(values + i), &x, &y, &z, &w);
 
-        if (!XMMatrixDecompose(&s, &r, &t, XMLoadFloat4x4(&matrix)))
+            XMVECTOR lengthSquared = XMVectorMultiplyAdd(x, x, XMVectorMultiplyAdd(y, y, XMVectorMultiplyAdd(z, z, XMVectorMultiply(w, w))));
+            XMVECTOR scale = XMVectorReciprocal(XMVectorSqrt(lengthSquared));
+
+            details::StoreFloat4x4(reinterpret_cast<float4*>(results + i),
+                                   XMVectorMultiply(x, scale),
+                                   XMVectorMultiply(y, scale),
+                                   XMVectorMultiply(z, scale),
+                                   XMVectorMultiply(w, scale));
+        }
+#endif
+
+        for (; i < count; i++)
         {
-            return false;
+            results[i] = normalize(values[i]);
         }
+    }
 
-        XMStoreFloat3(scale, s);
-        XMStoreQuaternion(rotation, r);
-        XMStoreFloat3(translation, t);
 
-        return true;
+    inline void slerp(_In_reads_(count) quaternion const* quaternions1, _In_reads_(count) quaternion const* quaternions2, size_t count, float amount, _Out_writes_(count) quaternion* results)
+    {
+        size_t i = 0;
+
+#ifdef _WINDOWS_NUMERICS_BATCH_SIMD_
+        using namespace ::DirectX;
+
+        // Same algorithm as the scalar slerp, but evaluating both the linear and
+        // spherical interpolation factors for every lane, then selecting between them.
+        const float epsilon = 1e-6f;
+
+        XMVECTOR t = XMVectorReplicate(amount);
+        XMVECTOR oneMinusT = XMVectorReplicate(1.0f - amount);
+        XMVECTOR linearThreshold = XMVectorReplicate(1.0f - epsilon);
+        XMVECTOR signMask = XMVectorSplatSignMask();
+        XMVECTOR zero = XMVectorZero();
+
+        for (; i < count - count % 4; i += 4)
+        {
+            XMVECTOR x1, y1, z1, w1;
+            XMVECTOR x2, y2, z2, w2;
+
+            details::LoadFloat4x4(reinterpret_cast<float4 const*>(quaternions1 + i), &x1, &y1, &z1, &w1);
+            details::LoadFloat4x4(reinterpret_cast<float4 const*>(quaternions2 + i), &x2, &y2, &z2, &w2);
+
+            XMVECTOR cosOmega = XMVectorMultiplyAdd(x1, x2, XMVectorMultiplyAdd(y1, y2, XMVectorMultiplyAdd(z1, z2, XMVectorMultiply(w1, w2))));
+
+            // Sign bit set in lanes where the dot product is negative, so we must flip quaternion2.
+            XMVECTOR flip = XMVectorAndInt(XMVectorLess(cosOmega, zero), signMask);
+
+            cosOmega = XMVectorXorInt(cosOmega, flip);
+
+            XMVECTOR omega = XMVectorACos(cosOmega);
+            XMVECTOR invSinOmega = XMVectorReciprocal(XMVectorSin(omega));
+
+            XMVECTOR s1 = XMVectorMultiply(XMVectorSin(XMVectorMultiply(oneMinusT, omega)), invSinOmega);
+            XMVECTOR s2 = XMVectorMultiply(XMVectorSin(XMVectorMultiply(t, omega)), invSinOmega);
+
+            // Too close, do straight linear interpolation.
+            XMVECTOR linear = XMVectorGreater(cosOmega, linearThreshold);
+
+            s1 = XMVectorSelect(s1, oneMinusT, linear);
+            s2 = XMVectorSelect(s2, t, linear);
+            s2 = XMVectorXorInt(s2, flip);
+
+            details::StoreFloat4x4(reinterpret_cast<float4*>(results + i),
+                                   XMVectorMultiplyAdd(s1, x1, XMVectorMultiply(s2, x2)),
+                                   XMVectorMultiplyAdd(s1, y1, XMVectorMultiply(s2, y2)),
+                                   XMVectorMultiplyAdd(s1, z1, XMVectorMultiply(s2, z2)),
+                                   XMVectorMultiplyAdd(s1, w1, XMVectorMultiply(s2, w2)));
+        }
+#endif
+
+        for (; i < count; i++)
+        {
+            results[i] = slerp(quaternions1[i], quaternions2[i], amount);
+        }
     }
 
 
-    inline float4x4 transform(float4x4 const& value, quaternion const& rotation)
+    inline void concatenate(_In_reads_(count) quaternion const* values1, _In_reads_(count) quaternion const* values2, size_t count, _Out_writes_(count) quaternion* results)
     {
-        // Compute rotation matrix.
-        float x2 = rotation.x + rotation.x;
-        float y2 = rotation.y + rotation.y;
-        float z2 = rotation.z + rotation.z;
-
-        float wx2 = rotation.w * x2;
-        float wy2 = rotation.w * y2;
-        float wz2 = rotation.w * z2;
-        float xx2 = rotation.x * x2;
-        float xy2 = rotation.x * y2;
-        float xz2 = rotation.x * z2;
-        float yy2 = rotation.y * y2;
-        float yz2 = rotation.y * z2;
-        float zz2 = rotation.z * z2;
+        size_t i = 0;
 
-        float q11 = 1 - yy2 - zz2;
-        float q21 = xy2 - wz2;
-        float q31 = xz2 + wy2;
+#ifdef _WINDOWS_NUMERICS_BATCH_SIMD_
+        using namespace ::DirectX;
 
-        float q12 = xy2 + wz2;
-        float q22 = 1 - xx2 - zz2;
-        float q32 = yz2 - wx2;
+        for (; i < count - count % 4; i += 4)
+        {
+            // concatenate(value1, value2) is value2 * value1, so a is value2 and b is value1.
+            XMVECTOR ax, ay, az, aw;
+            XMVECTOR bx, by, bz, bw;
 
-        float q13 = xz2 - wy2;
-        float q23 = yz2 + wx2;
-        float q33 = 1 - xx2 - yy2;
+            details::LoadFloat4x4(reinterpret_cast<float4 const*>(values2 + i), &ax, &ay, &az, &aw);
+            details::LoadFloat4x4(reinterpret_cast<float4 const*>(values1 + i), &bx, &by, &bz, &bw);
 
-        return float4x4
-        (
-            // First row
-            value.m11 * q11 + value.m12 * q21 + value.m13 * q31,
-            value.m11 * q12 + value.m12 * q22 + value.m13 * q32,
-            value.m11 * q13 + value.m12 * q23 + value.m13 * q33,
-            value.m14,
+            // Vector part: a.xyz * b.w + b.xyz * a.w + cross(a.xyz, b.xyz)
+            XMVECTOR x = XMVectorMultiplyAdd(ax, bw, XMVectorMultiplyAdd(bx, aw, XMVectorNegativeMultiplySubtract(az, by, XMVectorMultiply(ay, bz))));
+            XMVECTOR y = XMVectorMultiplyAdd(ay, bw, XMVectorMultiplyAdd(by, aw, XMVectorNegativeMultiplySubtract(ax, bz, XMVectorMultiply(az, bx))));
+            XMVECTOR z = XMVectorMultiplyAdd(az, bw, XMVectorMultiplyAdd(bz, aw, XMVectorNegativeMultiplySubtract(ay, bx, XMVectorMultiply(ax, by))));
 
-            // Second row
-            value.m21 * q11 + value.m22 * q21 + value.m23 * q31,
-            value.m21 * q12 + value.m22 * q22 + value.m23 * q32,
-            value.m21 * q13 + value.m22 * q23 + value.m23 * q33,
-            value.m24,
+            // Scalar part: a.w * b.w - dot(a.xyz, b.xyz)
+            XMVECTOR w = XMVectorNegativeMultiplySubtract(ax, bx, XMVectorNegativeMultiplySubtract(ay, by, XMVectorNegativeMultiplySubtract(az, bz, XMVectorMultiply(aw, bw))));
 
-            // Third row
-            value.m31 * q11 + value.m32 * q21 + value.m33 * q31,
-            value.m31 * q12 + value.m32 * q22 + value.m33 * q32,
-            value.m31 * q13 + value.m32 * q23 + value.m33 * q33,
-            value.m34,
+            details::StoreFloat4x4(reinterpret_cast<float4*>(results + i), x, y, z, w);
+        }
+#endif
 
-            // Fourth row
-            value.m41 * q11 + value.m42 * q21 + value.m43 * q31,
-            value.m41 * q12 + value.m42 * q22 + value.m43 * q32,
-            value.m41 * q13 + value.m42 * q23 + value.m43 * q33,
-            value.m44
-        );
+        for (; i < count; i++)
+        {
+            results[i] = concatenate(values1[i], values2[i]);
+        }
     }
 
 
-    inline float4x4 transpose(float4x4 const& matrix)
+    namespace details
     {
-#ifdef WINDOWS_NUMERICS_DISABLE_SIMD
-        return float4x4(matrix.m11, matrix.m21, matrix.m31, matrix.m41,
-                        matrix.m12, matrix.m22, matrix.m32, matrix.m42,
-                        matrix.m13, matrix.m23, matrix.m33, matrix.m43,
-                        matrix.m14, matrix.m24, matrix.m34, matrix.m44);
+        // Half precision conversion of a contiguous run of floats, using the hardware
+        // conversion instructions where available. DirectXMath provides the fallback.
+        inline void ConvertFloatToHalf(_In_reads_(count) float const* source, size_t count, _Out_writes_(count) uint16_t* destination)
+        {
+#ifdef _WINDOWS_NUMERICS_AVX2_
+            if (UseAvx2())
+            {
+                ConvertFloatToHalfAvx2(source, count, destination);
+                return;
+            }
+#endif
+
+#if defined _WINDOWS_NUMERICS_NEON_ && defined _WINDOWS_NUMERICS_NEON_AARCH64_
+            ConvertFloatToHalfNeon(source, count, destination);
 #else
-        using namespace ::DirectX;
+            ::DirectX::PackedVector::XMConvertFloatToHalfStream(destination, sizeof(uint16_t), source, sizeof(float), count);
+#endif
+        }
 
-        float4x4 result;
-        XMStoreFloat4x4(&result, XMMatrixTranspose(XMLoadFloat4x4(&matrix)));
-        return result;
+
+        inline void ConvertHalfToFloat(_In_reads_(count) uint16_t const* source, size_t count, _Out_writes_(count) float* destination)
+        {
+#ifdef _WINDOWS_NUMERICS_AVX2_
+            if (UseAvx2())
+            {
+                ConvertHalfToFloatAvx2(source, count, destination);
+                return;
+            }
 #endif
-    }
+
+#if defined _WINDOWS_NUMERICS_NEON_ && defined _WINDOWS_NUMERICS_NEON_AARCH64_
+            ConvertHalfToFloatNeon(source, count, destination);
+#else
+            ::DirectX::PackedVector::XMConvertHalfToFloatStream(destination, sizeof(float), source, sizeof(uint16_t), count);
+#endif
+        }
 
 
-    inline float4x4 lerp(float4x4 const& matrix1, float4x4 const& matrix2, float amount)
-    {
-        return matrix1 + (matrix2 - matrix1) * amount;
+        inline uint8_t FloatToUnorm8(float value)
+        {
+            // Written so that NaN converts to zero.
+            value = (value > 0) ? value : 0;
+            value = (value < 1) ? value : 1;
+
+            return static_cast<uint8_t>(value * 255.0f + 0.5f);
+        }
     }
 
 
-    inline plane::plane(float x, float y, float z, float d)
-        : normal(x, y, z), d(d)
+    inline half2::half2(uint16_t x, uint16_t y)
+        : x(x), y(y)
     { }
 
 
-    inline plane::plane(float3 normal, float d)
-        : normal(normal), d(d)
+    inline half4::half4(uint16_t x, uint16_t y, uint16_t z, uint16_t w)
+        : x(x), y(y), z(z), w(w)
     { }
 
 
-    inline plane::plane(float4 value)
-        : normal(value.x, value.y, value.z), d(value.w)
+    inline unorm8x4::unorm8x4(uint8_t x, uint8_t y, uint8_t z, uint8_t w)
+        : x(x), y(y), z(z), w(w)
     { }
 
 
-    inline plane make_plane_from_vertices(float3 const& point1, float3 const& point2, float3 const& point3)
+    inline half2 make_half2_from_float2(float2 const& value)
     {
-        float3 a = point2 - point1;
-        float3 b = point3 - point1;
-
-        float3 normal = normalize(cross(a, b));
-        float d = -dot(normal, point1);
+        using namespace ::DirectX::PackedVector;
 
-        return plane(normal, d);
+        return half2(XMConvertFloatToHalf(value.x),
+                     XMConvertFloatToHalf(value.y));
     }
 
 
-    inline bool operator ==(plane const& value1, plane const& value2)
+    inline half4 make_half4_from_float4(float4 const& value)
     {
-        return value1.normal.x == value2.normal.x &&
-               value1.normal.y == value2.normal.y &&
-               value1.normal.z == value2.normal.z &&
-               value1.d == value2.d;
+        using namespace ::DirectX::PackedVector;
+
+        return half4(XMConvertFloatToHalf(value.x),
+                     XMConvertFloatToHalf(value.y),
+                     XMConvertFloatToHalf(value.z),
+                     XMConvertFloatToHalf(value.w));
     }
 
 
-    inline bool operator !=(plane const& value1, plane const& value2)
+    inline unorm8x4 make_unorm8x4_from_float4(float4 const& value)
     {
-        return value1.normal.x != value2.normal.x ||
-               value1.normal.y != value2.normal.y || 
-               value1.normal.z != value2.normal.z ||
-               value1.d != value2.d;
+        return unorm8x4(details::FloatToUnorm8(value.x),
+                        details::FloatToUnorm8(value.y),
+                        details::FloatToUnorm8(value.z),
+                        details::FloatToUnorm8(value.w));
     }
 
 
-    inline plane normalize(plane const& value)
+    inline float2 make_float2_from_half2(half2 const& value)
     {
-#ifdef WINDOWS_NUMERICS_DISABLE_SIMD
-        float f = length_squared(value.normal);
-
-        if (fabs(f - 1.0f) < FLT_EPSILON)
-        {
-            return value;
-        }
-
-        float fInv = 1.0f / sqrtf(f);
+        using namespace ::DirectX::PackedVector;
 
-        return plane(value.normal * fInv, value.d * fInv);
-#else
-        using namespace ::DirectX;
-
-        plane result;
-        XMStorePlane(&result, XMPlaneNormalize(XMLoadPlane(&value)));
-        return result;
-#endif
+        return float2(XMConvertHalfToFloat(value.x),
+                      XMConvertHalfToFloat(value.y));
     }
 
 
-    inline plane transform(plane const& value, float4x4 const& matrix)
+    inline float4 make_float4_from_half4(half4 const& value)
     {
-        float4x4 inverseMatrix;
-        invert(matrix, &inverseMatrix);
-
-#ifdef WINDOWS_NUMERICS_DISABLE_SIMD
-        float4 planeAsVector(value.normal, value.d);
-
-        return plane(transform(planeAsVector, transpose(inverseMatrix)));
-#else
-        using namespace ::DirectX;
+        using namespace ::DirectX::PackedVector;
 
-        plane result;
-        XMStorePlane(&result, XMPlaneTransform(XMLoadPlane(&value), XMMatrixTranspose(XMLoadFloat4x4(&inverseMatrix))));
-        return result;
-#endif
+        return float4(XMConvertHalfToFloat(value.x),
+                      XMConvertHalfToFloat(value.y),
+                      XMConvertHalfToFloat(value.z),
+                      XMConvertHalfToFloat(value.w));
     }
 
 
-    inline plane transform(plane const& value, quaternion const& rotation)
+    inline float4 make_float4_from_unorm8x4(unorm8x4 const& value)
     {
-        float4 planeAsVector(value.normal, value.d);
+        const float scale = 1.0f / 255.0f;
 
-        return plane(transform(planeAsVector, rotation));
+        return float4(value.x * scale,
+                      value.y * scale,
+                      value.z * scale,
+                      value.w * scale);
     }
 
 
-    inline float dot(plane const& plane, float4 const& value)
+    inline bool operator ==(half2 const& value1, half2 const& value2)
     {
-        return plane.normal.x * value.x +
-               plane.normal.y * value.y + 
-               plane.normal.z * value.z + 
-               plane.d * value.w;
+        return value1.x == value2.x &&
+               value1.y == value2.y;
     }
 
 
-    inline float dot_coordinate(plane const& plane, float3 const& value)
+    inline bool operator !=(half2 const& value1, half2 const& value2)
     {
-        return plane.normal.x * value.x +
-               plane.normal.y * value.y + 
-               plane.normal.z * value.z + 
-               plane.d;
+        return value1.x != value2.x ||
+               value1.y != value2.y;
     }
 
 
-    inline float dot_normal(plane const& plane, float3 const& value)
+    inline bool operator ==(half4 const& value1, half4 const& value2)
     {
-        return plane.normal.x * value.x +
-               plane.normal.y * value.y + 
-               plane.normal.z * value.z;
+        return value1.x == value2.x &&
+               value1.y == value2.y &&
+               value1.z == value2.z &&
+               value1.w == value2.w;
     }
 
 
-    inline quaternion::quaternion(float x, float y, float z, float w)
-        : x(x), y(y), z(z), w(w)
-    { }
+    inline bool operator !=(half4 const& value1, half4 const& value2)
+    {
+        return value1.x != value2.x ||
+               value1.y != value2.y ||
+               value1.z != value2.z ||
+               value1.w != value2.w;
+    }
 
 
-    inline quaternion::quaternion(float3 vectorPart, float scalarPart)
-        : x(vectorPart.x), y(vectorPart.y), z(vectorPart.z), w(scalarPart)
-    { }
+    inline bool operator ==(unorm8x4 const& value1, unorm8x4 const& value2)
+    {
+        return value1.x == value2.x &&
+               value1.y == value2.y &&
+               value1.z == value2.z &&
+               value1.w == value2.w;
+    }
 
 
-    inline quaternion quaternion::identity()
+    inline bool operator !=(unorm8x4 const& value1, unorm8x4 const& value2)
     {
-        return quaternion(0, 0, 0, 1);
+        return value1.x != value2.x ||
+               value1.y != value2.y ||
+               value1.z != value2.z ||
+               value1.w != value2.w;
     }
 
 
-    inline quaternion make_quaternion_from_axis_angle(float3 const& axis, float angle)
+    inline void make_half2_from_float2(_In_reads_(count) float2 const* values, size_t count, _Out_writes_(count) half2* results)
     {
-        float halfAngle = angle * 0.5f;
-        float s = sinf(halfAngle);
-        float c = cosf(halfAngle);
-
-        return quaternion(axis * s, c);
+        details::ConvertFloatToHalf(&values->x, count * 2, &results->x);
     }
 
 
-    inline quaternion make_quaternion_from_yaw_pitch_roll(float yaw, float pitch, float roll)
+    inline void make_half4_from_float4(_In_reads_(count) float4 const* values, size_t count, _Out_writes_(count) half4* results)
     {
-        // Roll first, about axis the object is facing, then
-        // pitch upward, then yaw to face into the new heading
-        float sr, cr, sp, cp, sy, cy;
+        details::ConvertFloatToHalf(&values->x, count * 4, &results->x);
+    }
 
-        float halfRoll = roll * 0.5f;
-        sr = sinf(halfRoll); cr = cosf(halfRoll);
 
-        float halfPitch = pitch * 0.5f;
-        sp = sinf(halfPitch); cp = cosf(halfPitch);
+    inline void make_float2_from_half2(_In_reads_(count) half2 const* values, size_t count, _Out_writes_(count) float2* results)
+    {
+        details::ConvertHalfToFloat(&values->x, count * 2, &results->x);
+    }
 
-        float halfYaw = yaw * 0.5f;
-        sy = sinf(halfYaw); cy = cosf(halfYaw);
 
-        return quaternion(cy * sp * cr + sy * cp * sr,
-                          sy * cp * cr - cy * sp * sr,
-                          cy * cp * sr - sy * sp * cr,
-                          cy * cp * cr + sy * sp * sr);
+    inline void make_float4_from_half4(_In_reads_(count) half4 const* values, size_t count, _Out_writes_(count) float4* results)
+    {
+        details::ConvertHalfToFloat(&values->x, count * 4, &results->x);
     }
 
 
-    inline quaternion make_quaternion_from_rotation_matrix(float4x4 const& matrix)
+    inline void make_unorm8x4_from_float4(_In_reads_(count) float4 const* values, size_t count, _Out_writes_(count) unorm8x4* results)
     {
-        if (matrix.m11 + matrix.m22 + matrix.m33 > 0.0f)
-        {
-            float s = sqrtf(1.0f + matrix.m11 + matrix.m22 + matrix.m33);
-            float invS = 0.5f / s;
+        size_t i = 0;
 
-            return quaternion((matrix.m23 - matrix.m32) * invS,
-                              (matrix.m31 - matrix.m13) * invS,
-                              (matrix.m12 - matrix.m21) * invS,
-                              s * 0.5f);
-        }
-        else if (matrix.m11 >= matrix.m22 && matrix.m11 >= matrix.m33)
+#if defined _WINDOWS_NUMERICS_NEON_
+        for (; i < count - count % 4; i += 4)
         {
-            float s = sqrtf(1.0f + matrix.m11 - matrix.m22 - matrix.m33);
-            float invS = 0.5f / s;
+            uint16x4_t a = vmovn_u32(details::ToUnorm8Neon(vld1q_f32(&values[i].x)));
+            uint16x4_t b = vmovn_u32(details::ToUnorm8Neon(vld1q_f32(&values[i + 1].x)));
+            uint16x4_t c = vmovn_u32(details::ToUnorm8Neon(vld1q_f32(&values[i + 2].x)));
+            uint16x4_t d = vmovn_u32(details::ToUnorm8Neon(vld1q_f32(&values[i + 3].x)));
 
-            return quaternion(0.5f * s,
-                              (matrix.m12 + matrix.m21) * invS,
-                              (matrix.m13 + matrix.m31) * invS,
-                              (matrix.m23 - matrix.m32) * invS);
+            vst1q_u8(&results[i].x, vcombine_u8(vmovn_u16(vcombine_u16(a, b)), vmovn_u16(vcombine_u16(c, d))));
         }
-        else if (matrix.m22 > matrix.m33)
+#elif defined _WINDOWS_NUMERICS_BATCH_SIMD_ && defined _XM_SSE_INTRINSICS_
+        using namespace ::DirectX;
+
+        XMVECTOR scale = XMVectorReplicate(255.0f);
+        XMVECTOR half = XMVectorReplicate(0.5f);
+
+        for (; i < count - count % 4; i += 4)
         {
-            float s = sqrtf(1.0f + matrix.m22 - matrix.m11 - matrix.m33);
-            float invS = 0.5f / s;
+            __m128i a = _mm_cvttps_epi32(XMVectorMultiplyAdd(XMVectorSaturate(XMLoadFloat4(values + i)),     scale, half));
+            __m128i b = _mm_cvttps_epi32(XMVectorMultiplyAdd(XMVectorSaturate(XMLoadFloat4(values + i + 1)), scale, half));
+            __m128i c = _mm_cvttps_epi32(XMVectorMultiplyAdd(XMVectorSaturate(XMLoadFloat4(values + i + 2)), scale, half));
+            __m128i d = _mm_cvttps_epi32(XMVectorMultiplyAdd(XMVectorSaturate(XMLoadFloat4(values + i + 3)), scale, half));
 
-            return quaternion((matrix.m21 + matrix.m12) * invS,
-                              0.5f * s,
-                              (matrix.m32 + matrix.m23) * invS,
-                              (matrix.m31 - matrix.m13) * invS);
+            // Every value is already in the range 0 to 255, so the saturating packs just narrow them.
+            __m128i bytes = _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d));
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(results + i), bytes);
         }
-        else
-        {
-            float s = sqrtf(1.0f + matrix.m33 - matrix.m11 - matrix.m22);
-            float invS = 0.5f / s;
+#endif
 
-            return quaternion((matrix.m31 + matrix.m13) * invS,
-                              (matrix.m32 + matrix.m23) * invS,
-                              0.5f * s,
-                              (matrix.m12 - matrix.m21) * invS);
+        for (; i < count; i++)
+        {
+            results[i] = make_unorm8x4_from_float4(values[i]);
         }
     }
 
 
-    inline quaternion operator +(quaternion const& value1, quaternion const& value2)
+    inline void make_float4_from_unorm8x4(_In_reads_(count) unorm8x4 const* values, size_t count, _Out_writes_(count) float4* results)
     {
-#ifdef WINDOWS_NUMERICS_DISABLE_SIMD
-        return quaternion(value1.x + value2.x,
-                          value1.y + value2.y,
-                          value1.z + value2.z,
-                          value1.w + value2.w);
-#else
+        size_t i = 0;
+
+#if defined _WINDOWS_NUMERICS_NEON_
+        const float scale = 1.0f / 255.0f;
+
+        for (; i < count - count % 4; i += 4)
+        {
+            uint8x16_t bytes = vld1q_u8(&values[i].x);
+
+            uint16x8_t low = vmovl_u8(vget_low_u8(bytes));
+            uint16x8_t high = vmovl_u8(vget_high_u8(bytes));
+
+            vst1q_f32(&results[i].x,     vmulq_n_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(low))), scale));
+            vst1q_f32(&results[i + 1].x, vmulq_n_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(low))), scale));
+            vst1q_f32(&results[i + 2].x, vmulq_n_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(high))), scale));
+            vst1q_f32(&results[i + 3].x, vmulq_n_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(high))), scale));
+        }
+#elif defined _WINDOWS_NUMERICS_BATCH_SIMD_ && defined _XM_SSE_INTRINSICS_
         using namespace ::DirectX;
 
-        quaternion result;
-        XMStoreQuaternion(&result, XMVectorAdd(XMLoadQuaternion(&value1), XMLoadQuaternion(&value2)));
-        return result;
+        XMVECTOR scale = XMVectorReplicate(1.0f / 255.0f);
+        __m128i zero = _mm_setzero_si128();
+
+        for (; i < count - count % 4; i += 4)
+        {
+            __m128i bytes = _mm_loadu_si128(reinterpret_cast<__m128i const*>(values + i));
+
+            __m128i low = _mm_unpacklo_epi8(bytes, zero);
+            __m128i high = _mm_unpackhi_epi8(bytes, zero);
+
+            XMStoreFloat4(results + i,     XMVectorMultiply(_mm_cvtepi32_ps(_mm_unpacklo_epi16(low, zero)), scale));
+            XMStoreFloat4(results + i + 1, XMVectorMultiply(_mm_cvtepi32_ps(_mm_unpackhi_epi16(low, zero)), scale));
+            XMStoreFloat4(results + i + 2, XMVectorMultiply(_mm_cvtepi32_ps(_mm_unpacklo_epi16(high, zero)), scale));
+            XMStoreFloat4(results + i + 3, XMVectorMultiply(_mm_cvtepi32_ps(_mm_unpackhi_epi16(high, zero)), scale));
+        }
 #endif
+
+        for (; i < count; i++)
+        {
+            results[i] = make_float4_from_unorm8x4(values[i]);
+        }
     }
 
 
-    inline quaternion operator -(quaternion const& value1, quaternion const& value2)
+    inline aabb2::aabb2(float2 const& minimum, float2 const& maximum)
+        : minimum(minimum), maximum(maximum)
+    { }
+
+
+    inline aabb3::aabb3(float3 const& minimum, float3 const& maximum)
+        : minimum(minimum), maximum(maximum)
+    { }
+
+
+    inline aabb2 aabb2::empty()
     {
-#ifdef WINDOWS_NUMERICS_DISABLE_SIMD
-        return quaternion(value1.x - value2.x,
-                          value1.y - value2.y,
-                          value1.z - value2.z,
-                          value1.w - value2.w);
-#else
-        using namespace ::DirectX;
+        return aabb2(float2(FLT_MAX), float2(-FLT_MAX));
+    }
 
-        quaternion result;
-        XMStoreQuaternion(&result, XMVectorSubtract(XMLoadQuaternion(&value1), XMLoadQuaternion(&value2)));
-        return result;
-#endif
+
+    inline aabb3 aabb3::empty()
+    {
+        return aabb3(float3(FLT_MAX), float3(-FLT_MAX));
     }
 
 
-    inline quaternion operator *(quaternion const& value1, quaternion const& value2)
+    inline aabb2 make_aabb2_from_points(_In_reads_(count) float2 const* points, size_t count)
     {
-#ifdef WINDOWS_NUMERICS_DISABLE_SIMD
-        float3 q1(value1.x, value1.y, value1.z);
-        float3 q2(value2.x, value2.y, value2.z);
+        aabb2 result = aabb2::empty();
 
-        float3 c = cross(q1, q2);
-        float d = dot(q1, q2);
+        size_t i = 0;
 
-        return quaternion(q1 * value2.w + q2 * value1.w + c,
-                          value1.w * value2.w - d);
-#else
+#ifdef _WINDOWS_NUMERICS_BATCH_SIMD_
         using namespace ::DirectX;
 
-        quaternion result;
-        XMStoreQuaternion(&result, XMQuaternionMultiply(XMLoadQuaternion(&value2), XMLoadQuaternion(&value1)));
-        return result;
+        if (count >= 4)
+        {
+            // Each register holds two points. Two sets of accumulators keep
+            // consecutive iterations independent of each other.
+            XMVECTOR min0 = XMLoadFloat4(reinterpret_cast<XMFLOAT4 const*>(points));
+            XMVECTOR min1 = XMLoadFloat4(reinterpret_cast<XMFLOAT4 const*>(points + 2));
+            XMVECTOR max0 = min0;
+            XMVECTOR max1 = min1;
+
+            for (i = 4; i < count - count % 4; i += 4)
+            {
+                XMVECTOR a = XMLoadFloat4(reinterpret_cast<XMFLOAT4 const*>(points + i));
+                XMVECTOR b = XMLoadFloat4(reinterpret_cast<XMFLOAT4 const*>(points + i + 2));
+
+                min0 = XMVectorMin(min0, a);
+                max0 = XMVectorMax(max0, a);
+                min1 = XMVectorMin(min1, b);
+                max1 = XMVectorMax(max1, b);
+            }
+
+            XMVECTOR minimum = XMVectorMin(min0, min1);
+            XMVECTOR maximum = XMVectorMax(max0, max1);
+
+            XMStoreFloat2(&result.minimum, XMVectorMin(minimum, XMVectorSwizzle<2, 3, 0, 1>(minimum)));
+            XMStoreFloat2(&result.maximum, XMVectorMax(maximum, XMVectorSwizzle<2, 3, 0, 1>(maximum)));
+        }
 #endif
+
+        for (; i < count; i++)
+        {
+            result = merge(result, points[i]);
+        }
+
+        return result;
     }
 
 
-    inline quaternion operator *(quaternion const& value1, float value2)
+    inline aabb3 make_aabb3_from_points(_In_reads_(count) float3 const* points, size_t count)
     {
-#ifdef WINDOWS_NUMERICS_DISABLE_SIMD
-        return quaternion(value1.x * value2,
-                          value1.y * value2,
-                          value1.z * value2,
-                          value1.w * value2);
-#else
+        aabb3 result = aabb3::empty();
+
+        size_t i = 0;
+
+#ifdef _WINDOWS_NUMERICS_BATCH_SIMD_
         using namespace ::DirectX;
 
-        quaternion result;
-        XMStoreQuaternion(&result, XMVectorScale(XMLoadQuaternion(&value1), value2));
-        return result;
+        if (count >= 4)
+        {
+            XMVECTOR minX, minY, minZ;
+            details::LoadFloat3x4(points, &minX, &minY, &minZ);
+
+            XMVECTOR maxX = minX;
+            XMVECTOR maxY = minY;
+            XMVECTOR maxZ = minZ;
+
+            for (i = 4; i < count - count % 4; i += 4)
+            {
+                XMVECTOR x, y, z;
+                details::LoadFloat3x4(points + i, &x, &y, &z);
+
+                minX = XMVectorMin(minX, x);
+                minY = XMVectorMin(minY, y);
+                minZ = XMVectorMin(minZ, z);
+                maxX = XMVectorMax(maxX, x);
+                maxY = XMVectorMax(maxY, y);
+                maxZ = XMVectorMax(maxZ, z);
+            }
+
+            result.minimum = float3(details::HorizontalMin(minX), details::HorizontalMin(minY), details::HorizontalMin(minZ));
+            result.maximum = float3(details::HorizontalMax(maxX), details::HorizontalMax(maxY), details::HorizontalMax(maxZ));
+        }
 #endif
+
+        for (; i < count; i++)
+        {
+            result = merge(result, points[i]);
+        }
+
+        return result;
     }
 
 
-    inline quaternion operator /(quaternion const& value1, quaternion const& value2)
+    inline bool operator ==(aabb2 const& value1, aabb2 const& value2)
     {
-        return value1 * inverse(value2);
+        return value1.minimum == value2.minimum &&
+               value1.maximum == value2.maximum;
     }
 
 
-    inline quaternion operator -(quaternion const& value)
+    inline bool operator !=(aabb2 const& value1, aabb2 const& value2)
     {
-#ifdef WINDOWS_NUMERICS_DISABLE_SIMD
-        return quaternion(-value.x,
-                          -value.y,
-                          -value.z,
-                          -value.w);
-#else
-        using namespace ::DirectX;
-
-        quaternion result;
-        XMStoreQuaternion(&result, XMVectorNegate(XMLoadQuaternion(&value)));
-        return result;
-#endif
+        return value1.minimum != value2.minimum ||
+               value1.maximum != value2.maximum;
     }
 
 
-    inline quaternion& operator +=(quaternion& value1, quaternion const& value2)
+    inline bool operator ==(aabb3 const& value1, aabb3 const& value2)
     {
-        value1 = value1 + value2;
+        return value1.minimum == value2.minimum &&
+               value1.maximum == value2.maximum;
+    }
 
-        return value1;
+
+    inline bool operator !=(aabb3 const& value1, aabb3 const& value2)
+    {
+        return value1.minimum != value2.minimum ||
+               value1.maximum != value2.maximum;
     }
 
 
-    inline quaternion& operator -=(quaternion& value1, quaternion const& value2)
+    inline bool is_empty(aabb2 const& value)
     {
-        value1 = value1 - value2;
+        return value.minimum.x > value.maximum.x ||
+               value.minimum.y > value.maximum.y;
+    }
 
-        return value1;
+
+    inline bool is_empty(aabb3 const& value)
+    {
+        return value.minimum.x > value.maximum.x ||
+               value.minimum.y > value.maximum.y ||
+               value.minimum.z > value.maximum.z;
     }
 
 
-    inline quaternion& operator *=(quaternion& value1, quaternion const& value2)
+    inline float2 center(aabb2 const& value)
     {
-        value1 = value1 * value2;
+        return (value.minimum + value.maximum) * 0.5f;
+    }
 
-        return value1;
+
+    inline float3 center(aabb3 const& value)
+    {
+        return (value.minimum + value.maximum) * 0.5f;
     }
 
 
-    inline quaternion& operator *=(quaternion& value1, float value2)
+    inline float2 size(aabb2 const& value)
     {
-        value1 = value1 * value2;
+        return value.maximum - value.minimum;
+    }
 
-        return value1;
+
+    inline float3 size(aabb3 const& value)
+    {
+        return value.maximum - value.minimum;
     }
 
 
-    inline quaternion& operator /=(quaternion& value1, quaternion const& value2)
+    inline aabb2 merge(aabb2 const& value1, aabb2 const& value2)
     {
-        value1 = value1 / value2;
+        return aabb2((min)(value1.minimum, value2.minimum),
+                     (max)(value1.maximum, value2.maximum));
+    }
 
-        return value1;
+
+    inline aabb3 merge(aabb3 const& value1, aabb3 const& value2)
+    {
+        return aabb3((min)(value1.minimum, value2.minimum),
+                     (max)(value1.maximum, value2.maximum));
     }
 
 
-    inline bool operator ==(quaternion const& value1, quaternion const& value2)
+    inline aabb2 merge(aabb2 const& value, float2 const& point)
     {
-        return value1.x == value2.x &&
-               value1.y == value2.y &&
-               value1.z == value2.z &&
-               value1.w == value2.w;
+        return aabb2((min)(value.minimum, point),
+                     (max)(value.maximum, point));
     }
 
 
-    inline bool operator !=(quaternion const& value1, quaternion const& value2)
+    inline aabb3 merge(aabb3 const& value, float3 const& point)
     {
-        return value1.x != value2.x ||
-               value1.y != value2.y ||
-               value1.z != value2.z ||
-               value1.w != value2.w;
+        return aabb3((min)(value.minimum, point),
+                     (max)(value.maximum, point));
     }
 
 
-    inline bool is_identity(quaternion const& value)
+    inline aabb2 intersect(aabb2 const& value1, aabb2 const& value2)
     {
-        return value.x == 0 &&
-               value.y == 0 &&
-               value.z == 0 &&
-               value.w == 1;
+        // The result is empty if the boxes do not overlap.
+        return aabb2((max)(value1.minimum, value2.minimum),
+                     (min)(value1.maximum, value2.maximum));
     }
 
 
-    inline float length(quaternion const& value)
+    inline aabb3 intersect(aabb3 const& value1, aabb3 const& value2)
     {
-        return sqrtf(length_squared(value));
+        // The result is empty if the boxes do not overlap.
+        return aabb3((max)(value1.minimum, value2.minimum),
+                     (min)(value1.maximum, value2.maximum));
     }
 
 
-    inline float length_squared(quaternion const& value)
+    inline bool intersects(aabb2 const& value1, aabb2 const& value2)
     {
-        return dot(value, value);
+        return !is_empty(intersect(value1, value2));
     }
 
 
-    inline float dot(quaternion const& quaternion1, quaternion const& quaternion2)
+    inline bool intersects(aabb3 const& value1, aabb3 const& value2)
     {
-        return quaternion1.x * quaternion2.x +
-               quaternion1.y * quaternion2.y + 
-               quaternion1.z * quaternion2.z + 
-               quaternion1.w * quaternion2.w;
+        return !is_empty(intersect(value1, value2));
     }
 
 
-    inline quaternion normalize(quaternion const& value)
+    inline bool contains(aabb2 const& value, float2 const& point)
     {
-        return value * (1.0f / length(value));
+        return point.x >= value.minimum.x && point.x <= value.maximum.x &&
+               point.y >= value.minimum.y && point.y <= value.maximum.y;
     }
 
 
-    inline quaternion conjugate(quaternion const& value)
+    inline bool contains(aabb3 const& value, float3 const& point)
     {
-#ifdef WINDOWS_NUMERICS_DISABLE_SIMD
-        return quaternion(-value.x,
-                          -value.y,
-                          -value.z,
-                           value.w);
-#else
-        using namespace ::DirectX;
+        return point.x >= value.minimum.x && point.x <= value.maximum.x &&
+               point.y >= value.minimum.y && point.y <= value.maximum.y &&
+               point.z >= value.minimum.z && point.z <= value.maximum.z;
+    }
 
-        quaternion result;
-        XMStoreQuaternion(&result, XMQuaternionConjugate(XMLoadQuaternion(&value)));
-        return result;
-#endif
+
+    inline bool contains(aabb2 const& value, aabb2 const& other)
+    {
+        return is_empty(other) ||
+               (contains(value, other.minimum) && contains(value, other.maximum));
     }
 
 
-    inline quaternion inverse(quaternion const& value)
+    inline bool contains(aabb3 const& value, aabb3 const& other)
     {
-        return conjugate(value * (1.0f / length_squared(value)));
+        return is_empty(other) ||
+               (contains(value, other.minimum) && contains(value, other.maximum));
     }
 
 
-    inline quaternion slerp(quaternion const& quaternion1, quaternion const& quaternion2, float amount)
+    inline aabb2 transform(aabb2 const& value, float3x2 const& matrix)
     {
-        const float epsilon = 1e-6f;
+        if (is_empty(value))
+            return value;
 
-        float t = amount;
-        float cosOmega = dot(quaternion1, quaternion2);
-        bool flip = false;
-        
-        if (cosOmega < 0.0f)
-        {
-            flip = true;
-            cosOmega = -cosOmega;
-        }
+        // Each row of the matrix contributes its smallest and largest product
+        // to the new bounds, which then enclose all four transformed corners.
+        float2 minimum(matrix.m31, matrix.m32);
+        float2 maximum = minimum;
 
-        float s1, s2;
-        
-        if (cosOmega > (1.0f - epsilon))
-        {
-            // Too close, do straight linear interpolation.
-            s1 = 1.0f - t;
-            s2 = flip ? -t : t;
-        }
-        else
-        {
-            float omega = acosf(cosOmega);
-            float invSinOmega = 1.0f / sinf(omega);
+        float2 a = float2(matrix.m11, matrix.m12) * value.minimum.x;
+        float2 b = float2(matrix.m11, matrix.m12) * value.maximum.x;
 
-            s1 = sinf((1.0f - t) * omega) * invSinOmega;
-            s2 = flip ? -sinf(t * omega) * invSinOmega
-                      :  sinf(t * omega) * invSinOmega;
-        }
+        minimum += (min)(a, b);
+        maximum += (max)(a, b);
 
-#ifdef WINDOWS_NUMERICS_DISABLE_SIMD
-        return quaternion(s1 * quaternion1.x + s2 * quaternion2.x,
-                          s1 * quaternion1.y + s2 * quaternion2.y,
-                          s1 * quaternion1.z + s2 * quaternion2.z,
-                          s1 * quaternion1.w + s2 * quaternion2.w);
-#else
-        using namespace ::DirectX;
+        a = float2(matrix.m21, matrix.m22) * value.minimum.y;
+        b = float2(matrix.m21, matrix.m22) * value.maximum.y;
 
-        XMVECTOR q1 = XMVectorScale(XMLoadQuaternion(&quaternion1), s1);
-        XMVECTOR q2 = XMVectorScale(XMLoadQuaternion(&quaternion2), s2);
+        minimum += (min)(a, b);
+        maximum += (max)(a, b);
 
-        quaternion result;
-        XMStoreQuaternion(&result, XMVectorAdd(q1, q2));
-        return result;
-#endif
+        return aabb2(minimum, maximum);
     }
 
 
-    inline quaternion lerp(quaternion const& quaternion1, quaternion const& quaternion2, float amount)
+    inline aabb3 transform(aabb3 const& value, float4x4 const& matrix)
     {
-        float t2 = amount;
-        float t1 = 1.0f - amount;
+        if (is_empty(value))
+            return value;
 
-        if (dot(quaternion1, quaternion2) < 0.0f)
-        {
-            t2 = -t2;
-        }
+        // As for aabb2. The matrix is treated as affine: the projective column is ignored.
+        float3 minimum(matrix.m41, matrix.m42, matrix.m43);
+        float3 maximum = minimum;
 
-#ifdef WINDOWS_NUMERICS_DISABLE_SIMD
-        return normalize(quaternion(t1 * quaternion1.x + t2 * quaternion2.x,
-                                    t1 * quaternion1.y + t2 * quaternion2.y,
-                                    t1 * quaternion1.z + t2 * quaternion2.z,
-                                    t1 * quaternion1.w + t2 * quaternion2.w));
-#else
-        using namespace ::DirectX;
+        float3 a = float3(matrix.m11, matrix.m12, matrix.m13) * value.minimum.x;
+        float3 b = float3(matrix.m11, matrix.m12, matrix.m13) * value.maximum.x;
 
-        XMVECTOR q1 = XMVectorScale(XMLoadQuaternion(&quaternion1), t1);
-        XMVECTOR q2 = XMVectorScale(XMLoadQuaternion(&quaternion2), t2);
+        minimum += (min)(a, b);
+        maximum += (max)(a, b);
 
-        quaternion result;
-        XMStoreQuaternion(&result, XMQuaternionNormalize(XMVectorAdd(q1, q2)));
-        return result;
-#endif
-    }
+        a = float3(matrix.m21, matrix.m22, matrix.m23) * value.minimum.y;
+        b = float3(matrix.m21, matrix.m22, matrix.m23) * value.maximum.y;
 
+        minimum += (min)(a, b);
+        maximum += (max)(a, b);
 
-    inline quaternion concatenate(quaternion const& value1, quaternion const& value2)
-    {
-        return value2 * value1;
+        a = float3(matrix.m31, matrix.m32, matrix.m33) * value.minimum.z;
+        b = float3(matrix.m31, matrix.m32, matrix.m33) * value.maximum.z;
+
+        minimum += (min)(a, b);
+        maximum += (max)(a, b);
+
+        return aabb3(minimum, maximum);
     }
 }}}
 
 
 #undef _WINDOWS_NUMERICS_THROW_
 #undef _WINDOWS_NUMERICS_NAN_
-
+#undef _WINDOWS_NUMERICS_BATCH_SIMD_
+#undef _WINDOWS_NUMERICS_AVX2_
+#undef _WINDOWS_NUMERICS_AVX2_ALWAYS_
+#undef _WINDOWS_NUMERICS_AVX2_TARGET_
+#undef _WINDOWS_NUMERICS_NEON_
+#undef _WINDOWS_NUMERICS_NEON_AARCH64_
+
+#ifdef _MSC_VER
 #pragma warning(pop)
+#endif
@@ -15,6 +15,10 @@
 
 float valueTheOptimizerCannotRemove = 0;
 
+std::vector<PerfTestResult> perfTestResults;
+
+int enabledPerfTestModes = PerfTestMode_All;
+
 
 // Measures operations that are common to all the vector, matrix and quaternion types.
 template<typename T>
@@ -185,6 +189,16 @@ void RunFloat2Tests()
     {
         *value = transform_normal(*value, param);
     });
+
+    RunPerfTest<Batch<float2>, float3x2>("float2 transform batch (float3x2)", [](Batch<float2>* value, float3x2 const& param)
+    {
+        transform(value->Values, Batch<float2>::Size, param, value->Values);
+    });
+
+    RunPerfTest<Batch<float2>, float4x4>("float2 transform batch (float4x4)", [](Batch<float2>* value, float4x4 const& param)
+    {
+        transform(value->Values, Batch<float2>::Size, param, value->Values);
+    });
 }
 
 
@@ -196,12 +210,22 @@ void RunFloat3Tests()
     {
         *value = cross(*value, param);
     });
+
+    RunPerfTest<Batch<float3>, float4x4>("float3 transform batch (float4x4)", [](Batch<float3>* value, float4x4 const& param)
+    {
+        transform(value->Values, Batch<float3>::Size, param, value->Values);
+    });
 }
 
 
 void RunFloat4Tests()
 {
     RunCommonVectorTests<float4>("float4");
+
+    RunPerfTest<Batch<float4>, float4x4>("float4 transform batch (float4x4)", [](Batch<float4>* value, float4x4 const& param)
+    {
+        transform(value->Values, Batch<float4>::Size, param, value->Values);
+    });
 }
 
 
@@ -211,6 +235,10 @@ void RunFloat3x2Tests()
 }
 
 
+// On x86 and x64, operator*, invert and batched transform by float4x4 have AVX2 implementations.
+// To measure their gain, save a CSV report from a build with WINDOWS_NUMERICS_DISABLE_AVX2 defined,
+// then pass that as the --baseline when running a normal build on an AVX2 capable machine.
+// operator* only uses AVX2 when the compiler targets it (/arch:AVX2).
 void RunFloat4x4Tests()
 {
     RunCommonArithmeticTests<float4x4>("float4x4");
@@ -226,6 +254,23 @@ void RunFloat4x4Tests()
         param = *value;
         *value = transpose(t);
     });
+
+    RunPerfTest<float4x4, float4x4>("float4x4 invert", [](float4x4* value, float4x4& param)
+    {
+        auto t = param;
+        param = *value;
+        invert(t, value);
+    });
+
+    RunPerfTest<float, float4x4>("float4x4 decompose", [](float* value, float4x4 const& param)
+    {
+        float3 scale, translation;
+        quaternion rotation;
+        if (decompose(param, &scale, &rotation, &translation))
+        {
+            *value += scale.x + rotation.x + translation.x;
+        }
+    });
 }
 
 
@@ -262,6 +307,35 @@ void RunPlaneTests()
     {
         value->d = dot_normal(*value, param);
     });
+
+    RunPerfTest<plane, float4x4>("plane extract_frustum_planes", [](plane* value, float4x4 const& param)
+    {
+        plane planes[6];
+        extract_frustum_planes(param, planes);
+        value->d += planes[5].d;
+    });
+
+    RunPerfTest<plane, Batch<float4>>("plane cull_spheres batch", [](plane* value, Batch<float4> const& param)
+    {
+        // The batch is read as four consecutive arrays: center x, y, z and radius.
+        const int count = Batch<float4>::Size;
+        float const* data = &param.Values[0].x;
+        plane planes[6] = { *value, *value, *value, *value, *value, *value };
+        uint32_t visible;
+        cull_spheres(data, data + count, data + count * 2, data + count * 3, count, planes, 6, &visible);
+        value->d += static_cast<float>(visible & 1);
+    });
+
+    RunPerfTest<plane, Batch<float3>>("plane cull_boxes batch", [](plane* value, Batch<float3> const& param)
+    {
+        // The batch is read as six consecutive arrays: min x, y, z and max x, y, z.
+        const int count = Batch<float3>::Size / 2;
+        float const* data = &param.Values[0].x;
+        plane planes[6] = { *value, *value, *value, *value, *value, *value };
+        uint32_t visible;
+        cull_boxes(data, data + count, data + count * 2, data + count * 3, data + count * 4, data + count * 5, count, planes, 6, &visible);
+        value->d += static_cast<float>(visible & 1);
+    });
 }
 
 
@@ -292,12 +366,94 @@ void RunQuaternionTests()
     {
         *value = concatenate(*value, param);
     });
+
+    RunPerfTest<Batch<quaternion>, float>("quaternion normalize batch", [](Batch<quaternion>* value, float param)
+    {
+        value->Values[0].w += param;
+        normalize(value->Values, Batch<quaternion>::Size, value->Values);
+    });
+
+    RunPerfTest<Batch<quaternion>, Batch<quaternion>>("quaternion slerp batch", [](Batch<quaternion>* value, Batch<quaternion> const& param)
+    {
+        slerp(value->Values, param.Values, Batch<quaternion>::Size, 0.5f, value->Values);
+    });
+
+    RunPerfTest<Batch<quaternion>, Batch<quaternion>>("quaternion concatenate batch", [](Batch<quaternion>* value, Batch<quaternion> const& param)
+    {
+        concatenate(value->Values, param.Values, Batch<quaternion>::Size, value->Values);
+    });
+
+    RunPerfTest<float4x4, Batch<quaternion>>("quaternion make_float4x4_from_quaternion batch", [](float4x4* value, Batch<quaternion> const& param)
+    {
+        // Static, so the optimizer cannot discard the matrices we do not read back.
+        static float4x4 matrices[Batch<quaternion>::Size];
+        make_float4x4_from_quaternion(param.Values, Batch<quaternion>::Size, matrices);
+        *value += matrices[0];
+    });
 }
 
 
-int __cdecl main()
+void RunPackedVectorTests()
 {
-    printf("name, time, deviation\n");
+    // Round trips, so the values stay in range from one iteration to the next.
+    RunPerfTest<Batch<float2>, float>("half2 round trip batch", [](Batch<float2>* value, float)
+    {
+        half2 halves[Batch<float2>::Size];
+        make_half2_from_float2(value->Values, Batch<float2>::Size, halves);
+        make_float2_from_half2(halves, Batch<float2>::Size, value->Values);
+    });
+
+    RunPerfTest<Batch<float4>, float>("half4 round trip batch", [](Batch<float4>* value, float)
+    {
+        half4 halves[Batch<float4>::Size];
+        make_half4_from_float4(value->Values, Batch<float4>::Size, halves);
+        make_float4_from_half4(halves, Batch<float4>::Size, value->Values);
+    });
+
+    RunPerfTest<Batch<float4>, float>("unorm8x4 round trip batch", [](Batch<float4>* value, float)
+    {
+        unorm8x4 packed[Batch<float4>::Size];
+        make_unorm8x4_from_float4(value->Values, Batch<float4>::Size, packed);
+        make_float4_from_unorm8x4(packed, Batch<float4>::Size, value->Values);
+    });
+}
+
+
+void RunAabbTests()
+{
+    RunPerfTest<aabb2, Batch<float2>>("aabb2 make_aabb2_from_points batch", [](aabb2* value, Batch<float2> const& param)
+    {
+        *value = merge(*value, make_aabb2_from_points(param.Values, Batch<float2>::Size));
+    });
+
+    RunPerfTest<aabb3, Batch<float3>>("aabb3 make_aabb3_from_points batch", [](aabb3* value, Batch<float3> const& param)
+    {
+        *value = merge(*value, make_aabb3_from_points(param.Values, Batch<float3>::Size));
+    });
+
+    RunPerfTest<aabb2, float3x2>("aabb2 transform", [](aabb2* value, float3x2 const& param)
+    {
+        *value = transform(*value, param);
+    });
+
+    RunPerfTest<aabb3, float4x4>("aabb3 transform", [](aabb3* value, float4x4 const& param)
+    {
+        *value = transform(*value, param);
+    });
+}
+
+
+int main(int argc, char** argv)
+{
+    PerfReportOptions options;
+
+    if (!ParsePerfReportOptions(argc, argv, &options))
+    {
+        fprintf(stderr, "Usage: CppNumericsPerfTest [--format csv|json] [--output <file>] [--baseline <file.csv>] [--threshold <percent>] [--modes latency,throughput,streaming]\n");
+        return 1;
+    }
+
+    enabledPerfTestModes = options.Modes;
 
     RunFloat2Tests();
     RunFloat3Tests();
@@ -306,8 +462,10 @@ int __cdecl main()
     RunFloat4x4Tests();
     RunPlaneTests();
     RunQuaternionTests();
+    RunPackedVectorTests();
+    RunAabbTests();
 
-    printf("\nEnsureNotOptimizedAway: %f\n", valueTheOptimizerCannotRemove);
+    fprintf(stderr, "\nEnsureNotOptimizedAway: %f\n", valueTheOptimizerCannotRemove);
 
-    return 0;
+    return ReportPerfTestResults(options, perfTestResults, valueTheOptimizerCannotRemove);
 }
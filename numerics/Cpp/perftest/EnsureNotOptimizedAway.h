@@ -107,3 +107,27 @@ inline void EnsureNotOptimizedAway(quaternion const& value)
     EnsureNotOptimizedAway(value.z);
     EnsureNotOptimizedAway(value.w);
 }
+
+
+inline void EnsureNotOptimizedAway(aabb2 const& value)
+{
+    EnsureNotOptimizedAway(value.minimum);
+    EnsureNotOptimizedAway(value.maximum);
+}
+
+
+inline void EnsureNotOptimizedAway(aabb3 const& value)
+{
+    EnsureNotOptimizedAway(value.minimum);
+    EnsureNotOptimizedAway(value.maximum);
+}
+
+
+template<typename T>
+void EnsureNotOptimizedAway(Batch<T> const& value)
+{
+    for (auto& element : value.Values)
+    {
+        EnsureNotOptimizedAway(element);
+    }
+}
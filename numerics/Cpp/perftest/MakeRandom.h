@@ -13,6 +13,14 @@
 #pragma once
 
 
+// Generates a single random value.
+template<typename T>
+T MakeRandom()
+{
+    static_assert(sizeof(T) == 0, "Unknown MakeRandom type.");
+}
+
+
 // Generates an array of random values.
 template<typename T, size_t Count>
 std::array<T, Count> MakeRandom()
@@ -25,14 +33,6 @@ std::array<T, Count> MakeRandom()
 }
 
 
-// Generates a single random value.
-template<typename T>
-T MakeRandom()
-{
-    static_assert(false, "Unknown MakeRandom type.");
-}
-
-
 template<>
 inline float MakeRandom<float>()
 {
@@ -106,3 +106,63 @@ inline quaternion MakeRandom<quaternion>()
 
     return quaternion(v[0], v[1], v[2], v[3]);
 }
+
+
+template<>
+inline aabb2 MakeRandom<aabb2>()
+{
+    auto a = MakeRandom<float2>();
+    auto b = MakeRandom<float2>();
+
+    return aabb2((min)(a, b), (max)(a, b));
+}
+
+
+template<>
+inline aabb3 MakeRandom<aabb3>()
+{
+    auto a = MakeRandom<float3>();
+    auto b = MakeRandom<float3>();
+
+    return aabb3((min)(a, b), (max)(a, b));
+}
+
+
+// Generates a batch of random values.
+template<typename T>
+Batch<T> MakeRandomBatch()
+{
+    Batch<T> batch;
+
+    std::generate(std::begin(batch.Values), std::end(batch.Values), MakeRandom<T>);
+
+    return batch;
+}
+
+
+template<>
+inline Batch<float2> MakeRandom<Batch<float2>>()
+{
+    return MakeRandomBatch<float2>();
+}
+
+
+template<>
+inline Batch<float3> MakeRandom<Batch<float3>>()
+{
+    return MakeRandomBatch<float3>();
+}
+
+
+template<>
+inline Batch<float4> MakeRandom<Batch<float4>>()
+{
+    return MakeRandomBatch<float4>();
+}
+
+
+template<>
+inline Batch<quaternion> MakeRandom<Batch<quaternion>>()
+{
+    return MakeRandomBatch<quaternion>();
+}
@@ -0,0 +1,300 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+
+// Command line options controlling how results are reported:
+//
+//  --format csv|json       Output format (default csv).
+//  --output <file>         Write the report to a file instead of stdout.
+//  --baseline <file>       Compare against a CSV report from a previous run.
+//  --threshold <percent>   How much slower than the baseline a test may get before it is flagged (default 5).
+//  --modes <list>          Comma separated list of latency, throughput and streaming (default all three).
+struct PerfReportOptions
+{
+    PerfReportOptions()
+        : Json(false),
+          RegressionThreshold(5.0),
+          Modes(PerfTestMode_All)
+    { }
+
+    bool Json;
+    std::string OutputFile;
+    std::string BaselineFile;
+    double RegressionThreshold;
+    int Modes;
+};
+
+
+inline bool ParsePerfTestModes(std::string const& list, int* modes)
+{
+    std::istringstream names(list);
+    std::string name;
+
+    *modes = 0;
+
+    while (std::getline(names, name, ','))
+    {
+        if (name == GetPerfTestModeName(PerfTestMode_Latency))
+            *modes |= PerfTestMode_Latency;
+        else if (name == GetPerfTestModeName(PerfTestMode_Throughput))
+            *modes |= PerfTestMode_Throughput;
+        else if (name == GetPerfTestModeName(PerfTestMode_Streaming))
+            *modes |= PerfTestMode_Streaming;
+        else
+            return false;
+    }
+
+    return *modes != 0;
+}
+
+
+inline bool ParsePerfReportOptions(int argc, char** argv, PerfReportOptions* options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+
+        if (arg == "--format" && hasValue)
+        {
+            std::string format = argv[++i];
+
+            if (format == "json")
+                options->Json = true;
+            else if (format == "csv")
+                options->Json = false;
+            else
+                return false;
+        }
+        else if (arg == "--output" && hasValue)
+        {
+            options->OutputFile = argv[++i];
+        }
+        else if (arg == "--baseline" && hasValue)
+        {
+            options->BaselineFile = argv[++i];
+        }
+        else if (arg == "--threshold" && hasValue)
+        {
+            options->RegressionThreshold = atof(argv[++i]);
+        }
+        else if (arg == "--modes" && hasValue)
+        {
+            if (!ParsePerfTestModes(argv[++i], &options->Modes))
+                return false;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+inline std::string EscapeJsonString(std::string const& value)
+{
+    std::string result;
+
+    for (char c : value)
+    {
+        if (c == '"' || c == '\\')
+            result += '\\';
+
+        result += c;
+    }
+
+    return result;
+}
+
+
+inline void WriteCsvReport(std::ostream& output, std::vector<PerfTestResult> const& results)
+{
+    output << "name,mode,median,p5,p95,ns_per_op,deviation" << std::endl;
+
+    for (auto& result : results)
+    {
+        // Test names never contain quotes, but often contain spaces and parentheses, so are always quoted.
+        output << '"' << result.Name << "\","
+               << GetPerfTestModeName(result.Mode) << ','
+               << result.Median << ','
+               << result.Percentile5 << ','
+               << result.Percentile95 << ','
+               << result.NanosecondsPerOperation() << ','
+               << result.DeviationPercentage << std::endl;
+    }
+}
+
+
+inline void WriteJsonReport(std::ostream& output, std::vector<PerfTestResult> const& results, float checksum)
+{
+    output << "{" << std::endl
+           << "  \"innerRepetitions\": " << InnerRepetitions << "," << std::endl
+           << "  \"testPasses\": " << TestPasses << "," << std::endl
+           << "  \"checksum\": ";
+
+    // JSON has no representation for NaN or infinity.
+    if (std::isfinite(checksum))
+        output << checksum;
+    else
+        output << "null";
+
+    output << "," << std::endl
+           << "  \"tests\": [" << std::endl;
+
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        auto& result = results[i];
+
+        output << "    { \"name\": \"" << EscapeJsonString(result.Name) << "\""
+               << ", \"mode\": \"" << GetPerfTestModeName(result.Mode) << "\""
+               << ", \"median\": " << result.Median
+               << ", \"p5\": " << result.Percentile5
+               << ", \"p95\": " << result.Percentile95
+               << ", \"nsPerOp\": " << result.NanosecondsPerOperation()
+               << ", \"deviation\": " << result.DeviationPercentage
+               << " }" << (i + 1 < results.size() ? "," : "") << std::endl;
+    }
+
+    output << "  ]" << std::endl
+           << "}" << std::endl;
+}
+
+
+// Baseline results are looked up by test name and mode.
+inline std::string GetBaselineKey(std::string const& name, std::string const& mode)
+{
+    return name + " [" + mode + "]";
+}
+
+
+// Reads the ns/op column from a CSV report written by WriteCsvReport.
+inline bool ReadCsvBaseline(std::string const& filename, std::map<std::string, double>* baseline)
+{
+    std::ifstream input(filename);
+
+    if (!input)
+        return false;
+
+    std::string line;
+
+    // Skip the header row.
+    std::getline(input, line);
+
+    while (std::getline(input, line))
+    {
+        if (line.size() < 2 || line[0] != '"')
+            continue;
+
+        auto nameEnd = line.find('"', 1);
+
+        if (nameEnd == std::string::npos)
+            continue;
+
+        std::string name = line.substr(1, nameEnd - 1);
+
+        // Columns after the name are mode, median, p5, p95, ns_per_op, deviation.
+        std::istringstream fields(line.substr(nameEnd + 1));
+        std::vector<std::string> values;
+        std::string field;
+
+        while (std::getline(fields, field, ','))
+        {
+            if (!field.empty())
+                values.push_back(field);
+        }
+
+        if (values.size() >= 5)
+        {
+            (*baseline)[GetBaselineKey(name, values[0])] = atof(values[4].c_str());
+        }
+    }
+
+    return true;
+}
+
+
+// Compares results against a baseline, printing any tests that got slower by more than the threshold.
+// Returns the number of regressions found.
+inline int CompareWithBaseline(std::vector<PerfTestResult> const& results, std::map<std::string, double> const& baseline, double thresholdPercentage)
+{
+    int regressionCount = 0;
+
+    for (auto& result : results)
+    {
+        auto key = GetBaselineKey(result.Name, GetPerfTestModeName(result.Mode));
+        auto it = baseline.find(key);
+
+        if (it == baseline.end() || it->second <= 0)
+            continue;
+
+        double current = result.NanosecondsPerOperation();
+        double changePercentage = (current - it->second) / it->second * 100;
+
+        if (changePercentage > thresholdPercentage)
+        {
+            fprintf(stderr, "REGRESSION: %s: %.3f ns/op -> %.3f ns/op (+%.1f%%)\n", key.c_str(), it->second, current, changePercentage);
+            regressionCount++;
+        }
+        else if (changePercentage < -thresholdPercentage)
+        {
+            fprintf(stderr, "improvement: %s: %.3f ns/op -> %.3f ns/op (%.1f%%)\n", key.c_str(), it->second, current, changePercentage);
+        }
+    }
+
+    return regressionCount;
+}
+
+
+// Writes the final report and checks for regressions. Returns the process exit code.
+inline int ReportPerfTestResults(PerfReportOptions const& options, std::vector<PerfTestResult> const& results, float checksum)
+{
+    std::ofstream file;
+
+    if (!options.OutputFile.empty())
+    {
+        file.open(options.OutputFile);
+
+        if (!file)
+        {
+            fprintf(stderr, "Failed to open %s\n", options.OutputFile.c_str());
+            return 1;
+        }
+    }
+
+    std::ostream& output = options.OutputFile.empty() ? std::cout : file;
+
+    if (options.Json)
+        WriteJsonReport(output, results, checksum);
+    else
+        WriteCsvReport(output, results);
+
+    if (options.BaselineFile.empty())
+        return 0;
+
+    std::map<std::string, double> baseline;
+
+    if (!ReadCsvBaseline(options.BaselineFile, &baseline))
+    {
+        fprintf(stderr, "Failed to read baseline %s\n", options.BaselineFile.c_str());
+        return 1;
+    }
+
+    int regressionCount = CompareWithBaseline(results, baseline, options.RegressionThreshold);
+
+    fprintf(stderr, "%d regression(s) beyond %.1f%% threshold\n", regressionCount, options.RegressionThreshold);
+
+    return regressionCount > 0 ? 1 : 0;
+}
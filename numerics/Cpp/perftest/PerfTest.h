@@ -24,12 +24,103 @@ const int InnerRepetitions = 1000000;
 // enregistered) but not so big as to spill out of cache and introduce unpredictable memory latencies.
 const int ParamCount = 64;
 
+// Throughput tests interleave this many independent accumulators, so consecutive operations
+// do not depend on each other and the CPU can overlap their execution.
+const int ThroughputAccumulators = 8;
+
+// Streaming tests process arrays of values and parameters whose combined size is this many bytes,
+// which is much larger than any CPU cache, so they measure how well an operation copes with memory bandwidth.
+const size_t StreamingBytes = 64 * 1024 * 1024;
+
+// Streaming test passes are slow, so we run fewer of them.
+const int StreamingTestPasses = 20;
+
+
+// Each test can be measured in several ways.
+enum PerfTestMode
+{
+    // Every operation feeds its result into the next, measuring latency through a dependency chain.
+    PerfTestMode_Latency = 1,
+
+    // Independent operations across several accumulators, measuring instruction throughput.
+    PerfTestMode_Throughput = 2,
+
+    // Independent operations over arrays too big for the cache, measuring memory-bound behavior.
+    PerfTestMode_Streaming = 4,
+
+    PerfTestMode_All = PerfTestMode_Latency | PerfTestMode_Throughput | PerfTestMode_Streaming
+};
+
+
+inline char const* GetPerfTestModeName(PerfTestMode mode)
+{
+    switch (mode)
+    {
+    case PerfTestMode_Latency:      return "latency";
+    case PerfTestMode_Throughput:   return "throughput";
+    case PerfTestMode_Streaming:    return "streaming";
+    default:                        return "unknown";
+    }
+}
+
+
+// Bitmask of PerfTestMode values, selecting which kinds of measurement to run.
+extern int enabledPerfTestModes;
+
+
+#ifdef _MSC_VER
+#define PERFTEST_NOINLINE __declspec(noinline)
+#else
+#define PERFTEST_NOINLINE __attribute__((noinline))
+#endif
+
+
+#if defined _MSC_VER && _MSC_VER < 1900
+
+// Older Visual C++ runtimes implement std::chrono::steady_clock on top of the system
+// clock, which only ticks every few milliseconds. This wraps QueryPerformanceCounter
+// in the standard clock interface, so the rest of the harness is the same everywhere.
+struct PerfTestClock
+{
+    typedef std::chrono::nanoseconds duration;
+    typedef duration::rep rep;
+    typedef duration::period period;
+    typedef std::chrono::time_point<PerfTestClock> time_point;
+
+    static const bool is_steady = true;
+
+    static time_point now()
+    {
+        static const long long frequency = []
+        {
+            LARGE_INTEGER value;
+            QueryPerformanceFrequency(&value);
+            return value.QuadPart;
+        }();
+
+        LARGE_INTEGER counter;
+        QueryPerformanceCounter(&counter);
+
+        // Split the conversion to avoid overflowing 64 bits.
+        long long seconds = counter.QuadPart / frequency;
+        long long remainder = counter.QuadPart % frequency;
+
+        return time_point(duration(seconds * 1000000000 + remainder * 1000000000 / frequency));
+    }
+};
+
+#else
+
+typedef std::chrono::steady_clock PerfTestClock;
+
+#endif
+
 
 // The core thing being measured: repeats a simple operation a large number of times.
 // Marked as noinline to encourage inlining of the operation lambda, and to
 // keep this as separate as possible from the surrounding infrastructure goop.
 template<typename TValue, typename TParams, typename TOperation>
-__declspec(noinline) void RunInnerLoop(TValue* value, TParams& params, TOperation const& operation)
+PERFTEST_NOINLINE void RunInnerLoop(TValue* value, TParams& params, TOperation const& operation)
 {
     for (int i = 0; i < InnerRepetitions; i++)
     {
@@ -38,7 +129,46 @@ __declspec(noinline) void RunInnerLoop(TValue* value, TParams& params, TOperatio
 }
 
 
-// Runs a single test pass, returning how long it took.
+// Throughput version of the inner loop: the same number of operations, but spread across independent accumulators.
+template<typename TValue, typename TParams, typename TOperation>
+PERFTEST_NOINLINE void RunThroughputInnerLoop(TValue* values, TParams& params, TOperation const& operation)
+{
+    for (int i = 0; i < InnerRepetitions; i += ThroughputAccumulators)
+    {
+        for (int j = 0; j < ThroughputAccumulators; j++)
+        {
+            operation(&values[j], params[(i + j) % ParamCount]);
+        }
+    }
+}
+
+
+// Streaming version of the inner loop: each operation reads and writes a different element of large arrays.
+template<typename TValue, typename TParam, typename TOperation>
+PERFTEST_NOINLINE void RunStreamingInnerLoop(TValue* values, TParam* params, size_t count, TOperation const& operation)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        operation(&values[i], params[i]);
+    }
+}
+
+
+// Measures how long a function takes to run, in seconds.
+template<typename TFunction>
+double TimeFunction(TFunction const& function)
+{
+    auto startTime = PerfTestClock::now();
+
+    function();
+
+    auto endTime = PerfTestClock::now();
+
+    return std::chrono::duration_cast<std::chrono::duration<double>>(endTime - startTime).count();
+}
+
+
+// Runs a single test pass, returning how long it took in seconds.
 template<typename TValue, typename TParam, typename TOperation>
 double RunTestPass(TOperation const& operation)
 {
@@ -49,21 +179,61 @@ double RunTestPass(TOperation const& operation)
     auto params = MakeRandom<TParam, ParamCount>();
     
     // Run the test, and time how long it takes.
-    LARGE_INTEGER startTime;
-    QueryPerformanceCounter(&startTime);
-
-    RunInnerLoop(&value, params, operation);
-
-    LARGE_INTEGER endTime;
-    QueryPerformanceCounter(&endTime);
+    double time = TimeFunction([&]
+    {
+        RunInnerLoop(&value, params, operation);
+    });
 
     // Make sure the compiler doesn't try to optimize out our computation!
     EnsureNotOptimizedAway(value);
 
-    LARGE_INTEGER frequency;
-    QueryPerformanceFrequency(&frequency);
+    return time;
+}
+
+
+// Runs a single throughput test pass, returning how long it took in seconds.
+template<typename TValue, typename TParam, typename TOperation>
+double RunThroughputTestPass(TOperation const& operation)
+{
+    srand(1);
+
+    auto values = MakeRandom<TValue, ThroughputAccumulators>();
+    auto params = MakeRandom<TParam, ParamCount>();
+
+    double time = TimeFunction([&]
+    {
+        RunThroughputInnerLoop(values.data(), params, operation);
+    });
 
-    return static_cast<double>(endTime.QuadPart - startTime.QuadPart) / frequency.QuadPart;
+    for (auto& value : values)
+    {
+        EnsureNotOptimizedAway(value);
+    }
+
+    return time;
+}
+
+
+// Runs a single streaming test pass, returning how long it took in seconds. The arrays are
+// reset from the original random data before each pass, so the values do not drift into
+// denormal or infinite ranges that would change the timing.
+template<typename TValue, typename TParam, typename TOperation>
+double RunStreamingTestPass(TOperation const& operation, std::vector<TValue> const& originalValues, std::vector<TParam> const& originalParams, std::vector<TValue>& values, std::vector<TParam>& params)
+{
+    values = originalValues;
+    params = originalParams;
+
+    double time = TimeFunction([&]
+    {
+        RunStreamingInnerLoop(values.data(), params.data(), values.size(), operation);
+    });
+
+    for (auto& value : values)
+    {
+        EnsureNotOptimizedAway(value);
+    }
+
+    return time;
 }
 
 
@@ -93,23 +263,131 @@ double GetDeviationPercentage(T const& results)
 }
 
 
+// Reads a percentile from a sorted collection of test pass results, using the nearest-rank method.
+template<typename T>
+double GetPercentile(T const& sortedResults, int percentile)
+{
+    size_t rank = (sortedResults.size() * percentile + 99) / 100;
+
+    return sortedResults[rank > 0 ? rank - 1 : 0];
+}
+
+
+// Summary statistics for one test, measured in seconds per pass.
+struct PerfTestResult
+{
+    std::string Name;
+    PerfTestMode Mode;
+    size_t OperationsPerPass;
+    double Median;
+    double Percentile5;
+    double Percentile95;
+    double DeviationPercentage;
+
+    double NanosecondsPerOperation() const
+    {
+        return ToNanosecondsPerOperation(Median);
+    }
+
+    double ToNanosecondsPerOperation(double seconds) const
+    {
+        return seconds * 1e9 / OperationsPerPass;
+    }
+};
+
+
+// Results are accumulated here as the tests run, then reported at the end of the run.
+extern std::vector<PerfTestResult> perfTestResults;
+
+
+// Analyzes the timings from all passes of a test.
+template<typename T>
+PerfTestResult AnalyzeTestPasses(std::string const& testName, PerfTestMode mode, size_t operationsPerPass, T& results)
+{
+    std::sort(results.begin(), results.end());
+
+    PerfTestResult result;
+
+    result.Name = testName;
+    result.Mode = mode;
+    result.OperationsPerPass = operationsPerPass;
+    result.Median = results[results.size() / 2];
+    result.Percentile5 = GetPercentile(results, 5);
+    result.Percentile95 = GetPercentile(results, 95);
+    result.DeviationPercentage = GetDeviationPercentage(results);
+
+    return result;
+}
+
+
+// Prints progress while the tests are running. The machine readable report is written separately at the end.
+inline void ReportProgress(PerfTestResult const& result)
+{
+    fprintf(stderr, "%s [%s]: %.3f ns/op (p5 %.3f, p95 %.3f, deviation %.2f%%)\n",
+            result.Name.c_str(),
+            GetPerfTestModeName(result.Mode),
+            result.NanosecondsPerOperation(),
+            result.ToNanosecondsPerOperation(result.Percentile5),
+            result.ToNanosecondsPerOperation(result.Percentile95),
+            result.DeviationPercentage);
+}
+
+
+// Repeats a test pass multiple times, then analyzes and records the results.
+template<typename TRunPass>
+void RunTestPasses(std::string const& testName, PerfTestMode mode, int passCount, size_t operationsPerPass, TRunPass const& runPass)
+{
+    std::vector<double> results(passCount);
+
+    std::generate(results.begin(), results.end(), runPass);
+
+    auto result = AnalyzeTestPasses(testName, mode, operationsPerPass, results);
+
+    ReportProgress(result);
+
+    perfTestResults.push_back(result);
+}
+
+
 // The main test entrypoint.
 template<typename TValue, typename TParam, typename TOperation>
-__declspec(noinline) void RunPerfTest(std::string const& testName, TOperation const& operation)
+PERFTEST_NOINLINE void RunPerfTest(std::string const& testName, TOperation const& operation)
 {
-    // Repeat the test multiple times.
-    std::array<double, TestPasses> results;
+    if (enabledPerfTestModes & PerfTestMode_Latency)
+    {
+        RunTestPasses(testName, PerfTestMode_Latency, TestPasses, InnerRepetitions, [&]
+        {
+            return RunTestPass<TValue, TParam>(operation);
+        });
+    }
 
-    std::generate(results.begin(), results.end(), [&]
+    if (enabledPerfTestModes & PerfTestMode_Throughput)
     {
-        return RunTestPass<TValue, TParam>(operation);
-    });
+        RunTestPasses(testName, PerfTestMode_Throughput, TestPasses, InnerRepetitions, [&]
+        {
+            return RunThroughputTestPass<TValue, TParam>(operation);
+        });
+    }
 
-    // Analyze the results.
-    std::sort(results.begin(), results.end());
+    if (enabledPerfTestModes & PerfTestMode_Streaming)
+    {
+        // Generating the random data is slow, so do it once for all passes.
+        size_t count = StreamingBytes / (sizeof(TValue) + sizeof(TParam));
 
-    auto median = results[TestPasses / 2];
-    auto deviation = GetDeviationPercentage(results);
+        srand(1);
 
-    printf("%s, %f, %f%%\n", testName.c_str(), median, deviation);
+        std::vector<TValue> originalValues(count);
+        std::vector<TParam> originalParams(count);
+
+        std::generate(originalValues.begin(), originalValues.end(), MakeRandom<TValue>);
+        std::generate(originalParams.begin(), originalParams.end(), MakeRandom<TParam>);
+
+        std::vector<TValue> values;
+        std::vector<TParam> params;
+
+        RunTestPasses(testName, PerfTestMode_Streaming, StreamingTestPasses, count, [&]
+        {
+            return RunStreamingTestPass(operation, originalValues, originalParams, values, params);
+        });
+    }
 }
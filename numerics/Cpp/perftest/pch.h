@@ -18,13 +18,27 @@ using namespace Windows::Foundation::Numerics;
 
 #include <algorithm>
 #include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
 #include <numeric>
+#include <sstream>
 #include <string>
+#include <vector>
 
+#if defined _MSC_VER && _MSC_VER < 1900
 #define WIN32_LEAN_AND_MEAN
 #define NOMINMAX
 #include <windows.h>
+#endif
 
+#include "Batch.h"
 #include "EnsureNotOptimizedAway.h"
 #include "MakeRandom.h"
 #include "PerfTest.h"
+#include "PerfReport.h"
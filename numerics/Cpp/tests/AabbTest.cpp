@@ -0,0 +1,223 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+#include "Helpers.h"
+
+using namespace Windows::Foundation::Numerics;
+
+namespace NumericsTests
+{
+    NUMERICS_TEST_CLASS(AabbTest)
+    {
+        NUMERICS_TEST_CLASS_INNER(AabbTest)
+
+    public:
+        // A test for aabb2::empty() and aabb3::empty()
+        TEST_METHOD(AabbEmptyTest)
+        {
+            Assert::IsTrue(is_empty(aabb2::empty()));
+            Assert::IsTrue(is_empty(aabb3::empty()));
+
+            Assert::IsFalse(is_empty(aabb2(float2(1, 2), float2(1, 2))));
+            Assert::IsTrue(is_empty(aabb2(float2(1, 2), float2(3, 1))));
+            Assert::IsTrue(is_empty(aabb3(float3(1, 2, 3), float3(4, 5, 2))));
+
+            float2 point(1, 2);
+
+            Assert::IsTrue(aabb2(point, point) == merge(aabb2::empty(), point));
+            Assert::IsFalse(contains(aabb2::empty(), point));
+            Assert::IsFalse(intersects(aabb2::empty(), aabb2(float2(-1), float2(1))));
+            Assert::IsTrue(contains(aabb2(float2(-1), float2(1)), aabb2::empty()));
+            Assert::IsTrue(is_empty(transform(aabb2::empty(), make_float3x2_rotation(1))));
+            Assert::IsTrue(is_empty(transform(aabb3::empty(), make_float4x4_rotation_x(1))));
+        }
+
+        // A test for make_aabb2_from_points (float2 const*, size_t)
+        TEST_METHOD(Aabb2FromPointsTest)
+        {
+            float2 points[13];
+
+            for (int i = 0; i < 13; i++)
+            {
+                points[i] = float2(sinf(i * 1.7f) * (i + 1), cosf(i * 2.3f) * (i + 1));
+            }
+
+            // Every count exercises a different split between the SIMD and scalar loops.
+            for (size_t count = 0; count <= 13; count++)
+            {
+                aabb2 expected = aabb2::empty();
+
+                for (size_t i = 0; i < count; i++)
+                {
+                    expected.minimum.x = (points[i].x < expected.minimum.x) ? points[i].x : expected.minimum.x;
+                    expected.minimum.y = (points[i].y < expected.minimum.y) ? points[i].y : expected.minimum.y;
+                    expected.maximum.x = (points[i].x > expected.maximum.x) ? points[i].x : expected.maximum.x;
+                    expected.maximum.y = (points[i].y > expected.maximum.y) ? points[i].y : expected.maximum.y;
+                }
+
+                aabb2 actual = make_aabb2_from_points(points, count);
+                Assert::IsTrue(expected == actual, L"make_aabb2_from_points did not return the expected value.");
+            }
+        }
+
+        // A test for make_aabb3_from_points (float3 const*, size_t)
+        TEST_METHOD(Aabb3FromPointsTest)
+        {
+            float3 points[13];
+
+            for (int i = 0; i < 13; i++)
+            {
+                points[i] = float3(sinf(i * 1.7f) * (i + 1), cosf(i * 2.3f) * (i + 1), sinf(i * 0.9f + 1) * (13 - i));
+            }
+
+            for (size_t count = 0; count <= 13; count++)
+            {
+                aabb3 expected = aabb3::empty();
+
+                for (size_t i = 0; i < count; i++)
+                {
+                    expected.minimum.x = (points[i].x < expected.minimum.x) ? points[i].x : expected.minimum.x;
+                    expected.minimum.y = (points[i].y < expected.minimum.y) ? points[i].y : expected.minimum.y;
+                    expected.minimum.z = (points[i].z < expected.minimum.z) ? points[i].z : expected.minimum.z;
+                    expected.maximum.x = (points[i].x > expected.maximum.x) ? points[i].x : expected.maximum.x;
+                    expected.maximum.y = (points[i].y > expected.maximum.y) ? points[i].y : expected.maximum.y;
+                    expected.maximum.z = (points[i].z > expected.maximum.z) ? points[i].z : expected.maximum.z;
+                }
+
+                aabb3 actual = make_aabb3_from_points(points, count);
+                Assert::IsTrue(expected == actual, L"make_aabb3_from_points did not return the expected value.");
+            }
+        }
+
+        // A test for merge, intersect and intersects (aabb2, aabb2)
+        TEST_METHOD(Aabb2MergeIntersectTest)
+        {
+            aabb2 a(float2(0, 0), float2(4, 2));
+            aabb2 b(float2(3, -1), float2(5, 1));
+            aabb2 c(float2(10, 10), float2(11, 11));
+
+            Assert::IsTrue(aabb2(float2(0, -1), float2(5, 2)) == merge(a, b), L"merge did not return the expected value.");
+            Assert::IsTrue(aabb2(float2(3, 0), float2(4, 1)) == intersect(a, b), L"intersect did not return the expected value.");
+            Assert::IsTrue(aabb2(float2(0, 0), float2(4, 3)) == merge(a, float2(1, 3)), L"merge did not return the expected value.");
+
+            Assert::IsTrue(intersects(a, b));
+            Assert::IsTrue(intersects(b, a));
+            Assert::IsFalse(intersects(a, c));
+            Assert::IsTrue(is_empty(intersect(a, c)));
+
+            // Boxes that only touch along an edge still intersect.
+            Assert::IsTrue(intersects(a, aabb2(float2(4, 0), float2(6, 1))));
+
+            Assert::IsTrue(float2(2, 1) == center(a), L"center did not return the expected value.");
+            Assert::IsTrue(float2(4, 2) == size(a), L"size did not return the expected value.");
+        }
+
+        // A test for merge, intersect and intersects (aabb3, aabb3)
+        TEST_METHOD(Aabb3MergeIntersectTest)
+        {
+            aabb3 a(float3(0, 0, 0), float3(4, 2, 2));
+            aabb3 b(float3(3, -1, 1), float3(5, 1, 5));
+            aabb3 c(float3(3, -1, 3), float3(5, 1, 5));
+
+            Assert::IsTrue(aabb3(float3(0, -1, 0), float3(5, 2, 5)) == merge(a, b), L"merge did not return the expected value.");
+            Assert::IsTrue(aabb3(float3(3, 0, 1), float3(4, 1, 2)) == intersect(a, b), L"intersect did not return the expected value.");
+            Assert::IsTrue(aabb3(float3(-1, 0, 0), float3(4, 2, 2)) == merge(a, float3(-1, 1, 1)), L"merge did not return the expected value.");
+
+            Assert::IsTrue(intersects(a, b));
+            Assert::IsFalse(intersects(a, c));
+            Assert::IsTrue(is_empty(intersect(a, c)));
+
+            Assert::IsTrue(float3(2, 1, 1) == center(a), L"center did not return the expected value.");
+            Assert::IsTrue(float3(4, 2, 2) == size(a), L"size did not return the expected value.");
+        }
+
+        // A test for contains (aabb2, float2), (aabb2, aabb2), (aabb3, float3) and (aabb3, aabb3)
+        TEST_METHOD(AabbContainsTest)
+        {
+            aabb2 a(float2(0, 0), float2(4, 2));
+
+            Assert::IsTrue(contains(a, float2(1, 1)));
+            Assert::IsTrue(contains(a, float2(4, 2)));
+            Assert::IsFalse(contains(a, float2(5, 1)));
+            Assert::IsFalse(contains(a, float2(1, -1)));
+            Assert::IsTrue(contains(a, aabb2(float2(1, 1), float2(2, 2))));
+            Assert::IsFalse(contains(a, aabb2(float2(1, 1), float2(5, 2))));
+
+            aabb3 b(float3(0, 0, 0), float3(4, 2, 2));
+
+            Assert::IsTrue(contains(b, float3(1, 1, 1)));
+            Assert::IsFalse(contains(b, float3(1, 1, 3)));
+            Assert::IsTrue(contains(b, aabb3(float3(1, 1, 1), float3(2, 2, 2))));
+            Assert::IsFalse(contains(b, aabb3(float3(1, 1, -1), float3(2, 2, 2))));
+        }
+
+        // A test for transform (aabb2, float3x2)
+        TEST_METHOD(Aabb2TransformTest)
+        {
+            aabb2 box(float2(1, 2), float2(4, 3));
+
+            float3x2 m = make_float3x2_rotation(ToRadians(30.0f)) *
+                         make_float3x2_scale(2, -3) *
+                         make_float3x2_translation(10, 20);
+
+            // The bounds of the four transformed corners.
+            aabb2 expected = aabb2::empty();
+
+            expected = merge(expected, transform(float2(1, 2), m));
+            expected = merge(expected, transform(float2(4, 2), m));
+            expected = merge(expected, transform(float2(1, 3), m));
+            expected = merge(expected, transform(float2(4, 3), m));
+
+            aabb2 actual = transform(box, m);
+
+            Assert::IsTrue(Equal(expected.minimum, actual.minimum), L"transform did not return the expected value.");
+            Assert::IsTrue(Equal(expected.maximum, actual.maximum), L"transform did not return the expected value.");
+        }
+
+        // A test for transform (aabb3, float4x4)
+        TEST_METHOD(Aabb3TransformTest)
+        {
+            aabb3 box(float3(1, 2, -1), float3(4, 3, 5));
+
+            float4x4 m = make_float4x4_from_yaw_pitch_roll(ToRadians(30.0f), ToRadians(-40.0f), ToRadians(50.0f)) *
+                         make_float4x4_scale(2, -3, 0.5f) *
+                         make_float4x4_translation(10, 20, 30);
+
+            aabb3 expected = aabb3::empty();
+
+            for (int i = 0; i < 8; i++)
+            {
+                float3 corner((i & 1) ? box.maximum.x : box.minimum.x,
+                              (i & 2) ? box.maximum.y : box.minimum.y,
+                              (i & 4) ? box.maximum.z : box.minimum.z);
+
+                expected = merge(expected, transform(corner, m));
+            }
+
+            aabb3 actual = transform(box, m);
+
+            Assert::IsTrue(Equal(expected.minimum, actual.minimum), L"transform did not return the expected value.");
+            Assert::IsTrue(Equal(expected.maximum, actual.maximum), L"transform did not return the expected value.");
+        }
+
+        // A test to make sure these types have the expected layouts
+        TEST_METHOD(AabbSizeofTest)
+        {
+            Assert::AreEqual(size_t(16), sizeof(aabb2));
+            Assert::AreEqual(size_t(24), sizeof(aabb3));
+
+            Assert::AreEqual(size_t(8), offsetof(aabb2, maximum));
+            Assert::AreEqual(size_t(12), offsetof(aabb3, maximum));
+        }
+    };
+}
@@ -420,6 +420,116 @@ namespace NumericsTests
             Assert::IsTrue(Equal(expected, actual), L"transform did not return the expected value.");
         }
 
+        // A test for transform (float2 const*, size_t, float3x2, float2*)
+        TEST_METHOD(Float2TransformBatch3x2Test)
+        {
+            // Use a count that is not a multiple of the SIMD width, to exercise the remainder loop.
+            const size_t count = 11;
+
+            float2 positions[count];
+            float2 actual[count];
+
+            for (size_t i = 0; i < count; i++)
+            {
+                positions[i] = float2(i * 1.5f, 10.0f - i);
+            }
+
+            float3x2 m = make_float3x2_rotation(ToRadians(30.0f));
+            m.m31 = 10.0f;
+            m.m32 = 20.0f;
+
+            transform(positions, count, m, actual);
+
+            for (size_t i = 0; i < count; i++)
+            {
+                Assert::IsTrue(Equal(transform(positions[i], m), actual[i]), L"transform did not return the expected value.");
+            }
+        }
+
+        // A test for transform (float2 const*, size_t, float4x4, float2*)
+        TEST_METHOD(Float2TransformBatchTest)
+        {
+            const size_t count = 11;
+
+            float2 positions[count];
+            float2 actual[count];
+
+            for (size_t i = 0; i < count; i++)
+            {
+                positions[i] = float2(i * 1.5f, 10.0f - i);
+            }
+
+            float4x4 m =
+                make_float4x4_rotation_x(ToRadians(30.0f)) *
+                make_float4x4_rotation_y(ToRadians(30.0f)) *
+                make_float4x4_rotation_z(ToRadians(30.0f));
+            m.m41 = 10.0f;
+            m.m42 = 20.0f;
+            m.m43 = 30.0f;
+
+            transform(positions, count, m, actual);
+
+            for (size_t i = 0; i < count; i++)
+            {
+                Assert::IsTrue(Equal(transform(positions[i], m), actual[i]), L"transform did not return the expected value.");
+            }
+        }
+
+        // A test for transform (float2 const*, size_t, float3x2, float2*) transforming in place
+        TEST_METHOD(Float2TransformBatchInPlaceTest)
+        {
+            const size_t count = 6;
+
+            float2 values[count];
+            float2 expected[count];
+
+            float3x2 m = make_float3x2_scale(2.0f) * make_float3x2_translation(1.0f, -1.0f);
+
+            for (size_t i = 0; i < count; i++)
+            {
+                values[i] = float2(static_cast<float>(i), i * 2.0f);
+                expected[i] = transform(values[i], m);
+            }
+
+            transform(values, count, m, values);
+
+            for (size_t i = 0; i < count; i++)
+            {
+                Assert::IsTrue(Equal(expected[i], values[i]), L"transform did not return the expected value.");
+            }
+        }
+
+        // A test for deinterleave (float2) and interleave (float2)
+        TEST_METHOD(Float2InterleaveTest)
+        {
+            const size_t count = 7;
+
+            float2 values[count];
+            float x[count];
+            float y[count];
+            float2 actual[count];
+
+            for (size_t i = 0; i < count; i++)
+            {
+                values[i] = float2(static_cast<float>(i), i + 100.0f);
+            }
+
+            deinterleave(values, count, x, y);
+
+            for (size_t i = 0; i < count; i++)
+            {
+                Assert::AreEqual(values[i].x, x[i]);
+                Assert::AreEqual(values[i].y, y[i]);
+            }
+
+            interleave(x, y, count, actual);
+
+            for (size_t i = 0; i < count; i++)
+            {
+                Assert::AreEqual(values[i], actual[i]);
+            }
+        }
+
         // A test for normalize (float2)
         TEST_METHOD(Float2NormalizeTest)
         {
@@ -808,6 +918,22 @@ namespace NumericsTests
             Assert::AreEqual(expected, target, L"float2::cstr did not return the expected value.");
         }
 
+        // A test that float2 construction and arithmetic can be evaluated at compile time
+        TEST_METHOD(Float2ConstexprTest)
+        {
+#if !defined _MSC_VER || _MSC_VER >= 1900
+            constexpr float2 a(1, 2);
+            constexpr float2 b = a * 2.0f + float2::one() - float2(4) / float2(2, 4);
+
+            static_assert(b == float2(1, 4), "float2 operators did not return the expected value.");
+            static_assert(0.5f * b / 2.0f == float2(0.25f, 1), "float2 operators did not return the expected value.");
+            static_assert(-b != b, "operator - did not return the expected value.");
+            static_assert(b * float2::unit_x() + float2::unit_y() * 4 == b, "operator * did not return the expected value.");
+
+            Assert::IsTrue(Equal(float2(1, 4), b));
+#endif
+        }
+
         // A test for float2 comparison involving NaN values
         TEST_METHOD(Float2EqualsNanTest)
         {
@@ -454,6 +454,69 @@ namespace NumericsTests
             Assert::IsTrue(Equal(expected, actual), L"transform did not return the expected value.");
         }
 
+        // A test for transform (float3 const*, size_t, float4x4, float3*)
+        TEST_METHOD(Float3TransformBatchTest)
+        {
+            // Use a count that is not a multiple of the SIMD width, to exercise the remainder loop.
+            const size_t count = 11;
+
+            float3 positions[count];
+            float3 actual[count];
+
+            for (size_t i = 0; i < count; i++)
+            {
+                positions[i] = float3(i * 1.5f, 10.0f - i, i * -0.25f);
+            }
+
+            float4x4 m =
+                make_float4x4_rotation_x(ToRadians(30.0f)) *
+                make_float4x4_rotation_y(ToRadians(30.0f)) *
+                make_float4x4_rotation_z(ToRadians(30.0f));
+            m.m41 = 10.0f;
+            m.m42 = 20.0f;
+            m.m43 = 30.0f;
+
+            transform(positions, count, m, actual);
+
+            for (size_t i = 0; i < count; i++)
+            {
+                Assert::IsTrue(Equal(transform(positions[i], m), actual[i]), L"transform did not return the expected value.");
+            }
+        }
+
+        // A test for deinterleave (float3) and interleave (float3)
+        TEST_METHOD(Float3InterleaveTest)
+        {
+            const size_t count = 7;
+
+            float3 values[count];
+            float x[count];
+            float y[count];
+            float z[count];
+            float3 actual[count];
+
+            for (size_t i = 0; i < count; i++)
+            {
+                values[i] = float3(static_cast<float>(i), i + 100.0f, i + 200.0f);
+            }
+
+            deinterleave(values, count, x, y, z);
+
+            for (size_t i = 0; i < count; i++)
+            {
+                Assert::AreEqual(values[i].x, x[i]);
+                Assert::AreEqual(values[i].y, y[i]);
+                Assert::AreEqual(values[i].z, z[i]);
+            }
+
+            interleave(x, y, z, count, actual);
+
+            for (size_t i = 0; i < count; i++)
+            {
+                Assert::AreEqual(values[i], actual[i]);
+            }
+        }
+
         // A test for normalize (float3)
         TEST_METHOD(Float3NormalizeTest)
         {
@@ -776,6 +776,30 @@ namespace NumericsTests
             Assert::IsFalse(is_identity(float3x2(1, 0, 0, 1, 0, 1)));
         }
 
+        // A test that float3x2 construction and arithmetic can be evaluated at compile time
+        TEST_METHOD(Float3x2ConstexprTest)
+        {
+#if !defined _MSC_VER || _MSC_VER >= 1900
+            static constexpr float3x2 transforms[] =
+            {
+                float3x2::identity(),
+                make_float3x2_translation(10, 20),
+                make_float3x2_scale(2, float2(1, 1)),
+                make_float3x2_scale(float2(2, 3)) * make_float3x2_translation(float2(5, 6)),
+            };
+
+            static_assert(is_identity(transforms[0]), "is_identity did not return the expected value.");
+            static_assert(translation(transforms[1]) == float2(10, 20), "translation did not return the expected value.");
+            static_assert(transforms[2] == float3x2(2, 0, 0, 2, -1, -1), "make_float3x2_scale did not return the expected value.");
+            static_assert(transforms[3] == float3x2(2, 0, 0, 3, 5, 6), "operator * did not return the expected value.");
+            static_assert(determinant(transforms[3]) == 6, "determinant did not return the expected value.");
+            static_assert(transforms[1] + -transforms[1] == float3x2(0, 0, 0, 0, 0, 0), "operator + did not return the expected value.");
+            static_assert(transforms[3] - transforms[3] * 0.5f != transforms[3], "operator - did not return the expected value.");
+
+            Assert::IsTrue(Equal(make_float3x2_scale(float2(2, 3)) * make_float3x2_translation(float2(5, 6)), transforms[3]));
+#endif
+        }
+
         // A test for float3x2 comparison involving NaN values
         TEST_METHOD(Float3x2EqualsNanTest)
         {
@@ -609,6 +609,70 @@ namespace NumericsTests
             Assert::IsTrue(Equal(expected, actual), L"transform did not return the expected value.");
         }
 
+        // A test for transform (float4 const*, size_t, float4x4, float4*)
+        TEST_METHOD(Float4TransformBatchTest)
+        {
+            const size_t count = 7;
+
+            float4 vectors[count];
+            float4 actual[count];
+
+            for (size_t i = 0; i < count; i++)
+            {
+                vectors[i] = float4(i * 1.5f, 10.0f - i, i * -0.25f, 1.0f);
+            }
+
+            float4x4 m =
+                make_float4x4_rotation_x(ToRadians(30.0f)) *
+                make_float4x4_rotation_y(ToRadians(30.0f)) *
+                make_float4x4_rotation_z(ToRadians(30.0f));
+            m.m41 = 10.0f;
+            m.m42 = 20.0f;
+            m.m43 = 30.0f;
+
+            transform(vectors, count, m, actual);
+
+            for (size_t i = 0; i < count; i++)
+            {
+                Assert::IsTrue(Equal(transform(vectors[i], m), actual[i]), L"transform did not return the expected value.");
+            }
+        }
+
+        // A test for deinterleave (float4) and interleave (float4)
+        TEST_METHOD(Float4InterleaveTest)
+        {
+            const size_t count = 7;
+
+            float4 values[count];
+            float x[count];
+            float y[count];
+            float z[count];
+            float w[count];
+            float4 actual[count];
+
+            for (size_t i = 0; i < count; i++)
+            {
+                values[i] = float4(static_cast<float>(i), i + 100.0f, i + 200.0f, i + 300.0f);
+            }
+
+            deinterleave(values, count, x, y, z, w);
+
+            for (size_t i = 0; i < count; i++)
+            {
+                Assert::AreEqual(values[i].x, x[i]);
+                Assert::AreEqual(values[i].y, y[i]);
+                Assert::AreEqual(values[i].z, z[i]);
+                Assert::AreEqual(values[i].w, w[i]);
+            }
+
+            interleave(x, y, z, w, count, actual);
+
+            for (size_t i = 0; i < count; i++)
+            {
+                Assert::AreEqual(values[i], actual[i]);
+            }
+        }
+
         // A test for normalize (float4)
         TEST_METHOD(Float4NormalizeTest)
         {
@@ -246,6 +246,45 @@ namespace NumericsTests
             Assert::IsTrue(Equal(i, float4x4::identity()));
         }
 
+        // A test for invert (float4x4)
+        TEST_METHOD(Float4x4InvertGeneralTest)
+        {
+            float4x4 mtx(3, 1, -2, 0.5f,
+                         -1, 4, 1, 2,
+                         0.25f, -3, 2, 1,
+                         2, 0.5f, -1, 5);
+
+            float4x4 actual;
+            Assert::IsTrue(invert(mtx, &actual));
+
+            float4x4 i = mtx * actual;
+            Assert::IsTrue(Equal(i, float4x4::identity()));
+
+            i = actual * mtx;
+            Assert::IsTrue(Equal(i, float4x4::identity()));
+        }
+
+        // A test for make_float4x4_from_quaternion (quaternion const*, size_t, float4x4*)
+        TEST_METHOD(Float4x4CreateFromQuaternionBatchTest)
+        {
+            const size_t count = 7;
+
+            quaternion quaternions[count];
+            float4x4 actual[count];
+
+            for (size_t i = 0; i < count; i++)
+            {
+                quaternions[i] = make_quaternion_from_yaw_pitch_roll(i * 0.5f, i * -0.25f, 2.0f - i);
+            }
+
+            make_float4x4_from_quaternion(quaternions, count, actual);
+
+            for (size_t i = 0; i < count; i++)
+            {
+                Assert::IsTrue(Equal(make_float4x4_from_quaternion(quaternions[i]), actual[i]), L"make_float4x4_from_quaternion did not return the expected value.");
+            }
+        }
+
         void DecomposeTest(float yaw, float pitch, float roll, float3 expectedTranslation, float3 expectedScales)
         {
             quaternion expectedRotation = make_quaternion_from_yaw_pitch_roll(ToRadians(yaw), ToRadians(pitch), ToRadians(roll));
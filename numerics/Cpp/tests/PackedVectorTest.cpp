@@ -0,0 +1,188 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+#include "Helpers.h"
+
+using namespace Windows::Foundation::Numerics;
+
+namespace NumericsTests
+{
+    NUMERICS_TEST_CLASS(PackedVectorTest)
+    {
+        NUMERICS_TEST_CLASS_INNER(PackedVectorTest)
+
+    public:
+        // A test for make_half2_from_float2 (float2) and make_float2_from_half2 (half2)
+        TEST_METHOD(Half2ConversionTest)
+        {
+            half2 expected(0x3C00, 0xC000);
+            half2 actual = make_half2_from_float2(float2(1.0f, -2.0f));
+            Assert::IsTrue(expected == actual, L"make_half2_from_float2 did not return the expected value.");
+
+            float2 roundTrip = make_float2_from_half2(actual);
+            Assert::IsTrue(float2(1.0f, -2.0f) == roundTrip, L"make_float2_from_half2 did not return the expected value.");
+        }
+
+        // A test for make_half4_from_float4 (float4) and make_float4_from_half4 (half4)
+        TEST_METHOD(Half4ConversionTest)
+        {
+            half4 expected(0x0000, 0x3800, 0x7BFF, 0x7C00);
+            half4 actual = make_half4_from_float4(float4(0.0f, 0.5f, 65504.0f, INFINITY));
+            Assert::IsTrue(expected == actual, L"make_half4_from_float4 did not return the expected value.");
+
+            float4 roundTrip = make_float4_from_half4(actual);
+            Assert::IsTrue(float4(0.0f, 0.5f, 65504.0f, INFINITY) == roundTrip, L"make_float4_from_half4 did not return the expected value.");
+
+            // Values that are not exactly representable round to nearest.
+            actual = make_half4_from_float4(float4(1.0f / 3.0f, 1.0009765625f, 1.00048828125f, 1.00146484375f));
+            Assert::IsTrue(half4(0x3555, 0x3C01, 0x3C00, 0x3C02) == actual, L"make_half4_from_float4 did not return the expected value.");
+        }
+
+        // A test for make_half2_from_float2 and make_float2_from_half2 (batched)
+        TEST_METHOD(Half2BatchTest)
+        {
+            // 7 values is 14 floats, which exercises every width of the bulk conversions.
+            const size_t count = 7;
+
+            float2 values[count];
+            half2 halves[count];
+            float2 results[count];
+
+            for (size_t i = 0; i < count; i++)
+            {
+                values[i] = float2(i * 0.37f - 1.5f, i * 123.456f);
+            }
+
+            make_half2_from_float2(values, count, halves);
+
+            for (size_t i = 0; i < count; i++)
+            {
+                Assert::IsTrue(make_half2_from_float2(values[i]) == halves[i], L"make_half2_from_float2 did not return the expected value.");
+            }
+
+            make_float2_from_half2(halves, count, results);
+
+            for (size_t i = 0; i < count; i++)
+            {
+                Assert::IsTrue(make_float2_from_half2(halves[i]) == results[i], L"make_float2_from_half2 did not return the expected value.");
+            }
+        }
+
+        // A test for make_half4_from_float4 and make_float4_from_half4 (batched)
+        TEST_METHOD(Half4BatchTest)
+        {
+            // 13 values is 52 floats, which exercises every width of the bulk conversions.
+            const size_t count = 13;
+
+            float4 values[count];
+            half4 halves[count];
+            float4 results[count];
+
+            for (size_t i = 0; i < count; i++)
+            {
+                values[i] = float4(i * 0.37f - 1.5f, i * 123.456f, -1.0f / (i + 1), i * 1e-6f);
+            }
+
+            make_half4_from_float4(values, count, halves);
+
+            for (size_t i = 0; i < count; i++)
+            {
+                Assert::IsTrue(make_half4_from_float4(values[i]) == halves[i], L"make_half4_from_float4 did not return the expected value.");
+            }
+
+            // In-place conversion is not supported (the types differ in size), so convert into a separate array.
+            make_float4_from_half4(halves, count, results);
+
+            for (size_t i = 0; i < count; i++)
+            {
+                Assert::IsTrue(make_float4_from_half4(halves[i]) == results[i], L"make_float4_from_half4 did not return the expected value.");
+            }
+        }
+
+        // A test for make_unorm8x4_from_float4 (float4) and make_float4_from_unorm8x4 (unorm8x4)
+        TEST_METHOD(Unorm8x4ConversionTest)
+        {
+            unorm8x4 expected(0, 255, 128, 51);
+            unorm8x4 actual = make_unorm8x4_from_float4(float4(0.0f, 1.0f, 0.5f, 0.2f));
+            Assert::IsTrue(expected == actual, L"make_unorm8x4_from_float4 did not return the expected value.");
+
+            // Out of range values are clamped, and NaN converts to zero.
+            expected = unorm8x4(0, 255, 0, 255);
+            actual = make_unorm8x4_from_float4(float4(-1.0f, 2.0f, NAN, INFINITY));
+            Assert::IsTrue(expected == actual, L"make_unorm8x4_from_float4 did not return the expected value.");
+
+            float4 roundTrip = make_float4_from_unorm8x4(unorm8x4(0, 255, 128, 51));
+            Assert::IsTrue(Equal(float4(0.0f, 1.0f, 128.0f / 255.0f, 0.2f), roundTrip), L"make_float4_from_unorm8x4 did not return the expected value.");
+        }
+
+        // A test for make_unorm8x4_from_float4 and make_float4_from_unorm8x4 (batched)
+        TEST_METHOD(Unorm8x4BatchTest)
+        {
+            const size_t count = 11;
+
+            float4 values[count];
+            unorm8x4 packed[count];
+            float4 results[count];
+
+            for (size_t i = 0; i < count; i++)
+            {
+                values[i] = float4(i * 0.13f - 0.2f, i / 10.0f, 1.0f - i * 0.031f, (i == 5) ? NAN : i * 0.25f);
+            }
+
+            make_unorm8x4_from_float4(values, count, packed);
+
+            for (size_t i = 0; i < count; i++)
+            {
+                Assert::IsTrue(make_unorm8x4_from_float4(values[i]) == packed[i], L"make_unorm8x4_from_float4 did not return the expected value.");
+            }
+
+            make_float4_from_unorm8x4(packed, count, results);
+
+            for (size_t i = 0; i < count; i++)
+            {
+                Assert::IsTrue(make_float4_from_unorm8x4(packed[i]) == results[i], L"make_float4_from_unorm8x4 did not return the expected value.");
+            }
+        }
+
+        // A test for operator == and operator != (half2, half4, unorm8x4)
+        TEST_METHOD(PackedVectorEqualityTest)
+        {
+            Assert::IsTrue(half2(1, 2) == half2(1, 2));
+            Assert::IsFalse(half2(1, 2) == half2(1, 3));
+            Assert::IsTrue(half2(1, 2) != half2(0, 2));
+            Assert::IsFalse(half2(1, 2) != half2(1, 2));
+
+            Assert::IsTrue(half4(1, 2, 3, 4) == half4(1, 2, 3, 4));
+            Assert::IsFalse(half4(1, 2, 3, 4) == half4(1, 2, 3, 5));
+            Assert::IsTrue(half4(1, 2, 3, 4) != half4(1, 2, 0, 4));
+            Assert::IsFalse(half4(1, 2, 3, 4) != half4(1, 2, 3, 4));
+
+            Assert::IsTrue(unorm8x4(1, 2, 3, 4) == unorm8x4(1, 2, 3, 4));
+            Assert::IsFalse(unorm8x4(1, 2, 3, 4) == unorm8x4(0, 2, 3, 4));
+            Assert::IsTrue(unorm8x4(1, 2, 3, 4) != unorm8x4(1, 0, 3, 4));
+            Assert::IsFalse(unorm8x4(1, 2, 3, 4) != unorm8x4(1, 2, 3, 4));
+        }
+
+        // A test to make sure these types have the expected compact layouts
+        TEST_METHOD(PackedVectorSizeofTest)
+        {
+            Assert::AreEqual(size_t(4), sizeof(half2));
+            Assert::AreEqual(size_t(8), sizeof(half4));
+            Assert::AreEqual(size_t(4), sizeof(unorm8x4));
+
+            Assert::AreEqual(size_t(2), offsetof(half2, y));
+            Assert::AreEqual(size_t(6), offsetof(half4, w));
+            Assert::AreEqual(size_t(3), offsetof(unorm8x4, w));
+        }
+    };
+}
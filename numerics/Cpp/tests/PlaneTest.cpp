@@ -225,6 +225,107 @@ namespace NumericsTests
             actual = transform(target, q);
             Assert::IsTrue(Equal(expected, actual), L"transform did not return the expected value.");
         }
+
+        // A test for extract_frustum_planes (float4x4, plane*)
+        TEST_METHOD(PlaneExtractFrustumPlanesTest)
+        {
+            float4x4 m = make_float4x4_perspective_field_of_view(ToRadians(90.0f), 1.0f, 1.0f, 10.0f);
+
+            float root = sqrtf(0.5f);
+
+            plane expected[] =
+            {
+                plane(root, 0, -root, 0),
+                plane(-root, 0, -root, 0),
+                plane(0, root, -root, 0),
+                plane(0, -root, -root, 0),
+                plane(0, 0, -1, -1),
+                plane(0, 0, 1, 10),
+            };
+
+            plane actual[6];
+            extract_frustum_planes(m, actual);
+
+            for (int i = 0; i < 6; i++)
+            {
+                Assert::IsTrue(Equal(expected[i], actual[i]), L"extract_frustum_planes did not return the expected value.");
+            }
+        }
+
+        // A test for cull_spheres (float const*, float const*, float const*, float const*, size_t, plane const*, size_t, uint32_t*)
+        TEST_METHOD(PlaneCullSpheresTest)
+        {
+            float4x4 view = make_float4x4_look_at(float3(0, 0, 0), float3(0, 0, -1), float3(0, 1, 0));
+            float4x4 projection = make_float4x4_perspective_field_of_view(ToRadians(90.0f), 1.0f, 1.0f, 100.0f);
+
+            plane planes[6];
+            extract_frustum_planes(view * projection, planes);
+
+            // Cycle through spheres that are inside, behind the camera, straddling the
+            // left plane, and entirely outside the left plane. 37 spheres spans more than
+            // one mask word and leaves a remainder after the groups of four.
+            const size_t count = 37;
+
+            float x[count], y[count], z[count], radius[count];
+
+            for (size_t i = 0; i < count; i++)
+            {
+                static const float3 centers[] = { float3(1, 2, -10), float3(0, 0, 10), float3(-12, 0, -10), float3(-20, 0, -10) };
+
+                x[i] = centers[i % 4].x;
+                y[i] = centers[i % 4].y;
+                z[i] = centers[i % 4].z;
+                radius[i] = 3;
+            }
+
+            uint32_t visible[2] = { 0xFFFFFFFF, 0xFFFFFFFF };
+            cull_spheres(x, y, z, radius, count, planes, 6, visible);
+
+            for (size_t i = 0; i < 64; i++)
+            {
+                bool expected = (i < count) && (i % 4 == 0 || i % 4 == 2);
+                bool actual = (visible[i / 32] & (1u << (i % 32))) != 0;
+                Assert::AreEqual(expected, actual, L"cull_spheres did not return the expected value.");
+            }
+        }
+
+        // A test for cull_boxes (float const*, float const*, float const*, float const*, float const*, float const*, size_t, plane const*, size_t, uint32_t*)
+        TEST_METHOD(PlaneCullBoxesTest)
+        {
+            float4x4 projection = make_float4x4_perspective_field_of_view(ToRadians(90.0f), 1.0f, 1.0f, 100.0f);
+
+            plane planes[6];
+            extract_frustum_planes(projection, planes);
+
+            // Cycle through boxes that are inside, behind the camera, straddling the
+            // near plane, and beyond the far plane.
+            const size_t count = 37;
+
+            float minX[count], minY[count], minZ[count], maxX[count], maxY[count], maxZ[count];
+
+            for (size_t i = 0; i < count; i++)
+            {
+                static const float3 minimums[] = { float3(-1, -1, -20), float3(-1, -1, 5), float3(-1, -1, -2), float3(-1, -1, -150) };
+                static const float3 maximums[] = { float3(1, 1, -10), float3(1, 1, 8), float3(1, 1, -0.5f), float3(1, 1, -120) };
+
+                minX[i] = minimums[i % 4].x;
+                minY[i] = minimums[i % 4].y;
+                minZ[i] = minimums[i % 4].z;
+                maxX[i] = maximums[i % 4].x;
+                maxY[i] = maximums[i % 4].y;
+                maxZ[i] = maximums[i % 4].z;
+            }
+
+            uint32_t visible[2] = { 0xFFFFFFFF, 0xFFFFFFFF };
+            cull_boxes(minX, minY, minZ, maxX, maxY, maxZ, count, planes, 6, visible);
+
+            for (size_t i = 0; i < 64; i++)
+            {
+                bool expected = (i < count) && (i % 4 == 0 || i % 4 == 2);
+                bool actual = (visible[i / 32] & (1u << (i % 32))) != 0;
+                Assert::AreEqual(expected, actual, L"cull_boxes did not return the expected value.");
+            }
+        }
         
         // A test for plane comparison involving NaN values
         TEST_METHOD(PlaneEqualsNanTest)
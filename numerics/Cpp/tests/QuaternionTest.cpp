@@ -460,6 +460,88 @@ namespace NumericsTests
             Assert::IsTrue(Equal(expected, actual), L"slerp did not return the expected value.");
         }
 
+        // A test for slerp (quaternion const*, quaternion const*, size_t, float, quaternion*)
+        TEST_METHOD(QuaternionSlerpBatchTest)
+        {
+            const size_t count = 11;
+
+            quaternion a[count];
+            quaternion b[count];
+            quaternion actual[count];
+
+            float3 axis = normalize(float3(1.0f, 2.0f, 3.0f));
+
+            for (size_t i = 0; i < count; i++)
+            {
+                a[i] = make_quaternion_from_axis_angle(axis, ToRadians(i * 10.0f));
+                b[i] = make_quaternion_from_yaw_pitch_roll(i * 0.3f, i * -0.2f, 1.0f);
+            }
+
+            // Cover the flipped and nearly identical cases.
+            b[1] = -b[1];
+            b[2] = a[2];
+            b[9] = -a[9];
+
+            slerp(a, b, count, 0.3f, actual);
+
+            for (size_t i = 0; i < count; i++)
+            {
+                Assert::IsTrue(Equal(slerp(a[i], b[i], 0.3f), actual[i]), L"slerp did not return the expected value.");
+            }
+
+            // In place.
+            slerp(a, b, count, 0.3f, a);
+
+            for (size_t i = 0; i < count; i++)
+            {
+                Assert::IsTrue(Equal(actual[i], a[i]), L"slerp did not return the expected value.");
+            }
+        }
+
+        // A test for normalize (quaternion const*, size_t, quaternion*)
+        TEST_METHOD(QuaternionNormalizeBatchTest)
+        {
+            const size_t count = 7;
+
+            quaternion values[count];
+            quaternion actual[count];
+
+            for (size_t i = 0; i < count; i++)
+            {
+                values[i] = quaternion(i + 1.0f, 2.0f - i, i * 0.5f, -3.0f);
+            }
+
+            normalize(values, count, actual);
+
+            for (size_t i = 0; i < count; i++)
+            {
+                Assert::IsTrue(Equal(normalize(values[i]), actual[i]), L"normalize did not return the expected value.");
+            }
+        }
+
+        // A test for concatenate (quaternion const*, quaternion const*, size_t, quaternion*)
+        TEST_METHOD(QuaternionConcatenateBatchTest)
+        {
+            const size_t count = 7;
+
+            quaternion a[count];
+            quaternion b[count];
+            quaternion actual[count];
+
+            for (size_t i = 0; i < count; i++)
+            {
+                a[i] = quaternion(5.0f, 6.0f - i, 7.0f, 8.0f + i);
+                b[i] = quaternion(1.0f + i, 2.0f, 3.0f * i, 4.0f);
+            }
+
+            concatenate(a, b, count, actual);
+
+            for (size_t i = 0; i < count; i++)
+            {
+                Assert::IsTrue(Equal(concatenate(a[i], b[i]), actual[i]), L"concatenate did not return the expected value.");
+            }
+        }
+
         // A test for operator - (quaternion)
         TEST_METHOD(QuaternionUnaryNegationTest)
         {
@@ -14,9 +14,26 @@
 
 #include "../WindowsNumerics.h"
 
+#ifdef _MSC_VER
+
 #pragma warning(disable: 4505)  // "unreferenced local function"
 
 #include <SDKDDKVer.h>
+
+#else
+
+// Portable build (see CMakeLists.txt). There are no WinRT types to interop with.
+#include <cmath>
+
+using std::isnan;
+using std::isinf;
+
+#define swprintf_s(buffer, ...) swprintf(buffer, sizeof(buffer) / sizeof(buffer[0]), __VA_ARGS__)
+
+#define DISABLE_NUMERICS_INTEROP_TESTS
+
+#endif
+
 #include <CppUnitTest.h>
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
@@ -139,6 +139,32 @@ public:
         return &m_data;
     }
 
+    //
+    // Changes the size of the array, keeping the existing elements (up to the
+    // new size). This lets an array be filled in place when its final size is
+    // not known up front, rather than building it in a separate container
+    // and then copying.
+    //
+    void Resize(size_t newSize)
+    {
+        assert(newSize <= UINT_MAX);
+
+        // Don't let newSize * sizeof(T) wrap around to a smaller allocation.
+        if (newSize > SIZE_MAX / sizeof(T))
+            ThrowHR(E_OUTOFMEMORY);
+
+        if (newSize == m_size && m_data)
+            return;
+
+        // CoTaskMemRealloc frees the block, rather than resizing it, when asked for zero bytes.
+        auto newData = static_cast<T*>(CoTaskMemRealloc(m_data, std::max<size_t>(newSize, 1) * sizeof(T)));
+        if (!newData)
+            ThrowHR(E_OUTOFMEMORY);
+
+        m_data = newData;
+        m_size = static_cast<uint32_t>(newSize);
+    }
+
     void Detach(uint32_t* size, T** data)
     {
         *size = m_size;
@@ -33,7 +33,94 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 
         return internal->GetRealizedD2DStrokeStyle(d2dFactory.Get());
     }
-    
+
+
+    //
+    // Helpers for bounds culling. All of these are conservative: anything they
+    // are not sure about (infinite or NaN values) produces infinite bounds,
+    // which are never culled.
+    //
+
+    static bool IsInfinite(D2D1_RECT_F const& rect)
+    {
+        return rect.left == -FLT_MAX &&
+               rect.top == -FLT_MAX &&
+               rect.right == FLT_MAX &&
+               rect.bottom == FLT_MAX;
+    }
+
+    static D2D1_RECT_F TransformBounds(D2D1_RECT_F const& rect, D2D1_MATRIX_3X2_F const& transform)
+    {
+        if (IsInfinite(rect))
+            return rect;
+
+        auto matrix = D2D1::Matrix3x2F::ReinterpretBaseType(&transform);
+
+        D2D1_POINT_2F corners[] =
+        {
+            matrix->TransformPoint(D2D1::Point2F(rect.left,  rect.top)),
+            matrix->TransformPoint(D2D1::Point2F(rect.right, rect.top)),
+            matrix->TransformPoint(D2D1::Point2F(rect.left,  rect.bottom)),
+            matrix->TransformPoint(D2D1::Point2F(rect.right, rect.bottom)),
+        };
+
+        D2D1_RECT_F result{ FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+        for (auto& corner : corners)
+        {
+            if (isnan(corner.x) || isnan(corner.y))
+                return D2D1::InfiniteRect();
+
+            result.left   = std::min<float>(result.left,   corner.x);
+            result.top    = std::min<float>(result.top,    corner.y);
+            result.right  = std::max<float>(result.right,  corner.x);
+            result.bottom = std::max<float>(result.bottom, corner.y);
+        }
+
+        return result;
+    }
+
+    static D2D1_RECT_F IntersectBounds(D2D1_RECT_F const& rect1, D2D1_RECT_F const& rect2)
+    {
+        return D2D1_RECT_F
+        {
+            std::max<float>(rect1.left,   rect2.left),
+            std::max<float>(rect1.top,    rect2.top),
+            std::min<float>(rect1.right,  rect2.right),
+            std::min<float>(rect1.bottom, rect2.bottom)
+        };
+    }
+
+    static D2D1_RECT_F GetLineBounds(Vector2 const& point0, Vector2 const& point1)
+    {
+        return D2D1_RECT_F
+        {
+            std::min<float>(point0.X, point1.X),
+            std::min<float>(point0.Y, point1.Y),
+            std::max<float>(point0.X, point1.X),
+            std::max<float>(point0.Y, point1.Y)
+        };
+    }
+
+    static D2D1_RECT_F GetRectBounds(Rect const& rect)
+    {
+        // Rect allows negative sizes, which D2D treats as a flipped rectangle.
+        return GetLineBounds(Vector2{ rect.X, rect.Y }, Vector2{ rect.X + rect.Width, rect.Y + rect.Height });
+    }
+
+    static D2D1_RECT_F GetEllipseBounds(Vector2 const& centerPoint, float radiusX, float radiusY)
+    {
+        radiusX = fabs(radiusX);
+        radiusY = fabs(radiusY);
+
+        return D2D1_RECT_F
+        {
+            centerPoint.X - radiusX,
+            centerPoint.Y - radiusY,
+            centerPoint.X + radiusX,
+            centerPoint.Y + radiusY
+        };
+    }
 
     //
     // This drawing session adapter is used when wrapping an existing
@@ -91,10 +178,36 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             resource, 
             m_adapter);
         CheckMakeResult(drawingSession);
+
+        // The device context belongs to native code, which may change its state at any time.
+        drawingSession->DisableStateCache();
+
         return drawingSession;
     }
 
 
+    void CanvasDrawingSessionManager::SetStatsHandler(StatsHandler handler)
+    {
+        std::lock_guard<std::mutex> lock(m_statsHandlerMutex);
+
+        m_statsHandler = handler;
+    }
+
+
+    void CanvasDrawingSessionManager::ReportStats(CanvasDrawingSessionStats const& stats)
+    {
+        StatsHandler handler;
+
+        {
+            std::lock_guard<std::mutex> lock(m_statsHandlerMutex);
+            handler = m_statsHandler;
+        }
+
+        if (handler)
+            handler(stats);
+    }
+
+
     CanvasDrawingSession::CanvasDrawingSession(
         std::shared_ptr<CanvasDrawingSessionManager> manager,
         ICanvasDevice* owner,
@@ -104,6 +217,11 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         , m_owner(owner)
         , m_adapter(adapter)
         , m_nextLayerId(0)
+        , m_isStateCacheEnabled(true)
+        , m_isCullingEnabled(false)
+        , m_isTextLayoutCacheEnabled(false)
+        , m_stats()
+        , m_haveStatsBeenReported(false)
     {
         CheckInPointer(adapter.get());
     }
@@ -124,9 +242,16 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         if (FAILED(hr))
             return hr;
 
+        // The palette's brushes belong to the device context we just let go of.
+        m_solidColorBrushes.Clear();
+
         return ExceptionBoundary(
             [&]
             {
+                // The stats are reported even if the layers were not popped or
+                // EndDraw throws, since that is when they are most interesting.
+                auto reportStatsWarden = MakeScopeWarden([&] { ReportStats(); });
+
                 if (!m_activeLayerIds.empty())
                     ThrowHR(E_FAIL, HStringReference(Strings::DidNotPopLayer).Get());
 
@@ -143,6 +268,60 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
     }
 
 
+    void CanvasDrawingSession::ReportStats()
+    {
+        if (m_haveStatsBeenReported)
+            return;
+
+        m_haveStatsBeenReported = true;
+
+        Manager()->ReportStats(GetStats());
+    }
+
+
+    CanvasDrawingSessionStats CanvasDrawingSession::GetStats() const
+    {
+        auto stats = m_stats;
+
+        stats.Size = sizeof(stats);
+        stats.ColorBrushPaletteHits = m_solidColorBrushes.GetHitCount();
+        stats.ColorBrushPaletteMisses = m_solidColorBrushes.GetMissCount();
+
+        return stats;
+    }
+
+
+    IFACEMETHODIMP CanvasDrawingSession::GetStats(CanvasDrawingSessionStats* stats)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                CheckInPointer(stats);
+
+                // Callers compiled against a newer header pass a bigger
+                // struct, and only get the fields this version knows about.
+                if (stats->Size < sizeof(CanvasDrawingSessionStats))
+                    ThrowHR(E_INVALIDARG);
+
+                *stats = GetStats();
+            });
+    }
+
+
+    IFACEMETHODIMP CanvasDrawingSession::GetResource(REFIID iid, void** resource)
+    {
+        DisableStateCache();
+
+        return ResourceWrapper::GetResource(iid, resource);
+    }
+
+
+    void CanvasDrawingSession::DisableStateCache()
+    {
+        m_isStateCacheEnabled = false;
+    }
+
+
     IFACEMETHODIMP CanvasDrawingSession::Clear(
         Color color)
     {
@@ -152,6 +331,8 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                 auto& deviceContext = GetResource();
 
                 auto d2dColor = ToD2DColor(color);
+                m_stats.Clears++;
+
                 deviceContext->Clear(&d2dColor);
             });
     }
@@ -397,7 +578,12 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                     offset.X + destSize.width,
                     offset.Y + destSize.height
                 };
+
+                if (IsCulled(d2dDestRect, 0))
+                    return;
                 
+                m_stats.ImageDraws++;
+
                 deviceContext->DrawBitmap(
                     d2dBitmap.Get(),
                     &d2dDestRect,
@@ -414,6 +600,8 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                 D2D1_COMPOSITE_MODE compositeMode = composite ? static_cast<D2D1_COMPOSITE_MODE>(*composite)
                                                               : GetCompositeModeFromPrimitiveBlend(deviceContext.Get());
 
+                m_stats.ImageDraws++;
+
                 deviceContext->DrawImage(
                     As<ICanvasImageInternal>(image)->GetD2DImage(deviceContext.Get()).Get(),
                     &d2dOffset,
@@ -446,6 +634,12 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             D2D1_RECT_F d2dSourceRect;
             if (sourceRect) d2dSourceRect = ToD2DRect(*sourceRect);
 
+            // Perspective transforms are not accounted for by the culling test.
+            if (!perspective && IsCulled(GetRectBounds(destinationRect), 0))
+                return;
+
+            m_stats.ImageDraws++;
+
             deviceContext->DrawBitmap(
                 internal->GetD2DBitmap().Get(),
                 &d2dDestRect,
@@ -456,6 +650,237 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         });
     }
 
+    //
+    // DrawSprites
+    //
+
+    IFACEMETHODIMP CanvasDrawingSession::DrawSprites(
+        uint32_t bitmapsCount,
+        ICanvasBitmap** bitmaps,
+        uint32_t transformsCount,
+        Matrix3x2* transforms,
+        uint32_t sourceRectsCount,
+        Rect* sourceRects)
+    {
+        return DrawSpritesWithTintsAndOpacitiesAndInterpolationAndSortMode(
+            bitmapsCount,
+            bitmaps,
+            transformsCount,
+            transforms,
+            sourceRectsCount,
+            sourceRects,
+            0,
+            nullptr,
+            0,
+            nullptr,
+            CanvasImageInterpolation::Linear,
+            CanvasSpriteSortMode::None);
+    }
+
+    // A sprite whose transform is just a positive scale plus a translation can be drawn
+    // by passing DrawBitmap a destination rectangle, which avoids changing the transform
+    // of the device context.
+    static bool IsPositiveScaleAndTranslation(Matrix3x2 const& transform)
+    {
+        return transform.M12 == 0 &&
+               transform.M21 == 0 &&
+               transform.M11 > 0 &&
+               transform.M22 > 0;
+    }
+
+    IFACEMETHODIMP CanvasDrawingSession::DrawSpritesWithTintsAndOpacitiesAndInterpolationAndSortMode(
+        uint32_t bitmapsCount,
+        ICanvasBitmap** bitmaps,
+        uint32_t transformsCount,
+        Matrix3x2* transforms,
+        uint32_t sourceRectsCount,
+        Rect* sourceRects,
+        uint32_t tintsCount,
+        ABI::Windows::UI::Color* tints,
+        uint32_t opacitiesCount,
+        float* opacities,
+        CanvasImageInterpolation interpolation,
+        CanvasSpriteSortMode sortMode)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                auto& deviceContext = GetResource();
+
+                // Tints and opacities are optional, but when present must have one entry per sprite.
+                if (transformsCount != bitmapsCount ||
+                    sourceRectsCount != bitmapsCount ||
+                    (tintsCount != 0 && tintsCount != bitmapsCount) ||
+                    (opacitiesCount != 0 && opacitiesCount != bitmapsCount))
+                {
+                    ThrowHR(E_INVALIDARG);
+                }
+
+                if (bitmapsCount == 0)
+                    return;
+
+                CheckInPointer(bitmaps);
+                CheckInPointer(transforms);
+                CheckInPointer(sourceRects);
+
+                if (tintsCount) CheckInPointer(tints);
+                if (opacitiesCount) CheckInPointer(opacities);
+
+                // Validated up front, so a null doesn't slip through the
+                // unchanged bitmap check below (or get sorted to the front).
+                for (uint32_t i = 0; i < bitmapsCount; i++)
+                {
+                    CheckInPointer(bitmaps[i]);
+                }
+
+                std::vector<uint32_t> drawOrder(bitmapsCount);
+
+                for (uint32_t i = 0; i < bitmapsCount; i++)
+                {
+                    drawOrder[i] = i;
+                }
+
+                // Sorting groups together sprites that share a bitmap, so each bitmap is only
+                // looked up once. The sort is stable, so sprites using the same bitmap are
+                // still drawn in their original order.
+                if (sortMode == CanvasSpriteSortMode::Bitmap)
+                {
+                    std::stable_sort(
+                        drawOrder.begin(),
+                        drawOrder.end(),
+                        [=](uint32_t a, uint32_t b)
+                        {
+                            return std::less<ICanvasBitmap*>()(bitmaps[a], bitmaps[b]);
+                        });
+                }
+
+                auto d2dInterpolation = static_cast<D2D1_INTERPOLATION_MODE>(interpolation);
+
+                // The transform goes through the session, so its cached copy stays in sync.
+                D2D1::Matrix3x2F previousTransform;
+                GetTransform(&previousTransform);
+                bool transformChanged = false;
+
+                auto restoreTransformWarden = MakeScopeWarden(
+                    [&]
+                    {
+                        if (transformChanged)
+                            SetTransform(previousTransform);
+                    });
+
+                ICanvasBitmap* currentBitmap = nullptr;
+                ID2D1Bitmap1* d2dBitmap = nullptr;
+
+                // Sprites with a colored tint are drawn through a color matrix effect, which
+                // is created the first time it is needed and then shared by the whole batch.
+                ComPtr<ID2D1Effect> tintEffect;
+                ID2D1Bitmap1* tintEffectInput = nullptr;
+
+                for (auto i : drawOrder)
+                {
+                    auto& transform = transforms[i];
+                    auto& sourceRect = sourceRects[i];
+
+                    if (m_isCullingEnabled)
+                    {
+                        auto spriteTransform = D2D1::Matrix3x2F::ReinterpretBaseType(ReinterpretAs<D2D1_MATRIX_3X2_F*>(&transform));
+
+                        if (IsCulled(GetRectBounds(Rect{ 0, 0, sourceRect.Width, sourceRect.Height }), 0, *spriteTransform * previousTransform))
+                            continue;
+                    }
+
+                    m_stats.SpriteDraws++;
+
+                    if (bitmaps[i] != currentBitmap)
+                    {
+                        currentBitmap = bitmaps[i];
+                        d2dBitmap = As<ICanvasBitmapInternal>(currentBitmap)->GetD2DBitmap().Get();
+                    }
+
+                    D2D1_RECT_F d2dSourceRect = ToD2DRect(sourceRect);
+                    D2D1_COLOR_F tint = tintsCount ? ToD2DColor(tints[i]) : D2D1::ColorF(D2D1::ColorF::White);
+                    float opacity = (opacitiesCount ? opacities[i] : 1.0f) * tint.a;
+
+                    bool hasColorTint = tint.r != 1 || tint.g != 1 || tint.b != 1;
+
+                    if (!hasColorTint && IsPositiveScaleAndTranslation(transform))
+                    {
+                        // Fast path: fold the sprite transform into the destination rectangle.
+                        if (transformChanged)
+                        {
+                            SetTransform(previousTransform);
+                            transformChanged = false;
+                        }
+
+                        D2D1_RECT_F d2dDestRect
+                        {
+                            transform.M31,
+                            transform.M32,
+                            transform.M31 + sourceRect.Width * transform.M11,
+                            transform.M32 + sourceRect.Height * transform.M22
+                        };
+
+                        deviceContext->DrawBitmap(
+                            d2dBitmap,
+                            &d2dDestRect,
+                            opacity,
+                            d2dInterpolation,
+                            &d2dSourceRect,
+                            nullptr);
+
+                        continue;
+                    }
+
+                    auto spriteTransform = D2D1::Matrix3x2F::ReinterpretBaseType(ReinterpretAs<D2D1_MATRIX_3X2_F*>(&transform));
+
+                    SetTransform(*spriteTransform * previousTransform);
+                    transformChanged = true;
+
+                    if (!hasColorTint)
+                    {
+                        D2D1_RECT_F d2dDestRect{ 0, 0, sourceRect.Width, sourceRect.Height };
+
+                        deviceContext->DrawBitmap(
+                            d2dBitmap,
+                            &d2dDestRect,
+                            opacity,
+                            d2dInterpolation,
+                            &d2dSourceRect,
+                            nullptr);
+                    }
+                    else
+                    {
+                        if (!tintEffect)
+                            ThrowIfFailed(deviceContext->CreateEffect(CLSID_D2D1ColorMatrix, &tintEffect));
+
+                        if (tintEffectInput != d2dBitmap)
+                        {
+                            tintEffect->SetInput(0, d2dBitmap);
+                            tintEffectInput = d2dBitmap;
+                        }
+
+                        D2D1_MATRIX_5X4_F tintMatrix = D2D1::Matrix5x4F(
+                            tint.r, 0, 0, 0,
+                            0, tint.g, 0, 0,
+                            0, 0, tint.b, 0,
+                            0, 0, 0, opacity,
+                            0, 0, 0, 0);
+
+                        ThrowIfFailed(tintEffect->SetValue(D2D1_COLORMATRIX_PROP_COLOR_MATRIX, tintMatrix));
+
+                        D2D1_POINT_2F d2dOffset{ 0, 0 };
+
+                        deviceContext->DrawImage(
+                            tintEffect.Get(),
+                            &d2dOffset,
+                            &d2dSourceRect,
+                            d2dInterpolation,
+                            GetCompositeModeFromPrimitiveBlend(deviceContext.Get()));
+                    }
+                }
+            });
+    }
+
     //
     // DrawLine
     //
@@ -670,6 +1095,11 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         auto& deviceContext = GetResource();
         CheckInPointer(brush);
 
+        if (IsCulled(GetLineBounds(point0, point1), GetStrokeRadius(strokeWidth, strokeStyle, false)))
+            return;
+
+        m_stats.LineDraws++;
+
         deviceContext->DrawLine(
             ToD2DPoint(point0),
             ToD2DPoint(point1),
@@ -679,6 +1109,144 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
     }
 
 
+    //
+    // DrawLines
+    //
+
+    IFACEMETHODIMP CanvasDrawingSession::DrawLinesWithBrush(
+        uint32_t point0sCount,
+        Vector2* point0s,
+        uint32_t point1sCount,
+        Vector2* point1s,
+        ICanvasBrush* brush)
+    {
+        return DrawLinesWithBrushAndStrokeWidthAndStrokeStyle(
+            point0sCount,
+            point0s,
+            point1sCount,
+            point1s,
+            brush,
+            1.0f,
+            nullptr);
+    }
+
+
+    IFACEMETHODIMP CanvasDrawingSession::DrawLinesWithColors(
+        uint32_t point0sCount,
+        Vector2* point0s,
+        uint32_t point1sCount,
+        Vector2* point1s,
+        uint32_t colorsCount,
+        Color* colors)
+    {
+        return DrawLinesWithColorsAndStrokeWidthAndStrokeStyle(
+            point0sCount,
+            point0s,
+            point1sCount,
+            point1s,
+            colorsCount,
+            colors,
+            1.0f,
+            nullptr);
+    }
+
+
+    IFACEMETHODIMP CanvasDrawingSession::DrawLinesWithBrushAndStrokeWidthAndStrokeStyle(
+        uint32_t point0sCount,
+        Vector2* point0s,
+        uint32_t point1sCount,
+        Vector2* point1s,
+        ICanvasBrush* brush,
+        float strokeWidth,
+        ICanvasStrokeStyle* strokeStyle)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                CheckInPointer(brush);
+
+                if (point1sCount != point0sCount)
+                    ThrowHR(E_INVALIDARG);
+
+                DrawLinesImpl(
+                    point0sCount,
+                    point0s,
+                    point1s,
+                    ToD2DBrush(brush).Get(),
+                    nullptr,
+                    strokeWidth,
+                    strokeStyle);
+            });
+    }
+
+
+    IFACEMETHODIMP CanvasDrawingSession::DrawLinesWithColorsAndStrokeWidthAndStrokeStyle(
+        uint32_t point0sCount,
+        Vector2* point0s,
+        uint32_t point1sCount,
+        Vector2* point1s,
+        uint32_t colorsCount,
+        Color* colors,
+        float strokeWidth,
+        ICanvasStrokeStyle* strokeStyle)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                if (point1sCount != point0sCount || colorsCount != point0sCount)
+                    ThrowHR(E_INVALIDARG);
+
+                DrawLinesImpl(
+                    point0sCount,
+                    point0s,
+                    point1s,
+                    nullptr,
+                    colors,
+                    strokeWidth,
+                    strokeStyle);
+            });
+    }
+
+
+    void CanvasDrawingSession::DrawLinesImpl(
+        uint32_t count,
+        Vector2 const* point0s,
+        Vector2 const* point1s,
+        ID2D1Brush* brush,
+        Color const* colors,
+        float strokeWidth,
+        ICanvasStrokeStyle* strokeStyle)
+    {
+        auto& deviceContext = GetResource();
+
+        if (count == 0)
+            return;
+
+        CheckInPointer(point0s);
+        CheckInPointer(point1s);
+        if (!brush) CheckInPointer(colors);
+
+        // The stroke style is realized once for the whole batch.
+        auto d2dStrokeStyle = ToD2DStrokeStyle(strokeStyle, deviceContext.Get());
+        auto strokeRadius = GetStrokeRadius(strokeWidth, strokeStyle, false);
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            if (IsCulled(GetLineBounds(point0s[i], point1s[i]), strokeRadius))
+                continue;
+
+            m_stats.LineDraws++;
+
+            deviceContext->DrawLine(
+                ToD2DPoint(point0s[i]),
+                ToD2DPoint(point1s[i]),
+                GetBatchBrush(brush, colors, i),
+                strokeWidth,
+                d2dStrokeStyle.Get());
+        }
+    }
+
+
     //
     // DrawRectangle
     //
@@ -876,6 +1444,11 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 
         auto d2dRect = ToD2DRect(rect);
 
+        if (IsCulled(GetRectBounds(rect), GetStrokeRadius(strokeWidth, strokeStyle, false)))
+            return;
+
+        m_stats.RectangleDraws++;
+
         deviceContext->DrawRectangle(
             &d2dRect,
             brush,
@@ -951,12 +1524,59 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 
         auto d2dRect = ToD2DRect(rect);
 
+        if (IsCulled(GetRectBounds(rect), 0))
+            return;
+
+        m_stats.RectangleFills++;
+
         deviceContext->FillRectangle(
             &d2dRect,
             brush);
     }
 
 
+    // If a geometry is a rectangle (possibly wrapped in a transformed geometry) and
+    // the transform contains only scaling and translation, returns the area covered
+    // by the transformed geometry as an axis aligned rectangle.
+    static bool TryGetAxisAlignedRect(ID2D1Geometry* geometry, D2D1_MATRIX_3X2_F const& geometryTransform, D2D1_RECT_F* result)
+    {
+        ComPtr<ID2D1Geometry> sourceGeometry = geometry;
+        auto transform = *D2D1::Matrix3x2F::ReinterpretBaseType(&geometryTransform);
+
+        if (auto transformedGeometry = MaybeAs<ID2D1TransformedGeometry>(geometry))
+        {
+            D2D1::Matrix3x2F innerTransform;
+            transformedGeometry->GetTransform(&innerTransform);
+            transformedGeometry->GetSourceGeometry(&sourceGeometry);
+
+            transform = innerTransform * transform;
+        }
+
+        auto rectangleGeometry = MaybeAs<ID2D1RectangleGeometry>(sourceGeometry);
+
+        if (!rectangleGeometry)
+            return false;
+
+        if (transform._12 != 0.0f || transform._21 != 0.0f)
+            return false;
+
+        D2D1_RECT_F rect;
+        rectangleGeometry->GetRect(&rect);
+
+        auto topLeft = transform.TransformPoint(D2D1::Point2F(rect.left, rect.top));
+        auto bottomRight = transform.TransformPoint(D2D1::Point2F(rect.right, rect.bottom));
+
+        *result = D2D1_RECT_F
+        {
+            std::min<float>(topLeft.x, bottomRight.x),
+            std::min<float>(topLeft.y, bottomRight.y),
+            std::max<float>(topLeft.x, bottomRight.x),
+            std::max<float>(topLeft.y, bottomRight.y)
+        };
+
+        return true;
+    }
+
     static bool ArePointsInsideBitmap(ID2D1Bitmap* bitmap, D2D1_POINT_2F const& point1, D2D1_POINT_2F const& point2, D2D1_UNIT_MODE unitMode)
     {
         D2D1_SIZE_F bitmapSize;
@@ -994,6 +1614,50 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
     }
 
 
+    // Returns true if filling through a bitmap brush maps each bitmap pixel exactly onto
+    // a target pixel, in which case the interpolation mode has no effect on the result.
+    static bool IsBitmapBrushPixelAligned(ID2D1Bitmap* bitmap, D2D1::Matrix3x2F const& brushTransform, ID2D1DeviceContext1* deviceContext)
+    {
+        D2D1::Matrix3x2F worldTransform;
+        deviceContext->GetTransform(&worldTransform);
+
+        if (worldTransform._12 != 0 || worldTransform._21 != 0)
+            return false;
+
+        // Scale factors from bitmap pixels to bitmap units, and from target units to target pixels.
+        float bitmapScaleX = 1, bitmapScaleY = 1;
+        float targetScaleX = 1, targetScaleY = 1;
+
+        if (deviceContext->GetUnitMode() == D2D1_UNIT_MODE_DIPS)
+        {
+            float bitmapDpiX, bitmapDpiY;
+            bitmap->GetDpi(&bitmapDpiX, &bitmapDpiY);
+
+            float targetDpiX, targetDpiY;
+            deviceContext->GetDpi(&targetDpiX, &targetDpiY);
+
+            bitmapScaleX = DEFAULT_DPI / bitmapDpiX;
+            bitmapScaleY = DEFAULT_DPI / bitmapDpiY;
+            targetScaleX = targetDpiX / DEFAULT_DPI;
+            targetScaleY = targetDpiY / DEFAULT_DPI;
+        }
+
+        auto pixelTransform = D2D1::Matrix3x2F::Scale(bitmapScaleX, bitmapScaleY) *
+                              brushTransform *
+                              worldTransform *
+                              D2D1::Matrix3x2F::Scale(targetScaleX, targetScaleY);
+
+        const float epsilon = 0.001f;
+
+        auto isNear = [=](float value, float expected) { return fabs(value - expected) <= epsilon; };
+
+        return isNear(pixelTransform._11, 1) &&
+               isNear(pixelTransform._22, 1) &&
+               isNear(pixelTransform._31, roundf(pixelTransform._31)) &&
+               isNear(pixelTransform._32, roundf(pixelTransform._32));
+    }
+
+
     static bool TryGetFillOpacityMaskParameters(ID2D1Brush* opacityBrush, ID2D1DeviceContext1* deviceContext, D2D1_RECT_F const& destRect, ID2D1Bitmap** opacityBitmap, D2D1_RECT_F* opacitySourceRect)
     {
         // Is this a bitmap brush?
@@ -1021,11 +1685,13 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         }
 
         // Transform the dest rect by the inverse of the brush transform, yielding a FillOpacityMask source rect.
-        if (!D2D1InvertMatrix(&brushTransform))
+        auto inverseBrushTransform = brushTransform;
+
+        if (!D2D1InvertMatrix(&inverseBrushTransform))
             return false;
 
-        auto tl = D2D1_POINT_2F{ destRect.left,  destRect.top    } * brushTransform;
-        auto br = D2D1_POINT_2F{ destRect.right, destRect.bottom } * brushTransform;
+        auto tl = D2D1_POINT_2F{ destRect.left,  destRect.top    } * inverseBrushTransform;
+        auto br = D2D1_POINT_2F{ destRect.right, destRect.bottom } * inverseBrushTransform;
 
         // Can't use FillOpacityMask if the source rect goes outside the bounds of the bitmap.
         if (!ArePointsInsideBitmap(*opacityBitmap, tl, br, deviceContext->GetUnitMode()))
@@ -1035,8 +1701,12 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         if (bitmapBrush->GetOpacity() != 1.0f)
             return false;
 
-        if (bitmapBrush->GetInterpolationMode1() != D2D1_BITMAP_INTERPOLATION_MODE_LINEAR)
+        // Other interpolation modes give the same result when no resampling is needed.
+        if (bitmapBrush->GetInterpolationMode1() != D2D1_BITMAP_INTERPOLATION_MODE_LINEAR &&
+            !IsBitmapBrushPixelAligned(*opacityBitmap, brushTransform, deviceContext))
+        {
             return false;
+        }
 
         // FillOpacityMask requires that antialiasing be disabled.
         if (deviceContext->GetAntialiasMode() != D2D1_ANTIALIAS_MODE_ALIASED)
@@ -1067,9 +1737,16 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                 ComPtr<ID2D1Bitmap> opacityBitmap;
                 D2D1_RECT_F opacitySourceRect;
 
+                if (IsCulled(GetRectBounds(rect), 0))
+                    return;
+
+                m_stats.RectangleFills++;
+
                 if (TryGetFillOpacityMaskParameters(d2dOpacityBrush.Get(), deviceContext.Get(), d2dRect, &opacityBitmap, &opacitySourceRect))
                 {
                     // Fast path: we can use FillOpacityMask.
+                    m_stats.OpacityMaskFastPathFills++;
+
                     deviceContext->FillOpacityMask(opacityBitmap.Get(), d2dBrush.Get(), &d2dRect, &opacitySourceRect);
                 }
                 else
@@ -1078,6 +1755,8 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                     // a layer to apply the opacity brush (if any) and then draw a regular rectangle.
                     if (d2dOpacityBrush)
                     {
+                        m_stats.OpacityMaskLayerFallbacks++;
+
                         auto layerParameters = D2D1::LayerParameters1();
                         layerParameters.opacityBrush = d2dOpacityBrush.Get();
 
@@ -1110,6 +1789,80 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
     }
 
 
+    //
+    // FillRectangles
+    //
+
+    IFACEMETHODIMP CanvasDrawingSession::FillRectanglesWithBrush(
+        uint32_t rectsCount,
+        Rect* rects,
+        ICanvasBrush* brush)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                CheckInPointer(brush);
+
+                FillRectanglesImpl(
+                    rectsCount,
+                    rects,
+                    ToD2DBrush(brush).Get(),
+                    nullptr);
+            });
+    }
+
+
+    IFACEMETHODIMP CanvasDrawingSession::FillRectanglesWithColors(
+        uint32_t rectsCount,
+        Rect* rects,
+        uint32_t colorsCount,
+        Color* colors)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                if (colorsCount != rectsCount)
+                    ThrowHR(E_INVALIDARG);
+
+                FillRectanglesImpl(
+                    rectsCount,
+                    rects,
+                    nullptr,
+                    colors);
+            });
+    }
+
+
+    void CanvasDrawingSession::FillRectanglesImpl(
+        uint32_t count,
+        Rect const* rects,
+        ID2D1Brush* brush,
+        Color const* colors)
+    {
+        auto& deviceContext = GetResource();
+
+        if (count == 0)
+            return;
+
+        CheckInPointer(rects);
+        if (!brush) CheckInPointer(colors);
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            if (IsCulled(GetRectBounds(rects[i]), 0))
+                continue;
+
+            auto d2dRect = ToD2DRect(rects[i]);
+
+            m_stats.RectangleFills++;
+
+            deviceContext->FillRectangle(
+                &d2dRect,
+                GetBatchBrush(brush, colors, i));
+        }
+    }
+
+
     //
     // DrawRoundedRectangle
     //
@@ -1357,6 +2110,11 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 
         auto d2dRoundedRect = ToD2DRoundedRect(rect, radiusX, radiusY);
 
+        if (IsCulled(GetRectBounds(rect), GetStrokeRadius(strokeWidth, strokeStyle, false)))
+            return;
+
+        m_stats.RoundedRectangleDraws++;
+
         deviceContext->DrawRoundedRectangle(
             &d2dRoundedRect,
             brush,
@@ -1450,6 +2208,11 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 
         auto d2dRoundedRect = ToD2DRoundedRect(rect, radiusX, radiusY);
 
+        if (IsCulled(GetRectBounds(rect), 0))
+            return;
+
+        m_stats.RoundedRectangleFills++;
+
         deviceContext->FillRoundedRectangle(
             &d2dRoundedRect,
             brush);
@@ -1691,6 +2454,11 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 
         auto d2dEllipse = ToD2DEllipse(centerPoint, radiusX, radiusY);
 
+        if (IsCulled(GetEllipseBounds(centerPoint, radiusX, radiusY), GetStrokeRadius(strokeWidth, strokeStyle, false)))
+            return;
+
+        m_stats.EllipseDraws++;
+
         deviceContext->DrawEllipse(
             &d2dEllipse,
             brush,
@@ -1780,6 +2548,11 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 
         auto d2dEllipse = ToD2DEllipse(centerPoint, radiusX, radiusY);
 
+        if (IsCulled(GetEllipseBounds(centerPoint, radiusX, radiusY), 0))
+            return;
+
+        m_stats.EllipseFills++;
+
         deviceContext->FillEllipse(
             &d2dEllipse,
             brush);
@@ -2046,6 +2819,91 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
     }
 
 
+    //
+    // FillCircles
+    //
+
+    IFACEMETHODIMP CanvasDrawingSession::FillCirclesWithBrush(
+        uint32_t centerPointsCount,
+        Vector2* centerPoints,
+        uint32_t radiiCount,
+        float* radii,
+        ICanvasBrush* brush)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                CheckInPointer(brush);
+
+                if (radiiCount != centerPointsCount)
+                    ThrowHR(E_INVALIDARG);
+
+                FillCirclesImpl(
+                    centerPointsCount,
+                    centerPoints,
+                    radii,
+                    ToD2DBrush(brush).Get(),
+                    nullptr);
+            });
+    }
+
+
+    IFACEMETHODIMP CanvasDrawingSession::FillCirclesWithColors(
+        uint32_t centerPointsCount,
+        Vector2* centerPoints,
+        uint32_t radiiCount,
+        float* radii,
+        uint32_t colorsCount,
+        Color* colors)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                if (radiiCount != centerPointsCount || colorsCount != centerPointsCount)
+                    ThrowHR(E_INVALIDARG);
+
+                FillCirclesImpl(
+                    centerPointsCount,
+                    centerPoints,
+                    radii,
+                    nullptr,
+                    colors);
+            });
+    }
+
+
+    void CanvasDrawingSession::FillCirclesImpl(
+        uint32_t count,
+        Vector2 const* centerPoints,
+        float const* radii,
+        ID2D1Brush* brush,
+        Color const* colors)
+    {
+        auto& deviceContext = GetResource();
+
+        if (count == 0)
+            return;
+
+        CheckInPointer(centerPoints);
+        CheckInPointer(radii);
+        if (!brush) CheckInPointer(colors);
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            if (IsCulled(GetEllipseBounds(centerPoints[i], radii[i], radii[i]), 0))
+                continue;
+
+            auto d2dEllipse = ToD2DEllipse(centerPoints[i], radii[i], radii[i]);
+
+            m_stats.EllipseFills++;
+
+            deviceContext->FillEllipse(
+                &d2dEllipse,
+                GetBatchBrush(brush, colors, i));
+        }
+    }
+
+
     //
     // DrawText
     //
@@ -2219,30 +3077,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         ID2D1Brush* brush,
         ICanvasTextFormat* format)
     {
-        auto& deviceContext = GetResource();
-        CheckInPointer(brush);
-
-        if (!format)
-        {
-            format = GetDefaultTextFormat();
-        }
-
-        ComPtr<ICanvasTextFormatInternal> formatInternal;
-        ThrowIfFailed(format->QueryInterface(formatInternal.GetAddressOf()));
-
-        uint32_t textLength;
-        auto textBuffer = WindowsGetStringRawBuffer(text, &textLength);
-        ThrowIfNullPointer(textBuffer, E_INVALIDARG);
-
-        auto d2dRect = ToD2DRect(rect);
-
-        deviceContext->DrawText(
-            textBuffer,
-            textLength,
-            formatInternal->GetRealizedTextFormat().Get(),
-            &d2dRect,
-            brush,
-            static_cast<D2D1_DRAW_TEXT_OPTIONS>(formatInternal->GetDrawTextOptions()));
+        DrawTextImpl(text, rect, brush, format, false);
     }
 
 
@@ -2252,31 +3087,80 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         ID2D1Brush* brush,
         ICanvasTextFormat* format)
     {
+        // When drawing using just a point we specify a zero sized rectangle and
+        // disable word wrapping.
+        Rect rect{ point.X, point.Y, 0, 0 };
+
+        DrawTextImpl(text, rect, brush, format, true);
+    }
+
+
+    void CanvasDrawingSession::DrawTextImpl(
+        HSTRING text,
+        Rect const& rect,
+        ID2D1Brush* brush,
+        ICanvasTextFormat* format,
+        bool disableWordWrapping)
+    {
+        auto& deviceContext = GetResource();
+        CheckInPointer(brush);
+
         if (!format)
         {
             format = GetDefaultTextFormat();
         }
 
-        // When drawing using just a point we specify a zero sized rectangle and
-        // disable word wrapping.
-        Rect rect{ point.X, point.Y, 0, 0 };
+        ComPtr<ICanvasTextFormatInternal> formatInternal;
+        ThrowIfFailed(format->QueryInterface(formatInternal.GetAddressOf()));
+
+        uint32_t textLength;
+        auto textBuffer = WindowsGetStringRawBuffer(text, &textLength);
+        ThrowIfNullPointer(textBuffer, E_INVALIDARG);
 
-        //
-        // TODO #802: there's a thread-safety implication since we're modifying state
-        // on something that _may_ be being used on another thread.
-        //
-        CanvasWordWrapping oldWordWrapping{};
-        ThrowIfFailed(format->get_WordWrapping(&oldWordWrapping));
+        auto d2dRect = ToD2DRect(rect);
+        // Rather than changing the WordWrapping of the caller's format (which
+        // could be in use on another thread), use a NoWrap copy of it.
+        auto d2dFormat = disableWordWrapping ? formatInternal->GetRealizedNoWrapTextFormat()
+                                             : formatInternal->GetRealizedTextFormat();
+        auto d2dOptions = static_cast<D2D1_DRAW_TEXT_OPTIONS>(formatInternal->GetDrawTextOptions());
 
-        ThrowIfFailed(format->put_WordWrapping(CanvasWordWrapping::NoWrap));
+        m_stats.TextDraws++;
 
-        auto restoreWordWrapping = MakeScopeWarden(
-            [&]
-            {
-                format->put_WordWrapping(oldWordWrapping);
-            });
+        if (m_isTextLayoutCacheEnabled)
+        {
+            // This is what DrawText does, except that the layout can be reused.
+            auto result = Manager()->GetTextLayoutCache().Draw(
+                textBuffer,
+                textLength,
+                d2dFormat.Get(),
+                formatInternal->GetRealizedTextFormatVersion(),
+                rect.Width,
+                rect.Height,
+                [&](IDWriteTextLayout* layout)
+                {
+                    deviceContext->DrawTextLayout(
+                        D2D1::Point2F(d2dRect.left, d2dRect.top),
+                        layout,
+                        brush,
+                        d2dOptions);
+                });
+
+            if (result == TextLayoutCacheResult::Hit)
+                m_stats.TextLayoutCacheHits++;
+            else if (result == TextLayoutCacheResult::Miss)
+                m_stats.TextLayoutCacheMisses++;
+
+            if (result != TextLayoutCacheResult::NotCacheable)
+                return;
+        }
 
-        DrawTextAtRectImpl(text, rect, brush, format);
+        deviceContext->DrawText(
+            textBuffer,
+            textLength,
+            d2dFormat.Get(),
+            &d2dRect,
+            brush,
+            d2dOptions);
     }
 
 
@@ -2324,6 +3208,8 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                 CanvasDrawTextOptions drawTextOptions;
                 ThrowIfFailed(textLayout->get_Options(&drawTextOptions));
 
+                m_stats.TextDraws++;
+
                 deviceContext->DrawTextLayout(
                     D2D1_POINT_2F{ x, y },
                     GetWrappedResource<IDWriteTextLayout>(textLayout).Get(),
@@ -2361,6 +3247,8 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                 CanvasDrawTextOptions drawTextOptions;
                 ThrowIfFailed(textLayout->get_Options(&drawTextOptions));
 
+                m_stats.TextDraws++;
+
                 deviceContext->DrawTextLayout(
                     D2D1_POINT_2F{ x, y },
                     GetWrappedResource<IDWriteTextLayout>(textLayout).Get(),
@@ -2556,7 +3444,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             {
                 auto d2dBrush = ToD2DBrush(brush);
 
-                TemporaryTransform<ID2D1DeviceContext1> transform(GetResource().Get(), offset);
+                TemporaryTransform<CanvasDrawingSession> transform(this, offset);
                 TemporaryTransform<ID2D1Brush> brushTransform(d2dBrush.Get(), Vector2{ -offset.X, -offset.Y }, true);
 
                 DrawGeometryImpl(
@@ -2578,7 +3466,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         return ExceptionBoundary(
             [&]
             {
-                TemporaryTransform<ID2D1DeviceContext1> transform(GetResource().Get(), offset);
+                TemporaryTransform<CanvasDrawingSession> transform(this, offset);
 
                 DrawGeometryImpl(
                     geometry,
@@ -2669,8 +3557,15 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         CheckInPointer(geometry);
         CheckInPointer(brush);
 
+        auto d2dGeometry = GetWrappedResource<ID2D1Geometry>(geometry);
+
+        if (IsGeometryCulled(d2dGeometry.Get(), strokeWidth, strokeStyle))
+            return;
+
+        m_stats.GeometryDraws++;
+
         deviceContext->DrawGeometry(
-            GetWrappedResource<ID2D1Geometry>(geometry).Get(),
+            d2dGeometry.Get(),
             brush,
             strokeWidth,
             ToD2DStrokeStyle(strokeStyle, deviceContext.Get()).Get());
@@ -2708,7 +3603,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 
                 Vector2 inverseOffset{ -offset.X, -offset.Y };
 
-                TemporaryTransform<ID2D1DeviceContext1> transform(GetResource().Get(), offset);
+                TemporaryTransform<CanvasDrawingSession> transform(this, offset);
                 TemporaryTransform<ID2D1Brush> brushTransform(d2dBrush.Get(), inverseOffset, true);
                 TemporaryTransform<ID2D1Brush> opacityBrushTransform(d2dOpacityBrush.Get(), inverseOffset, true);
 
@@ -2728,7 +3623,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         return ExceptionBoundary(
             [&]
             {
-                TemporaryTransform<ID2D1DeviceContext1> transform(GetResource().Get(), offset);
+                TemporaryTransform<CanvasDrawingSession> transform(this, offset);
 
                 FillGeometryImpl(
                     geometry,
@@ -2843,19 +3738,43 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 
         auto d2dGeometry = GetWrappedResource<ID2D1Geometry>(geometry);
 
+        if (IsGeometryCulled(d2dGeometry.Get(), 0, nullptr))
+            return;
+
+        m_stats.GeometryFills++;
+
+        D2D1_RECT_F geometryRect;
+        ComPtr<ID2D1Bitmap> opacityBitmap;
+        D2D1_RECT_F opacitySourceRect;
+
         if (!opacityBrush || IsBitmapBrushWithClampExtendMode(brush))
         {
             // Fast path: if there is no opacity brush, or if our color brush is
             // a clamped bitmap, D2D can fill the geometry directly in a single call.
+            if (opacityBrush)
+                m_stats.OpacityMaskFastPathFills++;
+
             deviceContext->FillGeometry(
                 d2dGeometry.Get(),
                 brush,
                 opacityBrush);
         }
+        else if (MaybeAs<ID2D1BitmapBrush1>(opacityBrush) &&
+                 TryGetAxisAlignedRect(d2dGeometry.Get(), D2D1::Matrix3x2F::Identity(), &geometryRect) &&
+                 TryGetFillOpacityMaskParameters(opacityBrush, deviceContext.Get(), geometryRect, &opacityBitmap, &opacitySourceRect))
+        {
+            // Fast path: filling a rectangle geometry is the same as FillRectangle,
+            // so can use FillOpacityMask in the same cases.
+            m_stats.OpacityMaskFastPathFills++;
+
+            deviceContext->FillOpacityMask(opacityBitmap.Get(), brush, &geometryRect, &opacitySourceRect);
+        }
         else
         {
             // Slow path: if FillGeometry does not directly support the requested
             // operation, use a layer to apply the opacity brush instead.
+            m_stats.OpacityMaskLayerFallbacks++;
+
             auto layerParameters = D2D1::LayerParameters1();
             layerParameters.opacityBrush = opacityBrush;
 
@@ -2885,7 +3804,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             {
                 auto d2dBrush = ToD2DBrush(brush);
 
-                TemporaryTransform<ID2D1DeviceContext1> transform(GetResource().Get(), offset);
+                TemporaryTransform<CanvasDrawingSession> transform(this, offset);
                 TemporaryTransform<ID2D1Brush> brushTransform(d2dBrush.Get(), Vector2{ -offset.X, -offset.Y }, true);
 
                 DrawCachedGeometryImpl(
@@ -2903,7 +3822,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         return ExceptionBoundary(
             [&]
             {
-                TemporaryTransform<ID2D1DeviceContext1> transform(GetResource().Get(), offset);
+                TemporaryTransform<CanvasDrawingSession> transform(this, offset);
 
                 DrawCachedGeometryImpl(
                     cachedGeometry,
@@ -2974,6 +3893,8 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         CheckInPointer(cachedGeometry);
         CheckInPointer(brush);
 
+        m_stats.CachedGeometryDraws++;
+
         deviceContext->DrawGeometryRealization(
             GetWrappedResource<ID2D1GeometryRealization>(cachedGeometry).Get(),
             brush);
@@ -2982,18 +3903,19 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 
     ID2D1SolidColorBrush* CanvasDrawingSession::GetColorBrush(Color const& color)
     {
-        if (m_solidColorBrush)
-        {
-            m_solidColorBrush->SetColor(ToD2DColor(color));
-        }
-        else
-        {
-            // TODO #802: pool and reuse this brush along with the device context?
-            auto& deviceContext = GetResource();
-            ThrowIfFailed(deviceContext->CreateSolidColorBrush(ToD2DColor(color), &m_solidColorBrush));
-        }
+        auto& deviceContext = GetResource();
+
+        return m_solidColorBrushes.GetBrush(deviceContext.Get(), color);
+    }
 
-        return m_solidColorBrush.Get();
+
+    // Batched draws take either one brush for the whole batch, or one color per item.
+    ID2D1Brush* CanvasDrawingSession::GetBatchBrush(ID2D1Brush* brush, Color const* colors, uint32_t index)
+    {
+        if (brush)
+            return brush;
+
+        return GetColorBrush(colors[index]);
     }
 
 
@@ -3004,6 +3926,8 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 
         auto& deviceContext = GetResource();
 
+        m_stats.BrushesRealized++;
+
         return As<ICanvasBrushInternal>(brush)->GetD2DBrush(deviceContext.Get());
     }
 
@@ -3016,7 +3940,12 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                 auto& deviceContext = GetResource();
                 CheckInPointer(value);
 
-                *value = static_cast<CanvasAntialiasing>(deviceContext->GetAntialiasMode());
+                auto d2dValue = deviceContext->GetAntialiasMode();
+
+                if (m_isStateCacheEnabled)
+                    m_antialiasMode.Set(d2dValue);
+
+                *value = static_cast<CanvasAntialiasing>(d2dValue);
             });
 	}
 
@@ -3027,7 +3956,20 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             {
                 auto& deviceContext = GetResource();
 
-                deviceContext->SetAntialiasMode(static_cast<D2D1_ANTIALIAS_MODE>(value));
+                auto d2dValue = static_cast<D2D1_ANTIALIAS_MODE>(value);
+
+                if (m_isStateCacheEnabled && m_antialiasMode.Matches(d2dValue))
+                {
+                    m_stats.RedundantStateChangesSkipped++;
+                    return;
+                }
+
+                m_stats.StateChanges++;
+
+                deviceContext->SetAntialiasMode(d2dValue);
+
+                if (m_isStateCacheEnabled)
+                    m_antialiasMode.Set(d2dValue);
             });
 	}
 
@@ -3039,7 +3981,12 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                 auto& deviceContext = GetResource();
                 CheckInPointer(value);
 
-                *value = static_cast<CanvasBlend>(deviceContext->GetPrimitiveBlend());
+                auto d2dValue = deviceContext->GetPrimitiveBlend();
+
+                if (m_isStateCacheEnabled)
+                    m_primitiveBlend.Set(d2dValue);
+
+                *value = static_cast<CanvasBlend>(d2dValue);
             });
 	}
 
@@ -3050,7 +3997,20 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             {
                 auto& deviceContext = GetResource();
 
-                deviceContext->SetPrimitiveBlend(static_cast<D2D1_PRIMITIVE_BLEND>(value));
+                auto d2dValue = static_cast<D2D1_PRIMITIVE_BLEND>(value);
+
+                if (m_isStateCacheEnabled && m_primitiveBlend.Matches(d2dValue))
+                {
+                    m_stats.RedundantStateChangesSkipped++;
+                    return;
+                }
+
+                m_stats.StateChanges++;
+
+                deviceContext->SetPrimitiveBlend(d2dValue);
+
+                if (m_isStateCacheEnabled)
+                    m_primitiveBlend.Set(d2dValue);
             });
 	}
 
@@ -3062,7 +4022,12 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                 auto& deviceContext = GetResource();
                 CheckInPointer(value);
 
-                *value = static_cast<CanvasTextAntialiasing>(deviceContext->GetTextAntialiasMode());
+                auto d2dValue = deviceContext->GetTextAntialiasMode();
+
+                if (m_isStateCacheEnabled)
+                    m_textAntialiasMode.Set(d2dValue);
+
+                *value = static_cast<CanvasTextAntialiasing>(d2dValue);
             });
 	}
 
@@ -3073,7 +4038,20 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             {
                 auto& deviceContext = GetResource();
 
-                deviceContext->SetTextAntialiasMode(static_cast<D2D1_TEXT_ANTIALIAS_MODE>(value));
+                auto d2dValue = static_cast<D2D1_TEXT_ANTIALIAS_MODE>(value);
+
+                if (m_isStateCacheEnabled && m_textAntialiasMode.Matches(d2dValue))
+                {
+                    m_stats.RedundantStateChangesSkipped++;
+                    return;
+                }
+
+                m_stats.StateChanges++;
+
+                deviceContext->SetTextAntialiasMode(d2dValue);
+
+                if (m_isStateCacheEnabled)
+                    m_textAntialiasMode.Set(d2dValue);
             });
 	}
 
@@ -3087,6 +4065,9 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 
                 D2D1_MATRIX_3X2_F transform;
                 deviceContext->GetTransform(&transform);
+
+                if (m_isStateCacheEnabled)
+                    m_transform.Set(transform);
                 
                 //
                 // Un-apply the offset transform. This could be done with a matrix invert, 
@@ -3109,7 +4090,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         return ExceptionBoundary(
             [&]
             {
-                auto& deviceContext = GetResource();
+                GetResource();
                 
                 D2D1_POINT_2F offset = m_adapter->GetRenderingSurfaceOffset();
 
@@ -3117,10 +4098,41 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                 transform._31 += offset.x;
                 transform._32 += offset.y;
 
-                deviceContext->SetTransform(transform);
+                SetTransform(transform);
             });
 	}
 
+    void CanvasDrawingSession::GetTransform(D2D1_MATRIX_3X2_F* transform)
+    {
+        auto& deviceContext = GetResource();
+
+        if (m_isStateCacheEnabled && m_transform.TryGet(transform))
+            return;
+
+        deviceContext->GetTransform(transform);
+
+        if (m_isStateCacheEnabled)
+            m_transform.Set(*transform);
+    }
+
+    void CanvasDrawingSession::SetTransform(D2D1_MATRIX_3X2_F const& transform)
+    {
+        auto& deviceContext = GetResource();
+
+        if (m_isStateCacheEnabled && m_transform.Matches(transform))
+        {
+            m_stats.RedundantStateChangesSkipped++;
+            return;
+        }
+
+        m_stats.StateChanges++;
+
+        deviceContext->SetTransform(transform);
+
+        if (m_isStateCacheEnabled)
+            m_transform.Set(transform);
+    }
+
     IFACEMETHODIMP CanvasDrawingSession::get_Units(CanvasUnits* value)
     {
         return ExceptionBoundary(
@@ -3129,7 +4141,12 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                 auto& deviceContext = GetResource();
                 CheckInPointer(value);
 
-                *value = static_cast<CanvasUnits>(deviceContext->GetUnitMode());
+                auto d2dValue = deviceContext->GetUnitMode();
+
+                if (m_isStateCacheEnabled)
+                    m_unitMode.Set(d2dValue);
+
+                *value = static_cast<CanvasUnits>(d2dValue);
             });
 	}
 
@@ -3140,10 +4157,290 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             {
                 auto& deviceContext = GetResource();
 
-                deviceContext->SetUnitMode(static_cast<D2D1_UNIT_MODE>(value));
+                auto d2dValue = static_cast<D2D1_UNIT_MODE>(value);
+
+                if (m_isStateCacheEnabled && m_unitMode.Matches(d2dValue))
+                {
+                    m_stats.RedundantStateChangesSkipped++;
+                    return;
+                }
+
+                m_stats.StateChanges++;
+
+                deviceContext->SetUnitMode(d2dValue);
+
+                if (m_isStateCacheEnabled)
+                    m_unitMode.Set(d2dValue);
+
+                // The target and layer clip bounds are measured in the current units.
+                // Rather than convert the clip bounds of the active layers, stop culling
+                // against them; layers pushed from now on get bounds in the new units.
+                m_targetBounds.Invalidate();
+                std::fill(m_layerClipBounds.begin(), m_layerClipBounds.end(), D2D1::InfiniteRect());
+            });
+    }
+
+    IFACEMETHODIMP CanvasDrawingSession::get_IsCullingEnabled(boolean* value)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                GetResource();
+                CheckInPointer(value);
+
+                *value = m_isCullingEnabled;
+            });
+    }
+
+    IFACEMETHODIMP CanvasDrawingSession::put_IsCullingEnabled(boolean value)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                GetResource();
+
+                m_isCullingEnabled = !!value;
+            });
+    }
+
+    IFACEMETHODIMP CanvasDrawingSession::get_IsTextLayoutCacheEnabled(boolean* value)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                GetResource();
+                CheckInPointer(value);
+
+                *value = m_isTextLayoutCacheEnabled;
+            });
+    }
+
+    IFACEMETHODIMP CanvasDrawingSession::put_IsTextLayoutCacheEnabled(boolean value)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                GetResource();
+
+                m_isTextLayoutCacheEnabled = !!value;
             });
     }
 
+    // Returns the size of the render target, in the current unit mode.
+    D2D1_RECT_F CanvasDrawingSession::GetTargetBounds()
+    {
+        auto& deviceContext = GetResource();
+
+        D2D1_RECT_F bounds;
+
+        if (m_isStateCacheEnabled && m_targetBounds.TryGet(&bounds))
+            return bounds;
+
+        ComPtr<ID2D1Image> target;
+        deviceContext->GetTarget(&target);
+
+        auto targetBitmap = MaybeAs<ID2D1Bitmap>(target);
+
+        if (targetBitmap)
+        {
+            auto pixelSize = targetBitmap->GetPixelSize();
+
+            float width = static_cast<float>(pixelSize.width);
+            float height = static_cast<float>(pixelSize.height);
+
+            if (deviceContext->GetUnitMode() == D2D1_UNIT_MODE_DIPS)
+            {
+                float dpiX, dpiY;
+                deviceContext->GetDpi(&dpiX, &dpiY);
+
+                width *= DEFAULT_DPI / dpiX;
+                height *= DEFAULT_DPI / dpiY;
+            }
+
+            bounds = D2D1_RECT_F{ 0, 0, width, height };
+
+            // Guard against nonsensical DPI values.
+            if (!(width >= 0 && height >= 0))
+                bounds = D2D1::InfiniteRect();
+        }
+        else
+        {
+            // Command lists (or no target at all) have no fixed bounds.
+            bounds = D2D1::InfiniteRect();
+        }
+
+        if (m_isStateCacheEnabled)
+            m_targetBounds.Set(bounds);
+
+        return bounds;
+    }
+
+    // Returns the device space bounds of a new layer, intersected with the bounds of its parent layer.
+    D2D1_RECT_F CanvasDrawingSession::GetLayerClipBounds(D2D1_RECT_F const& clipRect, ID2D1Geometry* clipGeometry, D2D1_MATRIX_3X2_F const& geometryTransform)
+    {
+        auto parentBounds = m_layerClipBounds.empty() ? D2D1::InfiniteRect() : m_layerClipBounds.back();
+
+        // Avoid touching the device context at all when culling is turned off.
+        if (!m_isCullingEnabled)
+            return parentBounds;
+
+        D2D1::Matrix3x2F transform;
+        GetTransform(&transform);
+
+        auto bounds = IntersectBounds(parentBounds, TransformBounds(clipRect, transform));
+
+        if (clipGeometry)
+        {
+            D2D1_RECT_F geometryBounds;
+            auto worldTransform = *D2D1::Matrix3x2F::ReinterpretBaseType(&geometryTransform) * transform;
+
+            if (SUCCEEDED(clipGeometry->GetBounds(&worldTransform, &geometryBounds)) &&
+                geometryBounds.left <= geometryBounds.right &&
+                geometryBounds.top <= geometryBounds.bottom)
+            {
+                bounds = IntersectBounds(bounds, geometryBounds);
+            }
+        }
+
+        return bounds;
+    }
+
+    // How far outside its geometric bounds a stroke can reach. Square caps and
+    // joins extend half the stroke width diagonally, and miter joins can extend
+    // up to half the stroke width times the miter limit.
+    CanvasDrawingSession::StrokeRadius CanvasDrawingSession::GetStrokeRadius(float strokeWidth, ICanvasStrokeStyle* strokeStyle, bool hasMiterJoins)
+    {
+        // Don't query the stroke style unless the result is going to be used.
+        if (!m_isCullingEnabled)
+            return StrokeRadius{ 0, true };
+
+        const float sqrt2 = 1.41421356f;
+
+        float extent = sqrt2;
+        auto transformBehavior = CanvasStrokeTransformBehavior::Normal;
+
+        if (strokeStyle)
+            ThrowIfFailed(strokeStyle->get_TransformBehavior(&transformBehavior));
+
+        if (hasMiterJoins)
+        {
+            float miterLimit = 10.0f;
+
+            if (strokeStyle)
+                ThrowIfFailed(strokeStyle->get_MiterLimit(&miterLimit));
+
+            extent = std::max<float>(extent, miterLimit);
+        }
+
+        switch (transformBehavior)
+        {
+        case CanvasStrokeTransformBehavior::Fixed:
+            // The width is not scaled by the transform.
+            return StrokeRadius{ fabs(strokeWidth) * 0.5f * extent, false };
+
+        case CanvasStrokeTransformBehavior::Hairline:
+            {
+                // Always one pixel wide, whatever the stroke width or transform.
+                float pixelSize = 1;
+
+                auto& deviceContext = GetResource();
+
+                if (deviceContext->GetUnitMode() == D2D1_UNIT_MODE_DIPS)
+                {
+                    float dpiX, dpiY;
+                    deviceContext->GetDpi(&dpiX, &dpiY);
+
+                    pixelSize = DEFAULT_DPI / std::min(dpiX, dpiY);
+                }
+
+                return StrokeRadius{ pixelSize * 0.5f * extent, false };
+            }
+
+        default:
+            return StrokeRadius{ fabs(strokeWidth) * 0.5f * extent, true };
+        }
+    }
+
+    bool CanvasDrawingSession::IsCulled(D2D1_RECT_F const& bounds, float strokeRadius)
+    {
+        return IsCulled(bounds, StrokeRadius{ strokeRadius, true });
+    }
+
+    bool CanvasDrawingSession::IsCulled(D2D1_RECT_F const& bounds, StrokeRadius const& strokeRadius)
+    {
+        if (!m_isCullingEnabled)
+            return false;
+
+        D2D1_MATRIX_3X2_F transform;
+        GetTransform(&transform);
+
+        return IsCulled(bounds, strokeRadius, transform);
+    }
+
+    bool CanvasDrawingSession::IsCulled(D2D1_RECT_F const& bounds, float strokeRadius, D2D1_MATRIX_3X2_F const& transform)
+    {
+        return IsCulled(bounds, StrokeRadius{ strokeRadius, true }, transform);
+    }
+
+    bool CanvasDrawingSession::IsCulled(D2D1_RECT_F const& bounds, StrokeRadius const& strokeRadius, D2D1_MATRIX_3X2_F const& transform)
+    {
+        if (!m_isCullingEnabled)
+            return false;
+
+        auto deviceBounds = TransformBounds(bounds, transform);
+
+        if (IsInfinite(deviceBounds))
+            return false;
+
+        // Allow for the stroke (which is scaled by the transform, unless its
+        // transform behavior says otherwise) plus a pixel of slop for antialiasing.
+        float inflateX = 1;
+        float inflateY = 1;
+
+        if (strokeRadius.IsScaledByTransform)
+        {
+            inflateX += strokeRadius.Radius * (fabs(transform._11) + fabs(transform._21));
+            inflateY += strokeRadius.Radius * (fabs(transform._12) + fabs(transform._22));
+        }
+        else
+        {
+            inflateX += strokeRadius.Radius;
+            inflateY += strokeRadius.Radius;
+        }
+
+        auto visibleBounds = GetTargetBounds();
+
+        if (!m_layerClipBounds.empty())
+            visibleBounds = IntersectBounds(visibleBounds, m_layerClipBounds.back());
+
+        // These comparisons are all false for NaN, so NaN values are never culled.
+        bool isCulled = deviceBounds.right + inflateX < visibleBounds.left ||
+                        deviceBounds.bottom + inflateY < visibleBounds.top ||
+                        deviceBounds.left - inflateX > visibleBounds.right ||
+                        deviceBounds.top - inflateY > visibleBounds.bottom;
+
+        if (isCulled)
+            m_stats.CulledDraws++;
+
+        return isCulled;
+    }
+
+    bool CanvasDrawingSession::IsGeometryCulled(ID2D1Geometry* geometry, float strokeWidth, ICanvasStrokeStyle* strokeStyle)
+    {
+        // Computing geometry bounds is not free, so only do it if we are going to use them.
+        if (!m_isCullingEnabled)
+            return false;
+
+        D2D1_RECT_F bounds;
+        ThrowIfFailed(geometry->GetBounds(nullptr, &bounds));
+
+        // Empty geometry reports inverted bounds.
+        if (!(bounds.left <= bounds.right && bounds.top <= bounds.bottom))
+            return false;
+
+        return IsCulled(bounds, GetStrokeRadius(strokeWidth, strokeStyle, true));
+    }
+
     IFACEMETHODIMP CanvasDrawingSession::get_Device(ICanvasDevice** value)
     {
         using namespace ::Microsoft::WRL::Wrappers;
@@ -3324,12 +4621,38 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                 auto d2dAntialiasMode = deviceContext->GetAntialiasMode();
 
                 // Simple cases can be optimized to use PushAxisAlignedClip instead of PushLayer.
-                bool isAxisAlignedClip = clipRectangle &&
-                                         !d2dBrush &&
-                                         !d2dGeometry &&
-                                         opacity == 1.0f &&
-                                         options == CanvasLayerOptions::None &&
-                                         TransformIsAxisPreserving(deviceContext.Get());
+                // That requires an opaque layer with no opacity brush, where the clip region
+                // (the intersection of the clip rectangle and geometry) is an axis aligned
+                // rectangle after the current transform is applied.
+                bool isAxisAlignedClip = false;
+                D2D1_RECT_F axisAlignedClipRect = d2dRect;
+
+                if ((clipRectangle || d2dGeometry) &&
+                    !d2dBrush &&
+                    opacity == 1.0f &&
+                    options == CanvasLayerOptions::None)
+                {
+                    D2D1_RECT_F geometryClipRect = D2D1::InfiniteRect();
+
+                    if (!d2dGeometry || TryGetAxisAlignedRect(d2dGeometry.Get(), d2dMatrix, &geometryClipRect))
+                    {
+                        isAxisAlignedClip = TransformIsAxisPreserving(deviceContext.Get());
+
+                        if (d2dGeometry)
+                        {
+                            axisAlignedClipRect = IntersectBounds(d2dRect, geometryClipRect);
+
+                            // Don't let the intersection of disjoint rectangles turn inside out.
+                            axisAlignedClipRect.right = std::max<float>(axisAlignedClipRect.left, axisAlignedClipRect.right);
+                            axisAlignedClipRect.bottom = std::max<float>(axisAlignedClipRect.top, axisAlignedClipRect.bottom);
+                        }
+                    }
+                }
+
+                ComPtr<ID2D1Layer> d2dLayer;
+
+                if (!isAxisAlignedClip)
+                    d2dLayer = GetPooledLayer(deviceContext.Get());
 
                 // Store a unique ID, used for validation in PopLayer. This extra state 
                 // is needed because the D2D PopLayer method always just pops the topmost 
@@ -3345,27 +4668,34 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 
                 int layerId = ++m_nextLayerId;
 
+                auto clipBounds = GetLayerClipBounds(d2dRect, d2dGeometry.Get(), d2dMatrix);
+
                 m_activeLayerIds.push_back(layerId);
+                m_layerClipBounds.push_back(clipBounds);
 
                 // Construct a scope object that will pop the layer when its Close method is called.
                 WeakRef weakSelf = AsWeak(this);
 
                 auto activeLayer = Make<CanvasActiveLayer>(
-                    [weakSelf, layerId, isAxisAlignedClip]() mutable
+                    [weakSelf, layerId, d2dLayer]() mutable
                     {
                         auto strongSelf = LockWeakRef<ICanvasDrawingSession>(weakSelf);
                         auto self = static_cast<CanvasDrawingSession*>(strongSelf.Get());
 
                         if (self)
-                            self->PopLayer(layerId, isAxisAlignedClip);
+                            self->PopLayer(layerId, d2dLayer.Get());
                     });
 
                 CheckMakeResult(activeLayer);
 
+                m_stats.LayersPushed++;
+
                 if (isAxisAlignedClip)
                 {
+                    m_stats.AxisAlignedClipsPushed++;
+
                     // Tell D2D to push an axis aligned clip region.
-                    deviceContext->PushAxisAlignedClip(&d2dRect, d2dAntialiasMode);
+                    deviceContext->PushAxisAlignedClip(&axisAlignedClipRect, d2dAntialiasMode);
                 }
                 else
                 {
@@ -3381,14 +4711,33 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                         static_cast<D2D1_LAYER_OPTIONS1>(options)
                     };
 
-                    deviceContext->PushLayer(&parameters, nullptr);
+                    deviceContext->PushLayer(&parameters, d2dLayer.Get());
                 }
 
                 ThrowIfFailed(activeLayer.CopyTo(layer));
             });
     }
 
-    void CanvasDrawingSession::PopLayer(int layerId, bool isAxisAlignedClip)
+    ComPtr<ID2D1Layer> CanvasDrawingSession::GetPooledLayer(ID2D1DeviceContext* deviceContext)
+    {
+        // Deeply nested UI pushes and pops a lot of layers, so rather than
+        // leaving D2D to allocate resources for each one, we reuse ID2D1Layer
+        // objects once they have been popped.
+        if (!m_layerPool.empty())
+        {
+            auto d2dLayer = std::move(m_layerPool.back());
+            m_layerPool.pop_back();
+            return d2dLayer;
+        }
+
+        m_stats.LayerResourcesCreated++;
+
+        ComPtr<ID2D1Layer> d2dLayer;
+        ThrowIfFailed(deviceContext->CreateLayer(nullptr, &d2dLayer));
+        return d2dLayer;
+    }
+
+    void CanvasDrawingSession::PopLayer(int layerId, ID2D1Layer* d2dLayer)
     {
         auto& deviceContext = GetResource();
 
@@ -3398,14 +4747,17 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             ThrowHR(E_FAIL, HStringReference(Strings::PoppedWrongLayer).Get());
 
         m_activeLayerIds.pop_back();
+        m_layerClipBounds.pop_back();
 
-        if (isAxisAlignedClip)
+        if (!d2dLayer)
         {
             deviceContext->PopAxisAlignedClip();
         }
         else
         {
             deviceContext->PopLayer();
+
+            m_layerPool.push_back(d2dLayer);
         }
     }
 
@@ -12,6 +12,9 @@
 
 #pragma once
 
+#include "SolidColorBrushPalette.h"
+#include "TextLayoutCache.h"
+
 namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 {
     using namespace ABI::Microsoft::Graphics::Canvas::Numerics;
@@ -26,6 +29,49 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         virtual void EndDraw() = 0;
     };
 
+    //
+    // Shadow copy of one piece of device context state, which lets
+    // CanvasDrawingSession skip state changes that would have no effect.
+    //
+    template<typename T>
+    class CachedDeviceContextState
+    {
+        T m_value;
+        bool m_isValid;
+
+    public:
+        CachedDeviceContextState()
+            : m_isValid(false)
+        {
+        }
+
+        bool TryGet(T* value) const
+        {
+            if (!m_isValid)
+                return false;
+
+            *value = m_value;
+            return true;
+        }
+
+        // Bitwise comparison, so +0 vs. -0 counts as a change but NaN does not.
+        bool Matches(T const& value) const
+        {
+            return m_isValid && memcmp(&m_value, &value, sizeof(T)) == 0;
+        }
+
+        void Set(T const& value)
+        {
+            m_value = value;
+            m_isValid = true;
+        }
+
+        void Invalidate()
+        {
+            m_isValid = false;
+        }
+    };
+
     class CanvasDrawingSessionManager;
     class CanvasDrawingSession;
 
@@ -40,17 +86,51 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
     class CanvasDrawingSession : RESOURCE_WRAPPER_RUNTIME_CLASS(
         CanvasDrawingSessionTraits,
         ICanvasResourceCreatorWithDpi,
-        ICanvasResourceCreator)
+        ICanvasResourceCreator,
+        CloakedIid<ICanvasDrawingSessionStatsNative>)
     {
         InspectableClass(RuntimeClass_Microsoft_Graphics_Canvas_CanvasDrawingSession, BaseTrust);
 
         std::shared_ptr<ICanvasDrawingSessionAdapter> m_adapter;
-        ComPtr<ID2D1SolidColorBrush> m_solidColorBrush;
+        SolidColorBrushPalette m_solidColorBrushes;
         ComPtr<ICanvasTextFormat> m_defaultTextFormat;
 
         std::vector<int> m_activeLayerIds;
         int m_nextLayerId;
 
+        // Layer resources that have been popped, and can be reused by the
+        // next CreateLayer call that is not able to use PushAxisAlignedClip.
+        std::vector<ComPtr<ID2D1Layer>> m_layerPool;
+
+        //
+        // Device context state, cached so that redundant state changes can be
+        // skipped. The cache is disabled once native code has access to the
+        // device context, since it could then change the state behind our back.
+        //
+        CachedDeviceContextState<D2D1_MATRIX_3X2_F> m_transform;
+        CachedDeviceContextState<D2D1_ANTIALIAS_MODE> m_antialiasMode;
+        CachedDeviceContextState<D2D1_PRIMITIVE_BLEND> m_primitiveBlend;
+        CachedDeviceContextState<D2D1_TEXT_ANTIALIAS_MODE> m_textAntialiasMode;
+        CachedDeviceContextState<D2D1_UNIT_MODE> m_unitMode;
+        bool m_isStateCacheEnabled;
+
+        //
+        // Bounds culling state. m_layerClipBounds has an entry per active layer,
+        // holding the device space bounds of that layer's clip intersected with
+        // the bounds of its parent. Both depend on the unit mode, so when that
+        // changes m_targetBounds is invalidated and the layer bounds are reset
+        // to infinite.
+        //
+        bool m_isCullingEnabled;
+        std::vector<D2D1_RECT_F> m_layerClipBounds;
+        CachedDeviceContextState<D2D1_RECT_F> m_targetBounds;
+
+        // Whether DrawText uses the manager's TextLayoutCache.
+        bool m_isTextLayoutCacheEnabled;
+
+        CanvasDrawingSessionStats m_stats;
+        bool m_haveStatsBeenReported;
+
         //
         // Contract:
         //     Drawing sessions created conventionally initialize this member.
@@ -73,10 +153,34 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 
         virtual ~CanvasDrawingSession();
 
+        // Exposes the brush palette hit and miss counts.
+        SolidColorBrushPalette const& GetSolidColorBrushPalette() const { return m_solidColorBrushes; }
+
+        // Counts of the work done so far. Remains valid after the session is closed.
+        CanvasDrawingSessionStats GetStats() const;
+
+        // Called when the device context is shared with native code.
+        void DisableStateCache();
+
+        // These mirror the ID2D1DeviceContext methods, so TemporaryTransform
+        // can be used with a drawing session to get the benefit of its cache.
+        void GetTransform(D2D1_MATRIX_3X2_F* transform);
+        void SetTransform(D2D1_MATRIX_3X2_F const& transform);
+
         // IClosable
 
         IFACEMETHOD(Close)() override;
 
+        // ICanvasResourceWrapperNative
+
+        using ResourceWrapper::GetResource;
+
+        IFACEMETHOD(GetResource)(REFIID iid, void** resource) override;
+
+        // ICanvasDrawingSessionStatsNative
+
+        IFACEMETHOD(GetStats)(CanvasDrawingSessionStats* stats) override;
+
         // ICanvasDrawingSession
 
         IFACEMETHOD(Clear)(
@@ -167,6 +271,32 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             CanvasImageInterpolation interpolation,
             ABI::Microsoft::Graphics::Canvas::Numerics::Matrix4x4 perspective) override;
 
+        //
+        // DrawSprites
+        //
+
+        IFACEMETHOD(DrawSprites)(
+            uint32_t bitmapsCount,
+            ICanvasBitmap** bitmaps,
+            uint32_t transformsCount,
+            Matrix3x2* transforms,
+            uint32_t sourceRectsCount,
+            Rect* sourceRects) override;
+
+        IFACEMETHOD(DrawSpritesWithTintsAndOpacitiesAndInterpolationAndSortMode)(
+            uint32_t bitmapsCount,
+            ICanvasBitmap** bitmaps,
+            uint32_t transformsCount,
+            Matrix3x2* transforms,
+            uint32_t sourceRectsCount,
+            Rect* sourceRects,
+            uint32_t tintsCount,
+            ABI::Windows::UI::Color* tints,
+            uint32_t opacitiesCount,
+            float* opacities,
+            CanvasImageInterpolation interpolation,
+            CanvasSpriteSortMode sortMode) override;
+
         //
         // DrawLine
         //
@@ -261,6 +391,44 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             float strokeWidth,
             ICanvasStrokeStyle* strokeStyle) override;
 
+        //
+        // DrawLines
+        //
+
+        IFACEMETHOD(DrawLinesWithBrush)(
+            uint32_t point0sCount,
+            Vector2* point0s,
+            uint32_t point1sCount,
+            Vector2* point1s,
+            ICanvasBrush* brush) override;
+
+        IFACEMETHOD(DrawLinesWithColors)(
+            uint32_t point0sCount,
+            Vector2* point0s,
+            uint32_t point1sCount,
+            Vector2* point1s,
+            uint32_t colorsCount,
+            ABI::Windows::UI::Color* colors) override;
+
+        IFACEMETHOD(DrawLinesWithBrushAndStrokeWidthAndStrokeStyle)(
+            uint32_t point0sCount,
+            Vector2* point0s,
+            uint32_t point1sCount,
+            Vector2* point1s,
+            ICanvasBrush* brush,
+            float strokeWidth,
+            ICanvasStrokeStyle* strokeStyle) override;
+
+        IFACEMETHOD(DrawLinesWithColorsAndStrokeWidthAndStrokeStyle)(
+            uint32_t point0sCount,
+            Vector2* point0s,
+            uint32_t point1sCount,
+            Vector2* point1s,
+            uint32_t colorsCount,
+            ABI::Windows::UI::Color* colors,
+            float strokeWidth,
+            ICanvasStrokeStyle* strokeStyle) override;
+
         //
         // DrawRectangle
         //
@@ -388,6 +556,21 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             ICanvasBrush* brush,
             ICanvasBrush* opacityBrush) override;
 
+        //
+        // FillRectangles
+        //
+
+        IFACEMETHOD(FillRectanglesWithBrush)(
+            uint32_t rectsCount,
+            Rect* rects,
+            ICanvasBrush* brush) override;
+
+        IFACEMETHOD(FillRectanglesWithColors)(
+            uint32_t rectsCount,
+            Rect* rects,
+            uint32_t colorsCount,
+            ABI::Windows::UI::Color* colors) override;
+
         //
         // DrawRoundedRectangle
         //
@@ -778,6 +961,25 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             float radius,
             ABI::Windows::UI::Color color) override;
 
+        //
+        // FillCircles
+        //
+
+        IFACEMETHOD(FillCirclesWithBrush)(
+            uint32_t centerPointsCount,
+            Vector2* centerPoints,
+            uint32_t radiiCount,
+            float* radii,
+            ICanvasBrush* brush) override;
+
+        IFACEMETHOD(FillCirclesWithColors)(
+            uint32_t centerPointsCount,
+            Vector2* centerPoints,
+            uint32_t radiiCount,
+            float* radii,
+            uint32_t colorsCount,
+            ABI::Windows::UI::Color* colors) override;
+
         //
         // DrawText
         //
@@ -1103,6 +1305,12 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         IFACEMETHOD(get_Units)(CanvasUnits* value);
         IFACEMETHOD(put_Units)(CanvasUnits value);
 
+        IFACEMETHOD(get_IsCullingEnabled)(boolean* value);
+        IFACEMETHOD(put_IsCullingEnabled)(boolean value);
+
+        IFACEMETHOD(get_IsTextLayoutCacheEnabled)(boolean* value);
+        IFACEMETHOD(put_IsTextLayoutCacheEnabled)(boolean value);
+
         //
         // CreateLayer
         //
@@ -1179,6 +1387,15 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             float strokeWidth,
             ICanvasStrokeStyle* strokeStyle);
 
+        void DrawLinesImpl(
+            uint32_t count,
+            Vector2 const* point0s,
+            Vector2 const* point1s,
+            ID2D1Brush* brush,
+            ABI::Windows::UI::Color const* colors,
+            float strokeWidth,
+            ICanvasStrokeStyle* strokeStyle);
+
         void DrawRectangleImpl(
             Rect const& rect,
             ID2D1Brush* brush,
@@ -1189,6 +1406,12 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             Rect const& rect,
             ID2D1Brush* brush);
 
+        void FillRectanglesImpl(
+            uint32_t count,
+            Rect const* rects,
+            ID2D1Brush* brush,
+            ABI::Windows::UI::Color const* colors);
+
         void DrawRoundedRectangleImpl(
             Rect const& rect,
             float radiusX,
@@ -1217,6 +1440,13 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             float radiusY,
             ID2D1Brush* brush);
 
+        void FillCirclesImpl(
+            uint32_t count,
+            Vector2 const* centerPoints,
+            float const* radii,
+            ID2D1Brush* brush,
+            ABI::Windows::UI::Color const* colors);
+
         void DrawTextAtRectImpl(
             HSTRING text,
             Rect const& rect,
@@ -1229,6 +1459,13 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             ID2D1Brush* brush,
             ICanvasTextFormat* format);
 
+        void DrawTextImpl(
+            HSTRING text,
+            Rect const& rect,
+            ID2D1Brush* brush,
+            ICanvasTextFormat* format,
+            bool disableWordWrapping);
+
         ICanvasTextFormat* GetDefaultTextFormat();
 
         void DrawGeometryImpl(
@@ -1247,6 +1484,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             ID2D1Brush* brush);
 
         ID2D1SolidColorBrush* GetColorBrush(ABI::Windows::UI::Color const& color);
+        ID2D1Brush* GetBatchBrush(ID2D1Brush* brush, ABI::Windows::UI::Color const* colors, uint32_t index);
         ComPtr<ID2D1Brush> ToD2DBrush(ICanvasBrush* brush);
 
         HRESULT DrawImageImpl(
@@ -1273,7 +1511,37 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             CanvasLayerOptions options,
             ICanvasActiveLayer** layer);
 
-        void PopLayer(int layerId, bool isAxisAlignedClip);
+        // d2dLayer is null if the layer was implemented using PushAxisAlignedClip.
+        void PopLayer(int layerId, ID2D1Layer* d2dLayer);
+
+        ComPtr<ID2D1Layer> GetPooledLayer(ID2D1DeviceContext* deviceContext);
+
+        D2D1_RECT_F GetTargetBounds();
+        D2D1_RECT_F GetLayerClipBounds(D2D1_RECT_F const& clipRect, ID2D1Geometry* clipGeometry, D2D1_MATRIX_3X2_F const& geometryTransform);
+
+        // How far beyond its bounds a shape may be stroked. Unless the stroke
+        // style's TransformBehavior is Normal, Radius is not scaled by the
+        // transform, as it is already in the units of the render target.
+        struct StrokeRadius
+        {
+            float Radius;
+            bool IsScaledByTransform;
+        };
+
+        StrokeRadius GetStrokeRadius(float strokeWidth, ICanvasStrokeStyle* strokeStyle, bool hasMiterJoins);
+
+        // Returns true if drawing something within the specified bounds (in the
+        // coordinate space of the transform) cannot touch any visible pixels.
+        // strokeRadius is how far beyond these bounds the shape may be stroked,
+        // and a plain float is scaled by the transform.
+        bool IsCulled(D2D1_RECT_F const& bounds, float strokeRadius);
+        bool IsCulled(D2D1_RECT_F const& bounds, StrokeRadius const& strokeRadius);
+        bool IsCulled(D2D1_RECT_F const& bounds, float strokeRadius, D2D1_MATRIX_3X2_F const& transform);
+        bool IsCulled(D2D1_RECT_F const& bounds, StrokeRadius const& strokeRadius, D2D1_MATRIX_3X2_F const& transform);
+        bool IsGeometryCulled(ID2D1Geometry* geometry, float strokeWidth, ICanvasStrokeStyle* strokeStyle);
+
+        // Passes the stats to the manager's handler, the first time this is called.
+        void ReportStats();
     };
 
 
@@ -1295,6 +1563,28 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 
         ComPtr<CanvasDrawingSession> CreateWrapper(
             ID2D1DeviceContext1* resource);
+
+        //
+        // Instrumentation: if set, the handler is called with the stats of
+        // each drawing session created by this manager, as it is closed.
+        // The handler may be called from whichever thread closes the session,
+        // and must not throw. Apps can read the same counts through the
+        // session's ICanvasDrawingSessionStatsNative interface.
+        //
+        typedef std::function<void(CanvasDrawingSessionStats const&)> StatsHandler;
+
+        void SetStatsHandler(StatsHandler handler);
+
+        void ReportStats(CanvasDrawingSessionStats const& stats);
+
+        // Shared by the drawing sessions that set IsTextLayoutCacheEnabled.
+        TextLayoutCache& GetTextLayoutCache() { return m_textLayoutCache; }
+
+    private:
+        std::mutex m_statsHandlerMutex;
+        StatsHandler m_statsHandler;
+
+        TextLayoutCache m_textLayoutCache;
     };
 
 
@@ -0,0 +1,129 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    using namespace ::Microsoft::WRL;
+
+    //
+    // Small cache of solid color brushes, used by CanvasDrawingSession to
+    // implement the overloads that take a color rather than a brush.
+    //
+    // Changing the color of a brush that is referenced by pending drawing
+    // commands prevents D2D from batching those commands, so rather than
+    // repeatedly calling SetColor on one shared brush, we keep a brush per
+    // recently used color. When the palette is full, the least recently used
+    // brush is recolored.
+    //
+    class SolidColorBrushPalette
+    {
+    public:
+        static const size_t Capacity = 16;
+
+    private:
+        struct Entry
+        {
+            ABI::Windows::UI::Color Color;
+            ComPtr<ID2D1SolidColorBrush> Brush;
+            uint64_t LastUsed;
+        };
+
+        Entry m_entries[Capacity];
+        size_t m_count;
+        uint64_t m_clock;
+
+        uint64_t m_hitCount;
+        uint64_t m_missCount;
+
+    public:
+        SolidColorBrushPalette()
+            : m_count(0)
+            , m_clock(0)
+            , m_hitCount(0)
+            , m_missCount(0)
+        {
+        }
+
+        ID2D1SolidColorBrush* GetBrush(ID2D1DeviceContext* deviceContext, ABI::Windows::UI::Color const& color)
+        {
+            m_clock++;
+
+            size_t leastRecentlyUsed = 0;
+
+            for (size_t i = 0; i < m_count; i++)
+            {
+                auto& entry = m_entries[i];
+
+                if (IsSameColor(entry.Color, color))
+                {
+                    m_hitCount++;
+                    entry.LastUsed = m_clock;
+                    return entry.Brush.Get();
+                }
+
+                if (entry.LastUsed < m_entries[leastRecentlyUsed].LastUsed)
+                    leastRecentlyUsed = i;
+            }
+
+            m_missCount++;
+
+            if (m_count < Capacity)
+            {
+                auto& entry = m_entries[m_count];
+
+                ThrowIfFailed(deviceContext->CreateSolidColorBrush(ToD2DColor(color), &entry.Brush));
+
+                m_count++;
+
+                entry.Color = color;
+                entry.LastUsed = m_clock;
+                return entry.Brush.Get();
+            }
+            else
+            {
+                auto& entry = m_entries[leastRecentlyUsed];
+
+                entry.Brush->SetColor(ToD2DColor(color));
+
+                entry.Color = color;
+                entry.LastUsed = m_clock;
+                return entry.Brush.Get();
+            }
+        }
+
+        // Releases the brushes, for when the device context goes away. The
+        // hit and miss counts are kept.
+        void Clear()
+        {
+            for (size_t i = 0; i < m_count; i++)
+            {
+                m_entries[i].Brush.Reset();
+            }
+
+            m_count = 0;
+        }
+
+        uint64_t GetHitCount() const { return m_hitCount; }
+        uint64_t GetMissCount() const { return m_missCount; }
+
+    private:
+        static bool IsSameColor(ABI::Windows::UI::Color const& color1, ABI::Windows::UI::Color const& color2)
+        {
+            return color1.A == color2.A &&
+                   color1.R == color2.R &&
+                   color1.G == color2.G &&
+                   color1.B == color2.B;
+        }
+    };
+}}}}
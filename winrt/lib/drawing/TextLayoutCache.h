@@ -0,0 +1,240 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    using namespace ::Microsoft::WRL;
+
+    enum class TextLayoutCacheResult
+    {
+        NotCacheable,
+        Hit,
+        Miss
+    };
+
+    //
+    // Least recently used cache of IDWriteTextLayout objects, used by
+    // CanvasDrawingSession.DrawText when IsTextLayoutCacheEnabled is set.
+    //
+    // ID2D1DeviceContext::DrawText creates a new text layout (which means
+    // shaping the string from scratch) every time it is called. Apps that
+    // redraw the same labels every frame can avoid that work by reusing the
+    // layout from the previous frame.
+    //
+    // The cache is shared by all drawing sessions from the same manager, so
+    // it outlives any one frame. The lock is only held to look up and insert
+    // entries; layouts are created and drawn after it is released. DWrite
+    // does not allow one layout to be drawn from several threads at the same
+    // time, so an entry is marked as in use while it is being drawn, and
+    // anyone else who wants it at that moment is told to draw another way.
+    //
+    class TextLayoutCache
+    {
+    public:
+        static const size_t Capacity = 256;
+
+        // Longer strings are unlikely to be repeated labels, and would
+        // make the cache keys expensive to store and compare.
+        static const uint32_t MaxTextLength = 256;
+
+    private:
+        // Identifies a layout without owning its text, so lookups do not allocate.
+        struct KeyView
+        {
+            IDWriteTextFormat* Format;
+            uint32_t FormatVersion;
+            float Width;
+            float Height;
+            wchar_t const* Text;
+            size_t TextLength;
+        };
+
+        struct Key
+        {
+            ComPtr<IDWriteTextFormat> Format;
+            uint32_t FormatVersion;
+            float Width;
+            float Height;
+            std::wstring Text;
+
+            KeyView GetView() const
+            {
+                return KeyView{ Format.Get(), FormatVersion, Width, Height, Text.c_str(), Text.size() };
+            }
+        };
+
+        struct KeyLess
+        {
+            typedef void is_transparent;
+
+            bool operator()(Key const& a, Key const& b) const { return Less(a.GetView(), b.GetView()); }
+            bool operator()(Key const& a, KeyView const& b) const { return Less(a.GetView(), b); }
+            bool operator()(KeyView const& a, Key const& b) const { return Less(a, b.GetView()); }
+
+            static bool Less(KeyView const& a, KeyView const& b)
+            {
+                if (a.Format != b.Format)
+                    return std::less<IDWriteTextFormat*>()(a.Format, b.Format);
+
+                if (a.FormatVersion != b.FormatVersion)
+                    return a.FormatVersion < b.FormatVersion;
+
+                if (a.Width != b.Width)
+                    return a.Width < b.Width;
+
+                if (a.Height != b.Height)
+                    return a.Height < b.Height;
+
+                return std::lexicographical_compare(a.Text, a.Text + a.TextLength, b.Text, b.Text + b.TextLength);
+            }
+        };
+
+        // Points at keys owned by the entry map, which do not move.
+        typedef std::list<Key const*> UsageList;
+
+        struct Entry
+        {
+            ComPtr<IDWriteTextLayout> Layout;
+            UsageList::iterator Usage;
+            bool IsInUse;
+        };
+
+        typedef std::map<Key, Entry, KeyLess> EntryMap;
+
+        std::mutex m_mutex;
+        ComPtr<IDWriteFactory> m_factory;
+
+        // Most recently used entries are at the front of m_usage. Entries
+        // that are in use are never evicted, so iterators to them stay valid
+        // while they are drawn.
+        EntryMap m_entries;
+        UsageList m_usage;
+
+    public:
+        //
+        // Finds or creates a layout for the specified text, and passes it to
+        // drawFn. The layout is equivalent to the one that DrawText would
+        // create for a layout rectangle of the specified size.
+        //
+        // Returns NotCacheable, without calling drawFn, if the caller should
+        // draw this text some other way.
+        //
+        template<typename FN>
+        TextLayoutCacheResult Draw(
+            wchar_t const* text,
+            uint32_t textLength,
+            IDWriteTextFormat* format,
+            uint32_t formatVersion,
+            float width,
+            float height,
+            FN&& drawFn)
+        {
+            // The comparisons also reject NaN, which would break the map ordering.
+            if (textLength > MaxTextLength || !(width >= 0) || !(height >= 0))
+                return TextLayoutCacheResult::NotCacheable;
+
+            KeyView key{ format, formatVersion, width, height, text, textLength };
+
+            EntryMap::iterator entry;
+            ComPtr<IDWriteTextLayout> layout;
+            ComPtr<IDWriteFactory> factory;
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+
+                entry = m_entries.find(key);
+
+                if (entry != m_entries.end())
+                {
+                    // This layout is being drawn right now, by another thread or
+                    // further up this one's stack.
+                    if (entry->second.IsInUse)
+                        return TextLayoutCacheResult::NotCacheable;
+
+                    entry->second.IsInUse = true;
+                    layout = entry->second.Layout;
+
+                    m_usage.splice(m_usage.begin(), m_usage, entry->second.Usage);
+                }
+                else
+                {
+                    if (!m_factory)
+                        ThrowIfFailed(DWriteCreateFactory(DWRITE_FACTORY_TYPE_SHARED, __uuidof(m_factory), &m_factory));
+
+                    factory = m_factory;
+                }
+            }
+
+            auto result = TextLayoutCacheResult::Hit;
+            bool isCached = true;
+
+            if (!layout)
+            {
+                result = TextLayoutCacheResult::Miss;
+
+                ThrowIfFailed(factory->CreateTextLayout(text, textLength, format, width, height, &layout));
+
+                isCached = TryInsert(key, layout, &entry);
+            }
+
+            auto releaseWarden = MakeScopeWarden(
+                [&]
+                {
+                    if (isCached)
+                    {
+                        std::lock_guard<std::mutex> lock(m_mutex);
+                        entry->second.IsInUse = false;
+                    }
+                });
+
+            drawFn(layout.Get());
+
+            return result;
+        }
+
+    private:
+        // Adds a layout created by Draw, marked as in use. Returns false if
+        // another thread added the same layout first, or every entry that
+        // could be evicted to make room is in use.
+        bool TryInsert(KeyView const& keyView, ComPtr<IDWriteTextLayout> const& layout, EntryMap::iterator* entry)
+        {
+            Key key{ keyView.Format, keyView.FormatVersion, keyView.Width, keyView.Height, std::wstring(keyView.Text, keyView.TextLength) };
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            if (m_entries.find(keyView) != m_entries.end())
+                return false;
+
+            if (m_entries.size() >= Capacity)
+            {
+                auto leastRecentlyUsed = std::find_if(m_usage.rbegin(), m_usage.rend(),
+                    [&](Key const* usedKey) { return !m_entries.find(*usedKey)->second.IsInUse; });
+
+                if (leastRecentlyUsed == m_usage.rend())
+                    return false;
+
+                m_entries.erase(m_entries.find(**leastRecentlyUsed));
+                m_usage.erase(std::next(leastRecentlyUsed).base());
+            }
+
+            auto it = m_entries.insert(std::make_pair(std::move(key), Entry{ layout, m_usage.end(), true })).first;
+
+            m_usage.push_front(&it->first);
+            it->second.Usage = m_usage.begin();
+
+            *entry = it;
+            return true;
+        }
+    };
+}}}}
@@ -14,12 +14,36 @@
 #include "CanvasGeometry.h"
 #include "CanvasPathBuilder.h"
 #include "GeometrySink.h"
+#include "IndexedTessellationBuilder.h"
+#include "PathData.h"
 #include "TessellationSink.h"
 
 namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 {
     static const Matrix3x2 Identity3x2 = { 1, 0, 0, 1, 0, 0 };
 
+    //
+    // Guesses how many triangles Tessellate will output, so the output buffer
+    // can usually be allocated once. A figure of n line segments needs about
+    // n - 2 triangles, while curves are flattened into several lines each, so
+    // this allows two triangles per segment. Only path geometries can say how
+    // many segments they have; anything else starts small and grows.
+    //
+    static uint32_t EstimateTessellatedTrianglesCount(ID2D1Geometry* geometry)
+    {
+        auto pathGeometry = MaybeAs<ID2D1PathGeometry>(geometry);
+
+        if (!pathGeometry)
+            return 0;
+
+        UINT32 segmentCount;
+
+        if (FAILED(pathGeometry->GetSegmentCount(&segmentCount)))
+            return 0;
+
+        return static_cast<uint32_t>(std::min<uint64_t>(static_cast<uint64_t>(segmentCount) * 2, UINT_MAX / sizeof(CanvasTriangleVertices)));
+    }
+
     IFACEMETHODIMP CanvasGeometryFactory::CreateRectangle(
         ICanvasResourceCreator* resourceCreator,
         Rect rect,
@@ -163,6 +187,24 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             });
     }
 
+    IFACEMETHODIMP CanvasGeometryFactory::CreatePathFromBytes(
+        ICanvasResourceCreator* resourceCreator,
+        uint32_t byteCount,
+        BYTE* bytes,
+        ICanvasGeometry** geometry)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                CheckInPointer(resourceCreator);
+                CheckAndClearOutPointer(geometry);
+
+                auto newCanvasGeometry = GetManager()->Create(resourceCreator, bytes, byteCount);
+
+                ThrowIfFailed(newCanvasGeometry.CopyTo(geometry));
+            });
+    }
+
     IFACEMETHODIMP CanvasGeometryFactory::CreateGroup(
         ICanvasResourceCreator* resourceCreator,
         uint32_t geometryCount,
@@ -898,7 +940,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 
             auto& resource = GetResource();
 
-            auto tessellationSink = Make<TessellationSink>();
+            auto tessellationSink = Make<TessellationSink>(EstimateTessellatedTrianglesCount(resource.Get()));
             CheckMakeResult(tessellationSink);
 
             ThrowIfFailed(resource->Tessellate(
@@ -911,6 +953,96 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         });
     }
 
+    template<typename INDEX>
+    static void TessellateIndexedImpl(
+        CanvasGeometry* geometry,
+        Matrix3x2 transform,
+        float flatteningTolerance,
+        UINT32* verticesCount,
+        Vector2** vertices,
+        UINT32* indicesCount,
+        INDEX** indices)
+    {
+        CheckInPointer(verticesCount);
+        CheckAndClearOutPointer(vertices);
+        CheckInPointer(indicesCount);
+        CheckAndClearOutPointer(indices);
+
+        IndexedTessellationBuilder builder;
+
+        geometry->TessellateTo(
+            *ReinterpretAs<D2D1_MATRIX_3X2_F*>(&transform),
+            flatteningTolerance,
+            [&](D2D1_TRIANGLE const* triangles, uint32_t trianglesCount)
+            {
+                builder.AddTriangles(triangles, trianglesCount);
+            });
+
+        // Optimize drops vertices that are only used by degenerate triangles,
+        // so the index size is checked against the final vertex count.
+        builder.Optimize();
+
+        auto& builderVertices = builder.GetVertices();
+        auto& builderIndices = builder.GetIndices();
+
+        const uint64_t maxVerticesCount = uint64_t(1) << (sizeof(INDEX) * 8);
+
+        if (builderVertices.size() > maxVerticesCount)
+            ThrowHR(E_BOUNDS, HStringReference(Strings::TooManyVerticesForIndexSize).Get());
+
+        auto vertexArray = TransformToComArray<Vector2>(builderVertices.begin(), builderVertices.end(), FromD2DPoint);
+        auto indexArray = TransformToComArray<INDEX>(builderIndices.begin(), builderIndices.end(), [](uint32_t index) { return static_cast<INDEX>(index); });
+
+        vertexArray.Detach(verticesCount, vertices);
+        indexArray.Detach(indicesCount, indices);
+    }
+
+    IFACEMETHODIMP CanvasGeometry::TessellateIndexed(
+        Matrix3x2 transform,
+        float flatteningTolerance,
+        UINT32* verticesCount,
+        Vector2** vertices,
+        UINT32* indicesCount,
+        UINT32** indices)
+    {
+        return ExceptionBoundary([&]
+        {
+            TessellateIndexedImpl(this, transform, flatteningTolerance, verticesCount, vertices, indicesCount, indices);
+        });
+    }
+
+    IFACEMETHODIMP CanvasGeometry::TessellateIndexed16(
+        Matrix3x2 transform,
+        float flatteningTolerance,
+        UINT32* verticesCount,
+        Vector2** vertices,
+        UINT32* indicesCount,
+        UINT16** indices)
+    {
+        return ExceptionBoundary([&]
+        {
+            TessellateIndexedImpl(this, transform, flatteningTolerance, verticesCount, vertices, indicesCount, indices);
+        });
+    }
+
+    void CanvasGeometry::TessellateTo(
+        D2D1_MATRIX_3X2_F const& transform,
+        float flatteningTolerance,
+        std::function<void(D2D1_TRIANGLE const*, uint32_t)> const& callback)
+    {
+        auto& resource = GetResource();
+
+        auto tessellationSink = Make<StreamingTessellationSink>(callback);
+        CheckMakeResult(tessellationSink);
+
+        ThrowIfFailed(resource->Tessellate(
+            &transform,
+            flatteningTolerance,
+            tessellationSink.Get()));
+
+        ThrowIfFailed(tessellationSink->GetResult());
+    }
+
     IFACEMETHODIMP CanvasGeometry::SendPathTo(
         ICanvasPathReceiver* streamReader)
     {
@@ -940,6 +1072,25 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         });
     }
 
+    IFACEMETHODIMP CanvasGeometry::GetPathBytes(
+        UINT32* valueCount,
+        BYTE** valueElements)
+    {
+        return ExceptionBoundary([&]
+        {
+            CheckInPointer(valueCount);
+            CheckAndClearOutPointer(valueElements);
+
+            auto pathDataWriter = Make<PathDataWriter>();
+            CheckMakeResult(pathDataWriter);
+
+            ThrowIfFailed(SendPathTo(pathDataWriter.Get()));
+
+            auto bytes = pathDataWriter->GetBytes();
+            bytes.Detach(valueCount, valueElements);
+        });
+    }
+
     ComPtr<CanvasGeometry> CanvasGeometryManager::CreateNew(
         ICanvasResourceCreator* resourceCreator,
         Rect rect)
@@ -1060,6 +1211,39 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         return canvasGeometry;
     }
 
+    //
+    // The path data is read in place, with runs of segments handed to D2D
+    // as pointers into it, so loading straight from a memory mapped file
+    // costs no more than the D2D calls themselves.
+    //
+    ComPtr<CanvasGeometry> CanvasGeometryManager::CreateNew(
+        ICanvasResourceCreator* resourceCreator,
+        BYTE const* bytes,
+        size_t byteCount)
+    {
+        if (byteCount > 0)
+        {
+            CheckInPointer(bytes);
+        }
+
+        ComPtr<ICanvasDevice> device;
+        ThrowIfFailed(resourceCreator->get_Device(&device));
+
+        auto pathGeometry = As<ICanvasDeviceInternal>(device)->CreatePathGeometry();
+
+        ComPtr<ID2D1GeometrySink> geometrySink;
+        ThrowIfFailed(pathGeometry->Open(&geometrySink));
+
+        ReadPathData(bytes, byteCount, geometrySink.Get());
+
+        ThrowIfFailed(geometrySink->Close());
+
+        auto canvasGeometry = Make<CanvasGeometry>(shared_from_this(), pathGeometry.Get(), device.Get());
+        CheckMakeResult(canvasGeometry);
+
+        return canvasGeometry;
+    }
+
     ComPtr<CanvasGeometry> CanvasGeometryManager::CreateNew(
         ICanvasResourceCreator* resourceCreator,
         uint32_t geometryCount,
@@ -203,9 +203,40 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             UINT32* trianglesCount,
             CanvasTriangleVertices** triangles) override;
 
+        IFACEMETHOD(TessellateIndexed)(
+            Matrix3x2 transform,
+            float flatteningTolerance,
+            UINT32* verticesCount,
+            Vector2** vertices,
+            UINT32* indicesCount,
+            UINT32** indices) override;
+
+        IFACEMETHOD(TessellateIndexed16)(
+            Matrix3x2 transform,
+            float flatteningTolerance,
+            UINT32* verticesCount,
+            Vector2** vertices,
+            UINT32* indicesCount,
+            UINT16** indices) override;
+
         IFACEMETHOD(SendPathTo)(
             ICanvasPathReceiver* streamReader) override;
 
+        IFACEMETHOD(GetPathBytes)(
+            UINT32* valueCount,
+            BYTE** valueElements) override;
+
+        //
+        // Passes the tessellated triangles to callback as D2D produces them,
+        // rather than collecting them into one array. For internal callers
+        // that convert the triangles into some other format, and so would
+        // otherwise need to hold two copies of them.
+        //
+        void TessellateTo(
+            D2D1_MATRIX_3X2_F const& transform,
+            float flatteningTolerance,
+            std::function<void(D2D1_TRIANGLE const*, uint32_t)> const& callback);
+
     private:
         void StrokeImpl(
             float strokeWidth,
@@ -271,6 +302,13 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             uint32_t pointCount,
             Vector2* points);
 
+        // Takes the bytes before their count, so that calls passing a
+        // count and nullptr are not ambiguous with the polygon overload.
+        ComPtr<CanvasGeometry> CreateNew(
+            ICanvasResourceCreator* resourceCreator,
+            BYTE const* bytes,
+            size_t byteCount);
+
         ComPtr<CanvasGeometry> CreateNew(
             ICanvasResourceCreator* resourceCreator,
             uint32_t geometryCount,
@@ -361,6 +399,12 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             Numerics::Vector2* points,
             ICanvasGeometry** geometry) override;
 
+        IFACEMETHOD(CreatePathFromBytes)(
+            ICanvasResourceCreator* resourceCreator,
+            uint32_t byteCount,
+            BYTE* bytes,
+            ICanvasGeometry** geometry) override;
+
         IFACEMETHOD(CreateGroup)(
             ICanvasResourceCreator* resourceCreator,
             uint32_t geometryCount,
@@ -0,0 +1,369 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+#include "IndexedTessellationBuilder.h"
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    static uint32_t GetPositionBits(float value)
+    {
+        // +0 and -0 are the same position.
+        if (value == 0)
+            value = 0;
+
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+
+    static uint32_t HashPosition(uint32_t xBits, uint32_t yBits)
+    {
+        uint64_t key = (static_cast<uint64_t>(xBits) << 32) | yBits;
+
+        // Vertex coordinates often have many trailing zero bits, so they need
+        // thorough mixing (this is the MurmurHash3 finalizer).
+        key ^= key >> 33;
+        key *= 0xFF51AFD7ED558CCDull;
+        key ^= key >> 33;
+        key *= 0xC4CEB9FE1A85EC53ull;
+        key ^= key >> 33;
+
+        return static_cast<uint32_t>(key);
+    }
+
+
+    void IndexedTessellationBuilder::AddTriangles(D2D1_TRIANGLE const* triangles, uint32_t trianglesCount)
+    {
+        for (uint32_t i = 0; i < trianglesCount; i++)
+        {
+            auto& triangle = triangles[i];
+
+            auto index1 = AddVertex(triangle.point1);
+            auto index2 = AddVertex(triangle.point2);
+            auto index3 = AddVertex(triangle.point3);
+
+            // Triangles with two identical vertices cover no pixels.
+            if (index1 == index2 || index2 == index3 || index1 == index3)
+                continue;
+
+            m_indices.push_back(index1);
+            m_indices.push_back(index2);
+            m_indices.push_back(index3);
+        }
+    }
+
+
+    uint32_t IndexedTessellationBuilder::AddVertex(D2D1_POINT_2F const& point)
+    {
+        if ((m_vertices.size() + 1) * 2 > m_hashTable.size())
+            GrowHashTable();
+
+        auto xBits = GetPositionBits(point.x);
+        auto yBits = GetPositionBits(point.y);
+
+        auto mask = static_cast<uint32_t>(m_hashTable.size() - 1);
+        auto slot = HashPosition(xBits, yBits) & mask;
+
+        for (;;)
+        {
+            auto entry = m_hashTable[slot];
+
+            if (entry == 0)
+            {
+                if (m_vertices.size() >= UINT32_MAX - 1)
+                    ThrowHR(E_OUTOFMEMORY);
+
+                m_vertices.push_back(point);
+                m_hashTable[slot] = static_cast<uint32_t>(m_vertices.size());
+
+                return m_hashTable[slot] - 1;
+            }
+
+            auto& vertex = m_vertices[entry - 1];
+
+            if (GetPositionBits(vertex.x) == xBits && GetPositionBits(vertex.y) == yBits)
+                return entry - 1;
+
+            slot = (slot + 1) & mask;
+        }
+    }
+
+
+    void IndexedTessellationBuilder::GrowHashTable()
+    {
+        auto newSize = std::max<size_t>(1024, m_hashTable.size() * 2);
+
+        while (newSize < (m_vertices.size() + 1) * 2)
+        {
+            newSize *= 2;
+        }
+
+        m_hashTable.assign(newSize, 0);
+
+        auto mask = static_cast<uint32_t>(newSize - 1);
+
+        for (size_t i = 0; i < m_vertices.size(); i++)
+        {
+            auto slot = HashPosition(GetPositionBits(m_vertices[i].x), GetPositionBits(m_vertices[i].y)) & mask;
+
+            while (m_hashTable[slot] != 0)
+            {
+                slot = (slot + 1) & mask;
+            }
+
+            m_hashTable[slot] = static_cast<uint32_t>(i + 1);
+        }
+    }
+
+
+    void IndexedTessellationBuilder::Optimize()
+    {
+        if (m_indices.empty())
+            return;
+
+        OptimizeTriangleOrder();
+        OptimizeVertexOrder();
+    }
+
+
+    //
+    // How much we want the next triangle to use this vertex. Vertices that
+    // were used recently (so are probably still in the GPU's post transform
+    // cache) score highest, and vertices with only a few triangles left get
+    // a boost so they are finished off rather than left for later.
+    //
+    static float GetVertexScore(int cachePosition, uint32_t remainingTrianglesCount)
+    {
+        if (remainingTrianglesCount == 0)
+            return -1.0f;
+
+        const int cacheSize = IndexedTessellationBuilder::VertexCacheSize;
+
+        float score = 0;
+
+        if (cachePosition >= 0)
+        {
+            if (cachePosition < 3)
+            {
+                // Vertices of the triangle that was just output all score the
+                // same, whichever order the triangle listed them in.
+                score = 0.75f;
+            }
+            else
+            {
+                score = powf(1.0f - static_cast<float>(cachePosition - 3) / (cacheSize - 3), 1.5f);
+            }
+        }
+
+        score += 2.0f / sqrtf(static_cast<float>(remainingTrianglesCount));
+
+        return score;
+    }
+
+
+    void IndexedTessellationBuilder::OptimizeTriangleOrder()
+    {
+        auto trianglesCount = static_cast<uint32_t>(m_indices.size() / 3);
+        auto verticesCount = static_cast<uint32_t>(m_vertices.size());
+
+        //
+        // The triangles that use each vertex and have not been output yet.
+        // These are stored as ranges of one array, starting at
+        // firstTriangle[v] and remainingTriangles[v] long. Each entry is a
+        // corner (an index into m_indices, so the triangle is corner / 3), and
+        // cornerSlot records where each corner lives in the array. When a
+        // triangle is output its corners are swapped to the ends of their
+        // vertices' ranges, and the ranges are shortened, in constant time
+        // however many triangles share a vertex.
+        //
+        std::vector<uint32_t> remainingTriangles(verticesCount, 0);
+
+        for (auto index : m_indices)
+        {
+            remainingTriangles[index]++;
+        }
+
+        std::vector<uint32_t> firstTriangle(verticesCount);
+        uint32_t rangeStart = 0;
+
+        for (uint32_t v = 0; v < verticesCount; v++)
+        {
+            firstTriangle[v] = rangeStart;
+            rangeStart += remainingTriangles[v];
+        }
+
+        std::vector<uint32_t> vertexCorners(m_indices.size());
+        std::vector<uint32_t> cornerSlot(m_indices.size());
+
+        {
+            std::vector<uint32_t> filledCount(verticesCount, 0);
+
+            for (uint32_t i = 0; i < m_indices.size(); i++)
+            {
+                auto v = m_indices[i];
+                auto slot = firstTriangle[v] + filledCount[v]++;
+
+                vertexCorners[slot] = i;
+                cornerSlot[i] = slot;
+            }
+        }
+
+        std::vector<float> vertexScore(verticesCount);
+
+        for (uint32_t v = 0; v < verticesCount; v++)
+        {
+            vertexScore[v] = GetVertexScore(-1, remainingTriangles[v]);
+        }
+
+        std::vector<bool> isOutput(trianglesCount, false);
+
+        std::vector<uint32_t> newIndices;
+        newIndices.reserve(m_indices.size());
+
+        // Most recently used vertex first.
+        std::vector<uint32_t> cache;
+        std::vector<uint32_t> newCache;
+
+        cache.reserve(VertexCacheSize + 3);
+        newCache.reserve(VertexCacheSize + 3);
+
+        const uint32_t NoTriangle = UINT32_MAX;
+
+        uint32_t bestTriangle = NoTriangle;
+        uint32_t nextTriangleInOriginalOrder = 0;
+
+        for (uint32_t n = 0; n < trianglesCount; n++)
+        {
+            // When nothing in the cache has triangles left, carry on from
+            // wherever D2D's own output order has got to.
+            if (bestTriangle == NoTriangle)
+            {
+                while (isOutput[nextTriangleInOriginalOrder])
+                {
+                    nextTriangleInOriginalOrder++;
+                }
+
+                bestTriangle = nextTriangleInOriginalOrder;
+            }
+
+            isOutput[bestTriangle] = true;
+
+            auto triangleIndices = &m_indices[bestTriangle * 3];
+
+            newCache.clear();
+
+            for (int k = 0; k < 3; k++)
+            {
+                auto v = triangleIndices[k];
+
+                newIndices.push_back(v);
+                newCache.push_back(v);
+
+                auto corner = bestTriangle * 3 + k;
+                auto slot = cornerSlot[corner];
+                auto lastSlot = firstTriangle[v] + remainingTriangles[v] - 1;
+                auto lastCorner = vertexCorners[lastSlot];
+
+                vertexCorners[slot] = lastCorner;
+                cornerSlot[lastCorner] = slot;
+
+                vertexCorners[lastSlot] = corner;
+                cornerSlot[corner] = lastSlot;
+
+                remainingTriangles[v]--;
+            }
+
+            for (auto v : cache)
+            {
+                if (v != triangleIndices[0] && v != triangleIndices[1] && v != triangleIndices[2])
+                    newCache.push_back(v);
+            }
+
+            std::swap(cache, newCache);
+
+            // Rescore everything that was in the cache, including the
+            // vertices that have just been pushed out of it.
+            for (uint32_t i = 0; i < cache.size(); i++)
+            {
+                auto cachePosition = (i < VertexCacheSize) ? static_cast<int>(i) : -1;
+
+                vertexScore[cache[i]] = GetVertexScore(cachePosition, remainingTriangles[cache[i]]);
+            }
+
+            // The next triangle is the best scoring one that uses any of them.
+            // Only the first few triangles of each vertex are considered, so
+            // that high valence vertices (such as the center of a fan) don't
+            // make this quadratic. Their other triangles are still reachable
+            // through the vertices they share with their neighbors.
+            bestTriangle = NoTriangle;
+            float bestScore = 0;
+
+            for (auto v : cache)
+            {
+                auto candidatesCount = remainingTriangles[v];
+
+                if (candidatesCount > MaxCandidateTrianglesPerVertex)
+                    candidatesCount = MaxCandidateTrianglesPerVertex;
+
+                for (uint32_t j = 0; j < candidatesCount; j++)
+                {
+                    auto t = vertexCorners[firstTriangle[v] + j] / 3;
+                    auto indices = &m_indices[t * 3];
+
+                    float score = vertexScore[indices[0]] + vertexScore[indices[1]] + vertexScore[indices[2]];
+
+                    if (score > bestScore)
+                    {
+                        bestScore = score;
+                        bestTriangle = t;
+                    }
+                }
+            }
+
+            if (cache.size() > VertexCacheSize)
+                cache.resize(VertexCacheSize);
+        }
+
+        m_indices.swap(newIndices);
+    }
+
+
+    void IndexedTessellationBuilder::OptimizeVertexOrder()
+    {
+        const uint32_t NotYetUsed = UINT32_MAX;
+
+        std::vector<uint32_t> newVertexIndex(m_vertices.size(), NotYetUsed);
+
+        std::vector<D2D1_POINT_2F> newVertices;
+        newVertices.reserve(m_vertices.size());
+
+        // Vertices that were only used by degenerate triangles are dropped here.
+        for (auto& index : m_indices)
+        {
+            if (newVertexIndex[index] == NotYetUsed)
+            {
+                newVertexIndex[index] = static_cast<uint32_t>(newVertices.size());
+                newVertices.push_back(m_vertices[index]);
+            }
+
+            index = newVertexIndex[index];
+        }
+
+        m_vertices.swap(newVertices);
+
+        // The hash table refers to the old vertex order. AddVertex rebuilds
+        // it if any more triangles are added.
+        std::vector<uint32_t>().swap(m_hashTable);
+    }
+}}}}
@@ -0,0 +1,61 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    //
+    // Turns the triangle list from ID2D1Geometry::Tessellate into a vertex
+    // buffer plus an index buffer, for CanvasGeometry.TessellateIndexed.
+    //
+    // Neighboring triangles output by D2D share exactly the same vertex
+    // positions, so these are merged by looking them up in a hash table
+    // keyed on their coordinates. Optimize then reorders the triangles so
+    // that consecutive ones reuse recently transformed vertices (following
+    // Tom Forsyth's "Linear-Speed Vertex Cache Optimisation"), and the
+    // vertices so that they are read in the order the GPU first needs them.
+    //
+    class IndexedTessellationBuilder
+    {
+    public:
+        // Size of the vertex cache that Optimize assumes. Larger than most
+        // real hardware, which the Forsyth scoring copes with gracefully.
+        static const uint32_t VertexCacheSize = 32;
+
+        // How many of each cached vertex's remaining triangles Optimize
+        // scores when choosing the next triangle to output.
+        static const uint32_t MaxCandidateTrianglesPerVertex = 16;
+
+    private:
+        std::vector<D2D1_POINT_2F> m_vertices;
+        std::vector<uint32_t> m_indices;
+
+        // Open addressed, with slots holding vertex index + 1 (0 means empty).
+        std::vector<uint32_t> m_hashTable;
+
+    public:
+        void AddTriangles(D2D1_TRIANGLE const* triangles, uint32_t trianglesCount);
+
+        void Optimize();
+
+        std::vector<D2D1_POINT_2F> const& GetVertices() const { return m_vertices; }
+        std::vector<uint32_t> const& GetIndices() const { return m_indices; }
+
+    private:
+        uint32_t AddVertex(D2D1_POINT_2F const& point);
+        void GrowHashTable();
+
+        void OptimizeTriangleOrder();
+        void OptimizeVertexOrder();
+    };
+}}}}
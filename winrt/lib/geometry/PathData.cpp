@@ -0,0 +1,406 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+#include "PathData.h"
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    // Runs of segments are passed to D2D by reinterpreting the packed points.
+    static_assert(sizeof(D2D1_QUADRATIC_BEZIER_SEGMENT) == 2 * sizeof(D2D1_POINT_2F), "D2D1_QUADRATIC_BEZIER_SEGMENT must be two packed points");
+    static_assert(sizeof(D2D1_BEZIER_SEGMENT) == 3 * sizeof(D2D1_POINT_2F), "D2D1_BEZIER_SEGMENT must be three packed points");
+
+    PathDataWriter::PathDataWriter()
+        : m_filledRegionDetermination(CanvasFilledRegionDetermination::Alternate)
+    {
+    }
+
+
+    IFACEMETHODIMP PathDataWriter::BeginFigure(
+        Vector2 startPoint,
+        CanvasFigureFill figureFill)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                AddVerb(figureFill == CanvasFigureFill::DoesNotAffectFills ? PathDataVerb::BeginHollowFigure : PathDataVerb::BeginFigure);
+                AddPoint(startPoint);
+            });
+    }
+
+
+    IFACEMETHODIMP PathDataWriter::AddArc(
+        Vector2 endPoint,
+        float radiusX,
+        float radiusY,
+        float rotationAngle,
+        CanvasSweepDirection sweepDirection,
+        CanvasArcSize arcSize)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                uint8_t flags = 0;
+
+                if (sweepDirection == CanvasSweepDirection::Clockwise)
+                    flags |= PathDataArcClockwise;
+
+                if (arcSize == CanvasArcSize::Large)
+                    flags |= PathDataArcLarge;
+
+                AddVerb(PathDataVerb::Arc, flags);
+                AddPoint(endPoint);
+                AddPoint(Vector2{ radiusX, radiusY });
+                AddPoint(Vector2{ rotationAngle, 0 });
+            });
+    }
+
+
+    IFACEMETHODIMP PathDataWriter::AddCubicBezier(
+        Vector2 controlPoint1,
+        Vector2 controlPoint2,
+        Vector2 endPoint)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                AddVerb(PathDataVerb::CubicBezier);
+                AddPoint(controlPoint1);
+                AddPoint(controlPoint2);
+                AddPoint(endPoint);
+            });
+    }
+
+
+    IFACEMETHODIMP PathDataWriter::AddLine(
+        Vector2 endPoint)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                AddVerb(PathDataVerb::Line);
+                AddPoint(endPoint);
+            });
+    }
+
+
+    IFACEMETHODIMP PathDataWriter::AddQuadraticBezier(
+        Vector2 controlPoint,
+        Vector2 endPoint)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                AddVerb(PathDataVerb::QuadraticBezier);
+                AddPoint(controlPoint);
+                AddPoint(endPoint);
+            });
+    }
+
+
+    IFACEMETHODIMP PathDataWriter::SetFilledRegionDetermination(
+        CanvasFilledRegionDetermination filledRegionDetermination)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                if (filledRegionDetermination != CanvasFilledRegionDetermination::Alternate &&
+                    filledRegionDetermination != CanvasFilledRegionDetermination::Winding)
+                {
+                    ThrowHR(E_INVALIDARG);
+                }
+
+                m_filledRegionDetermination = filledRegionDetermination;
+            });
+    }
+
+
+    IFACEMETHODIMP PathDataWriter::SetSegmentOptions(
+        CanvasFigureSegmentOptions figureSegmentOptions)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                auto options = static_cast<uint32_t>(figureSegmentOptions);
+
+                if (options & ~PathDataSegmentOptionsMask)
+                    ThrowHR(E_INVALIDARG);
+
+                AddVerb(PathDataVerb::SetSegmentOptions, static_cast<uint8_t>(options));
+            });
+    }
+
+
+    IFACEMETHODIMP PathDataWriter::EndFigure(
+        CanvasFigureLoop figureLoop)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                AddVerb(figureLoop == CanvasFigureLoop::Closed ? PathDataVerb::EndClosedFigure : PathDataVerb::EndOpenFigure);
+            });
+    }
+
+
+    ComArray<BYTE> PathDataWriter::GetBytes() const
+    {
+        auto pointsSize = static_cast<uint64_t>(m_points.size()) * sizeof(D2D1_POINT_2F);
+        auto totalSize = sizeof(PathDataHeader) + pointsSize + m_verbs.size();
+
+        if (totalSize > UINT32_MAX)
+            ThrowHR(E_OUTOFMEMORY);
+
+        PathDataHeader header{};
+        header.Magic = PathDataHeader::ExpectedMagic;
+        header.Version = PathDataHeader::CurrentVersion;
+        header.FillMode = static_cast<uint8_t>(m_filledRegionDetermination);
+        header.PointCount = static_cast<uint32_t>(m_points.size());
+        header.VerbCount = static_cast<uint32_t>(m_verbs.size());
+
+        ComArray<BYTE> bytes(static_cast<size_t>(totalSize));
+
+        auto data = bytes.GetData();
+
+        memcpy(data, &header, sizeof(header));
+        data += sizeof(header);
+
+        if (!m_points.empty())
+            memcpy(data, m_points.data(), static_cast<size_t>(pointsSize));
+
+        data += pointsSize;
+
+        if (!m_verbs.empty())
+            memcpy(data, m_verbs.data(), m_verbs.size());
+
+        return bytes;
+    }
+
+
+    void PathDataWriter::AddVerb(PathDataVerb verb, uint8_t flags)
+    {
+        m_verbs.push_back(static_cast<uint8_t>(verb) + flags);
+    }
+
+
+    void PathDataWriter::AddPoint(Vector2 const& point)
+    {
+        m_points.push_back(ToD2DPoint(point));
+    }
+
+
+    static void ThrowInvalidPathData()
+    {
+        ThrowHR(E_INVALIDARG, HStringReference(Strings::InvalidPathData).Get());
+    }
+
+
+    //
+    // Everything is validated as it is read, so the data is only walked once.
+    //
+    class PathDataReader
+    {
+        D2D1_POINT_2F const* m_points;
+        uint32_t m_pointCount;
+        uint32_t m_nextPoint;
+
+        uint8_t const* m_verbs;
+        uint32_t m_verbCount;
+        uint32_t m_nextVerb;
+
+        bool m_isInFigure;
+
+    public:
+        PathDataReader(D2D1_POINT_2F const* points, uint32_t pointCount, uint8_t const* verbs, uint32_t verbCount)
+            : m_points(points)
+            , m_pointCount(pointCount)
+            , m_nextPoint(0)
+            , m_verbs(verbs)
+            , m_verbCount(verbCount)
+            , m_nextVerb(0)
+            , m_isInFigure(false)
+        {
+        }
+
+        void SendTo(ID2D1GeometrySink* geometrySink)
+        {
+            while (m_nextVerb < m_verbCount)
+            {
+                auto verb = m_verbs[m_nextVerb];
+
+                switch (static_cast<PathDataVerb>(verb))
+                {
+                case PathDataVerb::BeginFigure:
+                case PathDataVerb::BeginHollowFigure:
+                    if (m_isInFigure)
+                        ThrowInvalidPathData();
+
+                    geometrySink->BeginFigure(
+                        *TakePoints(1),
+                        (verb == static_cast<uint8_t>(PathDataVerb::BeginFigure)) ? D2D1_FIGURE_BEGIN_FILLED : D2D1_FIGURE_BEGIN_HOLLOW);
+
+                    m_isInFigure = true;
+                    m_nextVerb++;
+                    break;
+
+                case PathDataVerb::EndOpenFigure:
+                case PathDataVerb::EndClosedFigure:
+                    ValidateIsInFigure();
+
+                    geometrySink->EndFigure((verb == static_cast<uint8_t>(PathDataVerb::EndClosedFigure)) ? D2D1_FIGURE_END_CLOSED : D2D1_FIGURE_END_OPEN);
+
+                    m_isInFigure = false;
+                    m_nextVerb++;
+                    break;
+
+                case PathDataVerb::Line:
+                    {
+                        ValidateIsInFigure();
+                        auto count = TakeRun(verb);
+                        geometrySink->AddLines(TakePoints(count), count);
+                    }
+                    break;
+
+                case PathDataVerb::QuadraticBezier:
+                    {
+                        ValidateIsInFigure();
+                        auto count = TakeRun(verb);
+                        geometrySink->AddQuadraticBeziers(reinterpret_cast<D2D1_QUADRATIC_BEZIER_SEGMENT const*>(TakePoints(count, 2)), count);
+                    }
+                    break;
+
+                case PathDataVerb::CubicBezier:
+                    {
+                        ValidateIsInFigure();
+                        auto count = TakeRun(verb);
+                        geometrySink->AddBeziers(reinterpret_cast<D2D1_BEZIER_SEGMENT const*>(TakePoints(count, 3)), count);
+                    }
+                    break;
+
+                default:
+                    if (verb >= static_cast<uint8_t>(PathDataVerb::Arc) &&
+                        verb <= static_cast<uint8_t>(PathDataVerb::Arc) + (PathDataArcClockwise | PathDataArcLarge))
+                    {
+                        ValidateIsInFigure();
+
+                        auto flags = verb - static_cast<uint8_t>(PathDataVerb::Arc);
+                        auto points = TakePoints(3);
+
+                        D2D1_ARC_SEGMENT arc = D2D1::ArcSegment(
+                            points[0],
+                            D2D1::SizeF(points[1].x, points[1].y),
+                            ::DirectX::XMConvertToDegrees(points[2].x),
+                            (flags & PathDataArcClockwise) ? D2D1_SWEEP_DIRECTION_CLOCKWISE : D2D1_SWEEP_DIRECTION_COUNTER_CLOCKWISE,
+                            (flags & PathDataArcLarge) ? D2D1_ARC_SIZE_LARGE : D2D1_ARC_SIZE_SMALL);
+
+                        geometrySink->AddArc(&arc);
+                    }
+                    else if (verb >= static_cast<uint8_t>(PathDataVerb::SetSegmentOptions) &&
+                             verb <= static_cast<uint8_t>(PathDataVerb::SetSegmentOptions) + PathDataSegmentOptionsMask)
+                    {
+                        // CanvasFigureSegmentOptions has the same values as D2D1_PATH_SEGMENT.
+                        geometrySink->SetSegmentFlags(static_cast<D2D1_PATH_SEGMENT>(verb - static_cast<uint8_t>(PathDataVerb::SetSegmentOptions)));
+                    }
+                    else
+                    {
+                        ThrowInvalidPathData();
+                    }
+
+                    m_nextVerb++;
+                    break;
+                }
+            }
+
+            if (m_isInFigure || m_nextPoint != m_pointCount)
+                ThrowInvalidPathData();
+        }
+
+    private:
+        void ValidateIsInFigure() const
+        {
+            if (!m_isInFigure)
+                ThrowInvalidPathData();
+        }
+
+        // Consumes consecutive copies of the current verb, returning how many there were.
+        uint32_t TakeRun(uint8_t verb)
+        {
+            auto first = m_nextVerb;
+
+            while (m_nextVerb < m_verbCount && m_verbs[m_nextVerb] == verb)
+            {
+                m_nextVerb++;
+            }
+
+            return m_nextVerb - first;
+        }
+
+        D2D1_POINT_2F const* TakePoints(uint32_t count, uint32_t pointsPerItem = 1)
+        {
+            auto pointCount = static_cast<uint64_t>(count) * pointsPerItem;
+
+            if (pointCount > m_pointCount - m_nextPoint)
+                ThrowInvalidPathData();
+
+            auto points = m_points + m_nextPoint;
+            m_nextPoint += static_cast<uint32_t>(pointCount);
+            return points;
+        }
+    };
+
+
+    void ReadPathData(BYTE const* bytes, size_t byteCount, ID2D1GeometrySink* geometrySink)
+    {
+        PathDataHeader header;
+
+        if (byteCount < sizeof(header))
+            ThrowInvalidPathData();
+
+        memcpy(&header, bytes, sizeof(header));
+
+        if (header.Magic != PathDataHeader::ExpectedMagic)
+            ThrowInvalidPathData();
+
+        // Only data from a newer Win2D can have a version we don't know about.
+        if (header.Version > PathDataHeader::CurrentVersion)
+            ThrowHR(E_INVALIDARG, HStringReference(Strings::UnsupportedPathDataVersion).Get());
+
+        if (header.Version < PathDataHeader::CurrentVersion)
+            ThrowInvalidPathData();
+
+        if (header.FillMode > D2D1_FILL_MODE_WINDING || header.Reserved != 0)
+            ThrowInvalidPathData();
+
+        auto pointsSize = static_cast<uint64_t>(header.PointCount) * sizeof(D2D1_POINT_2F);
+
+        if (sizeof(header) + pointsSize + header.VerbCount != byteCount)
+            ThrowInvalidPathData();
+
+        auto points = reinterpret_cast<D2D1_POINT_2F const*>(bytes + sizeof(header));
+        auto verbs = bytes + sizeof(header) + pointsSize;
+
+        // Buffers from the WinRT projections and from mapped files are always
+        // suitably aligned, but a native caller could pass an arbitrary offset.
+        std::vector<D2D1_POINT_2F> alignedPoints;
+
+        if (reinterpret_cast<uintptr_t>(points) % __alignof(D2D1_POINT_2F) != 0)
+        {
+            alignedPoints.resize(header.PointCount);
+            memcpy(alignedPoints.data(), points, static_cast<size_t>(pointsSize));
+            points = alignedPoints.data();
+        }
+
+        geometrySink->SetFillMode(static_cast<D2D1_FILL_MODE>(header.FillMode));
+
+        PathDataReader reader(points, header.PointCount, verbs, header.VerbCount);
+        reader.SendTo(geometrySink);
+    }
+}}}}
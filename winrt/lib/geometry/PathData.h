@@ -0,0 +1,133 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    //
+    // Binary form of a path, as returned by CanvasGeometry.GetPathBytes and
+    // loaded by CanvasGeometry.CreatePathFromBytes. It is laid out as:
+    //
+    //      PathDataHeader
+    //      PointCount x D2D1_POINT_2F
+    //      VerbCount x PathDataVerb (one byte each)
+    //
+    // All values are little endian. The points come first so that they stay
+    // 4 byte aligned, which lets runs of lines and Beziers be passed to
+    // ID2D1GeometrySink straight from the caller's buffer (for instance a
+    // memory mapped file) without being copied.
+    //
+    struct PathDataHeader
+    {
+        // "W2DP" when read as bytes.
+        static const uint32_t ExpectedMagic = 0x50443257;
+
+        // Bump this whenever the format changes. Older readers reject newer data.
+        static const uint16_t CurrentVersion = 1;
+
+        uint32_t Magic;
+        uint16_t Version;
+        uint8_t FillMode;       // D2D1_FILL_MODE
+        uint8_t Reserved;       // Must be zero
+        uint32_t PointCount;
+        uint32_t VerbCount;
+    };
+
+    static_assert(sizeof(PathDataHeader) == 16, "PathDataHeader must not contain padding");
+
+    enum class PathDataVerb : uint8_t
+    {
+        BeginFigure = 0,            // 1 point: start point
+        BeginHollowFigure = 1,      // 1 point: start point
+        EndOpenFigure = 2,
+        EndClosedFigure = 3,
+        Line = 4,                   // 1 point: end point
+        QuadraticBezier = 5,        // 2 points: control point, end point
+        CubicBezier = 6,            // 3 points: control points, end point
+
+        // 3 points: end point, (radiusX, radiusY), (rotation in radians, 0).
+        // Plus ArcClockwise and/or ArcLarge.
+        Arc = 7,
+
+        // No points. Plus the CanvasFigureSegmentOptions value.
+        SetSegmentOptions = 11,
+    };
+
+    const uint8_t PathDataArcClockwise = 1;
+    const uint8_t PathDataArcLarge = 2;
+    const uint8_t PathDataSegmentOptionsMask = 3;
+
+
+    //
+    // Records whatever is sent to it, for CanvasGeometry.GetPathBytes.
+    //
+    class PathDataWriter : public RuntimeClass<
+        RuntimeClassFlags<WinRtClassicComMix>,
+        ICanvasPathReceiver>,
+        private LifespanTracker<PathDataWriter>
+    {
+        std::vector<D2D1_POINT_2F> m_points;
+        std::vector<uint8_t> m_verbs;
+        CanvasFilledRegionDetermination m_filledRegionDetermination;
+
+    public:
+        PathDataWriter();
+
+        IFACEMETHOD(BeginFigure)(
+            Vector2 startPoint,
+            CanvasFigureFill figureFill) override;
+
+        IFACEMETHOD(AddArc)(
+            Vector2 endPoint,
+            float radiusX,
+            float radiusY,
+            float rotationAngle,
+            CanvasSweepDirection sweepDirection,
+            CanvasArcSize arcSize) override;
+
+        IFACEMETHOD(AddCubicBezier)(
+            Vector2 controlPoint1,
+            Vector2 controlPoint2,
+            Vector2 endPoint) override;
+
+        IFACEMETHOD(AddLine)(
+            Vector2 endPoint) override;
+
+        IFACEMETHOD(AddQuadraticBezier)(
+            Vector2 controlPoint,
+            Vector2 endPoint) override;
+
+        IFACEMETHOD(SetFilledRegionDetermination)(
+            CanvasFilledRegionDetermination filledRegionDetermination) override;
+
+        IFACEMETHOD(SetSegmentOptions)(
+            CanvasFigureSegmentOptions figureSegmentOptions) override;
+
+        IFACEMETHOD(EndFigure)(
+            CanvasFigureLoop figureLoop) override;
+
+        ComArray<BYTE> GetBytes() const;
+
+    private:
+        void AddVerb(PathDataVerb verb, uint8_t flags = 0);
+        void AddPoint(Vector2 const& point);
+    };
+
+
+    //
+    // Sends path data to a geometry sink, which must be freshly opened. Throws
+    // E_INVALIDARG if the data is malformed, in which case the sink may have
+    // been given part of the path, and should be discarded.
+    //
+    void ReadPathData(BYTE const* bytes, size_t byteCount, ID2D1GeometrySink* geometrySink);
+}}}}
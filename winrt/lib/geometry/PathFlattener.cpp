@@ -0,0 +1,461 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+#include "PathFlattener.h"
+
+#include <cmath>
+
+using namespace DirectX;
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    PathFlattener::PathFlattener(float flatteningTolerance)
+        : m_flatteningTolerance(flatteningTolerance)
+        , m_fillMode(FillMode::Alternate)
+        , m_isInFigure(false)
+    {
+    }
+
+
+    void PathFlattener::BeginFigure(Point startPoint, bool isFilled)
+    {
+        if (m_isInFigure)
+        {
+            ThrowHR(E_INVALIDARG, HStringReference(Strings::FlattenerTwoBeginFigures).Get());
+        }
+
+        Figure figure{};
+        figure.FirstPoint = static_cast<uint32_t>(m_points.size());
+        figure.IsFilled = isFilled;
+
+        m_figures.push_back(figure);
+        m_points.push_back(startPoint);
+
+        m_isInFigure = true;
+    }
+
+
+    void PathFlattener::AddLine(Point endPoint)
+    {
+        ValidateIsInFigure();
+
+        m_points.push_back(endPoint);
+    }
+
+
+    void PathFlattener::AddQuadraticBezier(Point controlPoint, Point endPoint)
+    {
+        ValidateIsInFigure();
+
+        auto startPoint = GetCurrentPoint();
+        auto segmentCount = GetQuadraticBezierSegmentCount(startPoint, controlPoint, endPoint, m_flatteningTolerance);
+
+        // Raise to a cubic, so both kinds of curve share the same evaluator.
+        Point controlPoint1{ startPoint.X + (controlPoint.X - startPoint.X) * 2 / 3, startPoint.Y + (controlPoint.Y - startPoint.Y) * 2 / 3 };
+        Point controlPoint2{ endPoint.X + (controlPoint.X - endPoint.X) * 2 / 3, endPoint.Y + (controlPoint.Y - endPoint.Y) * 2 / 3 };
+
+        AddCubicBezierPoints(startPoint, controlPoint1, controlPoint2, endPoint, segmentCount);
+    }
+
+
+    void PathFlattener::AddCubicBezier(Point controlPoint1, Point controlPoint2, Point endPoint)
+    {
+        ValidateIsInFigure();
+
+        auto startPoint = GetCurrentPoint();
+        auto segmentCount = GetCubicBezierSegmentCount(startPoint, controlPoint1, controlPoint2, endPoint, m_flatteningTolerance);
+
+        AddCubicBezierPoints(startPoint, controlPoint1, controlPoint2, endPoint, segmentCount);
+    }
+
+
+    //
+    // Evaluates the curve at t = 1/n, 2/n ... 1, four values of t at a time.
+    //
+    // The curve is rewritten in power basis relative to its start point,
+    // p0 + a.t + b.t^2 + c.t^3, which needs three multiply-adds per
+    // coordinate rather than the dozen or so of de Casteljau, and keeps the
+    // coefficients small so large coordinates lose little precision.
+    //
+    void PathFlattener::AddCubicBezierPoints(Point p0, Point p1, Point p2, Point p3, uint32_t segmentCount)
+    {
+        auto ax = 3 * (p1.X - p0.X);
+        auto ay = 3 * (p1.Y - p0.Y);
+        auto bx = 3 * (p2.X - 2 * p1.X + p0.X);
+        auto by = 3 * (p2.Y - 2 * p1.Y + p0.Y);
+        auto cx = p3.X - p0.X + 3 * (p1.X - p2.X);
+        auto cy = p3.Y - p0.Y + 3 * (p1.Y - p2.Y);
+
+        auto vax = XMVectorReplicate(ax);
+        auto vay = XMVectorReplicate(ay);
+        auto vbx = XMVectorReplicate(bx);
+        auto vby = XMVectorReplicate(by);
+        auto vcx = XMVectorReplicate(cx);
+        auto vcy = XMVectorReplicate(cy);
+        auto vp0x = XMVectorReplicate(p0.X);
+        auto vp0y = XMVectorReplicate(p0.Y);
+
+        auto step = 1.0f / segmentCount;
+        auto vt = XMVectorMultiply(XMVectorSet(1, 2, 3, 4), XMVectorReplicate(step));
+        auto vtStep = XMVectorReplicate(4 * step);
+
+        auto firstNewPoint = m_points.size();
+        m_points.resize(firstNewPoint + segmentCount);
+        auto newPoints = &m_points[firstNewPoint];
+
+        XMFLOAT4A xs;
+        XMFLOAT4A ys;
+
+        for (uint32_t i = 0; i < segmentCount; i += 4)
+        {
+            auto vx = XMVectorMultiplyAdd(XMVectorMultiplyAdd(XMVectorMultiplyAdd(vcx, vt, vbx), vt, vax), vt, vp0x);
+            auto vy = XMVectorMultiplyAdd(XMVectorMultiplyAdd(XMVectorMultiplyAdd(vcy, vt, vby), vt, vay), vt, vp0y);
+
+            XMStoreFloat4A(&xs, vx);
+            XMStoreFloat4A(&ys, vy);
+
+            auto count = std::min<uint32_t>(4, segmentCount - i);
+
+            for (uint32_t j = 0; j < count; j++)
+            {
+                newPoints[i + j] = Point{ (&xs.x)[j], (&ys.x)[j] };
+            }
+
+            vt = XMVectorAdd(vt, vtStep);
+        }
+
+        // Rounding must not leave a gap before the next segment.
+        newPoints[segmentCount - 1] = p3;
+    }
+
+
+    //
+    // Arcs are converted from endpoint form to center form as described in
+    // the SVG spec (appendix F.6.5), and then split into equal angular steps
+    // small enough that no chord strays more than the tolerance from the
+    // ellipse.
+    //
+    void PathFlattener::AddArc(Point endPoint, float radiusX, float radiusY, float rotationAngle, bool isClockwise, bool isLargeArc)
+    {
+        ValidateIsInFigure();
+
+        auto startPoint = GetCurrentPoint();
+
+        if (startPoint.X == endPoint.X && startPoint.Y == endPoint.Y)
+            return;
+
+        double rx = fabs(radiusX);
+        double ry = fabs(radiusY);
+
+        if (rx == 0 || ry == 0 || !std::isfinite(rx) || !std::isfinite(ry) || !std::isfinite(rotationAngle))
+        {
+            m_points.push_back(endPoint);
+            return;
+        }
+
+        double cosPhi = cos(rotationAngle);
+        double sinPhi = sin(rotationAngle);
+
+        double halfDx = (static_cast<double>(startPoint.X) - endPoint.X) / 2;
+        double halfDy = (static_cast<double>(startPoint.Y) - endPoint.Y) / 2;
+
+        double x1 =  cosPhi * halfDx + sinPhi * halfDy;
+        double y1 = -sinPhi * halfDx + cosPhi * halfDy;
+
+        // Radii too small to reach the end point are scaled up until they just do.
+        double lambda = (x1 * x1) / (rx * rx) + (y1 * y1) / (ry * ry);
+
+        if (lambda > 1)
+        {
+            rx *= sqrt(lambda);
+            ry *= sqrt(lambda);
+        }
+
+        double rx2 = rx * rx;
+        double ry2 = ry * ry;
+
+        double numerator = rx2 * ry2 - rx2 * y1 * y1 - ry2 * x1 * x1;
+        double denominator = rx2 * y1 * y1 + ry2 * x1 * x1;
+
+        double coefficient = sqrt(std::max(0.0, numerator / denominator));
+
+        if (isLargeArc == isClockwise)
+            coefficient = -coefficient;
+
+        double centerX1 =  coefficient * rx * y1 / ry;
+        double centerY1 = -coefficient * ry * x1 / rx;
+
+        double centerX = cosPhi * centerX1 - sinPhi * centerY1 + (static_cast<double>(startPoint.X) + endPoint.X) / 2;
+        double centerY = sinPhi * centerX1 + cosPhi * centerY1 + (static_cast<double>(startPoint.Y) + endPoint.Y) / 2;
+
+        double startAngle = atan2((y1 - centerY1) / ry, (x1 - centerX1) / rx);
+        double endAngle = atan2((-y1 - centerY1) / ry, (-x1 - centerX1) / rx);
+
+        const double twoPi = 6.28318530717958647692;
+
+        // Increasing angles go clockwise, since y points down.
+        double sweepAngle = endAngle - startAngle;
+
+        if (isClockwise && sweepAngle < 0)
+            sweepAngle += twoPi;
+        else if (!isClockwise && sweepAngle > 0)
+            sweepAngle -= twoPi;
+
+        uint32_t segmentCount = MaxSegmentsPerCurve;
+
+        if (m_flatteningTolerance > 0)
+        {
+            double maxStepAngle = 2 * acos(std::max(-1.0, 1 - m_flatteningTolerance / std::max(rx, ry)));
+            double steps = ceil(fabs(sweepAngle) / maxStepAngle);
+
+            if (steps < MaxSegmentsPerCurve)
+                segmentCount = std::max(1u, static_cast<uint32_t>(steps));
+        }
+
+        for (uint32_t i = 1; i < segmentCount; i++)
+        {
+            double angle = startAngle + sweepAngle * i / segmentCount;
+
+            double ellipseX = rx * cos(angle);
+            double ellipseY = ry * sin(angle);
+
+            m_points.push_back(Point{
+                static_cast<float>(centerX + cosPhi * ellipseX - sinPhi * ellipseY),
+                static_cast<float>(centerY + sinPhi * ellipseX + cosPhi * ellipseY) });
+        }
+
+        m_points.push_back(endPoint);
+    }
+
+
+    void PathFlattener::EndFigure(bool isClosed)
+    {
+        if (!m_isInFigure)
+        {
+            ThrowHR(E_INVALIDARG, HStringReference(Strings::FlattenerEndFigureWithoutBeginFigure).Get());
+        }
+
+        auto& figure = m_figures.back();
+
+        // The closing line back to the start is implied.
+        if (isClosed && m_points.size() > figure.FirstPoint + 1)
+        {
+            auto& startPoint = m_points[figure.FirstPoint];
+            auto& lastPoint = m_points.back();
+
+            if (lastPoint.X == startPoint.X && lastPoint.Y == startPoint.Y)
+                m_points.pop_back();
+        }
+
+        figure.PointCount = static_cast<uint32_t>(m_points.size() - figure.FirstPoint);
+        figure.IsClosed = isClosed;
+
+        m_isInFigure = false;
+    }
+
+
+    void PathFlattener::Clear()
+    {
+        m_points.clear();
+        m_figures.clear();
+        m_isInFigure = false;
+    }
+
+
+    void PathFlattener::SendTo(PolygonTessellator& tessellator) const
+    {
+        tessellator.SetFillMode(m_fillMode);
+
+        for (auto& figure : m_figures)
+        {
+            // Figures that are still open have not had their PointCount set yet.
+            if (&figure == &m_figures.back() && m_isInFigure)
+                break;
+
+            if (!figure.IsFilled || figure.PointCount < 3)
+                continue;
+
+            tessellator.BeginFigure(m_points[figure.FirstPoint]);
+            tessellator.AddLines(&m_points[figure.FirstPoint + 1], figure.PointCount - 1);
+            tessellator.EndFigure();
+        }
+    }
+
+
+    // Length of p0 - 2p1 + p2, in double so that large coordinates don't overflow.
+    static float GetSecondDifferenceLength(PathFlattener::Point p0, PathFlattener::Point p1, PathFlattener::Point p2)
+    {
+        double x = static_cast<double>(p0.X) - 2.0 * p1.X + p2.X;
+        double y = static_cast<double>(p0.Y) - 2.0 * p1.Y + p2.Y;
+
+        return static_cast<float>(sqrt(x * x + y * y));
+    }
+
+
+    // Splitting into n steps leaves chords at most curvature / n^2 from the curve.
+    static uint32_t GetSegmentCount(float curvature, float flatteningTolerance)
+    {
+        if (!(flatteningTolerance > 0))
+            return PathFlattener::MaxSegmentsPerCurve;
+
+        float segmentCount = ceilf(sqrtf(curvature / flatteningTolerance));
+
+        // NaN coordinates give nothing meaningful to subdivide.
+        if (std::isnan(segmentCount) || segmentCount < 1)
+            return 1;
+
+        // This includes infinitely curved (or huge) curves.
+        if (segmentCount > PathFlattener::MaxSegmentsPerCurve)
+            return PathFlattener::MaxSegmentsPerCurve;
+
+        return static_cast<uint32_t>(segmentCount);
+    }
+
+
+    //
+    // A chord across a step of 1/n in t strays at most |B''| / 8n^2 from
+    // the curve, so n is chosen as the smallest that keeps this within the
+    // tolerance. For a quadratic B'' is the constant 2(p0 - 2p1 + p2).
+    //
+    uint32_t PathFlattener::GetQuadraticBezierSegmentCount(Point p0, Point p1, Point p2, float flatteningTolerance)
+    {
+        auto secondDifference = GetSecondDifferenceLength(p0, p1, p2);
+
+        return GetSegmentCount(secondDifference / 4, flatteningTolerance);
+    }
+
+
+    // For a cubic, |B''| is at most 6 times the larger second difference of its control points.
+    uint32_t PathFlattener::GetCubicBezierSegmentCount(Point p0, Point p1, Point p2, Point p3, float flatteningTolerance)
+    {
+        auto secondDifference1 = GetSecondDifferenceLength(p0, p1, p2);
+        auto secondDifference2 = GetSecondDifferenceLength(p1, p2, p3);
+
+        return GetSegmentCount(0.75f * std::max(secondDifference1, secondDifference2), flatteningTolerance);
+    }
+
+
+    void PathFlattener::ValidateIsInFigure() const
+    {
+        if (!m_isInFigure)
+        {
+            ThrowHR(E_INVALIDARG, HStringReference(Strings::FlattenerPathDataOutsideFigure).Get());
+        }
+    }
+
+
+    static PathFlattener::Point ToFlattenerPoint(Vector2 const& point)
+    {
+        return PathFlattener::Point{ point.X, point.Y };
+    }
+
+
+    IFACEMETHODIMP PathFlattenerReceiver::BeginFigure(
+        Vector2 startPoint,
+        CanvasFigureFill figureFill)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                m_flattener.BeginFigure(ToFlattenerPoint(startPoint), figureFill == CanvasFigureFill::Default);
+            });
+    }
+
+
+    IFACEMETHODIMP PathFlattenerReceiver::AddArc(
+        Vector2 endPoint,
+        float radiusX,
+        float radiusY,
+        float rotationAngle,
+        CanvasSweepDirection sweepDirection,
+        CanvasArcSize arcSize)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                m_flattener.AddArc(
+                    ToFlattenerPoint(endPoint),
+                    radiusX,
+                    radiusY,
+                    rotationAngle,
+                    sweepDirection == CanvasSweepDirection::Clockwise,
+                    arcSize == CanvasArcSize::Large);
+            });
+    }
+
+
+    IFACEMETHODIMP PathFlattenerReceiver::AddCubicBezier(
+        Vector2 controlPoint1,
+        Vector2 controlPoint2,
+        Vector2 endPoint)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                m_flattener.AddCubicBezier(ToFlattenerPoint(controlPoint1), ToFlattenerPoint(controlPoint2), ToFlattenerPoint(endPoint));
+            });
+    }
+
+
+    IFACEMETHODIMP PathFlattenerReceiver::AddLine(
+        Vector2 endPoint)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                m_flattener.AddLine(ToFlattenerPoint(endPoint));
+            });
+    }
+
+
+    IFACEMETHODIMP PathFlattenerReceiver::AddQuadraticBezier(
+        Vector2 controlPoint,
+        Vector2 endPoint)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                m_flattener.AddQuadraticBezier(ToFlattenerPoint(controlPoint), ToFlattenerPoint(endPoint));
+            });
+    }
+
+
+    IFACEMETHODIMP PathFlattenerReceiver::SetFilledRegionDetermination(
+        CanvasFilledRegionDetermination filledRegionDetermination)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                m_flattener.SetFillMode(static_cast<PathFlattener::FillMode>(filledRegionDetermination));
+            });
+    }
+
+
+    IFACEMETHODIMP PathFlattenerReceiver::SetSegmentOptions(
+        CanvasFigureSegmentOptions)
+    {
+        // Stroke joins do not affect the flattened shape.
+        return S_OK;
+    }
+
+
+    IFACEMETHODIMP PathFlattenerReceiver::EndFigure(
+        CanvasFigureLoop figureLoop)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                m_flattener.EndFigure(figureLoop == CanvasFigureLoop::Closed);
+            });
+    }
+}}}}
@@ -0,0 +1,147 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include "PolygonTessellator.h"
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    //
+    // Converts paths made of lines, Bezier curves and arcs into polylines on
+    // the CPU, without needing a D2D device.
+    //
+    // Each curve is split into the smallest number of equal steps that keeps
+    // the polyline within the flattening tolerance of the true curve. This is
+    // the same tolerance that D2D takes, in the coordinate space of the path,
+    // so values from CanvasGeometry.ComputeFlatteningTolerance can be passed
+    // straight in. Bezier points are evaluated four at a time using
+    // DirectXMath vector operations.
+    //
+    class PathFlattener
+    {
+    public:
+        typedef PolygonTessellator::Point Point;
+        typedef PolygonTessellator::FillMode FillMode;
+
+        // Figures are stored as ranges of GetPoints(). Closed figures do
+        // not repeat their start point at the end.
+        struct Figure
+        {
+            uint32_t FirstPoint;
+            uint32_t PointCount;
+            bool IsClosed;
+            bool IsFilled;
+        };
+
+        // However small the tolerance, no curve is split into more steps than this.
+        static const uint32_t MaxSegmentsPerCurve = 4096;
+
+    private:
+        float m_flatteningTolerance;
+        FillMode m_fillMode;
+
+        std::vector<Point> m_points;
+        std::vector<Figure> m_figures;
+        bool m_isInFigure;
+
+    public:
+        explicit PathFlattener(float flatteningTolerance = D2D1_DEFAULT_FLATTENING_TOLERANCE);
+
+        float GetFlatteningTolerance() const { return m_flatteningTolerance; }
+
+        void SetFillMode(FillMode fillMode) { m_fillMode = fillMode; }
+        FillMode GetFillMode() const { return m_fillMode; }
+
+        void BeginFigure(Point startPoint, bool isFilled = true);
+        void AddLine(Point endPoint);
+        void AddQuadraticBezier(Point controlPoint, Point endPoint);
+        void AddCubicBezier(Point controlPoint1, Point controlPoint2, Point endPoint);
+
+        // rotationAngle is in radians. Clockwise is in the y-down coordinate
+        // space of the path, matching CanvasSweepDirection.
+        void AddArc(Point endPoint, float radiusX, float radiusY, float rotationAngle, bool isClockwise, bool isLargeArc);
+
+        void EndFigure(bool isClosed);
+
+        void Clear();
+
+        std::vector<Point> const& GetPoints() const { return m_points; }
+        std::vector<Figure> const& GetFigures() const { return m_figures; }
+
+        // Adds the figures that affect fills, and the fill mode, to a tessellator.
+        void SendTo(PolygonTessellator& tessellator) const;
+
+        static uint32_t GetQuadraticBezierSegmentCount(Point p0, Point p1, Point p2, float flatteningTolerance);
+        static uint32_t GetCubicBezierSegmentCount(Point p0, Point p1, Point p2, Point p3, float flatteningTolerance);
+
+    private:
+        void ValidateIsInFigure() const;
+        Point GetCurrentPoint() const { return m_points.back(); }
+
+        void AddCubicBezierPoints(Point p0, Point p1, Point p2, Point p3, uint32_t segmentCount);
+    };
+
+
+    //
+    // ICanvasPathReceiver that flattens everything sent to it, so that
+    // CanvasGeometry.SendPathTo can be used to flatten an existing geometry.
+    //
+    class PathFlattenerReceiver : public RuntimeClass<
+        RuntimeClassFlags<WinRtClassicComMix>,
+        ICanvasPathReceiver>,
+        private LifespanTracker<PathFlattenerReceiver>
+    {
+        PathFlattener m_flattener;
+
+    public:
+        PathFlattenerReceiver(float flatteningTolerance)
+            : m_flattener(flatteningTolerance)
+        {
+        }
+
+        PathFlattener& GetFlattener() { return m_flattener; }
+
+        IFACEMETHOD(BeginFigure)(
+            Vector2 startPoint,
+            CanvasFigureFill figureFill) override;
+
+        IFACEMETHOD(AddArc)(
+            Vector2 endPoint,
+            float radiusX,
+            float radiusY,
+            float rotationAngle,
+            CanvasSweepDirection sweepDirection,
+            CanvasArcSize arcSize) override;
+
+        IFACEMETHOD(AddCubicBezier)(
+            Vector2 controlPoint1,
+            Vector2 controlPoint2,
+            Vector2 endPoint) override;
+
+        IFACEMETHOD(AddLine)(
+            Vector2 endPoint) override;
+
+        IFACEMETHOD(AddQuadraticBezier)(
+            Vector2 controlPoint,
+            Vector2 endPoint) override;
+
+        IFACEMETHOD(SetFilledRegionDetermination)(
+            CanvasFilledRegionDetermination filledRegionDetermination) override;
+
+        IFACEMETHOD(SetSegmentOptions)(
+            CanvasFigureSegmentOptions figureSegmentOptions) override;
+
+        IFACEMETHOD(EndFigure)(
+            CanvasFigureLoop figureLoop) override;
+    };
+}}}}
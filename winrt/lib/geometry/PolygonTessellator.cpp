@@ -0,0 +1,391 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+#include "PolygonTessellator.h"
+
+// Only standard headers, so this also builds outside of Win2D (see
+// build/cmake/geometry/CMakeLists.txt).
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <numeric>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    PolygonTessellator::PolygonTessellator()
+        : m_fillMode(FillMode::Alternate)
+        , m_isFigureOpen(false)
+        , m_figureStart{}
+        , m_currentPoint{}
+    {
+    }
+
+
+    void PolygonTessellator::BeginFigure(Point startPoint)
+    {
+        if (m_isFigureOpen)
+            EndFigure();
+
+        m_isFigureOpen = true;
+        m_figureStart = startPoint;
+        m_currentPoint = startPoint;
+    }
+
+
+    void PolygonTessellator::AddLine(Point endPoint)
+    {
+        // A line outside of any figure just sets the start of the next one.
+        if (!m_isFigureOpen)
+        {
+            BeginFigure(endPoint);
+            return;
+        }
+
+        AddEdge(m_currentPoint, endPoint);
+        m_currentPoint = endPoint;
+    }
+
+
+    void PolygonTessellator::AddLines(Point const* points, size_t pointCount)
+    {
+        for (size_t i = 0; i < pointCount; i++)
+        {
+            AddLine(points[i]);
+        }
+    }
+
+
+    void PolygonTessellator::EndFigure()
+    {
+        if (!m_isFigureOpen)
+            return;
+
+        AddEdge(m_currentPoint, m_figureStart);
+        m_isFigureOpen = false;
+    }
+
+
+    void PolygonTessellator::Clear()
+    {
+        m_edges.clear();
+        m_isFigureOpen = false;
+    }
+
+
+    void PolygonTessellator::AddEdge(Point from, Point to)
+    {
+        if (!std::isfinite(from.X) || !std::isfinite(from.Y) ||
+            !std::isfinite(to.X)   || !std::isfinite(to.Y))
+        {
+            return;
+        }
+
+        // Horizontal edges never separate the inside of a figure from the outside
+        // of it along a horizontal line, so the sweep does not need them.
+        if (from.Y == to.Y)
+            return;
+
+        if (from.Y < to.Y)
+            m_edges.push_back(Edge{ from.X, from.Y, to.X, to.Y, 1 });
+        else
+            m_edges.push_back(Edge{ to.X, to.Y, from.X, from.Y, -1 });
+    }
+
+
+    void PolygonTessellator::Tessellate(std::vector<Triangle>& triangles) const
+    {
+        if (m_isFigureOpen)
+        {
+            auto closed = *this;
+            closed.EndFigure();
+            closed.Tessellate(triangles);
+            return;
+        }
+
+        auto& edges = m_edges;
+        auto edgeCount = static_cast<uint32_t>(edges.size());
+
+        if (edgeCount == 0)
+            return;
+
+        // Sorted list of distinct vertex y coordinates. Nothing starts or ends
+        // between two consecutive values, so within each of these slabs the
+        // active edges are just straight lines that span the whole slab.
+        std::vector<double> slabs;
+        slabs.reserve(edgeCount * 2);
+
+        for (auto& edge : edges)
+        {
+            slabs.push_back(edge.Y0);
+            slabs.push_back(edge.Y1);
+        }
+
+        std::sort(slabs.begin(), slabs.end());
+        slabs.erase(std::unique(slabs.begin(), slabs.end()), slabs.end());
+
+        // Edges in the order they become active.
+        std::vector<uint32_t> edgesByTop(edgeCount);
+        std::iota(edgesByTop.begin(), edgesByTop.end(), 0);
+        std::sort(edgesByTop.begin(), edgesByTop.end(), [&](uint32_t a, uint32_t b) { return edges[a].Y0 < edges[b].Y0; });
+
+        struct ActiveEdge
+        {
+            uint32_t Index;
+            double XTop;
+            double XBottom;
+
+            bool operator<(ActiveEdge const& other) const
+            {
+                return (XTop != other.XTop) ? XTop < other.XTop : XBottom < other.XBottom;
+            }
+        };
+
+        std::vector<ActiveEdge> activeEdges;
+        uint32_t nextEdge = 0;
+
+        //
+        // Trapezoids that are still being swept down the filled region. Each
+        // lies between two adjacent active edges, so any edge is the left side
+        // of at most one of them, and they are stored indexed by left edge.
+        // Keeping a trapezoid open for as long as its edges stay adjacent
+        // means we output far fewer triangles than one pair per slab.
+        //
+        const uint32_t NoEdge = UINT32_MAX;
+
+        std::vector<uint32_t> spanRight(edgeCount, NoEdge);
+        std::vector<double> spanTop(edgeCount);
+        std::vector<uint32_t> spanLastSeen(edgeCount, 0);
+        std::vector<uint32_t> openSpans;
+        std::vector<uint32_t> nextOpenSpans;
+        uint32_t sweepStep = 0;
+
+        auto isInside = [&](int winding)
+        {
+            return (m_fillMode == FillMode::Winding) ? (winding != 0) : ((winding & 1) != 0);
+        };
+
+        auto outputTrapezoid = [&](uint32_t left, uint32_t right, double top, double bottom)
+        {
+            if (!(bottom > top))
+                return;
+
+            Point topLeft     { static_cast<float>(edges[left].XAt(top)),     static_cast<float>(top)    };
+            Point topRight    { static_cast<float>(edges[right].XAt(top)),    static_cast<float>(top)    };
+            Point bottomLeft  { static_cast<float>(edges[left].XAt(bottom)),  static_cast<float>(bottom) };
+            Point bottomRight { static_cast<float>(edges[right].XAt(bottom)), static_cast<float>(bottom) };
+
+            if (topRight.X != topLeft.X)
+                triangles.push_back(Triangle{ topLeft, topRight, bottomRight });
+
+            if (bottomRight.X != bottomLeft.X)
+                triangles.push_back(Triangle{ topLeft, bottomRight, bottomLeft });
+        };
+
+        auto closeOpenSpans = [&](double y)
+        {
+            for (auto left : openSpans)
+            {
+                if (spanLastSeen[left] != sweepStep && spanRight[left] != NoEdge)
+                {
+                    outputTrapezoid(left, spanRight[left], spanTop[left], y);
+                    spanRight[left] = NoEdge;
+                }
+            }
+        };
+
+        for (size_t i = 0; i + 1 < slabs.size(); i++)
+        {
+            double slabTop = slabs[i];
+            double slabBottom = slabs[i + 1];
+
+            activeEdges.erase(
+                std::remove_if(activeEdges.begin(), activeEdges.end(), [&](ActiveEdge const& activeEdge) { return edges[activeEdge.Index].Y1 <= slabTop; }),
+                activeEdges.end());
+
+            while (nextEdge < edgeCount && edges[edgesByTop[nextEdge]].Y0 <= slabTop)
+            {
+                activeEdges.push_back(ActiveEdge{ edgesByTop[nextEdge++], 0, 0 });
+            }
+
+            double top = slabTop;
+
+            do
+            {
+                for (auto& activeEdge : activeEdges)
+                {
+                    activeEdge.XTop = edges[activeEdge.Index].XAt(top);
+                    activeEdge.XBottom = edges[activeEdge.Index].XAt(slabBottom);
+                }
+
+                // The order rarely changes much from one slab to the next, which
+                // makes insertion sort cheaper than std::sort here.
+                for (size_t j = 1; j < activeEdges.size(); j++)
+                {
+                    auto activeEdge = activeEdges[j];
+                    size_t k = j;
+
+                    for (; k > 0 && activeEdge < activeEdges[k - 1]; k--)
+                    {
+                        activeEdges[k] = activeEdges[k - 1];
+                    }
+
+                    activeEdges[k] = activeEdge;
+                }
+
+                // If any edges cross within the slab, only sweep as far as the first
+                // crossing. The first edges to cross must be adjacent at the top.
+                double bottom = slabBottom;
+
+                for (size_t j = 0; j + 1 < activeEdges.size(); j++)
+                {
+                    auto& a = activeEdges[j];
+                    auto& b = activeEdges[j + 1];
+
+                    if (b.XBottom < a.XBottom)
+                    {
+                        double topGap = b.XTop - a.XTop;
+                        double bottomGap = a.XBottom - b.XBottom;
+                        double crossing = top + (slabBottom - top) * topGap / (topGap + bottomGap);
+
+                        bottom = std::min(bottom, crossing);
+                    }
+                }
+
+                // Rounding can put a crossing at (or just above) the top of the
+                // slab, but we must still make progress.
+                bottom = std::max(bottom, top + (slabBottom - slabTop) * 1e-9);
+
+                if (!(bottom > top) || bottom > slabBottom)
+                    bottom = slabBottom;
+
+                // Find the spans between adjacent edges that are inside the filled
+                // region, and extend or start a trapezoid for each of them.
+                sweepStep++;
+                nextOpenSpans.clear();
+
+                int winding = 0;
+
+                for (size_t j = 0; j + 1 < activeEdges.size(); j++)
+                {
+                    winding += edges[activeEdges[j].Index].Direction;
+
+                    if (!isInside(winding))
+                        continue;
+
+                    auto left = activeEdges[j].Index;
+                    auto right = activeEdges[j + 1].Index;
+
+                    if (spanRight[left] != right)
+                    {
+                        if (spanRight[left] != NoEdge)
+                            outputTrapezoid(left, spanRight[left], spanTop[left], top);
+
+                        spanRight[left] = right;
+                        spanTop[left] = top;
+                    }
+
+                    spanLastSeen[left] = sweepStep;
+                    nextOpenSpans.push_back(left);
+                }
+
+                closeOpenSpans(top);
+                std::swap(openSpans, nextOpenSpans);
+
+                top = bottom;
+            } while (top < slabBottom);
+        }
+
+        sweepStep++;
+        closeOpenSpans(slabs.back());
+    }
+
+
+    void PolygonTessellator::TessellateBatch(
+        PolygonTessellator const* tessellators,
+        size_t count,
+        std::vector<Triangle>* results,
+        unsigned threadCount)
+    {
+        if (count == 0)
+            return;
+
+        if (threadCount == 0)
+            threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+        threadCount = static_cast<unsigned>(std::min<size_t>(threadCount, count));
+
+        std::atomic<size_t> nextIndex(0);
+        std::exception_ptr firstException;
+        std::mutex exceptionMutex;
+
+        // Threads take the next item from a shared counter, so a few expensive
+        // geometries do not leave the other threads idle.
+        auto worker = [&]
+        {
+            try
+            {
+                for (;;)
+                {
+                    size_t i = nextIndex++;
+
+                    if (i >= count)
+                        break;
+
+                    results[i].clear();
+                    tessellators[i].Tessellate(results[i]);
+                }
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(exceptionMutex);
+
+                if (!firstException)
+                    firstException = std::current_exception();
+
+                nextIndex = count;
+            }
+        };
+
+        std::vector<std::thread> threads;
+
+        try
+        {
+            for (unsigned i = 1; i < threadCount; i++)
+            {
+                threads.emplace_back(worker);
+            }
+        }
+        catch (std::system_error const&)
+        {
+            // If we cannot start as many threads as requested, the ones we have will do all the work.
+        }
+
+        worker();
+
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        if (firstException)
+            std::rethrow_exception(firstException);
+    }
+}}}}
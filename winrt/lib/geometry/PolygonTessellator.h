@@ -0,0 +1,122 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    //
+    // CPU tessellator for figures made of straight line segments, producing
+    // the same kind of triangle list as ID2D1Geometry::Tessellate.
+    //
+    // This does not need a D2D device or factory, and only uses the C++
+    // standard library, so it can run on any platform and on any number of
+    // threads at once (each PolygonTessellator is only read by Tessellate).
+    //
+    // The filled region is split into trapezoids by sweeping down through
+    // the y coordinates of the vertices, and of any points where edges
+    // cross, so self intersecting and overlapping figures are handled in
+    // both fill modes. Each trapezoid is output as one or two triangles.
+    //
+    class PolygonTessellator
+    {
+    public:
+        // These have the same layout as Vector2 / D2D1_POINT_2F
+        // and CanvasTriangleVertices / D2D1_TRIANGLE.
+        struct Point
+        {
+            float X;
+            float Y;
+        };
+
+        struct Triangle
+        {
+            Point Vertex1;
+            Point Vertex2;
+            Point Vertex3;
+        };
+
+        // Same values as CanvasFilledRegionDetermination and D2D1_FILL_MODE.
+        enum class FillMode
+        {
+            Alternate = 0,
+            Winding = 1
+        };
+
+    private:
+        // Edges are stored top to bottom. Direction records which way the
+        // original segment went, for computing winding numbers.
+        struct Edge
+        {
+            double X0;
+            double Y0;
+            double X1;
+            double Y1;
+            int Direction;
+
+            double XAt(double y) const
+            {
+                return X0 + (X1 - X0) * (y - Y0) / (Y1 - Y0);
+            }
+        };
+
+        std::vector<Edge> m_edges;
+        FillMode m_fillMode;
+
+        bool m_isFigureOpen;
+        Point m_figureStart;
+        Point m_currentPoint;
+
+    public:
+        PolygonTessellator();
+
+        void SetFillMode(FillMode fillMode) { m_fillMode = fillMode; }
+        FillMode GetFillMode() const { return m_fillMode; }
+
+        //
+        // Figures are always treated as closed, since only their filled
+        // region is tessellated. Beginning a new figure (or calling
+        // Tessellate) while one is still open implicitly ends it.
+        //
+        void BeginFigure(Point startPoint);
+        void AddLine(Point endPoint);
+        void AddLines(Point const* points, size_t pointCount);
+        void EndFigure();
+
+        void Clear();
+
+        // Number of non-horizontal edges added so far.
+        size_t GetEdgeCount() const { return m_edges.size(); }
+
+        // Appends the triangles that make up the filled region.
+        void Tessellate(std::vector<Triangle>& triangles) const;
+
+        //
+        // Tessellates tessellators[i] into results[i] for each i < count,
+        // spreading the work across threadCount threads (zero means one per
+        // hardware thread). If any of them throws, the first exception is
+        // rethrown once all threads have finished.
+        //
+        static void TessellateBatch(
+            PolygonTessellator const* tessellators,
+            size_t count,
+            std::vector<Triangle>* results,
+            unsigned threadCount = 0);
+
+    private:
+        void AddEdge(Point from, Point to);
+    };
+}}}}
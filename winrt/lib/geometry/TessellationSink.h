@@ -14,15 +14,28 @@
 
 namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 {
+    static_assert(sizeof(CanvasTriangleVertices) == sizeof(D2D1_TRIANGLE), "CanvasTriangleVertices must match D2D1_TRIANGLE");
+
+    //
+    // Collects the output of ID2D1Geometry::Tessellate directly into the
+    // CoTaskMem buffer that is returned to the caller, so GetTriangles does
+    // not need to copy it. The buffer starts out at the estimated size (if
+    // the caller has one), and grows geometrically when that is too small.
+    //
     class TessellationSink : public RuntimeClass<RuntimeClassFlags<ClassicCom>, ID2D1TessellationSink>,
                             private LifespanTracker<TessellationSink>
     {
-        std::vector<CanvasTriangleVertices> m_triangles;
+        static const uint32_t MinimumCapacity = 64;
+
+        ComArray<CanvasTriangleVertices> m_triangles;
+        uint32_t m_trianglesCount;
         HRESULT m_result;
 
     public:
-        TessellationSink()
-            : m_result(S_OK)
+        TessellationSink(uint32_t estimatedTrianglesCount = 0)
+            : m_triangles(estimatedTrianglesCount)
+            , m_trianglesCount(0)
+            , m_result(S_OK)
         { }
 
         IFACEMETHODIMP_(void) AddTriangles(D2D1_TRIANGLE const* triangles, UINT32 trianglesCount)
@@ -32,9 +45,25 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 
             m_result = ExceptionBoundary([&]
             {
+                uint64_t requiredCapacity = static_cast<uint64_t>(m_trianglesCount) + trianglesCount;
+
+                if (requiredCapacity > m_triangles.GetSize())
+                {
+                    if (requiredCapacity > UINT_MAX)
+                        ThrowHR(E_OUTOFMEMORY);
+
+                    uint64_t newCapacity = std::max<uint64_t>(
+                        requiredCapacity,
+                        std::max<uint64_t>(static_cast<uint64_t>(m_triangles.GetSize()) * 2, MinimumCapacity));
+
+                    m_triangles.Resize(static_cast<size_t>(std::min<uint64_t>(newCapacity, UINT_MAX)));
+                }
+
                 auto canvasTriangles = ReinterpretAs<CanvasTriangleVertices const*>(triangles);
 
-                m_triangles.insert(m_triangles.end(), canvasTriangles, canvasTriangles + trianglesCount);
+                std::copy(canvasTriangles, canvasTriangles + trianglesCount, m_triangles.GetData() + m_trianglesCount);
+
+                m_trianglesCount += trianglesCount;
             });
         }
 
@@ -47,7 +76,54 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         {
             ThrowIfFailed(m_result);
 
-            return ComArray<CanvasTriangleVertices>(m_triangles.begin(), m_triangles.end());
+            // Give back any unused capacity. Shrinking a CoTaskMem block
+            // does not normally need to move it.
+            m_triangles.Resize(m_trianglesCount);
+
+            return std::move(m_triangles);
+        }
+    };
+
+
+    //
+    // Passes the output of ID2D1Geometry::Tessellate straight to a callback,
+    // in whatever batches D2D produces it, without storing any of it. Used
+    // when the caller is going to transform the triangles into some other
+    // format anyway (see CanvasGeometry::TessellateTo).
+    //
+    class StreamingTessellationSink : public RuntimeClass<RuntimeClassFlags<ClassicCom>, ID2D1TessellationSink>,
+                                     private LifespanTracker<StreamingTessellationSink>
+    {
+        std::function<void(D2D1_TRIANGLE const*, uint32_t)> m_callback;
+        HRESULT m_result;
+
+    public:
+        StreamingTessellationSink(std::function<void(D2D1_TRIANGLE const*, uint32_t)> callback)
+            : m_callback(std::move(callback))
+            , m_result(S_OK)
+        { }
+
+        IFACEMETHODIMP_(void) AddTriangles(D2D1_TRIANGLE const* triangles, UINT32 trianglesCount)
+        {
+            if (FAILED(m_result) || trianglesCount == 0)
+                return;
+
+            // ID2D1TessellationSink has no way to report errors, so they are
+            // saved here and returned from Close (which makes Tessellate fail).
+            m_result = ExceptionBoundary([&]
+            {
+                m_callback(triangles, trianglesCount);
+            });
+        }
+
+        IFACEMETHODIMP Close()
+        {
+            return m_result;
+        }
+
+        HRESULT GetResult() const
+        {
+            return m_result;
         }
     };
 }}}}
@@ -193,6 +193,9 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         , m_trimmingDelimiterCount(0)
         , m_wordWrapping(CanvasWordWrapping::Wrap)
         , m_drawTextOptions(CanvasDrawTextOptions::Default)
+        , m_version(0)
+        , m_isFormatSharedWithNative(false)
+        , m_noWrapFormatVersion(0)
     {
     }
 
@@ -201,6 +204,9 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         : m_manager(manager)
         , m_closed(false)
         , m_format(format)
+        , m_version(0)
+        , m_isFormatSharedWithNative(true)
+        , m_noWrapFormatVersion(0)
     {
         SetShadowPropertiesFromDWrite();
     }
@@ -226,16 +232,37 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             [&]
             {
                 CheckAndClearOutPointer(value);
-                ThrowIfFailed(GetRealizedTextFormat().CopyTo(iid, value));
+
+                std::lock_guard<std::mutex> lock(m_realizationMutex);
+
+                ThrowIfFailed(RealizeTextFormat().CopyTo(iid, value));
+
+                m_isFormatSharedWithNative = true;
             });
     }
 
 
     ComPtr<IDWriteTextFormat> CanvasTextFormat::GetRealizedTextFormat()
     {
-        if (m_format)
-            return m_format;
+        std::lock_guard<std::mutex> lock(m_realizationMutex);
+
+        return RealizeTextFormat();
+    }
+
 
+    // Must be called with m_realizationMutex held.
+    ComPtr<IDWriteTextFormat> CanvasTextFormat::RealizeTextFormat()
+    {
+        if (!m_format)
+            m_format = CreateTextFormat();
+
+        return m_format;
+    }
+
+
+    // Creates a new IDWriteTextFormat from the shadow properties.
+    ComPtr<IDWriteTextFormat> CanvasTextFormat::CreateTextFormat()
+    {
         ComPtr<IDWriteFactory2> factory;
         ThrowIfFailed(DWriteCreateFactory(
             DWRITE_FACTORY_TYPE_SHARED,
@@ -253,6 +280,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             fontCollection = m_manager->GetFontCollectionFromUri(uri);
         }
 
+        ComPtr<IDWriteTextFormat> format;
         ThrowIfFailed(factory->CreateTextFormat(
             static_cast<const wchar_t*>(fontFamily),
             fontCollection.Get(),
@@ -261,27 +289,86 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             ToFontStretch(m_fontStretch),
             m_fontSize,
             static_cast<const wchar_t*>(m_localeName),
-            &m_format));
+            &format));
 
-        RealizeFlowDirection();
-        RealizeIncrementalTabStop();
-        RealizeLineSpacing();
-        RealizeParagraphAlignment();
-        RealizeReadingDirection();
-        RealizeTextAlignment();
-        RealizeTrimming();
-        RealizeWordWrapping();
+        RealizeFlowDirection(format.Get());
+        RealizeIncrementalTabStop(format.Get());
+        RealizeLineSpacing(format.Get());
+        RealizeParagraphAlignment(format.Get());
+        RealizeReadingDirection(format.Get());
+        RealizeTextAlignment(format.Get());
+        RealizeTrimming(format.Get());
+        RealizeWordWrapping(format.Get());
 
-        return m_format;
+        return format;
     }
 
 
     CanvasDrawTextOptions CanvasTextFormat::GetDrawTextOptions()
     {
+        std::lock_guard<std::mutex> lock(m_realizationMutex);
+
         return m_drawTextOptions;
     }
 
 
+    uint32_t CanvasTextFormat::GetRealizedTextFormatVersion()
+    {
+        std::lock_guard<std::mutex> lock(m_realizationMutex);
+
+        return UpdateVersion();
+    }
+
+
+    // Must be called with m_realizationMutex held.
+    uint32_t CanvasTextFormat::UpdateVersion()
+    {
+        //
+        // Native code that has been given m_format may have changed it behind
+        // our back. The properties it can change are compared against the
+        // shadow copies, so the version only changes if one of them did.
+        //
+        if (m_isFormatSharedWithNative && m_format && SetMutableShadowPropertiesFromDWrite())
+            m_version++;
+
+        return m_version;
+    }
+
+
+    ComPtr<IDWriteTextFormat> CanvasTextFormat::GetRealizedNoWrapTextFormat()
+    {
+        std::lock_guard<std::mutex> lock(m_realizationMutex);
+
+        auto format = RealizeTextFormat();
+
+        if (format->GetWordWrapping() == DWRITE_WORD_WRAPPING_NO_WRAP)
+            return format;
+
+        auto version = UpdateVersion();
+
+        if (!m_noWrapFormat || m_noWrapFormatVersion != version)
+        {
+            // UpdateVersion has brought the shadow properties up to date, so
+            // this creates the same format as m_format, apart from the wrapping.
+            auto noWrapFormat = CreateTextFormat();
+            ThrowIfFailed(noWrapFormat->SetWordWrapping(DWRITE_WORD_WRAPPING_NO_WRAP));
+
+            if (m_isFormatSharedWithNative)
+            {
+                // Native code may have set a trimming sign, which has no shadow property.
+                DWriteTrimming trimming(format.Get());
+                ThrowIfFailed(noWrapFormat->SetTrimming(&trimming.Options, trimming.Sign.Get()));
+            }
+
+            m_noWrapFormat = noWrapFormat;
+            m_noWrapFormatVersion = version;
+        }
+
+        return m_noWrapFormat;
+    }
+
+
+    // Must be called with m_realizationMutex held.
     void CanvasTextFormat::Unrealize()
     {
         //
@@ -292,6 +379,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             SetShadowPropertiesFromDWrite();
 
         m_format.Reset();
+        m_isFormatSharedWithNative = false;
     }
 
 
@@ -301,33 +389,69 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 
         ThrowIfFailed(m_format->GetFontCollection(&m_fontCollection));
 
-        m_flowDirection      = ToCanvasTextDirection(m_format->GetFlowDirection());
         m_fontFamilyName     = GetFontFamilyName(m_format.Get());
         m_fontSize           = m_format->GetFontSize();
         m_fontStretch        = ToWindowsFontStretch(m_format->GetFontStretch());
         m_fontStyle          = ToWindowsFontStyle(m_format->GetFontStyle());
         m_fontWeight         = ToWindowsFontWeight(m_format->GetFontWeight());
-        m_incrementalTabStop = m_format->GetIncrementalTabStop();
         m_localeName         = GetLocaleName(m_format.Get());
-        m_verticalAlignment  = ToCanvasVerticalAlignment(m_format->GetParagraphAlignment());
-        m_paragraphAlignment = ToWindowsParagraphAlignment(m_format->GetTextAlignment());
-        m_readingDirection   = ToCanvasTextDirection(m_format->GetReadingDirection());
-        m_wordWrapping       = ToCanvasWordWrapping(m_format->GetWordWrapping());
         m_drawTextOptions    = CanvasDrawTextOptions::Default;
 
-        DWRITE_LINE_SPACING_METHOD method{};
-        ThrowIfFailed(m_format->GetLineSpacing(&method, &m_lineSpacing, &m_lineSpacingBaseline));
-        m_lineSpacingMethod = ToCanvasLineSpacingMethod(method);
+        SetMutableShadowPropertiesFromDWrite();
+    }
 
-        DWRITE_TRIMMING trimmingOptions{};
-        ComPtr<IDWriteInlineObject> inlineObject;
-        ThrowIfFailed(m_format->GetTrimming(
-            &trimmingOptions,
-            &inlineObject));
 
-        m_trimmingGranularity = ToCanvasTextTrimmingGranularity(trimmingOptions.granularity);
-        m_trimmingDelimiter = ToCanvasTrimmingDelimiter(trimmingOptions.delimiter);
-        m_trimmingDelimiterCount = trimmingOptions.delimiterCount;
+    //
+    // Copies the properties that can be changed on an existing
+    // IDWriteTextFormat into the shadow properties. Returns true if any of
+    // them had a different value.
+    //
+    bool CanvasTextFormat::SetMutableShadowPropertiesFromDWrite()
+    {
+        assert(m_format);
+
+        auto flowDirection      = ToCanvasTextDirection(m_format->GetFlowDirection());
+        auto incrementalTabStop = m_format->GetIncrementalTabStop();
+        auto verticalAlignment  = ToCanvasVerticalAlignment(m_format->GetParagraphAlignment());
+        auto paragraphAlignment = ToWindowsParagraphAlignment(m_format->GetTextAlignment());
+        auto readingDirection   = ToCanvasTextDirection(m_format->GetReadingDirection());
+        auto wordWrapping       = ToCanvasWordWrapping(m_format->GetWordWrapping());
+
+        DWriteLineSpacing lineSpacing(m_format.Get());
+        auto lineSpacingMethod = ToCanvasLineSpacingMethod(lineSpacing.Method);
+
+        DWriteTrimming trimming(m_format.Get());
+        auto trimmingGranularity    = ToCanvasTextTrimmingGranularity(trimming.Options.granularity);
+        auto trimmingDelimiter      = ToCanvasTrimmingDelimiter(trimming.Options.delimiter);
+        auto trimmingDelimiterCount = static_cast<int32_t>(trimming.Options.delimiterCount);
+
+        bool changed = flowDirection != m_flowDirection ||
+                       incrementalTabStop != m_incrementalTabStop ||
+                       verticalAlignment != m_verticalAlignment ||
+                       paragraphAlignment != m_paragraphAlignment ||
+                       readingDirection != m_readingDirection ||
+                       wordWrapping != m_wordWrapping ||
+                       lineSpacingMethod != m_lineSpacingMethod ||
+                       lineSpacing.Spacing != m_lineSpacing ||
+                       lineSpacing.Baseline != m_lineSpacingBaseline ||
+                       trimmingGranularity != m_trimmingGranularity ||
+                       !m_trimmingDelimiter.Equals(trimmingDelimiter) ||
+                       trimmingDelimiterCount != m_trimmingDelimiterCount;
+
+        m_flowDirection          = flowDirection;
+        m_incrementalTabStop     = incrementalTabStop;
+        m_verticalAlignment      = verticalAlignment;
+        m_paragraphAlignment     = paragraphAlignment;
+        m_readingDirection       = readingDirection;
+        m_wordWrapping           = wordWrapping;
+        m_lineSpacingMethod      = lineSpacingMethod;
+        m_lineSpacing            = lineSpacing.Spacing;
+        m_lineSpacingBaseline    = lineSpacing.Baseline;
+        m_trimmingGranularity    = trimmingGranularity;
+        m_trimmingDelimiter      = trimmingDelimiter;
+        m_trimmingDelimiterCount = trimmingDelimiterCount;
+
+        return changed;
     }
 
 
@@ -395,6 +519,8 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             {
                 CheckInPointer(value);
                 ThrowIfClosed();
+
+                std::lock_guard<std::mutex> lock(m_realizationMutex);
                 
                 if (m_format)
                     SetFrom(value, realizedGetter());
@@ -405,7 +531,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 
     
     template<typename T, typename TT, typename FNV>
-    HRESULT __declspec(nothrow) CanvasTextFormat::PropertyPut(T value, TT* dest, FNV&& validator, void(CanvasTextFormat::*realizer)())
+    HRESULT __declspec(nothrow) CanvasTextFormat::PropertyPut(T value, TT* dest, FNV&& validator, void(CanvasTextFormat::*realizer)(IDWriteTextFormat*))
     {
         return ExceptionBoundary(
             [&]
@@ -414,6 +540,10 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 
                 ThrowIfClosed();
 
+                // A drawing session on another thread may be realizing
+                // m_format, so it must not change under it.
+                std::lock_guard<std::mutex> lock(m_realizationMutex);
+
                 if (IsSame(dest, value))
                 {
                     // Don't do anything if the value we're setting is the same
@@ -432,14 +562,16 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                 // Set the shadow value
                 SetFrom(dest, value);
 
+                m_version++;
+
                 // Realize the value on the dwrite object, if we can
                 if (m_format && realizer)
-                    (this->*realizer)();
+                    (this->*realizer)(m_format.Get());
             });
     }
 
     template<typename T, typename TT>
-    HRESULT __declspec(nothrow) CanvasTextFormat::PropertyPut(T value, TT* dest, void(CanvasTextFormat::*realizer)())
+    HRESULT __declspec(nothrow) CanvasTextFormat::PropertyPut(T value, TT* dest, void(CanvasTextFormat::*realizer)(IDWriteTextFormat*))
     {
         return PropertyPut(value, dest, [](T){}, realizer);
     }
@@ -467,9 +599,9 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
     }
 
 
-    void CanvasTextFormat::RealizeFlowDirection()
+    void CanvasTextFormat::RealizeFlowDirection(IDWriteTextFormat* format)
     {
-        ThrowIfFailed(m_format->SetFlowDirection(ToFlowDirection(m_flowDirection)));        
+        ThrowIfFailed(format->SetFlowDirection(ToFlowDirection(m_flowDirection)));        
     }
 
     //
@@ -514,6 +646,8 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             [&]
             {
                 ThrowIfClosed();
+
+                std::lock_guard<std::mutex> lock(m_realizationMutex);
                 
                 if (IsSame(&m_fontFamilyName, value))
                     return;
@@ -526,6 +660,8 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                 m_fontCollection.Reset();
 
                 SetFrom(&m_fontFamilyName, value);
+
+                m_version++;
             });
     }
 
@@ -637,12 +773,12 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
     }
 
 
-    void CanvasTextFormat::RealizeIncrementalTabStop()
+    void CanvasTextFormat::RealizeIncrementalTabStop(IDWriteTextFormat* format)
     {
         // Negative value indicates that it hasn't been set yet, so we want to
         // use dwrite's default.
         if (m_incrementalTabStop >= 0.0f)
-            ThrowIfFailed(m_format->SetIncrementalTabStop(m_incrementalTabStop));
+            ThrowIfFailed(format->SetIncrementalTabStop(m_incrementalTabStop));
     }
 
     //
@@ -712,9 +848,9 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
     }
 
 
-    void CanvasTextFormat::RealizeLineSpacing()
+    void CanvasTextFormat::RealizeLineSpacing(IDWriteTextFormat* format)
     {
-        ThrowIfFailed(m_format->SetLineSpacing(
+        ThrowIfFailed(format->SetLineSpacing(
             ToLineSpacingMethod(m_lineSpacingMethod),
             m_lineSpacing,
             m_lineSpacingBaseline));
@@ -768,9 +904,9 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
     }
 
 
-    void CanvasTextFormat::RealizeParagraphAlignment()
+    void CanvasTextFormat::RealizeParagraphAlignment(IDWriteTextFormat* format)
     {
-        ThrowIfFailed(m_format->SetParagraphAlignment(ToParagraphAlignment(m_verticalAlignment)));
+        ThrowIfFailed(format->SetParagraphAlignment(ToParagraphAlignment(m_verticalAlignment)));
     }
 
     //
@@ -796,9 +932,9 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
     }
 
 
-    void CanvasTextFormat::RealizeReadingDirection()
+    void CanvasTextFormat::RealizeReadingDirection(IDWriteTextFormat* format)
     {
-        ThrowIfFailed(m_format->SetReadingDirection(ToReadingDirection(m_readingDirection)));
+        ThrowIfFailed(format->SetReadingDirection(ToReadingDirection(m_readingDirection)));
     }
 
     //
@@ -824,9 +960,9 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             &CanvasTextFormat::RealizeTextAlignment);
     }
 
-    void CanvasTextFormat::RealizeTextAlignment()
+    void CanvasTextFormat::RealizeTextAlignment(IDWriteTextFormat* format)
     {
-        ThrowIfFailed(m_format->SetTextAlignment(ToTextAlignment(m_paragraphAlignment)));        
+        ThrowIfFailed(format->SetTextAlignment(ToTextAlignment(m_paragraphAlignment)));        
     }
 
     //
@@ -896,14 +1032,14 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
     }
 
 
-    void CanvasTextFormat::RealizeTrimming()
+    void CanvasTextFormat::RealizeTrimming(IDWriteTextFormat* format)
     {
         DWRITE_TRIMMING trimmingOptions{};
         trimmingOptions.granularity = ToTrimmingGranularity(m_trimmingGranularity);
         trimmingOptions.delimiter = ToTrimmingDelimiter(m_trimmingDelimiter);
         trimmingOptions.delimiterCount = m_trimmingDelimiterCount;
             
-        ThrowIfFailed(m_format->SetTrimming(
+        ThrowIfFailed(format->SetTrimming(
             &trimmingOptions,
             nullptr));        
     }
@@ -932,9 +1068,9 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
     }
 
 
-    void CanvasTextFormat::RealizeWordWrapping()
+    void CanvasTextFormat::RealizeWordWrapping(IDWriteTextFormat* format)
     {
-        ThrowIfFailed(m_format->SetWordWrapping(ToWordWrapping(m_wordWrapping)));        
+        ThrowIfFailed(format->SetWordWrapping(ToWordWrapping(m_wordWrapping)));        
     }
 
     //
@@ -948,6 +1084,8 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             {
                 CheckInPointer(value);
                 ThrowIfClosed();
+
+                std::lock_guard<std::mutex> lock(m_realizationMutex);
                 *value = m_drawTextOptions;
             });
     }
@@ -968,6 +1106,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                 if ((value & ~validOptions) != CanvasDrawTextOptions::Default)
                     ThrowHR(E_INVALIDARG);
 
+                std::lock_guard<std::mutex> lock(m_realizationMutex);
                 m_drawTextOptions = value;
             });
     }
@@ -114,6 +114,14 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
     public:
         virtual ComPtr<IDWriteTextFormat> GetRealizedTextFormat() = 0;
         virtual CanvasDrawTextOptions GetDrawTextOptions() = 0;
+
+        // Changes whenever the realized format may have been modified, so
+        // that callers can tell when data derived from it has gone stale.
+        virtual uint32_t GetRealizedTextFormatVersion() = 0;
+
+        // Returns the realized format with word wrapping disabled, without
+        // changing the WordWrapping property.
+        virtual ComPtr<IDWriteTextFormat> GetRealizedNoWrapTextFormat() = 0;
     };
 
 
@@ -178,6 +186,30 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         //
         ComPtr<IDWriteTextFormat> m_format;
 
+        //
+        // Incremented whenever a property changes. Native code that has
+        // been given m_format could change it at any time, so once that has
+        // happened the version also changes when m_format no longer matches
+        // the shadow properties.
+        //
+        uint32_t m_version;
+        bool m_isFormatSharedWithNative;
+
+        //
+        // Copy of m_format with word wrapping disabled, used for drawing text
+        // at a point. This is recreated if m_version has changed since it was
+        // created.
+        //
+        ComPtr<IDWriteTextFormat> m_noWrapFormat;
+        uint32_t m_noWrapFormatVersion;
+
+        //
+        // Drawing sessions on several threads may realize the same format at
+        // once, while another thread sets its properties. This guards
+        // m_format, m_version, m_noWrapFormat and the shadow properties.
+        //
+        std::mutex m_realizationMutex;
+
     public:
         CanvasTextFormat(std::shared_ptr<CanvasTextFormatManager> manager);
         CanvasTextFormat(std::shared_ptr<CanvasTextFormatManager> manager, IDWriteTextFormat* format);
@@ -223,6 +255,8 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 
         virtual ComPtr<IDWriteTextFormat> GetRealizedTextFormat() override;
         virtual CanvasDrawTextOptions GetDrawTextOptions() override;
+        virtual uint32_t GetRealizedTextFormatVersion() override;
+        virtual ComPtr<IDWriteTextFormat> GetRealizedNoWrapTextFormat() override;
 
         //
         // ICanvasResourceWrapperNative
@@ -238,22 +272,27 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         HRESULT __declspec(nothrow) PropertyGet(T* value, ST const& shadowValue, FN realizedGetter);
 
         template<typename T, typename TT, typename FNV>
-        HRESULT __declspec(nothrow) PropertyPut(T value, TT* dest, FNV&& validator, void(CanvasTextFormat::*realizer)() = nullptr);
+        HRESULT __declspec(nothrow) PropertyPut(T value, TT* dest, FNV&& validator, void(CanvasTextFormat::*realizer)(IDWriteTextFormat*) = nullptr);
         
         template<typename T, typename TT>
-        HRESULT __declspec(nothrow) PropertyPut(T value, TT* dest, void(CanvasTextFormat::*realizer)() = nullptr);
+        HRESULT __declspec(nothrow) PropertyPut(T value, TT* dest, void(CanvasTextFormat::*realizer)(IDWriteTextFormat*) = nullptr);
 
         void SetShadowPropertiesFromDWrite();
+        bool SetMutableShadowPropertiesFromDWrite();
+
+        ComPtr<IDWriteTextFormat> RealizeTextFormat();
+        ComPtr<IDWriteTextFormat> CreateTextFormat();
+        uint32_t UpdateVersion();
 
         void Unrealize();
-        void RealizeFlowDirection();
-        void RealizeIncrementalTabStop();
-        void RealizeLineSpacing();
-        void RealizeParagraphAlignment();
-        void RealizeReadingDirection();
-        void RealizeTextAlignment();
-        void RealizeTrimming();
-        void RealizeWordWrapping();
+        void RealizeFlowDirection(IDWriteTextFormat* format);
+        void RealizeIncrementalTabStop(IDWriteTextFormat* format);
+        void RealizeLineSpacing(IDWriteTextFormat* format);
+        void RealizeParagraphAlignment(IDWriteTextFormat* format);
+        void RealizeReadingDirection(IDWriteTextFormat* format);
+        void RealizeTextAlignment(IDWriteTextFormat* format);
+        void RealizeTrimming(IDWriteTextFormat* format);
+        void RealizeWordWrapping(IDWriteTextFormat* format);
     };
 
 
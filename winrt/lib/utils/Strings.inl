@@ -40,6 +40,12 @@ STRING(PathBuilderClosedMidFigure, L"There was an attempt to use a CanvasPathBui
 STRING(TwoBeginFigures, L"A call to CanvasPathBuilder.BeginFigure occurred, when the figure was already begun.")
 STRING(CanOnlyAddPathDataWhileInFigure, L"This operation is only allowed after a successful call to CanvasPathBuilder.BeginFigure.")
 STRING(SetFilledRegionDeterminationAfterBeginFigure, L"This operation is not allowed after the first call to CanvasPathBuilder.BeginFigure.")
+STRING(TooManyVerticesForIndexSize, L"This geometry tessellates into more vertices than 16 bit indices can refer to. Use CanvasGeometry.TessellateIndexed instead.")
+STRING(InvalidPathData, L"The data passed to CanvasGeometry.CreatePathFromBytes is not in the format returned by CanvasGeometry.GetPathBytes, or has been corrupted.")
+STRING(UnsupportedPathDataVersion, L"The data passed to CanvasGeometry.CreatePathFromBytes was saved by a newer version of Win2D.")
+STRING(FlattenerTwoBeginFigures, L"A path being flattened began a figure when the previous figure had not been ended.")
+STRING(FlattenerEndFigureWithoutBeginFigure, L"A path being flattened ended a figure that had not been begun.")
+STRING(FlattenerPathDataOutsideFigure, L"A path being flattened added a segment outside of a figure.")
 STRING(PathBuilderAddGeometryMidFigure, L"CanvasPathBuilder.AddGeometry may not be called in the middle of a figure.")
 STRING(PoppedWrongLayer, L"Attempting to close a CanvasActiveLayer that is not top of the stack. The most recently created layer must be closed first.")
 STRING(DidNotPopLayer, L"After calling CanvasDrawingSession.CreateLayer, you must close the resulting CanvasActiveLayer before ending the CanvasDrawingSession.")
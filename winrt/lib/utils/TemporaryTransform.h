@@ -16,6 +16,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 {
     // Helper object whose job is to apply a temporary transform to a D2D
     // device context or brush, then undo it at the end of a drawing operation.
+    // Also works with CanvasDrawingSession, which caches the current transform.
     template<typename T>
     class TemporaryTransform
     {
@@ -33,6 +34,10 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         TemporaryTransform(T* target, Vector2 const& offset, bool postMultiply = false)
             : m_target(target)
         {
+            // A zero offset would not change anything, so leave the target alone.
+            if (offset.X == 0 && offset.Y == 0)
+                m_target = nullptr;
+
             if (m_target)
             {
                 auto translation = D2D1::Matrix3x2F::Translation(offset.X, offset.Y);
@@ -48,7 +53,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         {
             if (m_target)
             {
-                m_target->SetTransform(&m_previousTransform);
+                m_target->SetTransform(m_previousTransform);
             }
         }
     };
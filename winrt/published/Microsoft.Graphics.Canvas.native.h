@@ -13,6 +13,7 @@
 #pragma once
 
 #include <inspectable.h>
+#include <stdint.h>
 #include <wrl.h>
 
 namespace ABI
@@ -70,6 +71,92 @@ namespace ABI
                 public:
                     IFACEMETHOD(GetResource)(REFIID iid, void** resource) = 0;
                 };
+
+                //
+                // Counts of the work done by a CanvasDrawingSession, which can
+                // be used to find out which drawing code is getting more
+                // expensive. Batched draws such as DrawLines or DrawSprites
+                // count each item.
+                //
+                // Fields may be added to the end of this struct in later
+                // versions, so callers set Size before calling GetStats.
+                //
+                struct CanvasDrawingSessionStats
+                {
+                    // sizeof(CanvasDrawingSessionStats), set by the caller.
+                    // GetStats sets it to the number of bytes it filled in,
+                    // which is less than this if Win2D is older than the
+                    // header the caller was compiled against.
+                    uint32_t Size;
+
+                    // Draw calls, by primitive type.
+                    uint32_t Clears;
+                    uint32_t LineDraws;
+                    uint32_t RectangleDraws;
+                    uint32_t RectangleFills;
+                    uint32_t RoundedRectangleDraws;
+                    uint32_t RoundedRectangleFills;
+                    uint32_t EllipseDraws;
+                    uint32_t EllipseFills;
+                    uint32_t GeometryDraws;
+                    uint32_t GeometryFills;
+                    uint32_t CachedGeometryDraws;
+                    uint32_t ImageDraws;
+                    uint32_t SpriteDraws;
+                    uint32_t TextDraws;
+
+                    // Layers pushed by CreateLayer, and how many of those could use
+                    // PushAxisAlignedClip. LayerResourcesCreated counts the ID2D1Layer
+                    // objects that could not be reused from an earlier layer in the
+                    // same session.
+                    uint32_t LayersPushed;
+                    uint32_t AxisAlignedClipsPushed;
+                    uint32_t LayerResourcesCreated;
+
+                    // Fills with an opacity brush, split by whether D2D could draw them
+                    // in a single call (FillOpacityMask, or FillGeometry with a clamped
+                    // bitmap brush) or a layer had to be pushed.
+                    uint32_t OpacityMaskFastPathFills;
+                    uint32_t OpacityMaskLayerFallbacks;
+
+                    // ICanvasBrush objects converted to D2D brushes.
+                    uint32_t BrushesRealized;
+
+                    // Lookups in the solid color brush palette used by the color overloads.
+                    uint64_t ColorBrushPaletteHits;
+                    uint64_t ColorBrushPaletteMisses;
+
+                    // Changes to the Transform, Antialiasing, Blend, TextAntialiasing and
+                    // Units state (including the temporary transforms used when drawing
+                    // geometry at an offset), split by whether they reached the device
+                    // context or were skipped because the state already had the
+                    // requested value.
+                    uint32_t StateChanges;
+                    uint32_t RedundantStateChangesSkipped;
+
+                    // Draw calls skipped because IsCullingEnabled was set and they were
+                    // outside the render target or the current clip. These are not
+                    // included in the counts above.
+                    uint32_t CulledDraws;
+
+                    // Text draws that found (or added) a layout in the text layout cache.
+                    uint32_t TextLayoutCacheHits;
+                    uint32_t TextLayoutCacheMisses;
+                };
+
+                //
+                // Interface provided by CanvasDrawingSession that is able to
+                // retrieve its stats. This can be called at any time, including
+                // after the drawing session has been closed, when the counts
+                // are final. GetStats fails with E_INVALIDARG if stats->Size is
+                // smaller than the first version of CanvasDrawingSessionStats.
+                //
+                [uuid(3F379F1E-21E3-4676-AD11-9F4572E7FE29)]
+                class ICanvasDrawingSessionStatsNative : public IUnknown
+                {
+                public:
+                    IFACEMETHOD(GetStats)(CanvasDrawingSessionStats* stats) = 0;
+                };
             }
         }
     }
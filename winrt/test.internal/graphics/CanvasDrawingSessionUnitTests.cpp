@@ -15,6 +15,7 @@
 #include "StubCanvasBrush.h"
 #include "effects\generated\GaussianBlurEffect.h"
 #include "MockD2DRectangleGeometry.h"
+#include "MockD2DTransformedGeometry.h"
 #include "CanvasCachedGeometry.h"
 #include "MockD2DGeometryRealization.h"
 #include "StubCanvasTextLayoutAdapter.h"
@@ -68,6 +69,7 @@ TEST_CLASS(CanvasDrawingSession_CallsAdapter)
     {
         ComPtr<ID2D1DeviceContext1> m_expectedDeviceContext;
         std::shared_ptr<MockCanvasDrawingSessionAdapter> m_mockAdapter;
+        std::shared_ptr<CanvasDrawingSessionManager> m_manager;
         ComPtr<CanvasDrawingSession> m_canvasDrawingSession;
 
         Fixture()
@@ -75,8 +77,8 @@ TEST_CLASS(CanvasDrawingSession_CallsAdapter)
             m_expectedDeviceContext = Make<MockD2DDeviceContext>();
             m_mockAdapter = std::make_shared<MockCanvasDrawingSessionAdapter>();
             
-            auto manager = std::make_shared<CanvasDrawingSessionManager>();
-            m_canvasDrawingSession = manager->Create(m_expectedDeviceContext.Get(), m_mockAdapter);
+            m_manager = std::make_shared<CanvasDrawingSessionManager>();
+            m_canvasDrawingSession = m_manager->Create(m_expectedDeviceContext.Get(), m_mockAdapter);
         }
     };
 
@@ -107,6 +109,21 @@ TEST_CLASS(CanvasDrawingSession_CallsAdapter)
         Assert::AreEqual(DXGI_ERROR_DEVICE_REMOVED, f.m_canvasDrawingSession->Close());
     }
 
+    TEST_METHOD_EX(CanvasDrawingSession_Close_WhenEndDrawThrows_StatsAreStillReported)
+    {
+        Fixture f;
+
+        int handlerCallCount = 0;
+        f.m_manager->SetStatsHandler([&](CanvasDrawingSessionStats const&) { handlerCallCount++; });
+
+        f.m_mockAdapter->SetEndDrawToThrow();
+        Assert::AreEqual(DXGI_ERROR_DEVICE_REMOVED, f.m_canvasDrawingSession->Close());
+        Assert::AreEqual(1, handlerCallCount);
+
+        ThrowIfFailed(f.m_canvasDrawingSession->Close());
+        Assert::AreEqual(1, handlerCallCount);
+    }
+
     TEST_METHOD_EX(CanvasDrawingSession_Destroy_EndDrawErrorsSwallowed)
     {
         Fixture f;
@@ -176,43 +193,44 @@ class BrushValidator
 {
     bool m_isColorOverload;
     ID2D1Brush* m_expectedBrush;
-    bool m_gotColor2;
+    int m_createCount;
     int m_checkCount;
 
 public:
     BrushValidator(CanvasDrawingSessionFixture const& f, bool isColorOverload)
         : m_isColorOverload(isColorOverload),
           m_expectedBrush(nullptr),
-          m_gotColor2(false),
+          m_createCount(0),
           m_checkCount(0)
     {
         if (isColorOverload)
         {
             // When testing a WithColor overload, we expect to get two draw calls.
             // The first draw uses ArbitraryMarkerColor1 and should trigger a call to CreateSolidColorBrush.
-            // The second uses ArbitraryMarkerColor2 and should call SetColor on the previously created brush.
+            // The second uses ArbitraryMarkerColor2, which is not yet in the session's brush
+            // palette, so should create a second brush rather than recoloring the first.
 
             f.DeviceContext->CreateSolidColorBrushMethod.AllowAnyCall(
                 [&](const D2D1_COLOR_F* color, const D2D1_BRUSH_PROPERTIES* brushProperties, ID2D1SolidColorBrush** solidColorBrush)
                 {
-                    // First we should see a brush created using ArbitraryMarkerColor1.
-                    Assert::IsNull(m_expectedBrush);
-                    Assert::AreEqual(ToD2DColor(ArbitraryMarkerColor1), *color);
+                    switch (m_createCount++)
+                    {
+                    case 0:
+                        Assert::AreEqual(ToD2DColor(ArbitraryMarkerColor1), *color);
+                        break;
 
+                    case 1:
+                        Assert::AreEqual(ToD2DColor(ArbitraryMarkerColor2), *color);
+                        break;
+
+                    default:
+                        Assert::Fail();
+                    }
+
+                    // Brushes in the palette should never be recolored by these tests.
                     auto brush = Make<MockD2DSolidColorBrush>();
                     m_expectedBrush = brush.Get();
-                    brush.CopyTo(solidColorBrush);
-
-                    // Then we should see SetColor called with ArbitraryMarkerColor2.
-                    brush->MockSetColor =
-                        [&](const D2D1_COLOR_F* color)
-                        {
-                            Assert::IsFalse(m_gotColor2);
-                            Assert::AreEqual(ToD2DColor(ArbitraryMarkerColor2), *color);
-                            m_gotColor2 = true;
-                        };
-
-                    return S_OK;
+                    return brush.CopyTo(solidColorBrush);
                 });
         }
         else
@@ -226,22 +244,8 @@ public:
     {
         if (m_isColorOverload)
         {
-            switch (m_checkCount)
-            {
-            case 0:
-                // During the first draw call, our brush should have been created but its color not changed yet.
-                Assert::IsNotNull(m_expectedBrush);
-                Assert::IsFalse(m_gotColor2);
-                break;
-
-            case 1:
-                // During the second draw call, the brush color should have been changed.
-                Assert::IsTrue(m_gotColor2);
-                break;
-
-            default:
-                Assert::Fail();
-            }
+            // Each draw call should use the brush that was created for its color.
+            Assert::AreEqual(m_checkCount + 1, m_createCount);
         }
 
         Assert::AreEqual(m_expectedBrush, brush);
@@ -294,7 +298,7 @@ public:
             Bitmap = MakeBitmapManager()->GetOrCreate(nullptr, StubBitmap.Get());
         }
 
-    private:
+    protected:
         static std::shared_ptr<CanvasBitmapManager> MakeBitmapManager()
         {
             auto converter = Make<MockWICFormatConverter>();
@@ -794,6 +798,280 @@ public:
     }
 
 
+    //
+    // DrawSprites
+    //
+
+    class SpriteFixture : public BitmapFixture
+    {
+    public:
+        ComPtr<ID2D1Image> OtherImage;
+        ComPtr<CanvasBitmap> OtherBitmap;
+
+        SpriteFixture()
+        {
+            auto otherStubBitmap = Make<StubD2DBitmap>();
+            OtherImage = As<ID2D1Image>(otherStubBitmap);
+            OtherBitmap = MakeBitmapManager()->GetOrCreate(nullptr, otherStubBitmap.Get());
+
+            DeviceContext->GetTransformMethod.AllowAnyCall(
+                [](D2D1_MATRIX_3X2_F* transform)
+                {
+                    *transform = D2D1::Matrix3x2F::Identity();
+                });
+        }
+    };
+
+    TEST_METHOD_EX(CanvasDrawingSession_DrawSprites_InvalidArguments)
+    {
+        SpriteFixture f;
+
+        ICanvasBitmap* bitmaps[] = { f.Bitmap.Get(), nullptr };
+        Matrix3x2 transforms[] = { { 1, 0, 0, 1, 0, 0 }, { 1, 0, 0, 1, 0, 0 } };
+        Rect sourceRects[2] = {};
+        Color tints[2] = {};
+        float opacities[2] = {};
+
+        // Every array must have one entry per sprite, except for tints and opacities which may be empty.
+        Assert::AreEqual(E_INVALIDARG, f.DS->DrawSprites(2, bitmaps, 1, transforms, 2, sourceRects));
+        Assert::AreEqual(E_INVALIDARG, f.DS->DrawSprites(2, bitmaps, 2, transforms, 1, sourceRects));
+        Assert::AreEqual(E_INVALIDARG, f.DS->DrawSpritesWithTintsAndOpacitiesAndInterpolationAndSortMode(1, bitmaps, 1, transforms, 1, sourceRects, 2, tints, 0, nullptr, CanvasImageInterpolation::Linear, CanvasSpriteSortMode::None));
+        Assert::AreEqual(E_INVALIDARG, f.DS->DrawSpritesWithTintsAndOpacitiesAndInterpolationAndSortMode(1, bitmaps, 1, transforms, 1, sourceRects, 0, nullptr, 2, opacities, CanvasImageInterpolation::Linear, CanvasSpriteSortMode::None));
+
+        Assert::AreEqual(E_INVALIDARG, f.DS->DrawSprites(1, nullptr, 1, transforms, 1, sourceRects));
+        Assert::AreEqual(E_INVALIDARG, f.DS->DrawSprites(1, bitmaps, 1, nullptr, 1, sourceRects));
+        Assert::AreEqual(E_INVALIDARG, f.DS->DrawSprites(1, bitmaps, 1, transforms, 1, nullptr));
+
+        // A null bitmap anywhere in the batch is an error, and nothing is drawn.
+        f.DeviceContext->DrawBitmapMethod.SetExpectedCalls(0);
+        Assert::AreEqual(E_INVALIDARG, f.DS->DrawSprites(2, bitmaps, 2, transforms, 2, sourceRects));
+
+        // An empty batch draws nothing.
+        ThrowIfFailed(f.DS->DrawSprites(0, nullptr, 0, nullptr, 0, nullptr));
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_DrawSprites_WhenFirstBitmapIsNull_ReturnsInvalidArg)
+    {
+        SpriteFixture f;
+
+        ICanvasBitmap* bitmaps[] = { nullptr, f.Bitmap.Get() };
+        Matrix3x2 transforms[] = { { 1, 0, 0, 1, 0, 0 }, { 1, 0, 0, 1, 0, 0 } };
+        Rect sourceRects[2] = {};
+
+        f.DeviceContext->DrawBitmapMethod.SetExpectedCalls(0);
+
+        Assert::AreEqual(E_INVALIDARG, f.DS->DrawSprites(2, bitmaps, 2, transforms, 2, sourceRects));
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_DrawSprites_WhenSortingByBitmapWithANullBitmap_ReturnsInvalidArg)
+    {
+        SpriteFixture f;
+
+        // Sorting would move the null to the front.
+        ICanvasBitmap* bitmaps[] = { f.Bitmap.Get(), f.OtherBitmap.Get(), nullptr };
+        Matrix3x2 transforms[] = { { 1, 0, 0, 1, 0, 0 }, { 1, 0, 0, 1, 0, 0 }, { 1, 0, 0, 1, 0, 0 } };
+        Rect sourceRects[3] = {};
+
+        f.DeviceContext->DrawBitmapMethod.SetExpectedCalls(0);
+
+        Assert::AreEqual(E_INVALIDARG, f.DS->DrawSpritesWithTintsAndOpacitiesAndInterpolationAndSortMode(
+            3, bitmaps,
+            3, transforms,
+            3, sourceRects,
+            0, nullptr,
+            0, nullptr,
+            CanvasImageInterpolation::Linear,
+            CanvasSpriteSortMode::Bitmap));
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_DrawSprites_SortsByBitmap)
+    {
+        SpriteFixture f;
+
+        ICanvasBitmap* bitmaps[] = { f.Bitmap.Get(), f.OtherBitmap.Get(), f.Bitmap.Get() };
+
+        // Positive scale plus translation is folded into the DrawBitmap destination rectangle.
+        Matrix3x2 transforms[] =
+        {
+            { 1, 0, 0, 1, 10, 20 },
+            { 2, 0, 0, 3, 30, 40 },
+            { 1, 0, 0, 2, 50, 60 },
+        };
+
+        Rect sourceRects[] = { Rect{ 0, 0, 4, 5 }, Rect{ 1, 2, 6, 7 }, Rect{ 3, 4, 8, 9 } };
+        float opacities[] = { 0.25f, 0.5f, 0.75f };
+
+        // The stable sort keeps the two sprites sharing f.Bitmap in their original order.
+        ID2D1Image* expectedImages[] = { f.Image.Get(), f.Image.Get(), f.OtherImage.Get() };
+        D2D1_RECT_F expectedDestRects[] = { D2D1_RECT_F{ 10, 20, 14, 25 }, D2D1_RECT_F{ 50, 60, 58, 78 }, D2D1_RECT_F{ 30, 40, 42, 61 } };
+        D2D1_RECT_F expectedSourceRects[] = { D2D1_RECT_F{ 0, 0, 4, 5 }, D2D1_RECT_F{ 3, 4, 11, 13 }, D2D1_RECT_F{ 1, 2, 7, 9 } };
+        float expectedOpacities[] = { 0.25f, 0.75f, 0.5f };
+
+        int drawCount = 0;
+
+        f.DeviceContext->DrawBitmapMethod.SetExpectedCalls(3,
+            [&](ID2D1Bitmap* bitmap, const D2D1_RECT_F* destRect, FLOAT opacity, D2D1_INTERPOLATION_MODE interpolation, const D2D1_RECT_F* sourceRect, const D2D1_MATRIX_4X4_F* perspective)
+            {
+                Assert::AreEqual(expectedImages[drawCount], As<ID2D1Image>(bitmap).Get());
+                Assert::AreEqual(expectedDestRects[drawCount], *destRect);
+                Assert::AreEqual(expectedSourceRects[drawCount], *sourceRect);
+                Assert::AreEqual(expectedOpacities[drawCount], opacity);
+                Assert::AreEqual(D2D1_INTERPOLATION_MODE_NEAREST_NEIGHBOR, interpolation);
+                Assert::IsNull(perspective);
+
+                drawCount++;
+            });
+
+        ThrowIfFailed(f.DS->DrawSpritesWithTintsAndOpacitiesAndInterpolationAndSortMode(
+            3, bitmaps,
+            3, transforms,
+            3, sourceRects,
+            0, nullptr,
+            3, opacities,
+            CanvasImageInterpolation::NearestNeighbor,
+            CanvasSpriteSortMode::Bitmap));
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_DrawSprites_RotatedSpritesSetTransform)
+    {
+        SpriteFixture f;
+
+        ICanvasBitmap* bitmaps[] = { f.Bitmap.Get(), f.Bitmap.Get(), f.Bitmap.Get() };
+
+        Matrix3x2 transforms[] =
+        {
+            { 0, 1, -1, 0, 10, 20 },
+            { 0, 1, -1, 0, 30, 40 },
+            { 1, 0, 0, 1, 50, 60 },
+        };
+
+        Rect sourceRects[] = { Rect{ 0, 0, 4, 5 }, Rect{ 0, 0, 4, 5 }, Rect{ 0, 0, 4, 5 } };
+
+        D2D1_MATRIX_3X2_F expectedTransforms[] =
+        {
+            D2D1_MATRIX_3X2_F{ 0, 1, -1, 0, 10, 20 },
+            D2D1_MATRIX_3X2_F{ 0, 1, -1, 0, 30, 40 },
+            D2D1::Matrix3x2F::Identity(),
+        };
+
+        // The two rotated sprites each set a transform, and the original is restored once before the unrotated one.
+        int setTransformCount = 0;
+
+        f.DeviceContext->SetTransformMethod.SetExpectedCalls(3,
+            [&](D2D1_MATRIX_3X2_F const* transform)
+            {
+                Assert::AreEqual(expectedTransforms[setTransformCount], *transform);
+                setTransformCount++;
+            });
+
+        D2D1_RECT_F expectedDestRects[] = { D2D1_RECT_F{ 0, 0, 4, 5 }, D2D1_RECT_F{ 0, 0, 4, 5 }, D2D1_RECT_F{ 50, 60, 54, 65 } };
+        int drawCount = 0;
+
+        f.DeviceContext->DrawBitmapMethod.SetExpectedCalls(3,
+            [&](ID2D1Bitmap*, const D2D1_RECT_F* destRect, FLOAT opacity, D2D1_INTERPOLATION_MODE interpolation, const D2D1_RECT_F*, const D2D1_MATRIX_4X4_F*)
+            {
+                Assert::AreEqual(expectedDestRects[drawCount], *destRect);
+                Assert::AreEqual(1.0f, opacity);
+                Assert::AreEqual(D2D1_INTERPOLATION_MODE_LINEAR, interpolation);
+
+                drawCount++;
+            });
+
+        ThrowIfFailed(f.DS->DrawSprites(3, bitmaps, 3, transforms, 3, sourceRects));
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_DrawSprites_KeepsTheCachedTransformInSync)
+    {
+        SpriteFixture f;
+
+        ICanvasBitmap* bitmaps[] = { f.Bitmap.Get() };
+        Matrix3x2 transforms[] = { { 0, 1, -1, 0, 10, 20 } };
+        Rect sourceRects[] = { Rect{ 0, 0, 4, 5 } };
+
+        f.DeviceContext->SetTransformMethod.SetExpectedCalls(1);
+        ThrowIfFailed(f.DS->put_Transform(Numerics::Matrix3x2{ 1, 0, 0, 1, 5, 6 }));
+
+        // The session already knows its transform, so DrawSprites does not read
+        // it back, and sets it through the cache.
+        f.DeviceContext->GetTransformMethod.SetExpectedCalls(0);
+        f.DeviceContext->SetTransformMethod.SetExpectedCalls(2);
+        f.DeviceContext->DrawBitmapMethod.SetExpectedCalls(1);
+
+        ThrowIfFailed(f.DS->DrawSprites(1, bitmaps, 1, transforms, 1, sourceRects));
+
+        // The cache ends up matching the restored transform.
+        f.DeviceContext->SetTransformMethod.SetExpectedCalls(0);
+        ThrowIfFailed(f.DS->put_Transform(Numerics::Matrix3x2{ 1, 0, 0, 1, 5, 6 }));
+
+        f.DeviceContext->SetTransformMethod.SetExpectedCalls(1);
+        ThrowIfFailed(f.DS->put_Transform(Numerics::Matrix3x2{ 0, 1, -1, 0, 15, 26 }));
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_DrawSprites_Tints)
+    {
+        SpriteFixture f;
+
+        ICanvasBitmap* bitmaps[] = { f.Bitmap.Get(), f.Bitmap.Get(), f.Bitmap.Get() };
+        Matrix3x2 transforms[] = { { 1, 0, 0, 1, 0, 0 }, { 1, 0, 0, 1, 0, 0 }, { 1, 0, 0, 1, 0, 0 } };
+        Rect sourceRects[] = { Rect{ 0, 0, 4, 5 }, Rect{ 0, 0, 4, 5 }, Rect{ 0, 0, 4, 5 } };
+
+        // A white tint only scales the opacity, so can still use DrawBitmap.
+        Color tints[] = { Color{ 255, 255, 0, 0 }, Color{ 51, 255, 255, 255 }, Color{ 255, 0, 0, 255 } };
+
+        f.DeviceContext->SetTransformMethod.AllowAnyCall();
+        f.DeviceContext->GetPrimitiveBlendMethod.AllowAnyCall([] { return D2D1_PRIMITIVE_BLEND_SOURCE_OVER; });
+
+        f.DeviceContext->DrawBitmapMethod.SetExpectedCalls(1,
+            [&](ID2D1Bitmap*, const D2D1_RECT_F*, FLOAT opacity, D2D1_INTERPOLATION_MODE, const D2D1_RECT_F*, const D2D1_MATRIX_4X4_F*)
+            {
+                Assert::AreEqual(0.2f, opacity);
+            });
+
+        // Colored tints share a single color matrix effect.
+        auto mockEffect = Make<MockD2DEffect>();
+
+        mockEffect->MockSetInput =
+            [&](UINT32 index, ID2D1Image* input)
+            {
+                Assert::AreEqual(0U, index);
+                Assert::AreEqual(f.Image.Get(), input);
+            };
+
+        mockEffect->MockSetValue =
+            [&](UINT32 index, D2D1_PROPERTY_TYPE, CONST BYTE*, UINT32 dataSize)
+            {
+                Assert::AreEqual<UINT32>(D2D1_COLORMATRIX_PROP_COLOR_MATRIX, index);
+                Assert::AreEqual<UINT32>(sizeof(D2D1_MATRIX_5X4_F), dataSize);
+                return S_OK;
+            };
+
+        f.DeviceContext->CreateEffectMethod.SetExpectedCalls(1,
+            [&](IID const& effectId, ID2D1Effect** effect)
+            {
+                Assert::AreEqual(CLSID_D2D1ColorMatrix, effectId);
+                return mockEffect.CopyTo(effect);
+            });
+
+        f.DeviceContext->DrawImageMethod.SetExpectedCalls(2,
+            [&](ID2D1Image* image, D2D1_POINT_2F const* offset, D2D1_RECT_F const* sourceRect, D2D1_INTERPOLATION_MODE, D2D1_COMPOSITE_MODE compositeMode)
+            {
+                Assert::AreEqual(As<ID2D1Image>(mockEffect).Get(), image);
+                Assert::AreEqual(D2D1_POINT_2F{ 0, 0 }, *offset);
+                Assert::AreEqual(D2D1_RECT_F{ 0, 0, 4, 5 }, *sourceRect);
+                Assert::AreEqual(D2D1_COMPOSITE_MODE_SOURCE_OVER, compositeMode);
+            });
+
+        ThrowIfFailed(f.DS->DrawSpritesWithTintsAndOpacitiesAndInterpolationAndSortMode(
+            3, bitmaps,
+            3, transforms,
+            3, sourceRects,
+            3, tints,
+            0, nullptr,
+            CanvasImageInterpolation::Linear,
+            CanvasSpriteSortMode::None));
+    }
+
+
     //
     // DrawLine
     //
@@ -968,6 +1246,61 @@ public:
     }
 
 
+    //
+    // DrawLines
+    //
+
+    TEST_METHOD_EX(CanvasDrawingSession_DrawLinesWithBrush)
+    {
+        TestDrawLine(false, 1, false,
+            [](CanvasDrawingSessionFixture const& f, Vector2 p0, Vector2 p1, CanvasStrokeStyle*)
+        {
+            ThrowIfFailed(f.DS->DrawLinesWithBrush(1, &p0, 1, &p1, f.Brush.Get()));
+        });
+
+        // Null brush.
+        Assert::AreEqual(E_INVALIDARG, CanvasDrawingSessionFixture().DS->DrawLinesWithBrush(0, nullptr, 0, nullptr, nullptr));
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_DrawLinesWithColors)
+    {
+        TestDrawLine(true, 1, false,
+            [](CanvasDrawingSessionFixture const& f, Vector2 p0, Vector2 p1, CanvasStrokeStyle*)
+        {
+            Vector2 point0s[] = { p0, p0 };
+            Vector2 point1s[] = { p1, p1 };
+            Color colors[] = { ArbitraryMarkerColor1, ArbitraryMarkerColor2 };
+
+            ThrowIfFailed(f.DS->DrawLinesWithColors(2, point0s, 2, point1s, 2, colors));
+        });
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_DrawLinesWithBrushAndStrokeWidthAndStrokeStyle)
+    {
+        TestDrawLine(false, 123, true,
+            [](CanvasDrawingSessionFixture const& f, Vector2 p0, Vector2 p1, CanvasStrokeStyle* strokeStyle)
+        {
+            ThrowIfFailed(f.DS->DrawLinesWithBrushAndStrokeWidthAndStrokeStyle(1, &p0, 1, &p1, f.Brush.Get(), 123, strokeStyle));
+        });
+
+        // Null brush.
+        Assert::AreEqual(E_INVALIDARG, CanvasDrawingSessionFixture().DS->DrawLinesWithBrushAndStrokeWidthAndStrokeStyle(0, nullptr, 0, nullptr, nullptr, 0, nullptr));
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_DrawLinesWithColorsAndStrokeWidthAndStrokeStyle)
+    {
+        TestDrawLine(true, 123, true,
+            [](CanvasDrawingSessionFixture const& f, Vector2 p0, Vector2 p1, CanvasStrokeStyle* strokeStyle)
+        {
+            Vector2 point0s[] = { p0, p0 };
+            Vector2 point1s[] = { p1, p1 };
+            Color colors[] = { ArbitraryMarkerColor1, ArbitraryMarkerColor2 };
+
+            ThrowIfFailed(f.DS->DrawLinesWithColorsAndStrokeWidthAndStrokeStyle(2, point0s, 2, point1s, 2, colors, 123, strokeStyle));
+        });
+    }
+
+
     //
     // DrawRectangle
     //
@@ -1212,6 +1545,177 @@ public:
         });
     }
 
+
+    //
+    // FillRectangles
+    //
+
+    TEST_METHOD_EX(CanvasDrawingSession_FillRectanglesWithBrush)
+    {
+        TestFillRectangle(false,
+            [](CanvasDrawingSessionFixture const& f, Rect rect)
+        {
+            ThrowIfFailed(f.DS->FillRectanglesWithBrush(1, &rect, f.Brush.Get()));
+        });
+
+        // Null brush.
+        Assert::AreEqual(E_INVALIDARG, CanvasDrawingSessionFixture().DS->FillRectanglesWithBrush(0, nullptr, nullptr));
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_FillRectanglesWithColors)
+    {
+        TestFillRectangle(true,
+            [](CanvasDrawingSessionFixture const& f, Rect rect)
+        {
+            Rect rects[] = { rect, rect };
+            Color colors[] = { ArbitraryMarkerColor1, ArbitraryMarkerColor2 };
+
+            ThrowIfFailed(f.DS->FillRectanglesWithColors(2, rects, 2, colors));
+        });
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_FillRectanglesWithColors_ReusesBrushesForRepeatedColors)
+    {
+        CanvasDrawingSessionFixture f;
+
+        std::vector<ID2D1Brush*> createdBrushes;
+        std::vector<ID2D1Brush*> usedBrushes;
+
+        f.DeviceContext->CreateSolidColorBrushMethod.SetExpectedCalls(2,
+            [&](D2D1_COLOR_F const*, D2D1_BRUSH_PROPERTIES const*, ID2D1SolidColorBrush** value)
+            {
+                auto brush = Make<MockD2DSolidColorBrush>();
+                createdBrushes.push_back(brush.Get());
+                return brush.CopyTo(value);
+            });
+
+        f.DeviceContext->FillRectangleMethod.SetExpectedCalls(4,
+            [&](D2D1_RECT_F const*, ID2D1Brush* brush)
+            {
+                usedBrushes.push_back(brush);
+            });
+
+        Rect rects[4] = {};
+        Color colors[] = { ArbitraryMarkerColor1, ArbitraryMarkerColor2, ArbitraryMarkerColor1, ArbitraryMarkerColor2 };
+
+        ThrowIfFailed(f.DS->FillRectanglesWithColors(4, rects, 4, colors));
+
+        Assert::AreEqual(createdBrushes[0], usedBrushes[0]);
+        Assert::AreEqual(createdBrushes[1], usedBrushes[1]);
+        Assert::AreEqual(createdBrushes[0], usedBrushes[2]);
+        Assert::AreEqual(createdBrushes[1], usedBrushes[3]);
+
+        Assert::AreEqual(static_cast<uint64_t>(2), f.DS->GetSolidColorBrushPalette().GetHitCount());
+        Assert::AreEqual(static_cast<uint64_t>(2), f.DS->GetSolidColorBrushPalette().GetMissCount());
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_ColorBrushPalette_RecolorsLeastRecentlyUsedBrush)
+    {
+        CanvasDrawingSessionFixture f;
+
+        const uint32_t capacity = SolidColorBrushPalette::Capacity;
+
+        std::vector<ComPtr<MockD2DSolidColorBrush>> createdBrushes;
+
+        f.DeviceContext->CreateSolidColorBrushMethod.SetExpectedCalls(capacity,
+            [&](D2D1_COLOR_F const*, D2D1_BRUSH_PROPERTIES const*, ID2D1SolidColorBrush** value)
+            {
+                auto brush = Make<MockD2DSolidColorBrush>();
+                createdBrushes.push_back(brush);
+                return brush.CopyTo(value);
+            });
+
+        f.DeviceContext->FillRectangleMethod.AllowAnyCall();
+
+        // Fill the palette, then use the first color again so the second becomes the least recently used.
+        std::vector<Color> colors;
+
+        for (uint32_t i = 0; i < capacity; i++)
+        {
+            colors.push_back(Color{ 255, static_cast<uint8_t>(i), 0, 0 });
+        }
+
+        colors.push_back(colors[0]);
+
+        std::vector<Rect> rects(colors.size());
+
+        ThrowIfFailed(f.DS->FillRectanglesWithColors(static_cast<uint32_t>(rects.size()), rects.data(), static_cast<uint32_t>(colors.size()), colors.data()));
+
+        // One more color does not fit, so should recolor the brush that was created for colors[1].
+        Color newColor{ 255, 0, 255, 0 };
+        ID2D1Brush* usedBrush = nullptr;
+
+        createdBrushes[1]->MockSetColor =
+            [&](D2D1_COLOR_F const* color)
+            {
+                Assert::AreEqual(ToD2DColor(newColor), *color);
+            };
+
+        f.DeviceContext->FillRectangleMethod.SetExpectedCalls(1,
+            [&](D2D1_RECT_F const*, ID2D1Brush* brush)
+            {
+                usedBrush = brush;
+            });
+
+        ThrowIfFailed(f.DS->FillRectangleWithColor(Rect{}, newColor));
+
+        Assert::AreEqual(static_cast<ID2D1Brush*>(createdBrushes[1].Get()), usedBrush);
+
+        Assert::AreEqual(static_cast<uint64_t>(1), f.DS->GetSolidColorBrushPalette().GetHitCount());
+        Assert::AreEqual(static_cast<uint64_t>(capacity + 1), f.DS->GetSolidColorBrushPalette().GetMissCount());
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_ColorBrushPalette_IsReleasedOnClose)
+    {
+        CanvasDrawingSessionFixture f;
+
+        ComPtr<MockD2DSolidColorBrush> createdBrush;
+
+        f.DeviceContext->CreateSolidColorBrushMethod.SetExpectedCalls(1,
+            [&](D2D1_COLOR_F const*, D2D1_BRUSH_PROPERTIES const*, ID2D1SolidColorBrush** value)
+            {
+                createdBrush = Make<MockD2DSolidColorBrush>();
+                return createdBrush.CopyTo(value);
+            });
+
+        f.DeviceContext->FillRectangleMethod.AllowAnyCall();
+
+        ThrowIfFailed(f.DS->FillRectangleWithColor(Rect{}, ArbitraryMarkerColor1));
+
+        ThrowIfFailed(f.DS->Close());
+
+        // The session no longer holds the brush, but still remembers how the palette was used.
+        Assert::AreEqual(0ul, createdBrush.Reset());
+        Assert::AreEqual(static_cast<uint64_t>(1), f.DS->GetSolidColorBrushPalette().GetMissCount());
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_BatchedPrimitives_InvalidArrays)
+    {
+        CanvasDrawingSessionFixture f;
+
+        Vector2 points[2] = {};
+        Rect rects[2] = {};
+        float radii[2] = {};
+        Color colors[2] = {};
+
+        // Array lengths must match.
+        Assert::AreEqual(E_INVALIDARG, f.DS->DrawLinesWithBrush(2, points, 1, points, f.Brush.Get()));
+        Assert::AreEqual(E_INVALIDARG, f.DS->DrawLinesWithColors(2, points, 2, points, 1, colors));
+        Assert::AreEqual(E_INVALIDARG, f.DS->FillRectanglesWithColors(2, rects, 1, colors));
+        Assert::AreEqual(E_INVALIDARG, f.DS->FillCirclesWithBrush(2, points, 1, radii, f.Brush.Get()));
+        Assert::AreEqual(E_INVALIDARG, f.DS->FillCirclesWithColors(2, points, 2, radii, 1, colors));
+
+        // Null arrays are only valid when they are empty.
+        Assert::AreEqual(E_INVALIDARG, f.DS->DrawLinesWithBrush(1, nullptr, 1, points, f.Brush.Get()));
+        Assert::AreEqual(E_INVALIDARG, f.DS->FillRectanglesWithBrush(1, nullptr, f.Brush.Get()));
+        Assert::AreEqual(E_INVALIDARG, f.DS->FillRectanglesWithColors(1, rects, 1, nullptr));
+        Assert::AreEqual(E_INVALIDARG, f.DS->FillCirclesWithBrush(1, points, 1, nullptr, f.Brush.Get()));
+
+        ThrowIfFailed(f.DS->DrawLinesWithColors(0, nullptr, 0, nullptr, 0, nullptr));
+        ThrowIfFailed(f.DS->FillRectanglesWithColors(0, nullptr, 0, nullptr));
+        ThrowIfFailed(f.DS->FillCirclesWithColors(0, nullptr, 0, nullptr, 0, nullptr));
+    }
+
     class FillOpacityMaskFixture : public CanvasDrawingSessionFixture
     {
     public:
@@ -1236,6 +1740,9 @@ public:
 
             D2DBitmap->GetSizeMethod.AllowAnyCall([=] { return BitmapSize; });
 
+            SetWorldTransform(D2D1::Matrix3x2F::Identity());
+            SetDpi(DEFAULT_DPI, DEFAULT_DPI);
+
             D2DOpacityBrush->MockGetBitmap = [=](ID2D1Bitmap **bitmap)
             {
                 ThrowIfFailed(D2DBitmap.CopyTo(bitmap));
@@ -1265,6 +1772,17 @@ public:
             DeviceContext->GetUnitModeMethod.AllowAnyCall([=] { return mode; });
         }
 
+        void SetWorldTransform(D2D1_MATRIX_3X2_F worldTransform)
+        {
+            DeviceContext->GetTransformMethod.AllowAnyCall([=](D2D1_MATRIX_3X2_F* transform) { *transform = worldTransform; });
+        }
+
+        void SetDpi(float targetDpi, float bitmapDpi)
+        {
+            DeviceContext->GetDpiMethod.AllowAnyCall([=](float* dpiX, float* dpiY) { *dpiX = *dpiY = targetDpi; });
+            D2DBitmap->GetDpiMethod.AllowAnyCall([=](float* dpiX, float* dpiY) { *dpiX = *dpiY = bitmapDpi; return S_OK; });
+        }
+
         void SetOpacityBrushOpacity(float opacity)
         {
             D2DOpacityBrush->MockGetOpacity = [=] { return opacity; };
@@ -1461,15 +1979,76 @@ public:
         ThrowIfFailed(f.DS->FillRectangleWithBrushAndOpacityBrush(f.DestRect, f.Brush.Get(), f.OpacityBrush.Get()));
     }
 
-    TEST_METHOD_EX(CanvasDrawingSession_FillRectangleWithBrushAndOpacityBrush_WhenAntialiasEnabled_UsesLayerAndDrawRectangle)
+    TEST_METHOD_EX(CanvasDrawingSession_FillRectangleWithBrushAndOpacityBrush_WhenBrushInterpolationNotLinearButPixelAligned_UsesFillOpacityMask)
     {
         FillOpacityMaskFixture f;
 
-        f.SetAntialiasMode(D2D1_ANTIALIAS_MODE_PER_PRIMITIVE);
-
-        f.ExpectLayerAndFillRectangle();
+        f.SetOpacityBrushInterpolationMode(D2D1_INTERPOLATION_MODE_NEAREST_NEIGHBOR);
 
-        ThrowIfFailed(f.DS->FillRectangleWithBrushAndOpacityBrush(f.DestRect, f.Brush.Get(), f.OpacityBrush.Get()));
+        f.SetOpacityBrushTransform(
+            D2D1_MATRIX_3X2_F
+            { 
+                1, 0,
+                0, 1,
+                f.DestRect.X - 1, f.DestRect.Y - 2,
+            });
+
+        f.ExpectFillOpacityMask(D2D1_RECT_F{ 1, 2, 1 + f.DestRect.Width, 2 + f.DestRect.Height });
+
+        ThrowIfFailed(f.DS->FillRectangleWithBrushAndOpacityBrush(f.DestRect, f.Brush.Get(), f.OpacityBrush.Get()));
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_FillRectangleWithBrushAndOpacityBrush_WhenBrushInterpolationNotLinearAndResampled_UsesLayerAndDrawRectangle)
+    {
+        FillOpacityMaskFixture f;
+
+        f.SetOpacityBrushInterpolationMode(D2D1_INTERPOLATION_MODE_NEAREST_NEIGHBOR);
+
+        f.SetOpacityBrushTransform(
+            D2D1_MATRIX_3X2_F
+            { 
+                1, 0,
+                0, 1,
+                f.DestRect.X - 1, f.DestRect.Y - 2,
+            });
+
+        // Each of these stretches or offsets the bitmap relative to the target pixels.
+        std::function<void()> changes[] =
+        {
+            [&] { f.SetWorldTransform(D2D1::Matrix3x2F::Scale(2, 1)); },
+            [&] { f.SetWorldTransform(D2D1::Matrix3x2F::Translation(0.5f, 0)); },
+            [&] { f.SetDpi(DEFAULT_DPI * 2, DEFAULT_DPI); },
+        };
+
+        for (auto& change : changes)
+        {
+            change();
+
+            f.ExpectLayerAndFillRectangle();
+
+            ThrowIfFailed(f.DS->FillRectangleWithBrushAndOpacityBrush(f.DestRect, f.Brush.Get(), f.OpacityBrush.Get()));
+
+            f.SetWorldTransform(D2D1::Matrix3x2F::Identity());
+            f.SetDpi(DEFAULT_DPI, DEFAULT_DPI);
+        }
+
+        // Matching high DPI bitmap and target still line up.
+        f.SetDpi(DEFAULT_DPI * 2, DEFAULT_DPI * 2);
+
+        f.ExpectFillOpacityMask(D2D1_RECT_F{ 1, 2, 1 + f.DestRect.Width, 2 + f.DestRect.Height });
+
+        ThrowIfFailed(f.DS->FillRectangleWithBrushAndOpacityBrush(f.DestRect, f.Brush.Get(), f.OpacityBrush.Get()));
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_FillRectangleWithBrushAndOpacityBrush_WhenAntialiasEnabled_UsesLayerAndDrawRectangle)
+    {
+        FillOpacityMaskFixture f;
+
+        f.SetAntialiasMode(D2D1_ANTIALIAS_MODE_PER_PRIMITIVE);
+
+        f.ExpectLayerAndFillRectangle();
+
+        ThrowIfFailed(f.DS->FillRectangleWithBrushAndOpacityBrush(f.DestRect, f.Brush.Get(), f.OpacityBrush.Get()));
     }
 
     TEST_METHOD_EX(CanvasDrawingSession_FillRectangleWithBrushAndOpacityBrush_WhenOpacityNull_UsesDrawRectangle)
@@ -1491,6 +2070,37 @@ public:
     }
 
 
+    TEST_METHOD_EX(CanvasDrawingSession_FillGeometryWithBrushAndOpacityBrush_WhenGeometryIsRectangle_UsesFillOpacityMask)
+    {
+        FillOpacityMaskFixture f;
+
+        f.D2DBrush->MockGetExtendModeX = [] { return D2D1_EXTEND_MODE_WRAP; };
+        f.D2DBrush->MockGetExtendModeY = [] { return D2D1_EXTEND_MODE_WRAP; };
+
+        auto d2dGeometry = Make<MockD2DRectangleGeometry>();
+        d2dGeometry->GetRectMethod.AllowAnyCall([&](D2D1_RECT_F* rect) { *rect = ToD2DRect(f.DestRect); });
+
+        auto geometryManager = std::make_shared<CanvasGeometryManager>();
+        auto geometry = geometryManager->GetOrCreate(Make<StubCanvasDevice>().Get(), d2dGeometry.Get());
+
+        f.ExpectFillOpacityMask(D2D1_RECT_F{ 0, 0, f.BitmapSize.width, f.BitmapSize.height });
+
+        ThrowIfFailed(f.DS->FillGeometryAtOriginWithBrushAndOpacityBrush(geometry.Get(), f.Brush.Get(), f.OpacityBrush.Get()));
+
+        // When FillOpacityMask can't be used, this still falls back to a layer.
+        f.SetAntialiasMode(D2D1_ANTIALIAS_MODE_PER_PRIMITIVE);
+
+        f.DeviceContext->PushLayerMethod.SetExpectedCalls(1);
+        f.DeviceContext->FillGeometryMethod.SetExpectedCalls(1);
+        f.DeviceContext->PopLayerMethod.SetExpectedCalls(1);
+
+        ThrowIfFailed(f.DS->FillGeometryAtOriginWithBrushAndOpacityBrush(geometry.Get(), f.Brush.Get(), f.OpacityBrush.Get()));
+
+        Assert::AreEqual(1u, f.DS->GetStats().OpacityMaskFastPathFills);
+        Assert::AreEqual(1u, f.DS->GetStats().OpacityMaskLayerFallbacks);
+    }
+
+
     //
     // DrawRoundedRectangle
     //
@@ -2174,6 +2784,37 @@ public:
         });
     }
 
+
+    //
+    // FillCircles
+    //
+
+    TEST_METHOD_EX(CanvasDrawingSession_FillCirclesWithBrush)
+    {
+        TestFillEllipse(false, 23, 23,
+            [](CanvasDrawingSessionFixture const& f, Vector2 point)
+        {
+            float radius = 23;
+            ThrowIfFailed(f.DS->FillCirclesWithBrush(1, &point, 1, &radius, f.Brush.Get()));
+        });
+
+        // Null brush.
+        Assert::AreEqual(E_INVALIDARG, CanvasDrawingSessionFixture().DS->FillCirclesWithBrush(0, nullptr, 0, nullptr, nullptr));
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_FillCirclesWithColors)
+    {
+        TestFillEllipse(true, 23, 23,
+            [](CanvasDrawingSessionFixture const& f, Vector2 point)
+        {
+            Vector2 centerPoints[] = { point, point };
+            float radii[] = { 23, 23 };
+            Color colors[] = { ArbitraryMarkerColor1, ArbitraryMarkerColor2 };
+
+            ThrowIfFailed(f.DS->FillCirclesWithColors(2, centerPoints, 2, radii, 2, colors));
+        });
+    }
+
     //
     // DrawGeometry
     //
@@ -2208,7 +2849,8 @@ public:
 
         void ExpectTemporaryTranslation(int expectedDrawCount)
         {
-            DeviceContext->GetTransformMethod.SetExpectedCalls(expectedDrawCount,
+            // The drawing session caches the transform, so only reads it from the device context once.
+            DeviceContext->GetTransformMethod.SetExpectedCalls(1,
                 [&](D2D1_MATRIX_3X2_F* transform)
                 {
                     *transform = InitialTransform;
@@ -2728,6 +3370,10 @@ public:
             [&](FillGeometryWithOpacityBrushFixture const& f, CanvasGeometry* geometry)
             {
                 ThrowIfFailed(f.DS->FillGeometryAtOriginWithBrushAndOpacityBrush(geometry, f.Brush.Get(), f.OpacityBrush.Get()));
+
+                // D2D applies the opacity brush itself when the color brush is a clamped bitmap.
+                Assert::AreEqual(1u, f.DS->GetStats().OpacityMaskFastPathFills);
+                Assert::AreEqual(0u, f.DS->GetStats().OpacityMaskLayerFallbacks);
             });
 
         // Null opacity brush.
@@ -2735,6 +3381,8 @@ public:
             [](CanvasDrawingSessionFixture const& f, CanvasGeometry* geometry)
             {
                 ThrowIfFailed(f.DS->FillGeometryAtOriginWithBrushAndOpacityBrush(geometry, f.Brush.Get(), nullptr));
+
+                Assert::AreEqual(0u, f.DS->GetStats().OpacityMaskFastPathFills);
             });
 
         // Null brush or geometry.
@@ -2948,6 +3596,8 @@ public:
         Assert::AreEqual(E_INVALIDARG, f.DS->get_TextAntialiasing(nullptr));
         Assert::AreEqual(E_INVALIDARG, f.DS->get_Transform(nullptr));
         Assert::AreEqual(E_INVALIDARG, f.DS->get_Units(nullptr));
+        Assert::AreEqual(E_INVALIDARG, f.DS->get_IsCullingEnabled(nullptr));
+        Assert::AreEqual(E_INVALIDARG, f.DS->get_IsTextLayoutCacheEnabled(nullptr));
     }
     
     //
@@ -3151,6 +3801,324 @@ public:
         }
     }
 
+    TEST_METHOD_EX(CanvasDrawingSession_StateProperties_RedundantChangesAreSkipped)
+    {
+        CanvasDrawingSessionFixture f;
+
+        f.DeviceContext->SetAntialiasModeMethod.SetExpectedCalls(2);
+        f.DeviceContext->SetPrimitiveBlendMethod.SetExpectedCalls(1);
+        f.DeviceContext->SetTextAntialiasModeMethod.SetExpectedCalls(1);
+        f.DeviceContext->SetTransformMethod.SetExpectedCalls(1);
+        f.DeviceContext->SetUnitModeMethod.SetExpectedCalls(1);
+
+        for (int i = 0; i < 3; i++)
+        {
+            ThrowIfFailed(f.DS->put_Antialiasing(CanvasAntialiasing_Aliased));
+            ThrowIfFailed(f.DS->put_Blend(CanvasBlend_Copy));
+            ThrowIfFailed(f.DS->put_TextAntialiasing(CanvasTextAntialiasing_Grayscale));
+            ThrowIfFailed(f.DS->put_Transform(Numerics::Matrix3x2{ 1, 2, 3, 4, 5, 6 }));
+            ThrowIfFailed(f.DS->put_Units(CanvasUnits_Pixels));
+        }
+
+        // A value read back from the device context replaces the cached one.
+        f.DeviceContext->GetAntialiasModeMethod.SetExpectedCalls(1,
+            [] { return D2D1_ANTIALIAS_MODE_PER_PRIMITIVE; });
+
+        CanvasAntialiasing antialiasMode;
+        ThrowIfFailed(f.DS->get_Antialiasing(&antialiasMode));
+
+        ThrowIfFailed(f.DS->put_Antialiasing(CanvasAntialiasing_Antialiased));
+        ThrowIfFailed(f.DS->put_Antialiasing(CanvasAntialiasing_Aliased));
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_StateCacheIsDisabledOnceNativeCodeHasTheDeviceContext)
+    {
+        CanvasDrawingSessionFixture f;
+
+        f.DeviceContext->SetPrimitiveBlendMethod.AllowAnyCall();
+        ThrowIfFailed(f.DS->put_Blend(CanvasBlend_Copy));
+
+        GetWrappedResource<ID2D1DeviceContext1>(f.DS);
+
+        // Native code could have changed the blend, so setting it again must not be skipped.
+        f.DeviceContext->SetPrimitiveBlendMethod.SetExpectedCalls(2);
+
+        ThrowIfFailed(f.DS->put_Blend(CanvasBlend_Copy));
+        ThrowIfFailed(f.DS->put_Blend(CanvasBlend_Copy));
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_Stats)
+    {
+        auto deviceContext = Make<StubD2DDeviceContextWithGetFactory>();
+        auto brush = Make<StubCanvasBrush>();
+
+        auto manager = std::make_shared<CanvasDrawingSessionManager>();
+        auto drawingSession = manager->Create(deviceContext.Get(), std::make_shared<StubCanvasDrawingSessionAdapter>());
+
+        deviceContext->FillRectangleMethod.AllowAnyCall();
+        deviceContext->DrawLineMethod.AllowAnyCall();
+        deviceContext->SetPrimitiveBlendMethod.AllowAnyCall();
+
+        ThrowIfFailed(drawingSession->FillRectangleWithBrush(Rect{}, brush.Get()));
+        ThrowIfFailed(drawingSession->FillRectangleWithColor(Rect{}, ArbitraryMarkerColor1));
+        ThrowIfFailed(drawingSession->FillRectangleWithColor(Rect{}, ArbitraryMarkerColor1));
+
+        Vector2 points[3] = {};
+        ThrowIfFailed(drawingSession->DrawLinesWithBrush(3, points, 3, points, brush.Get()));
+
+        ThrowIfFailed(drawingSession->put_Blend(CanvasBlend_Copy));
+        ThrowIfFailed(drawingSession->put_Blend(CanvasBlend_Copy));
+
+        int handlerCallCount = 0;
+
+        manager->SetStatsHandler(
+            [&](CanvasDrawingSessionStats const& stats)
+            {
+                handlerCallCount++;
+
+                Assert::AreEqual(3u, stats.RectangleFills);
+                Assert::AreEqual(3u, stats.LineDraws);
+                Assert::AreEqual(0u, stats.EllipseFills);
+                Assert::AreEqual(2u, stats.BrushesRealized);
+                Assert::AreEqual(static_cast<uint64_t>(1), stats.ColorBrushPaletteHits);
+                Assert::AreEqual(static_cast<uint64_t>(1), stats.ColorBrushPaletteMisses);
+                Assert::AreEqual(1u, stats.StateChanges);
+                Assert::AreEqual(1u, stats.RedundantStateChangesSkipped);
+            });
+
+        // The stats are reported once, when the session is closed.
+        ThrowIfFailed(drawingSession->Close());
+        ThrowIfFailed(drawingSession->Close());
+
+        Assert::AreEqual(1, handlerCallCount);
+        Assert::AreEqual(3u, drawingSession->GetStats().RectangleFills);
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_Stats_AreAvailableThroughICanvasDrawingSessionStatsNative)
+    {
+        CanvasDrawingSessionFixture f;
+
+        f.DeviceContext->ClearMethod.AllowAnyCall();
+
+        ThrowIfFailed(f.DS->Clear(ArbitraryMarkerColor1));
+
+        auto statsNative = As<ICanvasDrawingSessionStatsNative>(f.DS);
+
+        Assert::AreEqual(E_INVALIDARG, statsNative->GetStats(nullptr));
+
+        CanvasDrawingSessionStats stats{};
+        stats.Size = sizeof(stats);
+        ThrowIfFailed(statsNative->GetStats(&stats));
+        Assert::AreEqual(static_cast<uint32_t>(sizeof(stats)), stats.Size);
+        Assert::AreEqual(1u, stats.Clears);
+        Assert::AreEqual(0u, stats.LineDraws);
+
+        // The final counts can still be read once the session is closed.
+        ThrowIfFailed(f.DS->Clear(ArbitraryMarkerColor1));
+        ThrowIfFailed(f.DS->Close());
+
+        ThrowIfFailed(statsNative->GetStats(&stats));
+        Assert::AreEqual(2u, stats.Clears);
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_Stats_WhenSizeIsTooSmall_ReturnsInvalidArg)
+    {
+        CanvasDrawingSessionFixture f;
+
+        auto statsNative = As<ICanvasDrawingSessionStatsNative>(f.DS);
+
+        CanvasDrawingSessionStats stats{};
+        Assert::AreEqual(E_INVALIDARG, statsNative->GetStats(&stats));
+
+        stats.Size = sizeof(stats) - 1;
+        Assert::AreEqual(E_INVALIDARG, statsNative->GetStats(&stats));
+        Assert::AreEqual(0u, stats.Clears);
+    }
+
+    static void SetCullingTarget(StubD2DDeviceContextWithGetFactory* deviceContext, uint32_t width, uint32_t height)
+    {
+        auto targetBitmap = Make<MockD2DBitmap>();
+
+        targetBitmap->GetPixelSizeMethod.AllowAnyCall(
+            [=] { return D2D1_SIZE_U{ width, height }; });
+
+        deviceContext->GetTargetMethod.AllowAnyCall(
+            [=](ID2D1Image** value) { ThrowIfFailed(targetBitmap.CopyTo(value)); });
+
+        deviceContext->GetUnitModeMethod.AllowAnyCall(
+            [] { return D2D1_UNIT_MODE_DIPS; });
+
+        deviceContext->GetDpiMethod.AllowAnyCall(
+            [](float* dpiX, float* dpiY) { *dpiX = *dpiY = DEFAULT_DPI * 2; });
+
+        deviceContext->GetTransformMethod.AllowAnyCall(
+            [](D2D1_MATRIX_3X2_F* transform) { *transform = D2D1::Matrix3x2F::Identity(); });
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_IsCullingEnabled_DefaultsToFalse)
+    {
+        CanvasDrawingSessionFixture f;
+
+        boolean isCullingEnabled;
+        ThrowIfFailed(f.DS->get_IsCullingEnabled(&isCullingEnabled));
+        Assert::IsFalse(!!isCullingEnabled);
+
+        // With culling disabled, even offscreen draws reach D2D without querying the target.
+        f.DeviceContext->FillRectangleMethod.SetExpectedCalls(1);
+
+        ThrowIfFailed(f.DS->FillRectangleWithBrush(Rect{ -1000, -1000, 10, 10 }, f.Brush.Get()));
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_Culling_SkipsDrawsOutsideTheTarget)
+    {
+        CanvasDrawingSessionFixture f;
+
+        // 200x100 pixels at 192 DPI is 100x50 DIPs.
+        SetCullingTarget(f.DeviceContext.Get(), 200, 100);
+
+        ThrowIfFailed(f.DS->put_IsCullingEnabled(true));
+
+        boolean isCullingEnabled;
+        ThrowIfFailed(f.DS->get_IsCullingEnabled(&isCullingEnabled));
+        Assert::IsTrue(!!isCullingEnabled);
+
+        f.DeviceContext->FillRectangleMethod.SetExpectedCalls(2);
+
+        ThrowIfFailed(f.DS->FillRectangleWithBrush(Rect{ 10, 10, 10, 10 }, f.Brush.Get()));     // Inside
+        ThrowIfFailed(f.DS->FillRectangleWithBrush(Rect{ 95, 45, 10, 10 }, f.Brush.Get()));     // Partially inside
+        ThrowIfFailed(f.DS->FillRectangleWithBrush(Rect{ 120, 10, 10, 10 }, f.Brush.Get()));    // Right of the target
+        ThrowIfFailed(f.DS->FillRectangleWithBrush(Rect{ 10, -30, 10, 10 }, f.Brush.Get()));    // Above the target
+
+        // Wide strokes can reach back into the target.
+        f.DeviceContext->DrawLineMethod.SetExpectedCalls(1);
+
+        ThrowIfFailed(f.DS->DrawLineWithBrushAndStrokeWidth(Vector2{ -20, 10 }, Vector2{ -20, 20 }, f.Brush.Get(), 50));
+        ThrowIfFailed(f.DS->DrawLineWithBrushAndStrokeWidth(Vector2{ -20, 10 }, Vector2{ -20, 20 }, f.Brush.Get(), 5));
+
+        // NaN coordinates are never culled.
+        f.DeviceContext->FillEllipseMethod.SetExpectedCalls(1);
+
+        ThrowIfFailed(f.DS->FillCircleWithBrush(Vector2{ std::numeric_limits<float>::quiet_NaN(), 10 }, 5, f.Brush.Get()));
+
+        Assert::AreEqual(3u, f.DS->GetStats().CulledDraws);
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_Culling_FixedStrokesAreNotScaledByTheTransform)
+    {
+        CanvasDrawingSessionFixture f;
+
+        SetCullingTarget(f.DeviceContext.Get(), 200, 100);
+
+        f.DeviceContext->GetTransformMethod.AllowAnyCall(
+            [](D2D1_MATRIX_3X2_F* transform) { *transform = D2D1::Matrix3x2F::Scale(0.1f, 0.1f); });
+
+        ThrowIfFailed(f.DS->put_IsCullingEnabled(true));
+
+        auto strokeStyle = Make<CanvasStrokeStyle>();
+        ThrowIfFailed(strokeStyle->put_TransformBehavior(CanvasStrokeTransformBehavior::Fixed));
+
+        // This line is 8 DIPs left of the target, but its stroke is 20 DIPs
+        // wide, however much the transform scales it down.
+        f.DeviceContext->DrawLineMethod.SetExpectedCalls(1);
+
+        ThrowIfFailed(f.DS->DrawLineWithBrushAndStrokeWidthAndStrokeStyle(Vector2{ -80, 10 }, Vector2{ -80, 20 }, f.Brush.Get(), 20, strokeStyle.Get()));
+        ThrowIfFailed(f.DS->DrawLineWithBrushAndStrokeWidthAndStrokeStyle(Vector2{ -300, 10 }, Vector2{ -300, 20 }, f.Brush.Get(), 20, strokeStyle.Get()));
+
+        Assert::AreEqual(1u, f.DS->GetStats().CulledDraws);
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_Culling_HairlineStrokesAreAlwaysOnePixelWide)
+    {
+        CanvasDrawingSessionFixture f;
+
+        SetCullingTarget(f.DeviceContext.Get(), 200, 100);
+
+        // At 24 DPI, a pixel is 4 DIPs.
+        f.DeviceContext->GetDpiMethod.AllowAnyCall(
+            [](float* dpiX, float* dpiY) { *dpiX = *dpiY = DEFAULT_DPI / 4; });
+
+        f.DeviceContext->GetTransformMethod.AllowAnyCall(
+            [](D2D1_MATRIX_3X2_F* transform) { *transform = D2D1::Matrix3x2F::Scale(0.1f, 0.1f); });
+
+        ThrowIfFailed(f.DS->put_IsCullingEnabled(true));
+
+        auto strokeStyle = Make<CanvasStrokeStyle>();
+        ThrowIfFailed(strokeStyle->put_TransformBehavior(CanvasStrokeTransformBehavior::Hairline));
+
+        // This line is 1.5 DIPs left of the target, which is less than half
+        // of the pixel wide hairline.
+        f.DeviceContext->DrawLineMethod.SetExpectedCalls(1);
+
+        ThrowIfFailed(f.DS->DrawLineWithBrushAndStrokeWidthAndStrokeStyle(Vector2{ -15, 10 }, Vector2{ -15, 20 }, f.Brush.Get(), 1, strokeStyle.Get()));
+        ThrowIfFailed(f.DS->DrawLineWithBrushAndStrokeWidthAndStrokeStyle(Vector2{ -300, 10 }, Vector2{ -300, 20 }, f.Brush.Get(), 1, strokeStyle.Get()));
+
+        Assert::AreEqual(1u, f.DS->GetStats().CulledDraws);
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_Culling_SkipsDrawsOutsideTheLayerClip)
+    {
+        CanvasDrawingSessionFixture f;
+
+        SetCullingTarget(f.DeviceContext.Get(), 200, 100);
+
+        ThrowIfFailed(f.DS->put_IsCullingEnabled(true));
+
+        f.DeviceContext->GetAntialiasModeMethod.AllowAnyCall();
+        f.DeviceContext->PushAxisAlignedClipMethod.SetExpectedCalls(1);
+        f.DeviceContext->PopAxisAlignedClipMethod.SetExpectedCalls(1);
+
+        ComPtr<ICanvasActiveLayer> layer;
+        ThrowIfFailed(f.DS->CreateLayerWithOpacityAndClipRectangle(1, Rect{ 0, 0, 20, 20 }, &layer));
+
+        f.DeviceContext->FillRectangleMethod.SetExpectedCalls(1);
+
+        ThrowIfFailed(f.DS->FillRectangleWithBrush(Rect{ 10, 10, 5, 5 }, f.Brush.Get()));
+        ThrowIfFailed(f.DS->FillRectangleWithBrush(Rect{ 50, 10, 5, 5 }, f.Brush.Get()));
+
+        ThrowIfFailed(As<IClosable>(layer)->Close());
+
+        // Once the layer is closed, the same rectangle is visible again.
+        f.DeviceContext->FillRectangleMethod.SetExpectedCalls(1);
+
+        ThrowIfFailed(f.DS->FillRectangleWithBrush(Rect{ 50, 10, 5, 5 }, f.Brush.Get()));
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_Culling_WhenUnitsChangeInsideALayer_DoesNotUseStaleClipBounds)
+    {
+        D2D1_UNIT_MODE unitMode = D2D1_UNIT_MODE_DIPS;
+
+        CanvasDrawingSessionFixture f;
+
+        SetCullingTarget(f.DeviceContext.Get(), 200, 100);
+
+        f.DeviceContext->GetUnitModeMethod.AllowAnyCall([&] { return unitMode; });
+        f.DeviceContext->SetUnitModeMethod.AllowAnyCall([&](D2D1_UNIT_MODE value) { unitMode = value; });
+
+        ThrowIfFailed(f.DS->put_IsCullingEnabled(true));
+
+        f.DeviceContext->GetAntialiasModeMethod.AllowAnyCall();
+        f.DeviceContext->PushAxisAlignedClipMethod.SetExpectedCalls(1);
+        f.DeviceContext->PopAxisAlignedClipMethod.SetExpectedCalls(1);
+
+        // At 192 DPI this clip is 40x40 pixels.
+        ComPtr<ICanvasActiveLayer> layer;
+        ThrowIfFailed(f.DS->CreateLayerWithOpacityAndClipRectangle(1, Rect{ 0, 0, 20, 20 }, &layer));
+
+        ThrowIfFailed(f.DS->put_Units(CanvasUnits_Pixels));
+
+        // Inside the clip when measured in pixels, so this must not be culled.
+        f.DeviceContext->FillRectangleMethod.SetExpectedCalls(1);
+
+        ThrowIfFailed(f.DS->FillRectangleWithBrush(Rect{ 30, 30, 5, 5 }, f.Brush.Get()));
+
+        // Draws outside the target, which is 200x100 pixels, are still culled.
+        ThrowIfFailed(f.DS->FillRectangleWithBrush(Rect{ 250, 10, 5, 5 }, f.Brush.Get()));
+
+        Assert::AreEqual(1u, f.DS->GetStats().CulledDraws);
+
+        ThrowIfFailed(As<IClosable>(layer)->Close());
+    }
+
     TEST_METHOD_EX(CanvasDrawingSession_SiSOffsetIsHiddenFromTransformProperty)
     {
         auto deviceContext = Make<StubD2DDeviceContextWithGetFactory>();
@@ -3570,6 +4538,161 @@ TEST_CLASS(CanvasDrawingSession_DrawTextTests)
             ThrowIfFailed(f.DS->DrawTextAtRectCoordsWithColorAndFormat(text, 1, 2, 3, 4, ArbitraryMarkerColor2, nullptr));
         });
     }
+
+    TEST_METHOD_EX(CanvasDrawingSession_DrawTextAtPoint_DoesNotModifyTheTextFormat)
+    {
+        Fixture f;
+
+        ThrowIfFailed(f.Format->put_WordWrapping(CanvasWordWrapping::WholeWord));
+
+        ThrowIfFailed(f.Format->put_FontSize(30));
+
+        auto formatInternal = As<ICanvasTextFormatInternal>(f.Format);
+        auto realizedFormat = formatInternal->GetRealizedTextFormat();
+
+        std::vector<IDWriteTextFormat*> formats;
+
+        f.Expect(2, L"text", D2D1_RECT_F{ 1, 2, 1, 2 }, D2D1_DRAW_TEXT_OPTIONS_NONE,
+            [&](IDWriteTextFormat* format, ID2D1Brush*)
+            {
+                Assert::AreEqual(DWRITE_WORD_WRAPPING_NO_WRAP, format->GetWordWrapping());
+                Assert::AreEqual(30.0f, format->GetFontSize());
+                formats.push_back(format);
+            });
+
+        ThrowIfFailed(f.DS->DrawTextAtPointWithBrushAndFormat(WinString(L"text"), Vector2{ 1, 2 }, f.Brush.Get(), f.Format.Get()));
+        ThrowIfFailed(f.DS->DrawTextAtPointWithBrushAndFormat(WinString(L"text"), Vector2{ 1, 2 }, f.Brush.Get(), f.Format.Get()));
+
+        // The NoWrap copy is created once and reused.
+        Assert::IsTrue(formats[0] == formats[1]);
+        Assert::IsTrue(formats[0] != realizedFormat.Get());
+
+        // The caller's format was not touched.
+        CanvasWordWrapping wordWrapping;
+        ThrowIfFailed(f.Format->get_WordWrapping(&wordWrapping));
+        Assert::AreEqual(CanvasWordWrapping::WholeWord, wordWrapping);
+        Assert::IsTrue(realizedFormat == formatInternal->GetRealizedTextFormat());
+        Assert::AreEqual(DWRITE_WORD_WRAPPING_WHOLE_WORD, realizedFormat->GetWordWrapping());
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_TextLayoutCache_ReusesLayoutsForRepeatedText)
+    {
+        Fixture f;
+
+        boolean isEnabled;
+        ThrowIfFailed(f.DS->get_IsTextLayoutCacheEnabled(&isEnabled));
+        Assert::IsFalse(!!isEnabled);
+
+        ThrowIfFailed(f.DS->put_IsTextLayoutCacheEnabled(true));
+        ThrowIfFailed(f.Format->put_Options(CanvasDrawTextOptions::Clip));
+
+        std::vector<IDWriteTextLayout*> layouts;
+
+        f.DeviceContext->DrawTextLayoutMethod.SetExpectedCalls(4,
+            [&](D2D1_POINT_2F point, IDWriteTextLayout* layout, ID2D1Brush*, D2D1_DRAW_TEXT_OPTIONS options)
+            {
+                Assert::AreEqual(D2D1::Point2F(1, 2), point);
+                Assert::AreEqual(3.0f, layout->GetMaxWidth());
+                Assert::AreEqual(4.0f, layout->GetMaxHeight());
+                Assert::AreEqual(D2D1_DRAW_TEXT_OPTIONS_CLIP, options);
+
+                layouts.push_back(layout);
+            });
+
+        WinString text(L"label");
+
+        ThrowIfFailed(f.DS->DrawTextAtRectWithBrushAndFormat(text, Rect{ 1, 2, 3, 4 }, f.Brush.Get(), f.Format.Get()));
+        ThrowIfFailed(f.DS->DrawTextAtRectWithBrushAndFormat(text, Rect{ 1, 2, 3, 4 }, f.Brush.Get(), f.Format.Get()));
+
+        // Changing the format, even in a way that does not recreate the
+        // IDWriteTextFormat, must not reuse the old layout.
+        ThrowIfFailed(f.Format->put_ParagraphAlignment(ABI::Windows::UI::Text::ParagraphAlignment_Center));
+
+        ThrowIfFailed(f.DS->DrawTextAtRectWithBrushAndFormat(text, Rect{ 1, 2, 3, 4 }, f.Brush.Get(), f.Format.Get()));
+        ThrowIfFailed(f.DS->DrawTextAtRectWithBrushAndFormat(WinString(L"other"), Rect{ 1, 2, 3, 4 }, f.Brush.Get(), f.Format.Get()));
+
+        Assert::IsTrue(layouts[0] == layouts[1]);
+        Assert::IsTrue(layouts[1] != layouts[2]);
+        Assert::IsTrue(layouts[2] != layouts[3]);
+        Assert::AreEqual(DWRITE_TEXT_ALIGNMENT_CENTER, layouts[2]->GetTextAlignment());
+
+        auto stats = f.DS->GetStats();
+        Assert::AreEqual(1u, stats.TextLayoutCacheHits);
+        Assert::AreEqual(3u, stats.TextLayoutCacheMisses);
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_TextLayoutCache_FallsBackToDrawTextForLongStrings)
+    {
+        Fixture f;
+
+        ThrowIfFailed(f.DS->put_IsTextLayoutCacheEnabled(true));
+
+        std::wstring longText(TextLayoutCache::MaxTextLength + 1, L'x');
+
+        f.Expect(1, longText, D2D1_RECT_F{ 1, 2, 4, 6 }, D2D1_DRAW_TEXT_OPTIONS_NONE, [](IDWriteTextFormat*, ID2D1Brush*) {});
+
+        ThrowIfFailed(f.DS->DrawTextAtRectWithBrushAndFormat(WinString(longText), Rect{ 1, 2, 3, 4 }, f.Brush.Get(), f.Format.Get()));
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_TextLayoutCache_EvictsLeastRecentlyUsedLayout)
+    {
+        Fixture f;
+
+        ThrowIfFailed(f.DS->put_IsTextLayoutCacheEnabled(true));
+
+        f.DeviceContext->DrawTextLayoutMethod.AllowAnyCall();
+
+        auto draw = [&](size_t i)
+        {
+            ThrowIfFailed(f.DS->DrawTextAtRectWithBrushAndFormat(WinString(std::to_wstring(i)), Rect{ 0, 0, 10, 10 }, f.Brush.Get(), f.Format.Get()));
+        };
+
+        for (size_t i = 0; i <= TextLayoutCache::Capacity; i++)
+        {
+            draw(i);
+        }
+
+        // 0 was evicted to make room for the last string, so drawing it is a miss, which evicts 1.
+        draw(0);
+        draw(2);
+
+        auto stats = f.DS->GetStats();
+        Assert::AreEqual(1u, stats.TextLayoutCacheHits);
+        Assert::AreEqual(static_cast<uint32_t>(TextLayoutCache::Capacity + 2), stats.TextLayoutCacheMisses);
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_TextLayoutCache_DoesNotHoldItsLockWhileDrawing)
+    {
+        Fixture f;
+
+        ThrowIfFailed(f.DS->put_IsTextLayoutCacheEnabled(true));
+
+        WinString text(L"label");
+
+        f.DeviceContext->DrawTextLayoutMethod.SetExpectedCalls(1);
+
+        ThrowIfFailed(f.DS->DrawTextAtRectWithBrushAndFormat(text, Rect{ 1, 2, 3, 4 }, f.Brush.Get(), f.Format.Get()));
+
+        // Drawing while the cached layout is being drawn (as another thread
+        // could) must not deadlock. A layout is only drawn by one caller at a
+        // time, so the nested draw of the same text falls back to DrawText.
+        f.DeviceContext->DrawTextMethod.SetExpectedCalls(1);
+        f.DeviceContext->DrawTextLayoutMethod.SetExpectedCalls(2,
+            [&](D2D1_POINT_2F, IDWriteTextLayout*, ID2D1Brush*, D2D1_DRAW_TEXT_OPTIONS)
+            {
+                if (f.DeviceContext->DrawTextMethod.GetCurrentCallCount() == 0)
+                {
+                    ThrowIfFailed(f.DS->DrawTextAtRectWithBrushAndFormat(text, Rect{ 1, 2, 3, 4 }, f.Brush.Get(), f.Format.Get()));
+                    ThrowIfFailed(f.DS->DrawTextAtRectWithBrushAndFormat(WinString(L"other"), Rect{ 1, 2, 3, 4 }, f.Brush.Get(), f.Format.Get()));
+                }
+            });
+
+        ThrowIfFailed(f.DS->DrawTextAtRectWithBrushAndFormat(text, Rect{ 1, 2, 3, 4 }, f.Brush.Get(), f.Format.Get()));
+
+        auto stats = f.DS->GetStats();
+        Assert::AreEqual(1u, stats.TextLayoutCacheHits);
+        Assert::AreEqual(2u, stats.TextLayoutCacheMisses);
+    }
 };
 
 TEST_CLASS(CanvasDrawingSession_CloseTests)
@@ -3755,6 +4878,10 @@ TEST_CLASS(CanvasDrawingSession_CloseTests)
         EXPECT_OBJECT_CLOSED(canvasDrawingSession->put_Transform(Numerics::Matrix3x2()));
         EXPECT_OBJECT_CLOSED(canvasDrawingSession->get_Units(nullptr));
         EXPECT_OBJECT_CLOSED(canvasDrawingSession->put_Units(CanvasUnits::Dips));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->get_IsCullingEnabled(nullptr));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->put_IsCullingEnabled(true));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->get_IsTextLayoutCacheEnabled(nullptr));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->put_IsTextLayoutCacheEnabled(true));
         EXPECT_OBJECT_CLOSED(canvasDrawingSession->get_Device(&deviceVerify));
 
 
@@ -3766,6 +4893,7 @@ TEST_CLASS(CanvasDrawingSession_CloseTests)
         CanvasDrawingSessionFixture f;
 
         ASSERT_IMPLEMENTS_INTERFACE(f.DS, ICanvasResourceCreator);
+        ASSERT_IMPLEMENTS_INTERFACE(f.DS, ICanvasDrawingSessionStatsNative);
     }
 
     TEST_METHOD_EX(CanvasDrawingSession_get_Device_NullArg)
@@ -3840,7 +4968,7 @@ TEST_CLASS(CanvasDrawingSession_CreateLayerTests)
 
                     Assert::AreEqual(expectedOptions, (CanvasLayerOptions)parameters->layerOptions);
                     Assert::AreEqual(D2D1_ANTIALIAS_MODE_PER_PRIMITIVE, parameters->maskAntialiasMode);
-                    Assert::IsNull(layer);
+                    Assert::IsNotNull(layer);
                 });
         }
 
@@ -3852,6 +4980,25 @@ TEST_CLASS(CanvasDrawingSession_CreateLayerTests)
                     *transform = returnValue;
                 });
         }
+
+        ComPtr<ICanvasGeometry> MakeRectangleClipGeometry(D2D1_RECT_F rect)
+        {
+            auto d2dGeometry = Make<MockD2DRectangleGeometry>();
+
+            d2dGeometry->GetRectMethod.AllowAnyCall(
+                [=](D2D1_RECT_F* value)
+                {
+                    *value = rect;
+                });
+
+            return WrapClipGeometry(d2dGeometry.Get());
+        }
+
+        ComPtr<ICanvasGeometry> WrapClipGeometry(ID2D1Geometry* d2dGeometry)
+        {
+            auto geometryManager = std::make_shared<CanvasGeometryManager>();
+            return geometryManager->GetOrCreate(Make<StubCanvasDevice>().Get(), d2dGeometry);
+        }
     };
 
     TEST_METHOD_EX(CanvasDrawingSession_CreateLayerWithOpacity)
@@ -4026,6 +5173,30 @@ TEST_CLASS(CanvasDrawingSession_CreateLayerTests)
         ValidateStoredErrorState(E_FAIL, Strings::DidNotPopLayer);
     }
 
+    TEST_METHOD_EX(CanvasDrawingSession_CreateLayer_WhenLayerNotClosed_StatsAreStillReported)
+    {
+        Fixture f;
+        f.DeviceContext->PushLayerMethod.AllowAnyCall();
+
+        int handlerCallCount = 0;
+        f.DS->Manager()->SetStatsHandler(
+            [&](CanvasDrawingSessionStats const& stats)
+            {
+                handlerCallCount++;
+                Assert::AreEqual(1u, stats.LayersPushed);
+            });
+
+        ComPtr<ICanvasActiveLayer> activeLayer;
+        ThrowIfFailed(f.DS->CreateLayerWithOpacity(1.0f, &activeLayer));
+
+        Assert::AreEqual(E_FAIL, As<IClosable>(f.DS)->Close());
+        Assert::AreEqual(1, handlerCallCount);
+
+        // They are only reported once, however many times Close fails.
+        Assert::AreEqual(E_FAIL, As<IClosable>(f.DS)->Close());
+        Assert::AreEqual(1, handlerCallCount);
+    }
+
     TEST_METHOD_EX(CanvasDrawingSession_CreateLayer_WhenClipRectTransformIsScaleAndTranslate_UsesAxisAlignedClip)
     {
         Fixture f;
@@ -4077,6 +5248,119 @@ TEST_CLASS(CanvasDrawingSession_CreateLayerTests)
         ThrowIfFailed(f.DS->CreateLayerWithOpacityAndClipRectangle(1.0f, Rect{ 1, 2, 3, 4 }, &activeLayer));
     }
 
+    TEST_METHOD_EX(CanvasDrawingSession_CreateLayer_WhenClipGeometryIsRectangle_UsesAxisAlignedClip)
+    {
+        Fixture f;
+
+        auto clipGeometry = f.MakeRectangleClipGeometry(D2D1_RECT_F{ 1, 2, 4, 6 });
+
+        f.ExpectOneGetTransform(D2D1_MATRIX_3X2_F{ 2, 0, 0, 3, 4, 5 });
+
+        f.DeviceContext->PushAxisAlignedClipMethod.SetExpectedCalls(1,
+            [=](D2D1_RECT_F const* clipRect, D2D1_ANTIALIAS_MODE)
+            {
+                // The geometry transform is applied to the rectangle, but the device context transform is not.
+                Assert::AreEqual(D2D1_RECT_F{ -8, 26, -2, 38 }, *clipRect);
+            });
+
+        ComPtr<ICanvasActiveLayer> activeLayer;
+        ThrowIfFailed(f.DS->CreateLayerWithOpacityAndClipGeometryAndTransform(1.0f, clipGeometry.Get(), Matrix3x2{ -2, 0, 0, 3, 0, 20 }, &activeLayer));
+
+        f.DeviceContext->PopAxisAlignedClipMethod.SetExpectedCalls(1);
+        ThrowIfFailed(As<IClosable>(activeLayer)->Close());
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_CreateLayer_WhenClipGeometryIsTransformedRectangle_IntersectsWithClipRectangle)
+    {
+        Fixture f;
+
+        auto rectangleGeometry = Make<MockD2DRectangleGeometry>();
+        rectangleGeometry->GetRectMethod.AllowAnyCall([](D2D1_RECT_F* value) { *value = D2D1_RECT_F{ 0, 0, 10, 10 }; });
+
+        auto transformedGeometry = Make<MockD2DTransformedGeometry>();
+        transformedGeometry->GetSourceGeometryMethod.AllowAnyCall([=](ID2D1Geometry** value) { rectangleGeometry.CopyTo(value); });
+        transformedGeometry->GetTransformMethod.AllowAnyCall([](D2D1_MATRIX_3X2_F* value) { *value = D2D1::Matrix3x2F::Translation(5, 5); });
+
+        auto clipGeometry = f.WrapClipGeometry(transformedGeometry.Get());
+
+        f.ExpectOneGetTransform(D2D1_MATRIX_3X2_F{ 1, 0, 0, 1, 0, 0 });
+
+        f.DeviceContext->PushAxisAlignedClipMethod.SetExpectedCalls(1,
+            [=](D2D1_RECT_F const* clipRect, D2D1_ANTIALIAS_MODE)
+            {
+                Assert::AreEqual(D2D1_RECT_F{ 5, 7, 12, 15 }, *clipRect);
+            });
+
+        ComPtr<ICanvasActiveLayer> activeLayer;
+        ThrowIfFailed(f.DS->CreateLayerWithAllOptions(1.0f, nullptr, Rect{ 0, 7, 12, 20 }, clipGeometry.Get(), Matrix3x2{ 1, 0, 0, 1, 0, 0 }, CanvasLayerOptions::None, &activeLayer));
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_CreateLayer_WhenClipGeometryTransformIsRotation_DoesNotUseAxisAlignedClip)
+    {
+        Fixture f;
+
+        auto clipGeometry = f.MakeRectangleClipGeometry(D2D1_RECT_F{ 1, 2, 4, 6 });
+
+        f.DeviceContext->PushLayerMethod.SetExpectedCalls(1);
+
+        ComPtr<ICanvasActiveLayer> activeLayer;
+        ThrowIfFailed(f.DS->CreateLayerWithOpacityAndClipGeometryAndTransform(1.0f, clipGeometry.Get(), Matrix3x2{ 0, 1, -1, 0, 0, 0 }, &activeLayer));
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_CreateLayer_WhenClipGeometryHasOpacity_DoesNotUseAxisAlignedClip)
+    {
+        Fixture f;
+
+        auto clipGeometry = f.MakeRectangleClipGeometry(D2D1_RECT_F{ 1, 2, 4, 6 });
+
+        f.DeviceContext->PushLayerMethod.SetExpectedCalls(1);
+
+        ComPtr<ICanvasActiveLayer> activeLayer;
+        ThrowIfFailed(f.DS->CreateLayerWithOpacityAndClipGeometry(0.5f, clipGeometry.Get(), &activeLayer));
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_CreateLayer_ReusesLayerResourcesAfterTheyArePopped)
+    {
+        Fixture f;
+
+        std::vector<ID2D1Layer*> pushedLayers;
+
+        f.DeviceContext->PushLayerMethod.AllowAnyCall(
+            [&](D2D1_LAYER_PARAMETERS1 const*, ID2D1Layer* layer)
+            {
+                pushedLayers.push_back(layer);
+            });
+
+        f.DeviceContext->PopLayerMethod.AllowAnyCall();
+
+        // Two nested layers need two layer resources.
+        f.DeviceContext->CreateLayerMethod.SetExpectedCalls(2,
+            [](D2D1_SIZE_F const* size, ID2D1Layer** layer)
+            {
+                Assert::IsNull(size);
+                return Make<MockD2DLayer>().CopyTo(layer);
+            });
+
+        ComPtr<ICanvasActiveLayer> outerLayer;
+        ComPtr<ICanvasActiveLayer> innerLayer;
+        ThrowIfFailed(f.DS->CreateLayerWithOpacity(0.5f, &outerLayer));
+        ThrowIfFailed(f.DS->CreateLayerWithOpacity(0.5f, &innerLayer));
+        ThrowIfFailed(As<IClosable>(innerLayer)->Close());
+        ThrowIfFailed(As<IClosable>(outerLayer)->Close());
+
+        Assert::IsTrue(pushedLayers[0] != pushedLayers[1]);
+
+        // Later layers reuse the ones that have been popped.
+        f.DeviceContext->CreateLayerMethod.SetExpectedCalls(0);
+
+        ComPtr<ICanvasActiveLayer> siblingLayer;
+        ThrowIfFailed(f.DS->CreateLayerWithOpacity(0.5f, &siblingLayer));
+        ThrowIfFailed(As<IClosable>(siblingLayer)->Close());
+
+        Assert::IsTrue(pushedLayers[2] == pushedLayers[0] || pushedLayers[2] == pushedLayers[1]);
+        Assert::AreEqual(2u, f.DS->GetStats().LayerResourcesCreated);
+    }
+
     TEST_METHOD_EX(CanvasDrawingSession_CreateLayer_AxisAlignedClip_WhenActiveLayerClosed_PopAxisAlignedClipIsCalled)
     {
         Fixture f;
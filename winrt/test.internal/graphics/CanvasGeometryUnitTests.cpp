@@ -12,6 +12,7 @@
 
 #include "pch.h"
 #include <CanvasPathBuilder.h>
+#include <PathFlattener.h>
 #include "MockD2DRectangleGeometry.h"
 #include "MockD2DEllipseGeometry.h"
 #include "MockD2DRoundedRectangleGeometry.h"
@@ -1212,6 +1213,203 @@ public:
         Assert::AreEqual(E_INVALIDARG, f.RectangleGeometry->TessellateWithTransformAndFlatteningTolerance(Matrix3x2{}, 0, t.GetAddressOfSize(), nullptr));
     }
 
+    TEST_METHOD_EX(CanvasGeometry_Tessellate_PathGeometry_OutputCanExceedSegmentCountEstimate)
+    {
+        Fixture f;
+
+        auto d2dPathGeometry = Make<MockD2DPathGeometry>();
+        auto canvasGeometry = f.Manager->GetOrCreate(f.Device.Get(), d2dPathGeometry.Get());
+
+        d2dPathGeometry->GetSegmentCountMethod.SetExpectedCalls(1,
+            [](UINT32* count)
+            {
+                *count = 1;
+                return S_OK;
+            });
+
+        d2dPathGeometry->TessellateMethod.SetExpectedCalls(1,
+            [](D2D1_MATRIX_3X2_F const*, float, ID2D1TessellationSink* sink)
+            {
+                D2D1_TRIANGLE triangles[] = { sc_triangle1, sc_triangle2, sc_triangle3 };
+
+                sink->AddTriangles(triangles, 1);
+                sink->AddTriangles(triangles + 1, 2);
+
+                return S_OK;
+            });
+
+        ComArray<CanvasTriangleVertices> triangles;
+        ThrowIfFailed(canvasGeometry->Tessellate(triangles.GetAddressOfSize(), triangles.GetAddressOfData()));
+
+        Assert::AreEqual(3u, triangles.GetSize());
+        Assert::AreEqual(sc_triangle1, *ReinterpretAs<D2D1_TRIANGLE const*>(&triangles[0]));
+        Assert::AreEqual(sc_triangle2, *ReinterpretAs<D2D1_TRIANGLE const*>(&triangles[1]));
+        Assert::AreEqual(sc_triangle3, *ReinterpretAs<D2D1_TRIANGLE const*>(&triangles[2]));
+    }
+
+    TEST_METHOD_EX(CanvasGeometry_TessellateTo_PassesBatchesToCallback)
+    {
+        TessellateFixture f;
+
+        f.ExpectOneTessellateCall(sc_someD2DTransform, 23);
+
+        auto canvasGeometry = f.Manager->GetOrCreate(f.Device.Get(), f.D2DRectangleGeometry.Get());
+
+        std::vector<uint32_t> batchSizes;
+        std::vector<D2D1_TRIANGLE> triangles;
+
+        canvasGeometry->TessellateTo(sc_someD2DTransform, 23,
+            [&](D2D1_TRIANGLE const* batch, uint32_t count)
+            {
+                batchSizes.push_back(count);
+                triangles.insert(triangles.end(), batch, batch + count);
+            });
+
+        Assert::AreEqual(2u, (uint32_t)batchSizes.size());
+        Assert::AreEqual(1u, batchSizes[0]);
+        Assert::AreEqual(2u, batchSizes[1]);
+
+        Assert::AreEqual(sc_triangle1, triangles[0]);
+        Assert::AreEqual(sc_triangle2, triangles[1]);
+        Assert::AreEqual(sc_triangle3, triangles[2]);
+    }
+
+    TEST_METHOD_EX(CanvasGeometry_TessellateTo_CallbackErrorIsPropagated)
+    {
+        TessellateFixture f;
+
+        f.ExpectOneTessellateCall(sc_identityD2DTransform, D2D1_DEFAULT_FLATTENING_TOLERANCE);
+
+        auto canvasGeometry = f.Manager->GetOrCreate(f.Device.Get(), f.D2DRectangleGeometry.Get());
+
+        int callCount = 0;
+
+        ExpectHResultException(E_OUTOFMEMORY,
+            [&]
+            {
+                canvasGeometry->TessellateTo(sc_identityD2DTransform, D2D1_DEFAULT_FLATTENING_TOLERANCE,
+                    [&](D2D1_TRIANGLE const*, uint32_t)
+                    {
+                        callCount++;
+                        ThrowHR(E_OUTOFMEMORY);
+                    });
+            });
+
+        // Later batches are not passed on once the callback has failed.
+        Assert::AreEqual(1, callCount);
+    }
+
+    struct TessellateIndexedFixture : public GeometryOperationsFixture_DoesNotOutputToTempPathBuilder
+    {
+        TessellateIndexedFixture()
+        {
+            // Two triangles that make a square, sharing the diagonal.
+            D2DRectangleGeometry->TessellateMethod.SetExpectedCalls(1,
+                [](D2D1_MATRIX_3X2_F const* transform, float flatteningTolerance, ID2D1TessellationSink* sink)
+                {
+                    Assert::AreEqual(sc_someD2DTransform, *transform);
+                    Assert::AreEqual(23.0f, flatteningTolerance);
+
+                    D2D1_TRIANGLE triangles[] =
+                    {
+                        { { 0, 0 }, { 1, 0 }, { 1, 1 } },
+                        { { 0, 0 }, { 1, 1 }, { 0, 1 } },
+                    };
+
+                    sink->AddTriangles(triangles, 2);
+
+                    return S_OK;
+                });
+        }
+
+        template<typename INDEX>
+        void Validate(ComArray<Vector2>& vertices, ComArray<INDEX>& indices)
+        {
+            Assert::AreEqual(4u, vertices.GetSize());
+            Assert::AreEqual(6u, indices.GetSize());
+
+            Vector2 expected[] =
+            {
+                { 0, 0 }, { 1, 0 }, { 1, 1 },
+                { 0, 0 }, { 1, 1 }, { 0, 1 },
+            };
+
+            for (uint32_t i = 0; i < 6; i++)
+            {
+                Assert::IsTrue(indices[i] < vertices.GetSize());
+                Assert::AreEqual(expected[i], vertices[indices[i]]);
+            }
+        }
+    };
+
+    TEST_METHOD_EX(CanvasGeometry_TessellateIndexed_MergesSharedVertices)
+    {
+        TessellateIndexedFixture f;
+        ComArray<Vector2> vertices;
+        ComArray<UINT32> indices;
+
+        ThrowIfFailed(f.RectangleGeometry->TessellateIndexed(sc_someTransform, 23, vertices.GetAddressOfSize(), vertices.GetAddressOfData(), indices.GetAddressOfSize(), indices.GetAddressOfData()));
+
+        f.Validate(vertices, indices);
+    }
+
+    TEST_METHOD_EX(CanvasGeometry_TessellateIndexed16_MergesSharedVertices)
+    {
+        TessellateIndexedFixture f;
+        ComArray<Vector2> vertices;
+        ComArray<UINT16> indices;
+
+        ThrowIfFailed(f.RectangleGeometry->TessellateIndexed16(sc_someTransform, 23, vertices.GetAddressOfSize(), vertices.GetAddressOfData(), indices.GetAddressOfSize(), indices.GetAddressOfData()));
+
+        f.Validate(vertices, indices);
+    }
+
+    TEST_METHOD_EX(CanvasGeometry_TessellateIndexed16_FailsWhenIndicesWouldOverflow)
+    {
+        GeometryOperationsFixture_DoesNotOutputToTempPathBuilder f;
+
+        f.D2DRectangleGeometry->TessellateMethod.SetExpectedCalls(1,
+            [](D2D1_MATRIX_3X2_F const*, float, ID2D1TessellationSink* sink)
+            {
+                // More distinct vertices than 16 bit indices can refer to.
+                std::vector<D2D1_TRIANGLE> triangles;
+
+                for (int i = 0; i < 65535; i++)
+                {
+                    float x = static_cast<float>(i);
+                    triangles.push_back(D2D1_TRIANGLE{ { x, 0 }, { x + 1, 0 }, { x + 2, 1 } });
+                }
+
+                sink->AddTriangles(triangles.data(), static_cast<uint32_t>(triangles.size()));
+
+                return S_OK;
+            });
+
+        ComArray<Vector2> vertices;
+        ComArray<UINT16> indices;
+
+        Assert::AreEqual(E_BOUNDS, f.RectangleGeometry->TessellateIndexed16(Matrix3x2{}, 0, vertices.GetAddressOfSize(), vertices.GetAddressOfData(), indices.GetAddressOfSize(), indices.GetAddressOfData()));
+        ValidateStoredErrorState(E_BOUNDS, Strings::TooManyVerticesForIndexSize);
+    }
+
+    TEST_METHOD_EX(CanvasGeometry_TessellateIndexed_NullArgs)
+    {
+        GeometryOperationsFixture_DoesNotOutputToTempPathBuilder f;
+        ComArray<Vector2> v;
+        ComArray<UINT32> i;
+        ComArray<UINT16> i16;
+
+        Assert::AreEqual(E_INVALIDARG, f.RectangleGeometry->TessellateIndexed(Matrix3x2{}, 0, nullptr, v.GetAddressOfData(), i.GetAddressOfSize(), i.GetAddressOfData()));
+        Assert::AreEqual(E_INVALIDARG, f.RectangleGeometry->TessellateIndexed(Matrix3x2{}, 0, v.GetAddressOfSize(), nullptr, i.GetAddressOfSize(), i.GetAddressOfData()));
+        Assert::AreEqual(E_INVALIDARG, f.RectangleGeometry->TessellateIndexed(Matrix3x2{}, 0, v.GetAddressOfSize(), v.GetAddressOfData(), nullptr, i.GetAddressOfData()));
+        Assert::AreEqual(E_INVALIDARG, f.RectangleGeometry->TessellateIndexed(Matrix3x2{}, 0, v.GetAddressOfSize(), v.GetAddressOfData(), i.GetAddressOfSize(), nullptr));
+
+        Assert::AreEqual(E_INVALIDARG, f.RectangleGeometry->TessellateIndexed16(Matrix3x2{}, 0, nullptr, v.GetAddressOfData(), i16.GetAddressOfSize(), i16.GetAddressOfData()));
+        Assert::AreEqual(E_INVALIDARG, f.RectangleGeometry->TessellateIndexed16(Matrix3x2{}, 0, v.GetAddressOfSize(), nullptr, i16.GetAddressOfSize(), i16.GetAddressOfData()));
+        Assert::AreEqual(E_INVALIDARG, f.RectangleGeometry->TessellateIndexed16(Matrix3x2{}, 0, v.GetAddressOfSize(), v.GetAddressOfData(), nullptr, i16.GetAddressOfData()));
+        Assert::AreEqual(E_INVALIDARG, f.RectangleGeometry->TessellateIndexed16(Matrix3x2{}, 0, v.GetAddressOfSize(), v.GetAddressOfData(), i16.GetAddressOfSize(), nullptr));
+    }
+
     TEST_METHOD_EX(CanvasGeometry_Closure)
     {
         GeometryOperationsFixture_DoesNotOutputToTempPathBuilder f;
@@ -1277,9 +1475,18 @@ public:
         Assert::AreEqual(RO_E_CLOSED, canvasGeometry->Tessellate(t.GetAddressOfSize(), t.GetAddressOfData()));
         Assert::AreEqual(RO_E_CLOSED, canvasGeometry->TessellateWithTransformAndFlatteningTolerance(m, 0, t.GetAddressOfSize(), t.GetAddressOfData()));
 
+        ComArray<Vector2> tv;
+        ComArray<UINT32> ti;
+        ComArray<UINT16> ti16;
+        Assert::AreEqual(RO_E_CLOSED, canvasGeometry->TessellateIndexed(m, 0, tv.GetAddressOfSize(), tv.GetAddressOfData(), ti.GetAddressOfSize(), ti.GetAddressOfData()));
+        Assert::AreEqual(RO_E_CLOSED, canvasGeometry->TessellateIndexed16(m, 0, tv.GetAddressOfSize(), tv.GetAddressOfData(), ti16.GetAddressOfSize(), ti16.GetAddressOfData()));
+
         auto geometrySink = Make<StubGeometrySink>();
         Assert::AreEqual(RO_E_CLOSED, canvasGeometry->SendPathTo(geometrySink.Get()));
 
+        ComArray<BYTE> pathBytes;
+        Assert::AreEqual(RO_E_CLOSED, canvasGeometry->GetPathBytes(pathBytes.GetAddressOfSize(), pathBytes.GetAddressOfData()));
+
         ComPtr<ICanvasDevice> retrievedDevice;
         Assert::AreEqual(RO_E_CLOSED, canvasGeometry->get_Device(&retrievedDevice));
     }
@@ -1357,6 +1564,87 @@ public:
         Assert::AreEqual(S_OK, canvasGeometry->SendPathTo(geometrySink.Get()));
     }
 
+    TEST_METHOD_EX(CanvasGeometry_SendPathTo_PathFlattenerReceiver)
+    {
+        Fixture f;
+
+        auto mockD2DPathGeometry = Make<MockD2DPathGeometry>();
+        auto canvasGeometry = f.Manager->GetOrCreate(f.Device.Get(), mockD2DPathGeometry.Get());
+
+        mockD2DPathGeometry->StreamMethod.SetExpectedCalls(1,
+            [&](ID2D1GeometrySink* internalSink)
+            {
+                internalSink->SetFillMode(D2D1_FILL_MODE_WINDING);
+
+                internalSink->BeginFigure(D2D1_POINT_2F{ 0, 0 }, D2D1_FIGURE_BEGIN_FILLED);
+                internalSink->AddLine(D2D1_POINT_2F{ 10, 0 });
+
+                const D2D1_QUADRATIC_BEZIER_SEGMENT bezier{ { 10, 5 }, { 10, 10 } };
+                internalSink->AddQuadraticBezier(&bezier);
+
+                const D2D1_ARC_SEGMENT arc{ { 0, 10 }, { 10, 10 }, 0, D2D1_SWEEP_DIRECTION_CLOCKWISE, D2D1_ARC_SIZE_SMALL };
+                internalSink->AddArc(&arc);
+
+                internalSink->EndFigure(D2D1_FIGURE_END_CLOSED);
+
+                internalSink->BeginFigure(D2D1_POINT_2F{ 20, 20 }, D2D1_FIGURE_BEGIN_HOLLOW);
+                internalSink->AddLine(D2D1_POINT_2F{ 30, 30 });
+                internalSink->EndFigure(D2D1_FIGURE_END_OPEN);
+                return S_OK;
+            });
+
+        auto receiver = Make<PathFlattenerReceiver>(0.01f);
+
+        Assert::AreEqual(S_OK, canvasGeometry->SendPathTo(receiver.Get()));
+
+        auto& flattener = receiver->GetFlattener();
+        auto& figures = flattener.GetFigures();
+        auto& points = flattener.GetPoints();
+
+        Assert::IsTrue(flattener.GetFillMode() == PathFlattener::FillMode::Winding);
+        Assert::AreEqual(2u, (uint32_t)figures.size());
+
+        // The straight quadratic is a single segment, and the arc several.
+        Assert::IsTrue(figures[0].IsFilled);
+        Assert::IsTrue(figures[0].IsClosed);
+        Assert::IsTrue(figures[0].PointCount > 4);
+
+        Assert::AreEqual(10.0f, points[1].X);
+        Assert::AreEqual(0.0f, points[1].Y);
+        Assert::AreEqual(10.0f, points[2].X);
+        Assert::AreEqual(10.0f, points[2].Y);
+
+        auto& arcEnd = points[figures[0].FirstPoint + figures[0].PointCount - 1];
+        Assert::AreEqual(0.0f, arcEnd.X);
+        Assert::AreEqual(10.0f, arcEnd.Y);
+
+        Assert::IsFalse(figures[1].IsFilled);
+        Assert::IsFalse(figures[1].IsClosed);
+        Assert::AreEqual(2u, figures[1].PointCount);
+        Assert::AreEqual(30.0f, points[figures[1].FirstPoint + 1].X);
+    }
+
+    TEST_METHOD_EX(CanvasGeometry_SendPathTo_PathFlattenerReceiver_ErrorIsPropagated)
+    {
+        Fixture f;
+
+        auto mockD2DPathGeometry = Make<MockD2DPathGeometry>();
+        auto canvasGeometry = f.Manager->GetOrCreate(f.Device.Get(), mockD2DPathGeometry.Get());
+
+        mockD2DPathGeometry->StreamMethod.SetExpectedCalls(1,
+            [&](ID2D1GeometrySink* internalSink)
+            {
+                internalSink->BeginFigure(D2D1_POINT_2F{}, D2D1_FIGURE_BEGIN_FILLED);
+                internalSink->BeginFigure(D2D1_POINT_2F{}, D2D1_FIGURE_BEGIN_FILLED);
+                return S_OK;
+            });
+
+        auto receiver = Make<PathFlattenerReceiver>(0.25f);
+
+        Assert::AreEqual(E_INVALIDARG, canvasGeometry->SendPathTo(receiver.Get()));
+        ValidateStoredErrorState(E_INVALIDARG, Strings::FlattenerTwoBeginFigures);
+    }
+
     TEST_METHOD_EX(CanvasGeometry_Stream_BeginFigure_ErrorIsPropagated)
     {
         Fixture f;
@@ -2018,4 +2306,114 @@ public:
 
         Assert::AreEqual(S_OK, canvasGeometry->SendPathTo(geometrySink.Get()));
     }
+
+    TEST_METHOD_EX(CanvasGeometry_GetPathBytes_RoundTripsThroughCreatePathFromBytes)
+    {
+        Fixture f;
+
+        auto mockD2DPathGeometry = Make<MockD2DPathGeometry>();
+        auto canvasGeometry = f.Manager->GetOrCreate(f.Device.Get(), mockD2DPathGeometry.Get());
+
+        mockD2DPathGeometry->StreamMethod.SetExpectedCalls(1,
+            [&](ID2D1GeometrySink* internalSink)
+            {
+                internalSink->SetFillMode(D2D1_FILL_MODE_WINDING);
+                internalSink->BeginFigure(D2D1_POINT_2F{ 1, 2 }, D2D1_FIGURE_BEGIN_FILLED);
+
+                D2D1_POINT_2F lines[] = { { 3, 4 }, { 5, 6 } };
+                internalSink->AddLines(lines, 2);
+
+                internalSink->EndFigure(D2D1_FIGURE_END_CLOSED);
+                return S_OK;
+            });
+
+        ComArray<BYTE> pathBytes;
+        ThrowIfFailed(canvasGeometry->GetPathBytes(pathBytes.GetAddressOfSize(), pathBytes.GetAddressOfData()));
+
+        f.Device->CreatePathGeometryMethod.SetExpectedCalls(1,
+            [&]
+            {
+                auto pathGeometry = Make<MockD2DPathGeometry>();
+
+                pathGeometry->OpenMethod.SetExpectedCalls(1,
+                    [&](ID2D1GeometrySink** out)
+                    {
+                        auto geometrySink = Make<MockD2DGeometrySink>();
+
+                        geometrySink->SetFillModeMethod.SetExpectedCalls(1,
+                            [](D2D1_FILL_MODE fillMode)
+                            {
+                                Assert::AreEqual(D2D1_FILL_MODE_WINDING, fillMode);
+                            });
+
+                        geometrySink->BeginFigureMethod.SetExpectedCalls(1,
+                            [](D2D1_POINT_2F point, D2D1_FIGURE_BEGIN figureBegin)
+                            {
+                                Assert::AreEqual(D2D1::Point2F(1, 2), point);
+                                Assert::AreEqual(D2D1_FIGURE_BEGIN_FILLED, figureBegin);
+                            });
+
+                        geometrySink->AddLinesMethod.SetExpectedCalls(1,
+                            [](D2D1_POINT_2F const* points, UINT32 pointsCount)
+                            {
+                                Assert::AreEqual(2u, pointsCount);
+                                Assert::AreEqual(D2D1::Point2F(3, 4), points[0]);
+                                Assert::AreEqual(D2D1::Point2F(5, 6), points[1]);
+                            });
+
+                        geometrySink->EndFigureMethod.SetExpectedCalls(1,
+                            [](D2D1_FIGURE_END figureEnd)
+                            {
+                                Assert::AreEqual(D2D1_FIGURE_END_CLOSED, figureEnd);
+                            });
+
+                        geometrySink->CloseMethod.SetExpectedCalls(1);
+
+                        return geometrySink.CopyTo(out);
+                    });
+
+                return pathGeometry;
+            });
+
+        auto loadedGeometry = f.Manager->Create(f.Device.Get(), pathBytes.GetData(), pathBytes.GetSize());
+
+        Assert::IsNotNull(loadedGeometry.Get());
+    }
+
+    TEST_METHOD_EX(CanvasGeometry_CreatePathFromBytes_InvalidData)
+    {
+        Fixture f;
+
+        f.Device->CreatePathGeometryMethod.SetExpectedCalls(2,
+            []
+            {
+                auto pathGeometry = Make<MockD2DPathGeometry>();
+
+                pathGeometry->OpenMethod.SetExpectedCalls(1,
+                    [](ID2D1GeometrySink** out)
+                    {
+                        return Make<MockD2DGeometrySink>().CopyTo(out);
+                    });
+
+                return pathGeometry;
+            });
+
+        BYTE notPathData[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16 };
+
+        ExpectHResultException(E_INVALIDARG, [&] { f.Manager->Create(f.Device.Get(), notPathData, sizeof(notPathData)); });
+        ExpectHResultException(E_INVALIDARG, [&] { f.Manager->Create(f.Device.Get(), notPathData, 0); });
+    }
+
+    TEST_METHOD_EX(CanvasGeometry_PathBytes_NullArgs)
+    {
+        Fixture f;
+
+        auto canvasGeometry = f.Manager->Create(f.Device.Get(), Rect{});
+        ComArray<BYTE> pathBytes;
+
+        Assert::AreEqual(E_INVALIDARG, canvasGeometry->GetPathBytes(nullptr, pathBytes.GetAddressOfData()));
+        Assert::AreEqual(E_INVALIDARG, canvasGeometry->GetPathBytes(pathBytes.GetAddressOfSize(), nullptr));
+
+        ExpectHResultException(E_INVALIDARG, [&] { f.Manager->Create(f.Device.Get(), static_cast<BYTE const*>(nullptr), 1); });
+    }
 };
\ No newline at end of file
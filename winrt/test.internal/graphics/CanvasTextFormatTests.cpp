@@ -677,6 +677,54 @@ namespace canvas
                 static_cast<CanvasDrawTextOptions>(999));
         }
 
+        TEST_METHOD_EX(CanvasTextFormat_RealizedTextFormatVersion_OnlyChangesWhenTheFormatDoes)
+        {
+            auto ctf = CreateTestManager()->Create();
+
+            auto version = ctf->GetRealizedTextFormatVersion();
+            Assert::AreEqual(version, ctf->GetRealizedTextFormatVersion());
+
+            ThrowIfFailed(ctf->put_FontSize(20));
+            Assert::AreNotEqual(version, ctf->GetRealizedTextFormatVersion());
+
+            // Once native code has the DWrite format, reading the version
+            // still leaves it alone...
+            ComPtr<IDWriteTextFormat> dwriteFormat;
+            ThrowIfFailed(ctf->GetResource(IID_PPV_ARGS(&dwriteFormat)));
+
+            version = ctf->GetRealizedTextFormatVersion();
+            Assert::AreEqual(version, ctf->GetRealizedTextFormatVersion());
+
+            // ...until native code changes the format.
+            ThrowIfFailed(dwriteFormat->SetTextAlignment(DWRITE_TEXT_ALIGNMENT_CENTER));
+            Assert::AreNotEqual(version, ctf->GetRealizedTextFormatVersion());
+        }
+
+        TEST_METHOD_EX(CanvasTextFormat_RealizedNoWrapTextFormat_FollowsChangesMadeByNativeCode)
+        {
+            auto ctf = CreateTestManager()->Create();
+
+            ThrowIfFailed(ctf->put_FontSize(20));
+
+            ComPtr<IDWriteTextFormat> dwriteFormat;
+            ThrowIfFailed(ctf->GetResource(IID_PPV_ARGS(&dwriteFormat)));
+
+            auto noWrapFormat = ctf->GetRealizedNoWrapTextFormat();
+            Assert::AreEqual(DWRITE_WORD_WRAPPING_NO_WRAP, noWrapFormat->GetWordWrapping());
+            Assert::AreEqual(20.0f, noWrapFormat->GetFontSize());
+            Assert::IsTrue(noWrapFormat == ctf->GetRealizedNoWrapTextFormat());
+
+            ThrowIfFailed(dwriteFormat->SetTextAlignment(DWRITE_TEXT_ALIGNMENT_CENTER));
+
+            auto updatedNoWrapFormat = ctf->GetRealizedNoWrapTextFormat();
+            Assert::IsTrue(updatedNoWrapFormat != noWrapFormat);
+            Assert::AreEqual(DWRITE_TEXT_ALIGNMENT_CENTER, updatedNoWrapFormat->GetTextAlignment());
+            Assert::AreEqual(DWRITE_WORD_WRAPPING_NO_WRAP, updatedNoWrapFormat->GetWordWrapping());
+
+            // The format native code was given keeps its own wrapping.
+            Assert::AreEqual(DWRITE_WORD_WRAPPING_WRAP, dwriteFormat->GetWordWrapping());
+        }
+
 #undef TEST_SIMPLE_PROPERTY
 #undef SIMPLE_DWRITE_SETTER
 #undef SIMPLE_DWRITE_GETTER
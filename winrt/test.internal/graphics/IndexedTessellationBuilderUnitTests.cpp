@@ -0,0 +1,274 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+#include <IndexedTessellationBuilder.h>
+
+TEST_CLASS(IndexedTessellationBuilderUnitTests)
+{
+    // Grid of squares, each split into two triangles, in a scrambled order.
+    static std::vector<D2D1_TRIANGLE> MakeGrid(int size)
+    {
+        std::vector<D2D1_TRIANGLE> triangles;
+
+        for (int y = 0; y < size; y++)
+        {
+            for (int x = 0; x < size; x++)
+            {
+                D2D1_POINT_2F topLeft     { static_cast<float>(x),     static_cast<float>(y)     };
+                D2D1_POINT_2F topRight    { static_cast<float>(x + 1), static_cast<float>(y)     };
+                D2D1_POINT_2F bottomLeft  { static_cast<float>(x),     static_cast<float>(y + 1) };
+                D2D1_POINT_2F bottomRight { static_cast<float>(x + 1), static_cast<float>(y + 1) };
+
+                triangles.push_back(D2D1_TRIANGLE{ topLeft, topRight, bottomRight });
+                triangles.push_back(D2D1_TRIANGLE{ topLeft, bottomRight, bottomLeft });
+            }
+        }
+
+        for (size_t i = 0; i < triangles.size(); i++)
+        {
+            std::swap(triangles[i], triangles[(i * 7919) % triangles.size()]);
+        }
+
+        return triangles;
+    }
+
+    // Each triangle as a sorted list of its coordinates, so triangle lists
+    // can be compared regardless of triangle or vertex order.
+    static std::multiset<std::vector<float>> GetTriangleSet(IndexedTessellationBuilder const& builder)
+    {
+        std::multiset<std::vector<float>> result;
+
+        auto& vertices = builder.GetVertices();
+        auto& indices = builder.GetIndices();
+
+        for (size_t i = 0; i < indices.size(); i += 3)
+        {
+            std::vector<std::pair<float, float>> points;
+
+            for (size_t j = 0; j < 3; j++)
+            {
+                points.push_back(std::make_pair(vertices[indices[i + j]].x, vertices[indices[i + j]].y));
+            }
+
+            std::sort(points.begin(), points.end());
+
+            result.insert(std::vector<float>{ points[0].first, points[0].second, points[1].first, points[1].second, points[2].first, points[2].second });
+        }
+
+        return result;
+    }
+
+    // Average number of vertices per triangle that miss a FIFO cache of the given size.
+    static float GetAverageCacheMissRatio(std::vector<uint32_t> const& indices, size_t cacheSize)
+    {
+        std::vector<uint32_t> cache;
+        size_t missCount = 0;
+
+        for (auto index : indices)
+        {
+            if (std::find(cache.begin(), cache.end(), index) == cache.end())
+            {
+                missCount++;
+
+                cache.insert(cache.begin(), index);
+
+                if (cache.size() > cacheSize)
+                    cache.pop_back();
+            }
+        }
+
+        return static_cast<float>(missCount) / (indices.size() / 3);
+    }
+
+    TEST_METHOD_EX(IndexedTessellationBuilder_Empty)
+    {
+        IndexedTessellationBuilder builder;
+
+        builder.Optimize();
+
+        Assert::AreEqual(0u, (uint32_t)builder.GetVertices().size());
+        Assert::AreEqual(0u, (uint32_t)builder.GetIndices().size());
+    }
+
+    TEST_METHOD_EX(IndexedTessellationBuilder_MergesIdenticalVertices)
+    {
+        IndexedTessellationBuilder builder;
+
+        auto triangles = MakeGrid(10);
+        builder.AddTriangles(triangles.data(), static_cast<uint32_t>(triangles.size()));
+
+        Assert::AreEqual(11u * 11u, (uint32_t)builder.GetVertices().size());
+        Assert::AreEqual(10u * 10u * 2 * 3, (uint32_t)builder.GetIndices().size());
+    }
+
+    TEST_METHOD_EX(IndexedTessellationBuilder_PositiveAndNegativeZero_AreMerged)
+    {
+        IndexedTessellationBuilder builder;
+
+        D2D1_TRIANGLE triangles[] =
+        {
+            { { 0, 0 }, { 1, 0 }, { 1, 1 } },
+            { { -0.0f, -0.0f }, { 1, 1 }, { 0, 1 } },
+        };
+
+        builder.AddTriangles(triangles, 2);
+
+        Assert::AreEqual(4u, (uint32_t)builder.GetVertices().size());
+    }
+
+    TEST_METHOD_EX(IndexedTessellationBuilder_DegenerateTriangles_AreDropped)
+    {
+        IndexedTessellationBuilder builder;
+
+        D2D1_TRIANGLE triangles[] =
+        {
+            { { 0, 0 }, { 0, 0 }, { 1, 1 } },
+            { { 0, 0 }, { 1, 0 }, { 1, 1 } },
+        };
+
+        builder.AddTriangles(triangles, 2);
+        builder.Optimize();
+
+        Assert::AreEqual(3u, (uint32_t)builder.GetVertices().size());
+        Assert::AreEqual(3u, (uint32_t)builder.GetIndices().size());
+    }
+
+    TEST_METHOD_EX(IndexedTessellationBuilder_Optimize_KeepsTheSameTriangles)
+    {
+        IndexedTessellationBuilder builder;
+
+        auto triangles = MakeGrid(30);
+        builder.AddTriangles(triangles.data(), static_cast<uint32_t>(triangles.size()));
+
+        auto before = GetTriangleSet(builder);
+
+        builder.Optimize();
+
+        Assert::IsTrue(before == GetTriangleSet(builder));
+        Assert::AreEqual(31u * 31u, (uint32_t)builder.GetVertices().size());
+    }
+
+    TEST_METHOD_EX(IndexedTessellationBuilder_Optimize_OrdersVerticesByFirstUse)
+    {
+        IndexedTessellationBuilder builder;
+
+        auto triangles = MakeGrid(30);
+        builder.AddTriangles(triangles.data(), static_cast<uint32_t>(triangles.size()));
+        builder.Optimize();
+
+        uint32_t nextNewVertex = 0;
+
+        for (auto index : builder.GetIndices())
+        {
+            Assert::IsTrue(index <= nextNewVertex);
+
+            if (index == nextNewVertex)
+                nextNewVertex++;
+        }
+    }
+
+    TEST_METHOD_EX(IndexedTessellationBuilder_Optimize_ImprovesVertexCacheHits)
+    {
+        IndexedTessellationBuilder builder;
+
+        auto triangles = MakeGrid(50);
+        builder.AddTriangles(triangles.data(), static_cast<uint32_t>(triangles.size()));
+
+        auto before = GetAverageCacheMissRatio(builder.GetIndices(), 16);
+
+        builder.Optimize();
+
+        auto after = GetAverageCacheMissRatio(builder.GetIndices(), 16);
+
+        // A regular grid has about one vertex per two triangles, so
+        // the best possible ratio is a little over 0.5.
+        Assert::IsTrue(before > 2.0f);
+        Assert::IsTrue(after < 0.8f);
+    }
+
+    TEST_METHOD_EX(IndexedTessellationBuilder_Optimize_HighValenceVertex)
+    {
+        // A fan around one shared center vertex, in a scrambled order. If
+        // Optimize looked at every remaining triangle of the center vertex
+        // after outputting each triangle, this would take minutes.
+        const uint32_t trianglesCount = 100000;
+        const float pi = 3.14159265f;
+
+        std::vector<D2D1_POINT_2F> rim(trianglesCount);
+
+        for (uint32_t i = 0; i < trianglesCount; i++)
+        {
+            float angle = 2 * pi * i / trianglesCount;
+            rim[i] = D2D1_POINT_2F{ 1000 * cosf(angle), 1000 * sinf(angle) };
+        }
+
+        std::vector<D2D1_TRIANGLE> triangles;
+
+        for (uint32_t i = 0; i < trianglesCount; i++)
+        {
+            auto j = (i * 7919) % trianglesCount;
+            triangles.push_back(D2D1_TRIANGLE{ D2D1_POINT_2F{ 0, 0 }, rim[j], rim[(j + 1) % trianglesCount] });
+        }
+
+        IndexedTessellationBuilder builder;
+        builder.AddTriangles(triangles.data(), trianglesCount);
+
+        auto before = GetTriangleSet(builder);
+
+        builder.Optimize();
+
+        Assert::IsTrue(before == GetTriangleSet(builder));
+        Assert::AreEqual(trianglesCount + 1, (uint32_t)builder.GetVertices().size());
+
+        // Neighboring triangles of a fan share two vertices, so the best
+        // order misses the cache about once per triangle.
+        Assert::IsTrue(GetAverageCacheMissRatio(builder.GetIndices(), 16) < 1.1f);
+    }
+
+    TEST_METHOD_EX(IndexedTessellationBuilder_ManySmallBatches)
+    {
+        // The streaming tessellation sink delivers triangles a few at a
+        // time. If each batch grew the buffers to exactly the size needed,
+        // this would copy them once per triangle and take minutes.
+        auto triangles = MakeGrid(300);
+        auto trianglesCount = static_cast<uint32_t>(triangles.size());
+
+        IndexedTessellationBuilder oneBatch;
+        oneBatch.AddTriangles(triangles.data(), trianglesCount);
+
+        IndexedTessellationBuilder smallBatches;
+
+        for (uint32_t i = 0; i < trianglesCount; i++)
+        {
+            smallBatches.AddTriangles(&triangles[i], 1);
+        }
+
+        Assert::IsTrue(oneBatch.GetVertices() == smallBatches.GetVertices());
+        Assert::IsTrue(oneBatch.GetIndices() == smallBatches.GetIndices());
+    }
+
+    TEST_METHOD_EX(IndexedTessellationBuilder_AddTrianglesAfterOptimize_StillMergesVertices)
+    {
+        IndexedTessellationBuilder builder;
+
+        D2D1_TRIANGLE triangle1 = { { 0, 0 }, { 1, 0 }, { 1, 1 } };
+        D2D1_TRIANGLE triangle2 = { { 0, 0 }, { 1, 1 }, { 0, 1 } };
+
+        builder.AddTriangles(&triangle1, 1);
+        builder.Optimize();
+        builder.AddTriangles(&triangle2, 1);
+
+        Assert::AreEqual(4u, (uint32_t)builder.GetVertices().size());
+        Assert::AreEqual(6u, (uint32_t)builder.GetIndices().size());
+    }
+};
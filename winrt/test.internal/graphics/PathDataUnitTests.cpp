@@ -0,0 +1,298 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+#include <PathData.h>
+#include "MockD2DGeometrySink.h"
+
+TEST_CLASS(PathDataUnitTests)
+{
+    static std::vector<BYTE> ToVector(ComArray<BYTE>& bytes)
+    {
+        return std::vector<BYTE>(bytes.GetData(), bytes.GetData() + bytes.GetSize());
+    }
+
+    static ComPtr<MockD2DGeometrySink> MakeSinkThatAllowsAnyCall()
+    {
+        auto geometrySink = Make<MockD2DGeometrySink>();
+
+        geometrySink->SetFillModeMethod.AllowAnyCall();
+        geometrySink->SetSegmentFlagsMethod.AllowAnyCall();
+        geometrySink->BeginFigureMethod.AllowAnyCall();
+        geometrySink->AddLinesMethod.AllowAnyCall();
+        geometrySink->AddQuadraticBeziersMethod.AllowAnyCall();
+        geometrySink->AddBeziersMethod.AllowAnyCall();
+        geometrySink->AddArcMethod.AllowAnyCall();
+        geometrySink->EndFigureMethod.AllowAnyCall();
+
+        return geometrySink;
+    }
+
+    static void ExpectInvalid(std::vector<BYTE> const& bytes)
+    {
+        auto geometrySink = MakeSinkThatAllowsAnyCall();
+
+        ExpectHResultException(E_INVALIDARG, [&] { ReadPathData(bytes.data(), bytes.size(), geometrySink.Get()); });
+    }
+
+    TEST_METHOD_EX(PathData_EmptyPath_IsJustAHeader)
+    {
+        auto writer = Make<PathDataWriter>();
+        auto bytes = writer->GetBytes();
+
+        Assert::AreEqual(static_cast<uint32_t>(sizeof(PathDataHeader)), bytes.GetSize());
+
+        auto geometrySink = Make<MockD2DGeometrySink>();
+
+        geometrySink->SetFillModeMethod.SetExpectedCalls(1,
+            [](D2D1_FILL_MODE fillMode)
+            {
+                Assert::AreEqual(D2D1_FILL_MODE_ALTERNATE, fillMode);
+            });
+
+        ReadPathData(bytes.GetData(), bytes.GetSize(), geometrySink.Get());
+    }
+
+    TEST_METHOD_EX(PathData_RoundTripsEverySegmentType)
+    {
+        auto writer = Make<PathDataWriter>();
+
+        ThrowIfFailed(writer->SetFilledRegionDetermination(CanvasFilledRegionDetermination::Winding));
+        ThrowIfFailed(writer->BeginFigure(Vector2{ 1, 2 }, CanvasFigureFill::Default));
+        ThrowIfFailed(writer->AddLine(Vector2{ 3, 4 }));
+        ThrowIfFailed(writer->AddLine(Vector2{ 5, 6 }));
+        ThrowIfFailed(writer->AddLine(Vector2{ 7, 8 }));
+        ThrowIfFailed(writer->AddQuadraticBezier(Vector2{ 9, 10 }, Vector2{ 11, 12 }));
+        ThrowIfFailed(writer->AddCubicBezier(Vector2{ 13, 14 }, Vector2{ 15, 16 }, Vector2{ 17, 18 }));
+        ThrowIfFailed(writer->AddArc(Vector2{ 19, 20 }, 21, 22, DirectX::XM_PIDIV2, CanvasSweepDirection::Clockwise, CanvasArcSize::Large));
+        ThrowIfFailed(writer->SetSegmentOptions(CanvasFigureSegmentOptions::ForceUnstroked));
+        ThrowIfFailed(writer->EndFigure(CanvasFigureLoop::Closed));
+        ThrowIfFailed(writer->BeginFigure(Vector2{ 23, 24 }, CanvasFigureFill::DoesNotAffectFills));
+        ThrowIfFailed(writer->EndFigure(CanvasFigureLoop::Open));
+
+        auto bytes = writer->GetBytes();
+        auto bytesBegin = bytes.GetData();
+        auto bytesEnd = bytes.GetData() + bytes.GetSize();
+
+        auto geometrySink = Make<MockD2DGeometrySink>();
+        int figureIndex = 0;
+
+        geometrySink->SetFillModeMethod.SetExpectedCalls(1,
+            [](D2D1_FILL_MODE fillMode)
+            {
+                Assert::AreEqual(D2D1_FILL_MODE_WINDING, fillMode);
+            });
+
+        geometrySink->BeginFigureMethod.SetExpectedCalls(2,
+            [&](D2D1_POINT_2F point, D2D1_FIGURE_BEGIN figureBegin)
+            {
+                if (figureIndex == 0)
+                {
+                    Assert::AreEqual(D2D1::Point2F(1, 2), point);
+                    Assert::AreEqual(D2D1_FIGURE_BEGIN_FILLED, figureBegin);
+                }
+                else
+                {
+                    Assert::AreEqual(D2D1::Point2F(23, 24), point);
+                    Assert::AreEqual(D2D1_FIGURE_BEGIN_HOLLOW, figureBegin);
+                }
+            });
+
+        // Consecutive lines are passed on together, straight from the path data.
+        geometrySink->AddLinesMethod.SetExpectedCalls(1,
+            [&](D2D1_POINT_2F const* points, UINT32 pointsCount)
+            {
+                Assert::AreEqual(3u, pointsCount);
+                Assert::IsTrue(reinterpret_cast<BYTE const*>(points) > bytesBegin);
+                Assert::IsTrue(reinterpret_cast<BYTE const*>(points + pointsCount) < bytesEnd);
+
+                Assert::AreEqual(D2D1::Point2F(3, 4), points[0]);
+                Assert::AreEqual(D2D1::Point2F(5, 6), points[1]);
+                Assert::AreEqual(D2D1::Point2F(7, 8), points[2]);
+            });
+
+        geometrySink->AddQuadraticBeziersMethod.SetExpectedCalls(1,
+            [](D2D1_QUADRATIC_BEZIER_SEGMENT const* beziers, UINT32 beziersCount)
+            {
+                Assert::AreEqual(1u, beziersCount);
+                Assert::AreEqual(D2D1::Point2F(9, 10), beziers[0].point1);
+                Assert::AreEqual(D2D1::Point2F(11, 12), beziers[0].point2);
+            });
+
+        geometrySink->AddBeziersMethod.SetExpectedCalls(1,
+            [](D2D1_BEZIER_SEGMENT const* beziers, UINT32 beziersCount)
+            {
+                Assert::AreEqual(1u, beziersCount);
+                Assert::AreEqual(D2D1::Point2F(13, 14), beziers[0].point1);
+                Assert::AreEqual(D2D1::Point2F(15, 16), beziers[0].point2);
+                Assert::AreEqual(D2D1::Point2F(17, 18), beziers[0].point3);
+            });
+
+        geometrySink->AddArcMethod.SetExpectedCalls(1,
+            [](D2D1_ARC_SEGMENT const* arc)
+            {
+                Assert::AreEqual(D2D1::Point2F(19, 20), arc->point);
+                Assert::AreEqual(21.0f, arc->size.width);
+                Assert::AreEqual(22.0f, arc->size.height);
+                Assert::AreEqual(90.0f, arc->rotationAngle, 0.001f);
+                Assert::AreEqual(D2D1_SWEEP_DIRECTION_CLOCKWISE, arc->sweepDirection);
+                Assert::AreEqual(D2D1_ARC_SIZE_LARGE, arc->arcSize);
+            });
+
+        geometrySink->SetSegmentFlagsMethod.SetExpectedCalls(1,
+            [](D2D1_PATH_SEGMENT flags)
+            {
+                Assert::AreEqual(D2D1_PATH_SEGMENT_FORCE_UNSTROKED, flags);
+            });
+
+        geometrySink->EndFigureMethod.SetExpectedCalls(2,
+            [&](D2D1_FIGURE_END figureEnd)
+            {
+                Assert::AreEqual((figureIndex == 0) ? D2D1_FIGURE_END_CLOSED : D2D1_FIGURE_END_OPEN, figureEnd);
+                figureIndex++;
+            });
+
+        ReadPathData(bytes.GetData(), bytes.GetSize(), geometrySink.Get());
+    }
+
+    TEST_METHOD_EX(PathData_MisalignedData_IsStillRead)
+    {
+        auto writer = Make<PathDataWriter>();
+
+        ThrowIfFailed(writer->BeginFigure(Vector2{ 1, 2 }, CanvasFigureFill::Default));
+        ThrowIfFailed(writer->AddLine(Vector2{ 3, 4 }));
+        ThrowIfFailed(writer->AddLine(Vector2{ 5, 6 }));
+        ThrowIfFailed(writer->EndFigure(CanvasFigureLoop::Closed));
+
+        auto bytes = writer->GetBytes();
+
+        std::vector<BYTE> misaligned(bytes.GetSize() + 1);
+        memcpy(misaligned.data() + 1, bytes.GetData(), bytes.GetSize());
+
+        auto geometrySink = MakeSinkThatAllowsAnyCall();
+
+        geometrySink->AddLinesMethod.SetExpectedCalls(1,
+            [](D2D1_POINT_2F const* points, UINT32 pointsCount)
+            {
+                Assert::AreEqual(2u, pointsCount);
+                Assert::AreEqual(D2D1::Point2F(3, 4), points[0]);
+                Assert::AreEqual(D2D1::Point2F(5, 6), points[1]);
+            });
+
+        ReadPathData(misaligned.data() + 1, bytes.GetSize(), geometrySink.Get());
+    }
+
+    TEST_METHOD_EX(PathData_MalformedHeader_Throws)
+    {
+        auto writer = Make<PathDataWriter>();
+
+        ThrowIfFailed(writer->BeginFigure(Vector2{ 1, 2 }, CanvasFigureFill::Default));
+        ThrowIfFailed(writer->AddLine(Vector2{ 3, 4 }));
+        ThrowIfFailed(writer->EndFigure(CanvasFigureLoop::Closed));
+
+        auto comArray = writer->GetBytes();
+        auto valid = ToVector(comArray);
+
+        ExpectInvalid(std::vector<BYTE>());
+        ExpectInvalid(std::vector<BYTE>(valid.begin(), valid.begin() + sizeof(PathDataHeader) - 1));
+
+        auto truncated = valid;
+        truncated.pop_back();
+        ExpectInvalid(truncated);
+
+        auto tooLong = valid;
+        tooLong.push_back(static_cast<BYTE>(PathDataVerb::EndOpenFigure));
+        ExpectInvalid(tooLong);
+
+        auto wrongMagic = valid;
+        wrongMagic[0] ^= 1;
+        ExpectInvalid(wrongMagic);
+
+        auto newerVersion = valid;
+        reinterpret_cast<PathDataHeader*>(newerVersion.data())->Version++;
+        ExpectInvalid(newerVersion);
+        ValidateStoredErrorState(E_INVALIDARG, Strings::UnsupportedPathDataVersion);
+
+        // There has never been a version before the current one.
+        auto olderVersion = valid;
+        reinterpret_cast<PathDataHeader*>(olderVersion.data())->Version--;
+        ExpectInvalid(olderVersion);
+        ValidateStoredErrorState(E_INVALIDARG, Strings::InvalidPathData);
+
+        auto badFillMode = valid;
+        reinterpret_cast<PathDataHeader*>(badFillMode.data())->FillMode = 2;
+        ExpectInvalid(badFillMode);
+
+        auto unknownVerb = valid;
+        unknownVerb.back() = 0xFF;
+        ExpectInvalid(unknownVerb);
+    }
+
+    TEST_METHOD_EX(PathData_MalformedFigures_Throw)
+    {
+        std::vector<std::function<void(PathDataWriter*)>> badPaths =
+        {
+            // Segment outside a figure.
+            [](PathDataWriter* writer) { writer->AddLine(Vector2{ 1, 2 }); },
+
+            // Figure never ended.
+            [](PathDataWriter* writer) { writer->BeginFigure(Vector2{ 1, 2 }, CanvasFigureFill::Default); },
+
+            // Figure begun twice.
+            [](PathDataWriter* writer)
+            {
+                writer->BeginFigure(Vector2{ 1, 2 }, CanvasFigureFill::Default);
+                writer->BeginFigure(Vector2{ 1, 2 }, CanvasFigureFill::Default);
+                writer->EndFigure(CanvasFigureLoop::Open);
+            },
+
+            // Figure ended twice.
+            [](PathDataWriter* writer)
+            {
+                writer->BeginFigure(Vector2{ 1, 2 }, CanvasFigureFill::Default);
+                writer->EndFigure(CanvasFigureLoop::Open);
+                writer->EndFigure(CanvasFigureLoop::Open);
+            },
+        };
+
+        for (auto& badPath : badPaths)
+        {
+            auto writer = Make<PathDataWriter>();
+            badPath(writer.Get());
+
+            auto bytes = writer->GetBytes();
+            ExpectInvalid(ToVector(bytes));
+        }
+    }
+
+    TEST_METHOD_EX(PathData_PointCountMismatch_Throws)
+    {
+        auto writer = Make<PathDataWriter>();
+
+        ThrowIfFailed(writer->BeginFigure(Vector2{ 1, 2 }, CanvasFigureFill::Default));
+        ThrowIfFailed(writer->AddCubicBezier(Vector2{ 3, 4 }, Vector2{ 5, 6 }, Vector2{ 7, 8 }));
+        ThrowIfFailed(writer->EndFigure(CanvasFigureLoop::Closed));
+
+        auto comArray = writer->GetBytes();
+        auto valid = ToVector(comArray);
+
+        // The Bezier becomes a line, leaving two points unused.
+        auto extraPoints = valid;
+        extraPoints[extraPoints.size() - 2] = static_cast<BYTE>(PathDataVerb::Line);
+        ExpectInvalid(extraPoints);
+
+        // EndFigure becomes a second Bezier, with no points left for it.
+        auto tooFewPoints = valid;
+        tooFewPoints.back() = static_cast<BYTE>(PathDataVerb::CubicBezier);
+        ExpectInvalid(tooFewPoints);
+    }
+};
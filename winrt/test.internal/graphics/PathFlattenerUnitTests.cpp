@@ -0,0 +1,360 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+#include <PathFlattener.h>
+
+typedef PathFlattener::Point Point;
+
+TEST_CLASS(PathFlattenerUnitTests)
+{
+    static Point Lerp(Point a, Point b, float t)
+    {
+        return Point{ a.X + (b.X - a.X) * t, a.Y + (b.Y - a.Y) * t };
+    }
+
+    static Point EvaluateCubic(Point p0, Point p1, Point p2, Point p3, float t)
+    {
+        auto a = Lerp(p0, p1, t);
+        auto b = Lerp(p1, p2, t);
+        auto c = Lerp(p2, p3, t);
+
+        return Lerp(Lerp(a, b, t), Lerp(b, c, t), t);
+    }
+
+    static float GetDistanceToSegment(Point p, Point a, Point b)
+    {
+        float dx = b.X - a.X;
+        float dy = b.Y - a.Y;
+        float lengthSquared = dx * dx + dy * dy;
+
+        float t = (lengthSquared > 0) ? ((p.X - a.X) * dx + (p.Y - a.Y) * dy) / lengthSquared : 0;
+        t = std::max(0.0f, std::min(1.0f, t));
+
+        auto nearest = Lerp(a, b, t);
+
+        return sqrtf((p.X - nearest.X) * (p.X - nearest.X) + (p.Y - nearest.Y) * (p.Y - nearest.Y));
+    }
+
+    static float GetDistanceToPolyline(Point p, std::vector<Point> const& points)
+    {
+        float distance = FLT_MAX;
+
+        for (size_t i = 1; i < points.size(); i++)
+        {
+            distance = std::min(distance, GetDistanceToSegment(p, points[i - 1], points[i]));
+        }
+
+        return distance;
+    }
+
+    TEST_METHOD_EX(PathFlattener_Lines_ArePassedThrough)
+    {
+        PathFlattener flattener;
+
+        flattener.BeginFigure(Point{ 1, 2 });
+        flattener.AddLine(Point{ 3, 4 });
+        flattener.AddLine(Point{ 5, 6 });
+        flattener.EndFigure(false);
+
+        flattener.BeginFigure(Point{ 7, 8 }, false);
+        flattener.AddLine(Point{ 9, 10 });
+        flattener.AddLine(Point{ 7, 8 });
+        flattener.EndFigure(true);
+
+        auto& points = flattener.GetPoints();
+        auto& figures = flattener.GetFigures();
+
+        Assert::AreEqual(5u, (uint32_t)points.size());
+        Assert::AreEqual(2u, (uint32_t)figures.size());
+
+        Assert::AreEqual(0u, figures[0].FirstPoint);
+        Assert::AreEqual(3u, figures[0].PointCount);
+        Assert::IsFalse(figures[0].IsClosed);
+        Assert::IsTrue(figures[0].IsFilled);
+
+        // The closed figure does not repeat its start point.
+        Assert::AreEqual(3u, figures[1].FirstPoint);
+        Assert::AreEqual(2u, figures[1].PointCount);
+        Assert::IsTrue(figures[1].IsClosed);
+        Assert::IsFalse(figures[1].IsFilled);
+
+        Assert::AreEqual(5.0f, points[2].X);
+        Assert::AreEqual(10.0f, points[4].Y);
+    }
+
+    TEST_METHOD_EX(PathFlattener_StraightCurves_AreOneSegment)
+    {
+        PathFlattener flattener(0.01f);
+
+        flattener.BeginFigure(Point{ 0, 0 });
+        flattener.AddQuadraticBezier(Point{ 5, 5 }, Point{ 10, 10 });
+        flattener.AddCubicBezier(Point{ 11, 11 }, Point{ 12, 12 }, Point{ 13, 13 });
+        flattener.EndFigure(false);
+
+        Assert::AreEqual(3u, (uint32_t)flattener.GetPoints().size());
+    }
+
+    TEST_METHOD_EX(PathFlattener_CubicBezier_StaysWithinTolerance)
+    {
+        Point p0{ 0, 0 };
+        Point p1{ 30, 200 };
+        Point p2{ 170, -100 };
+        Point p3{ 200, 100 };
+
+        for (float tolerance : { 1.0f, 0.25f, 0.01f })
+        {
+            PathFlattener flattener(tolerance);
+
+            flattener.BeginFigure(p0);
+            flattener.AddCubicBezier(p1, p2, p3);
+            flattener.EndFigure(false);
+
+            auto& points = flattener.GetPoints();
+
+            Assert::AreEqual(p3.X, points.back().X);
+            Assert::AreEqual(p3.Y, points.back().Y);
+
+            // Every flattened point is on the curve.
+            for (size_t i = 1; i < points.size(); i++)
+            {
+                auto expected = EvaluateCubic(p0, p1, p2, p3, static_cast<float>(i) / (points.size() - 1));
+
+                Assert::AreEqual(expected.X, points[i].X, 0.001f);
+                Assert::AreEqual(expected.Y, points[i].Y, 0.001f);
+            }
+
+            // And the curve never strays far from the polyline.
+            for (int i = 0; i <= 1000; i++)
+            {
+                auto p = EvaluateCubic(p0, p1, p2, p3, i / 1000.0f);
+
+                Assert::IsTrue(GetDistanceToPolyline(p, points) <= tolerance);
+            }
+        }
+    }
+
+    TEST_METHOD_EX(PathFlattener_SmallerTolerance_GivesMoreSegments)
+    {
+        Point p0{ 0, 0 };
+        Point p1{ 50, 100 };
+        Point p2{ 100, 0 };
+
+        uint32_t previousCount = 0;
+
+        for (float tolerance : { 10.0f, 1.0f, 0.1f, 0.01f })
+        {
+            auto count = PathFlattener::GetQuadraticBezierSegmentCount(p0, p1, p2, tolerance);
+
+            Assert::IsTrue(count > previousCount);
+            previousCount = count;
+        }
+
+        // Every fourfold reduction in tolerance doubles the number of segments
+        // (give or take one, from rounding up).
+        auto coarseCount = PathFlattener::GetCubicBezierSegmentCount(p0, p1, p2, p0, 0.1f);
+        auto fineCount = PathFlattener::GetCubicBezierSegmentCount(p0, p1, p2, p0, 0.025f);
+
+        Assert::IsTrue(fineCount >= coarseCount * 2 - 1);
+        Assert::IsTrue(fineCount <= coarseCount * 2);
+
+        Assert::AreEqual(PathFlattener::MaxSegmentsPerCurve, PathFlattener::GetCubicBezierSegmentCount(p0, p1, p2, p0, 0));
+        Assert::AreEqual(PathFlattener::MaxSegmentsPerCurve, PathFlattener::GetCubicBezierSegmentCount(p0, p1, p2, p0, 1e-20f));
+        Assert::AreEqual(1u, PathFlattener::GetCubicBezierSegmentCount(p0, Point{ NAN, 0 }, p2, p0, 0.1f));
+    }
+
+    TEST_METHOD_EX(PathFlattener_NonFiniteAndHugeCurves_SegmentCounts)
+    {
+        const float inf = std::numeric_limits<float>::infinity();
+
+        Point p0{ 0, 0 };
+        Point p2{ 10, 0 };
+
+        // An infinitely curved curve gets as many segments as any curve may have...
+        Assert::AreEqual(PathFlattener::MaxSegmentsPerCurve, PathFlattener::GetQuadraticBezierSegmentCount(p0, Point{ inf, 0 }, p2, 0.25f));
+        Assert::AreEqual(PathFlattener::MaxSegmentsPerCurve, PathFlattener::GetCubicBezierSegmentCount(p0, Point{ 0, -inf }, p2, p0, 0.25f));
+
+        // ...but NaN gives nothing to subdivide.
+        Assert::AreEqual(1u, PathFlattener::GetQuadraticBezierSegmentCount(p0, Point{ NAN, 0 }, p2, 0.25f));
+        Assert::AreEqual(1u, PathFlattener::GetCubicBezierSegmentCount(p0, p2, Point{ 0, NAN }, p0, 0.25f));
+
+        // Squaring these coordinates overflows a float, but the curve is
+        // still well within a large enough tolerance.
+        Assert::AreEqual(1u, PathFlattener::GetQuadraticBezierSegmentCount(p0, Point{ -1e20f, 0 }, p2, 1e30f));
+        Assert::AreEqual(1u, PathFlattener::GetCubicBezierSegmentCount(p0, Point{ 0, 1e20f }, Point{ 0, -1e20f }, p0, 1e30f));
+    }
+
+    TEST_METHOD_EX(PathFlattener_Arc_FollowsTheCircle)
+    {
+        for (bool isClockwise : { false, true })
+        {
+            PathFlattener flattener(0.1f);
+
+            flattener.BeginFigure(Point{ 0, 0 });
+            flattener.AddArc(Point{ 20, 0 }, 10, 10, 0, isClockwise, false);
+            flattener.EndFigure(false);
+
+            auto& points = flattener.GetPoints();
+
+            Assert::IsTrue(points.size() > 5);
+
+            for (size_t i = 1; i + 1 < points.size(); i++)
+            {
+                float dx = points[i].X - 10;
+                float dy = points[i].Y;
+
+                Assert::AreEqual(10.0f, sqrtf(dx * dx + dy * dy), 0.001f);
+
+                // Going clockwise from the left of the circle to the right
+                // passes over the top, which is negative y.
+                Assert::IsTrue(isClockwise ? (dy < 0) : (dy > 0));
+
+                // Consecutive points are within the tolerance of the circle.
+                float midX = (points[i].X + points[i - 1].X) / 2 - 10;
+                float midY = (points[i].Y + points[i - 1].Y) / 2;
+
+                Assert::IsTrue(10 - sqrtf(midX * midX + midY * midY) <= 0.1f);
+            }
+        }
+    }
+
+    TEST_METHOD_EX(PathFlattener_Arc_LargeArcGoesTheLongWayRound)
+    {
+        PathFlattener flattener(0.1f);
+
+        flattener.BeginFigure(Point{ 10, 0 });
+        flattener.AddArc(Point{ 0, 10 }, 10, 10, 0, false, true);
+        flattener.EndFigure(false);
+
+        auto& points = flattener.GetPoints();
+
+        // Center is at (0, 0), and the arc covers three quarters of the circle.
+        for (size_t i = 1; i + 1 < points.size(); i++)
+        {
+            Assert::AreEqual(10.0f, sqrtf(points[i].X * points[i].X + points[i].Y * points[i].Y), 0.001f);
+        }
+
+        auto minX = std::min_element(points.begin(), points.end(), [](Point a, Point b) { return a.X < b.X; })->X;
+        auto minY = std::min_element(points.begin(), points.end(), [](Point a, Point b) { return a.Y < b.Y; })->Y;
+
+        Assert::AreEqual(-10.0f, minX, 0.1f);
+        Assert::AreEqual(-10.0f, minY, 0.1f);
+    }
+
+    TEST_METHOD_EX(PathFlattener_Arc_TooSmallRadii_AreScaledUp)
+    {
+        PathFlattener flattener(0.1f);
+
+        flattener.BeginFigure(Point{ 0, 0 });
+        flattener.AddArc(Point{ 20, 0 }, 1, 1, 0, true, false);
+        flattener.EndFigure(false);
+
+        // Becomes a semicircle of radius 10.
+        for (auto& point : flattener.GetPoints())
+        {
+            float dx = point.X - 10;
+
+            Assert::AreEqual(10.0f, sqrtf(dx * dx + point.Y * point.Y), 0.001f);
+        }
+    }
+
+    TEST_METHOD_EX(PathFlattener_Arc_DegenerateArcs)
+    {
+        PathFlattener flattener;
+
+        flattener.BeginFigure(Point{ 0, 0 });
+
+        // Zero radius is a straight line.
+        flattener.AddArc(Point{ 10, 0 }, 0, 5, 0, true, false);
+        Assert::AreEqual(2u, (uint32_t)flattener.GetPoints().size());
+
+        // Ending where it started adds nothing.
+        flattener.AddArc(Point{ 10, 0 }, 5, 5, 0, true, true);
+        Assert::AreEqual(2u, (uint32_t)flattener.GetPoints().size());
+    }
+
+    TEST_METHOD_EX(PathFlattener_PathDataOutsideFigure_Throws)
+    {
+        PathFlattener flattener;
+
+        ExpectHResultException(E_INVALIDARG, [&] { flattener.AddLine(Point{ 1, 1 }); });
+        ExpectHResultException(E_INVALIDARG, [&] { flattener.AddQuadraticBezier(Point{ 1, 1 }, Point{ 2, 2 }); });
+        ExpectHResultException(E_INVALIDARG, [&] { flattener.AddCubicBezier(Point{ 1, 1 }, Point{ 2, 2 }, Point{ 3, 3 }); });
+        ExpectHResultException(E_INVALIDARG, [&] { flattener.AddArc(Point{ 1, 1 }, 1, 1, 0, true, false); });
+        ExpectHResultException(E_INVALIDARG, [&] { flattener.EndFigure(true); });
+
+        flattener.BeginFigure(Point{ 0, 0 });
+
+        ExpectHResultException(E_INVALIDARG, [&] { flattener.BeginFigure(Point{ 0, 0 }); });
+    }
+
+    TEST_METHOD_EX(PathFlattener_Circle_TessellatesToTheRightArea)
+    {
+        PathFlattener flattener(0.01f);
+
+        flattener.BeginFigure(Point{ 0, 0 });
+        flattener.AddArc(Point{ 100, 0 }, 50, 50, 0, true, false);
+        flattener.AddArc(Point{ 0, 0 }, 50, 50, 0, true, false);
+        flattener.EndFigure(true);
+
+        PolygonTessellator tessellator;
+        flattener.SendTo(tessellator);
+
+        std::vector<PolygonTessellator::Triangle> triangles;
+        tessellator.Tessellate(triangles);
+
+        double area = 0;
+
+        for (auto& t : triangles)
+        {
+            area += fabs((t.Vertex2.X - t.Vertex1.X) * (t.Vertex3.Y - t.Vertex1.Y) -
+                         (t.Vertex3.X - t.Vertex1.X) * (t.Vertex2.Y - t.Vertex1.Y)) / 2;
+        }
+
+        // Flattening can only cut inside the circle, by at most the tolerance.
+        const double pi = 3.14159265358979;
+
+        Assert::IsTrue(area <= pi * 50 * 50);
+        Assert::IsTrue(area >= pi * 49.99 * 49.99);
+    }
+
+    TEST_METHOD_EX(PathFlattener_SendTo_SkipsUnfilledFigures)
+    {
+        auto receiver = Make<PathFlattenerReceiver>(0.25f);
+
+        ThrowIfFailed(receiver->SetFilledRegionDetermination(CanvasFilledRegionDetermination::Winding));
+
+        ThrowIfFailed(receiver->BeginFigure(Vector2{ 0, 0 }, CanvasFigureFill::Default));
+        ThrowIfFailed(receiver->AddLine(Vector2{ 10, 0 }));
+        ThrowIfFailed(receiver->AddLine(Vector2{ 10, 10 }));
+        ThrowIfFailed(receiver->EndFigure(CanvasFigureLoop::Closed));
+
+        ThrowIfFailed(receiver->BeginFigure(Vector2{ 20, 0 }, CanvasFigureFill::DoesNotAffectFills));
+        ThrowIfFailed(receiver->AddLine(Vector2{ 30, 0 }));
+        ThrowIfFailed(receiver->AddLine(Vector2{ 30, 10 }));
+        ThrowIfFailed(receiver->EndFigure(CanvasFigureLoop::Closed));
+
+        Assert::AreEqual(E_INVALIDARG, receiver->EndFigure(CanvasFigureLoop::Open));
+        ValidateStoredErrorState(E_INVALIDARG, Strings::FlattenerEndFigureWithoutBeginFigure);
+
+        auto& flattener = receiver->GetFlattener();
+
+        Assert::AreEqual(2u, (uint32_t)flattener.GetFigures().size());
+        Assert::IsTrue(flattener.GetFillMode() == PolygonTessellator::FillMode::Winding);
+
+        PolygonTessellator tessellator;
+        flattener.SendTo(tessellator);
+
+        Assert::AreEqual(2u, (uint32_t)tessellator.GetEdgeCount());
+        Assert::IsTrue(tessellator.GetFillMode() == PolygonTessellator::FillMode::Winding);
+    }
+};
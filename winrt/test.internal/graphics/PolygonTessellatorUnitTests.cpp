@@ -0,0 +1,261 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+#include <PolygonTessellator.h>
+
+typedef PolygonTessellator::Point Point;
+typedef PolygonTessellator::Triangle Triangle;
+typedef PolygonTessellator::FillMode FillMode;
+
+TEST_CLASS(PolygonTessellatorUnitTests)
+{
+    static double GetArea(std::vector<Triangle> const& triangles)
+    {
+        double area = 0;
+
+        for (auto& t : triangles)
+        {
+            double cross = (t.Vertex2.X - t.Vertex1.X) * (t.Vertex3.Y - t.Vertex1.Y) -
+                           (t.Vertex3.X - t.Vertex1.X) * (t.Vertex2.Y - t.Vertex1.Y);
+
+            area += fabs(cross) / 2;
+        }
+
+        return area;
+    }
+
+    static void AddRectangle(PolygonTessellator& tessellator, float left, float top, float right, float bottom)
+    {
+        tessellator.BeginFigure(Point{ left, top });
+        tessellator.AddLine(Point{ right, top });
+        tessellator.AddLine(Point{ right, bottom });
+        tessellator.AddLine(Point{ left, bottom });
+        tessellator.EndFigure();
+    }
+
+    TEST_METHOD_EX(PolygonTessellator_Empty_OutputsNoTriangles)
+    {
+        PolygonTessellator tessellator;
+        std::vector<Triangle> triangles;
+
+        tessellator.Tessellate(triangles);
+        Assert::AreEqual(0u, (uint32_t)triangles.size());
+
+        // A figure with no area.
+        tessellator.BeginFigure(Point{ 0, 0 });
+        tessellator.AddLine(Point{ 10, 0 });
+        tessellator.Tessellate(triangles);
+        Assert::AreEqual(0u, (uint32_t)triangles.size());
+    }
+
+    TEST_METHOD_EX(PolygonTessellator_Square_OutputsTwoTriangles)
+    {
+        PolygonTessellator tessellator;
+        AddRectangle(tessellator, 1, 2, 11, 12);
+
+        std::vector<Triangle> triangles;
+        tessellator.Tessellate(triangles);
+
+        Assert::AreEqual(2u, (uint32_t)triangles.size());
+        Assert::AreEqual(100.0, GetArea(triangles), 0.001);
+
+        for (auto& t : triangles)
+        {
+            for (auto& v : { t.Vertex1, t.Vertex2, t.Vertex3 })
+            {
+                Assert::IsTrue(v.X == 1 || v.X == 11);
+                Assert::IsTrue(v.Y == 2 || v.Y == 12);
+            }
+        }
+    }
+
+    TEST_METHOD_EX(PolygonTessellator_Tessellate_AppendsToExistingTriangles)
+    {
+        PolygonTessellator tessellator;
+        AddRectangle(tessellator, 0, 0, 1, 1);
+
+        std::vector<Triangle> triangles(3);
+        tessellator.Tessellate(triangles);
+
+        Assert::AreEqual(5u, (uint32_t)triangles.size());
+    }
+
+    TEST_METHOD_EX(PolygonTessellator_OpenFigure_IsImplicitlyClosed)
+    {
+        PolygonTessellator tessellator;
+        tessellator.BeginFigure(Point{ 0, 0 });
+        tessellator.AddLine(Point{ 10, 0 });
+        tessellator.AddLine(Point{ 0, 10 });
+
+        std::vector<Triangle> triangles;
+        tessellator.Tessellate(triangles);
+
+        Assert::AreEqual(50.0, GetArea(triangles), 0.001);
+
+        // Tessellate did not close the figure in the tessellator itself.
+        tessellator.AddLine(Point{ -10, 0 });
+
+        triangles.clear();
+        tessellator.Tessellate(triangles);
+
+        Assert::AreEqual(100.0, GetArea(triangles), 0.001);
+    }
+
+    TEST_METHOD_EX(PolygonTessellator_OverlappingFigures_DependOnFillMode)
+    {
+        PolygonTessellator tessellator;
+        AddRectangle(tessellator, 0, 0, 10, 10);
+        AddRectangle(tessellator, 5, 5, 15, 15);
+
+        std::vector<Triangle> triangles;
+        tessellator.Tessellate(triangles);
+
+        // Alternate leaves the overlapping area unfilled.
+        Assert::AreEqual(150.0, GetArea(triangles), 0.001);
+
+        tessellator.SetFillMode(FillMode::Winding);
+
+        triangles.clear();
+        tessellator.Tessellate(triangles);
+
+        Assert::AreEqual(175.0, GetArea(triangles), 0.001);
+    }
+
+    TEST_METHOD_EX(PolygonTessellator_OppositeWindings_CancelOut)
+    {
+        PolygonTessellator tessellator;
+        tessellator.SetFillMode(FillMode::Winding);
+
+        AddRectangle(tessellator, 0, 0, 10, 10);
+
+        // Same rectangle, in the other direction.
+        tessellator.BeginFigure(Point{ 2, 2 });
+        tessellator.AddLine(Point{ 2, 8 });
+        tessellator.AddLine(Point{ 8, 8 });
+        tessellator.AddLine(Point{ 8, 2 });
+
+        std::vector<Triangle> triangles;
+        tessellator.Tessellate(triangles);
+
+        Assert::AreEqual(64.0, GetArea(triangles), 0.001);
+    }
+
+    TEST_METHOD_EX(PolygonTessellator_SelfIntersectingFigure_IsSplitAtTheCrossing)
+    {
+        PolygonTessellator tessellator;
+
+        // Bow tie, with the edges crossing at (5, 5).
+        tessellator.BeginFigure(Point{ 0, 0 });
+        tessellator.AddLine(Point{ 10, 10 });
+        tessellator.AddLine(Point{ 10, 0 });
+        tessellator.AddLine(Point{ 0, 10 });
+
+        std::vector<Triangle> triangles;
+        tessellator.Tessellate(triangles);
+
+        Assert::AreEqual(50.0, GetArea(triangles), 0.001);
+
+        // No triangle may straddle the crossing.
+        for (auto& t : triangles)
+        {
+            float minY = std::min<float>(std::min<float>(t.Vertex1.Y, t.Vertex2.Y), t.Vertex3.Y);
+            float maxY = std::max<float>(std::max<float>(t.Vertex1.Y, t.Vertex2.Y), t.Vertex3.Y);
+
+            Assert::IsTrue(maxY <= 5.0f || minY >= 5.0f);
+        }
+    }
+
+    TEST_METHOD_EX(PolygonTessellator_Pentagram_DependsOnFillMode)
+    {
+        PolygonTessellator tessellator;
+
+        const float pi = 3.14159265f;
+
+        for (int i = 0; i < 5; i++)
+        {
+            float angle = i * 4 * pi / 5;
+            tessellator.AddLine(Point{ 50 * sinf(angle), -50 * cosf(angle) });
+        }
+
+        std::vector<Triangle> alternate;
+        tessellator.Tessellate(alternate);
+
+        tessellator.SetFillMode(FillMode::Winding);
+
+        std::vector<Triangle> winding;
+        tessellator.Tessellate(winding);
+
+        // Winding also fills the pentagon in the middle.
+        double alternateArea = GetArea(alternate);
+        double windingArea = GetArea(winding);
+
+        Assert::AreEqual(1939.19, alternateArea, 0.1);
+        Assert::AreEqual(2806.42, windingArea, 0.1);
+    }
+
+    TEST_METHOD_EX(PolygonTessellator_NonFiniteAndHorizontalEdges_AreIgnored)
+    {
+        PolygonTessellator tessellator;
+        AddRectangle(tessellator, 0, 0, 10, 10);
+
+        Assert::AreEqual(2u, (uint32_t)tessellator.GetEdgeCount());
+
+        tessellator.BeginFigure(Point{ 0, 0 });
+        tessellator.AddLine(Point{ NAN, 5 });
+        tessellator.EndFigure();
+
+        Assert::AreEqual(2u, (uint32_t)tessellator.GetEdgeCount());
+
+        tessellator.Clear();
+
+        Assert::AreEqual(0u, (uint32_t)tessellator.GetEdgeCount());
+    }
+
+    TEST_METHOD_EX(PolygonTessellator_TessellateBatch_MatchesTessellate)
+    {
+        const size_t count = 20;
+
+        std::vector<PolygonTessellator> tessellators(count);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            auto& tessellator = tessellators[i];
+
+            tessellator.SetFillMode((i & 1) ? FillMode::Winding : FillMode::Alternate);
+
+            for (size_t j = 0; j < 10 + i; j++)
+            {
+                float x = static_cast<float>((j * 37 + i * 11) % 100);
+                float y = static_cast<float>((j * 53 + i * 7) % 100);
+
+                tessellator.AddLine(Point{ x, y });
+            }
+        }
+
+        for (unsigned threadCount : { 0u, 1u, 3u })
+        {
+            std::vector<std::vector<Triangle>> results(count);
+
+            PolygonTessellator::TessellateBatch(tessellators.data(), count, results.data(), threadCount);
+
+            for (size_t i = 0; i < count; i++)
+            {
+                std::vector<Triangle> expected;
+                tessellators[i].Tessellate(expected);
+
+                Assert::AreEqual((uint32_t)expected.size(), (uint32_t)results[i].size());
+                Assert::IsTrue(memcmp(expected.data(), results[i].data(), expected.size() * sizeof(Triangle)) == 0);
+            }
+        }
+    }
+};
@@ -60,6 +60,9 @@ namespace canvas
         DONT_EXPECT(DrawBitmapWithDestRectAndSourceRectAndOpacityAndInterpolation               , ICanvasBitmap*, Rect, Rect, float, CanvasImageInterpolation);
         DONT_EXPECT(DrawBitmapWithDestRectAndSourceRectAndOpacityAndInterpolationAndPerspective , ICanvasBitmap*, Rect, Rect, float, CanvasImageInterpolation, Matrix4x4);
 
+        DONT_EXPECT(DrawSprites                                                 , uint32_t, ICanvasBitmap**, uint32_t, Matrix3x2*, uint32_t, Rect*);
+        DONT_EXPECT(DrawSpritesWithTintsAndOpacitiesAndInterpolationAndSortMode , uint32_t, ICanvasBitmap**, uint32_t, Matrix3x2*, uint32_t, Rect*, uint32_t, Color*, uint32_t, float*, CanvasImageInterpolation, CanvasSpriteSortMode);
+
         DONT_EXPECT(DrawLineWithBrush                                     , Vector2, Vector2, ICanvasBrush*);
         DONT_EXPECT(DrawLineAtCoordsWithBrush                             , float, float, float, float, ICanvasBrush*);
         DONT_EXPECT(DrawLineWithColor                                     , Vector2, Vector2, Color);
@@ -73,6 +76,11 @@ namespace canvas
         DONT_EXPECT(DrawLineWithColorAndStrokeWidthAndStrokeStyle         , Vector2, Vector2, Color, float, ICanvasStrokeStyle*);
         DONT_EXPECT(DrawLineAtCoordsWithColorAndStrokeWidthAndStrokeStyle , float, float, float, float, Color, float, ICanvasStrokeStyle*);
 
+        DONT_EXPECT(DrawLinesWithBrush                              , uint32_t, Vector2*, uint32_t, Vector2*, ICanvasBrush*);
+        DONT_EXPECT(DrawLinesWithColors                             , uint32_t, Vector2*, uint32_t, Vector2*, uint32_t, Color*);
+        DONT_EXPECT(DrawLinesWithBrushAndStrokeWidthAndStrokeStyle  , uint32_t, Vector2*, uint32_t, Vector2*, ICanvasBrush*, float, ICanvasStrokeStyle*);
+        DONT_EXPECT(DrawLinesWithColorsAndStrokeWidthAndStrokeStyle , uint32_t, Vector2*, uint32_t, Vector2*, uint32_t, Color*, float, ICanvasStrokeStyle*);
+
         DONT_EXPECT(DrawRectangleWithBrush                                     , Rect, ICanvasBrush*);
         DONT_EXPECT(DrawRectangleAtCoordsWithBrush                             , float, float, float, float, ICanvasBrush*);
         DONT_EXPECT(DrawRectangleWithColor                                     , Rect, Color);
@@ -93,6 +101,9 @@ namespace canvas
         DONT_EXPECT(FillRectangleWithBrushAndOpacityBrush        , Rect, ICanvasBrush*, ICanvasBrush*);
         DONT_EXPECT(FillRectangleAtCoordsWithBrushAndOpacityBrush, float, float, float, float, ICanvasBrush*, ICanvasBrush*);
 
+        DONT_EXPECT(FillRectanglesWithBrush  , uint32_t, Rect*, ICanvasBrush*);
+        DONT_EXPECT(FillRectanglesWithColors , uint32_t, Rect*, uint32_t, Color*);
+
         DONT_EXPECT(DrawRoundedRectangleWithBrush                                     , Rect, float, float, ICanvasBrush*);
         DONT_EXPECT(DrawRoundedRectangleAtCoordsWithBrush                             , float, float, float, float, float, float, ICanvasBrush*);
         DONT_EXPECT(DrawRoundedRectangleWithColor                                     , Rect, float, float, Color);
@@ -147,6 +158,9 @@ namespace canvas
         DONT_EXPECT(FillCircleWithColor         , Vector2, float, Color);
         DONT_EXPECT(FillCircleAtCoordsWithColor , float, float, float, Color);
 
+        DONT_EXPECT(FillCirclesWithBrush  , uint32_t, Vector2*, uint32_t, float*, ICanvasBrush*);
+        DONT_EXPECT(FillCirclesWithColors , uint32_t, Vector2*, uint32_t, float*, uint32_t, Color*);
+
         DONT_EXPECT(DrawTextAtPointWithColor                , HSTRING, Vector2, Color);
         DONT_EXPECT(DrawTextAtPointCoordsWithColor          , HSTRING, float, float, Color);
         DONT_EXPECT(DrawTextAtPointWithBrushAndFormat       , HSTRING, Vector2, ICanvasBrush*, ICanvasTextFormat*);
@@ -209,6 +223,10 @@ namespace canvas
         DONT_EXPECT(put_Transform        , ABI::Microsoft::Graphics::Canvas::Numerics::Matrix3x2);
         DONT_EXPECT(get_Units            , CanvasUnits*);
         DONT_EXPECT(put_Units            , CanvasUnits);
+        DONT_EXPECT(get_IsCullingEnabled , boolean*);
+        DONT_EXPECT(put_IsCullingEnabled , boolean);
+        DONT_EXPECT(get_IsTextLayoutCacheEnabled , boolean*);
+        DONT_EXPECT(put_IsTextLayoutCacheEnabled , boolean);
 
         DONT_EXPECT(CreateLayerWithOpacity                                , float, ICanvasActiveLayer**);
         DONT_EXPECT(CreateLayerWithOpacityBrush                           , ICanvasBrush*, ICanvasActiveLayer**);
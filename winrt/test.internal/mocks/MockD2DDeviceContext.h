@@ -65,6 +65,7 @@ namespace canvas
         CALL_COUNTER_WITH_MOCK(CreateStrokedGeometryRealizationMethod, HRESULT(ID2D1Geometry*, FLOAT, FLOAT, ID2D1StrokeStyle *, ID2D1GeometryRealization**));
         CALL_COUNTER_WITH_MOCK(DrawGeometryRealizationMethod         , void(ID2D1GeometryRealization*, ID2D1Brush*));
         CALL_COUNTER_WITH_MOCK(DrawTextLayoutMethod                  , void(D2D1_POINT_2F, IDWriteTextLayout*, ID2D1Brush*, D2D1_DRAW_TEXT_OPTIONS));
+        CALL_COUNTER_WITH_MOCK(CreateLayerMethod                     , HRESULT(const D2D1_SIZE_F*, ID2D1Layer**));
         CALL_COUNTER_WITH_MOCK(PushLayerMethod                       , void(const D2D1_LAYER_PARAMETERS1*, ID2D1Layer*));
         CALL_COUNTER_WITH_MOCK(PopLayerMethod                        , void());
         CALL_COUNTER_WITH_MOCK(PushAxisAlignedClipMethod             , void(D2D1_RECT_F const*, D2D1_ANTIALIAS_MODE));
@@ -149,10 +150,9 @@ namespace canvas
             return E_NOTIMPL;
         }
 
-        IFACEMETHODIMP CreateLayer(const D2D1_SIZE_F *,ID2D1Layer **) override
+        IFACEMETHODIMP CreateLayer(const D2D1_SIZE_F* size, ID2D1Layer** layer) override
         {
-            Assert::Fail(L"Unexpected call to CreateLayer");
-            return E_NOTIMPL;
+            return CreateLayerMethod.WasCalled(size, layer);
         }
 
         IFACEMETHODIMP CreateMesh(ID2D1Mesh **) override
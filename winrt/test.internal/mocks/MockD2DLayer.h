@@ -0,0 +1,45 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+namespace canvas
+{
+    class MockD2DLayer : public RuntimeClass<
+        RuntimeClassFlags<ClassicCom>,
+        ChainInterfaces<ID2D1Layer, ID2D1Resource>>
+    {
+    public:
+        CALL_COUNTER_WITH_MOCK(GetSizeMethod, D2D1_SIZE_F());
+
+        CALL_COUNTER_WITH_MOCK(GetFactoryMethod, void(ID2D1Factory**));
+
+        //
+        // ID2D1Layer
+        //
+
+        STDMETHOD_(D2D1_SIZE_F, GetSize)() const override
+        {
+            return GetSizeMethod.WasCalled();
+        }
+
+        //
+        // ID2D1Resource
+        //
+
+        STDMETHOD_(void, GetFactory)(
+            ID2D1Factory** factory) const override
+        {
+            GetFactoryMethod.WasCalled(factory);
+        }
+    };
+}
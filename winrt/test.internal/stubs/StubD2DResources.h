@@ -12,6 +12,8 @@
 
 #pragma once
 
+#include "MockD2DLayer.h"
+
 // This device derives from MockCanvasDevice, but it allows creation of stroke styles.
 class StubD2DFactoryWithCreateStrokeStyle : public MockD2DFactory
 {
@@ -59,6 +61,12 @@ public:
         m_factory = Make<StubD2DFactoryWithCreateStrokeStyle>();
 
         CheckMakeResult(m_factory);
+
+        CreateLayerMethod.AllowAnyCall(
+            [](const D2D1_SIZE_F*, ID2D1Layer** layer)
+            {
+                return Make<MockD2DLayer>().CopyTo(layer);
+            });
     }
 
     IFACEMETHODIMP_(void) GetFactory(ID2D1Factory** factory) const override
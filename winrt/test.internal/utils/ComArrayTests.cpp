@@ -24,6 +24,19 @@ TEST_CLASS(ComArrayTests)
             return p;
         }
         
+        static void* CoTaskMemRealloc(void* p, size_t bytes)
+        {
+            if (p)
+            {
+                Assert::AreEqual<size_t>(1U, GetAllocations()->count(p));
+                GetAllocations()->erase(p);
+            }
+
+            auto newP = ::CoTaskMemRealloc(p, bytes);
+            GetAllocations()->insert(newP);
+            return newP;
+        }
+
         static void CoTaskMemFree(void* p)
         {
             if (p)
@@ -126,6 +139,50 @@ TEST_CLASS(ComArrayTests)
         Tracker::CoTaskMemFree(data);
     }
 
+    TEST_METHOD_EX(ComArray_Resize_KeepsExistingElements)
+    {
+        ComArray<float, Tracker> array(2);
+        array[0] = 1;
+        array[1] = 2;
+
+        array.Resize(1000);
+
+        Assert::AreEqual(1000U, array.GetSize());
+        Assert::AreEqual(1.0f, array[0]);
+        Assert::AreEqual(2.0f, array[1]);
+
+        array.Resize(1);
+
+        Assert::AreEqual(1U, array.GetSize());
+        Assert::AreEqual(1.0f, array[0]);
+
+        array.Resize(0);
+
+        Assert::AreEqual(0U, array.GetSize());
+        Assert::IsNotNull(array.GetData());
+    }
+
+    TEST_METHOD_EX(ComArray_Resize_EmptyArray)
+    {
+        ComArray<float, Tracker> array;
+
+        array.Resize(10);
+
+        Assert::AreEqual(10U, array.GetSize());
+        Assert::IsNotNull(array.GetData());
+    }
+
+    TEST_METHOD_EX(ComArray_Resize_WhenSizeInBytesOverflows_ThrowsAndKeepsExistingElements)
+    {
+        ComArray<float, Tracker> array(1);
+        array[0] = 1;
+
+        ExpectHResultException(E_OUTOFMEMORY, [&] { array.Resize(SIZE_MAX / sizeof(float) + 1); });
+
+        Assert::AreEqual(1U, array.GetSize());
+        Assert::AreEqual(1.0f, array[0]);
+    }
+
     TEST_METHOD_EX(ComArray_GetAddressOfData_ReleasesAndTracksNewValue)
     {
         ComArray<float, Tracker> array(100);